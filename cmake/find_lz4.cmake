@@ -0,0 +1,27 @@
+macro(find_lz4)
+    if(NOT lz4_CACHED)
+        find_package(lz4 QUIET)
+
+        if(NOT lz4_FOUND)
+            include(FindPkgConfig)
+            find_package(PkgConfig QUIET)
+            if(PkgConfig_FOUND)
+                pkg_search_module(LZ4 QUIET liblz4)
+            endif()
+
+            if(LZ4_FOUND)
+                set(lz4_INCLUDE_DIRS ${LZ4_INCLUDE_DIRS}
+                    CACHE STRING "Include directories for LZ4"
+                )
+                set(lz4_LIBRARIES ${LZ4_LDFLAGS}
+                    CACHE STRING "Libraries for LZ4"
+                )
+                set(lz4_FOUND TRUE)
+            endif()
+        endif()
+
+        if(lz4_FOUND)
+            set(lz4_CACHED TRUE CACHE BOOL "LZ4 found")
+        endif()
+    endif()
+endmacro()
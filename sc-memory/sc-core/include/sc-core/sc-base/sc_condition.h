@@ -8,6 +8,7 @@
 #define _sc_condition_h_
 
 #include "sc-core/sc_defines.h"
+#include "sc-core/sc_types.h"
 
 typedef struct _sc_condition sc_condition;
 typedef struct _sc_mutex sc_mutex;
@@ -16,6 +17,14 @@ _SC_EXTERN void sc_cond_init(sc_condition * condition);
 
 _SC_EXTERN void sc_cond_wait(sc_condition * condition, sc_mutex * mutex);
 
+/*! Waits for condition like `sc_cond_wait`, but no longer than specified time.
+ * @param condition Condition to wait for
+ * @param mutex Locked mutex, it is unlocked while the thread waits
+ * @param timeout_ms Maximum time to wait in milliseconds
+ * @returns SC_FALSE, if time is out, otherwise SC_TRUE.
+ */
+_SC_EXTERN sc_bool sc_cond_wait_for(sc_condition * condition, sc_mutex * mutex, sc_uint32 timeout_ms);
+
 _SC_EXTERN void sc_cond_signal(sc_condition * condition);
 
 _SC_EXTERN void sc_cond_broadcast(sc_condition * condition);
@@ -52,6 +52,12 @@ _SC_EXTERN void sc_monitor_acquire_write(sc_monitor * monitor);
  */
 _SC_EXTERN void sc_monitor_release_write(sc_monitor * monitor);
 
+/*! Tries to acquire a write lock on the specified monitor without blocking
+ * @param monitor Pointer to the sc_monitor
+ * @returns SC_TRUE if the write lock has been acquired, otherwise SC_FALSE
+ */
+_SC_EXTERN sc_bool sc_monitor_try_acquire_write(sc_monitor * monitor);
+
 /*! Acquires read locks for multiple monitors
  * @param n Count of monitors
  * @param ... Variable argument list containing pointers to sc_monitors
@@ -80,4 +86,12 @@ _SC_EXTERN void sc_monitor_acquire_write_n(sc_uint32 n, ...);
  */
 _SC_EXTERN void sc_monitor_release_write_n(sc_uint32 n, ...);
 
+/*! Tries to acquire write locks for multiple monitors without blocking
+ * @param n Count of monitors
+ * @param ... Variable argument list containing pointers to sc_monitors
+ * @returns SC_TRUE if all write locks have been acquired, otherwise SC_FALSE and no lock is held
+ * @remarks Use it to acquire monitors while other monitors are held, blocking in this case may lead to deadlock
+ */
+_SC_EXTERN sc_bool sc_monitor_try_acquire_write_n(sc_uint32 n, ...);
+
 #endif
@@ -40,7 +40,8 @@ sc_bool sc_dictionary_destroy(sc_dictionary * dictionary, void (*node_clear)(sc_
  * @param string An appendable string
  * @param string_size An appendable string size
  * @param data A pointer to data storing by appended string
- * @returns Returns A sc-dictionary node where appended string ends
+ * @returns Returns A sc-dictionary node where appended string ends, or null_ptr if sc-dictionary isn't a trie (it is
+ * hashed or it is an adaptive radix tree)
  */
 sc_dictionary_node * sc_dictionary_append(
     sc_dictionary * dictionary,
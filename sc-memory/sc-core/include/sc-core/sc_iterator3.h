@@ -52,6 +52,14 @@ struct _sc_iterator_result
     SC_ADDR_EMPTY, SC_TRUE \
   }
 
+//! Position of iteration over sc-connectors between two sc-elements in index of sc-connectors
+typedef struct _sc_connectors_index_position
+{
+  sc_uint32 index;       // index of the last got sc-connector in sc-connectors of pair
+  sc_uint32 generation;  // generation of sc-connectors of pair when the index was got
+  sc_uint32 number;      // number of the last got sc-connector in order of adding to pair, 0 if nothing is got
+} sc_connectors_index_position;
+
 /*! Structure to store iterator information
  */
 struct _sc_iterator3
@@ -61,6 +69,8 @@ struct _sc_iterator3
   sc_iterator_result results[3];  // results array (same size as params)
   sc_memory_context const * ctx;  // pointer to used memory context
   sc_bool finished;
+  sc_bool is_arcs_index_used;  // sc-arcs are iterated by index of sc-arcs by types
+  sc_connectors_index_position connectors_index_position;  // position of iteration by index of sc-connectors
 };
 
 /*! Create iterator to find outgoing sc-arcs for specified element
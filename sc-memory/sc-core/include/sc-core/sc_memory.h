@@ -97,6 +97,67 @@ _SC_EXTERN sc_result sc_memory_shutdown(sc_bool save_state);
  */
 _SC_EXTERN void sc_memory_shutdown_extensions();
 
+/*!
+ * @brief Verifies sc-memory saved in file system without loading it.
+ *
+ * This function verifies checksums of saved sc-segments and strings channels and reports every corrupted one.
+ * It must be called when sc-memory isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param[out] corrupted_count Count of corrupted sc-segments and strings channels.
+ *
+ * @return Returns SC_RESULT_OK if saved sc-memory is verified, even if it is corrupted; otherwise, an error code is
+ *         returned.
+ */
+_SC_EXTERN sc_result sc_memory_verify_storage(sc_memory_params const * params, sc_uint32 * corrupted_count);
+
+/*!
+ * @brief Compacts sc-memory saved in file system.
+ *
+ * This function loads saved sc-memory, relocates its sc-elements into the first sc-segments, frees sc-segments emptied
+ * by erased sc-elements and saves sc-memory. Addresses of relocated sc-elements are changed, so sc-addrs and their
+ * hashes kept outside of sc-memory become invalid. It must be called when sc-memory isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param[out] moved_count Count of relocated sc-elements.
+ *
+ * @return Returns SC_RESULT_OK if sc-memory is compacted and saved; otherwise, an error code is returned.
+ */
+_SC_EXTERN sc_result sc_memory_compact_storage(sc_memory_params const * params, sc_uint32 * moved_count);
+
+/*!
+ * @brief Exports sc-memory saved in file system to file.
+ *
+ * This function loads saved sc-memory and writes its sc-elements with types, begin and end sc-elements of
+ * sc-connectors and contents of sc-links to file. The binary format of file doesn't depend on layout of sc-elements, so
+ * file is imported by sc-machines built with other options. Sc-segments are scanned in parallel. It must be called when
+ * sc-memory isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param path Path to file to export sc-elements to.
+ * @param[out] exported_count Count of exported sc-elements.
+ *
+ * @return Returns SC_RESULT_OK if sc-memory is exported; otherwise, an error code is returned.
+ */
+_SC_EXTERN sc_result
+sc_memory_export_storage(sc_memory_params const * params, sc_char const * path, sc_uint64 * exported_count);
+
+/*!
+ * @brief Imports sc-elements exported by `sc_memory_export_storage` to sc-memory saved in file system.
+ *
+ * This function loads saved sc-memory, or initializes empty one if `clear` parameter is set, generates sc-elements of
+ * file and saves sc-memory. Imported sc-elements get new addresses. It must be called when sc-memory isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param path Path to file to import sc-elements from.
+ * @param[out] imported_count Count of imported sc-elements.
+ *
+ * @return Returns SC_RESULT_OK if sc-elements are imported and sc-memory is saved; otherwise, an error code is
+ * returned.
+ */
+_SC_EXTERN sc_result
+sc_memory_import_storage(sc_memory_params const * params, sc_char const * path, sc_uint64 * imported_count);
+
 /*!
  * Generates a new sc-memory context for a specified user.
  *
@@ -244,6 +305,33 @@ _SC_EXTERN sc_bool sc_memory_is_element_ext(sc_memory_context const * ctx, sc_ad
  */
 _SC_EXTERN sc_result sc_memory_element_free(sc_memory_context * ctx, sc_addr addr);
 
+/*!
+ * @brief Erases sc-elements and all connected elements in batch.
+ *
+ * This function frees the memory occupied by sc-elements identified by the provided sc-addrs, along with all the
+ * connected elements (incoming/outgoing sc-connectors) related to them. Unlike calling `sc_memory_element_free` for
+ * each sc-element, closure of sc-elements is computed once, sc-connectors between erased sc-elements aren't unlinked
+ * one by one, and sc-elements are released segment by segment.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param count Count of sc-elements to be erased.
+ * @param addrs A pointer to array of sc-addrs of sc-elements to be erased.
+ *
+ * @return Returns SC_RESULT_OK if the operation executed successfully.
+ *
+ * @note Permissions are checked for all sc-elements before any of them is erased. Valid sc-elements are erased even if
+ * some sc-addrs are not valid.
+ * @note This function is thread-safe.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ADDR_IS_NOT_VALID Some of specified sc-addrs are not valid.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHORIZED The specified sc-memory context is not authorized.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_ERASE_PERMISSIONS The specified sc-memory context does not have
+ * erase permissions.
+ */
+_SC_EXTERN sc_result sc_memory_elements_erase(sc_memory_context * ctx, sc_uint32 count, sc_addr const * addrs);
+
 /*!
  * @brief Generates a new sc-node with the specified type.
  *
@@ -290,6 +378,30 @@ _SC_EXTERN sc_addr sc_memory_node_new(sc_memory_context const * ctx, sc_type typ
  */
 _SC_EXTERN sc_addr sc_memory_node_new_ext(sc_memory_context const * ctx, sc_type type, sc_result * result);
 
+/*!
+ * @brief Generates sc-nodes with the specified type in batch.
+ *
+ * This function creates `count` sc-nodes with the specified type and stores their sc-addrs in `addrs`. Sc-addrs are
+ * reserved in sc-segments for all sc-nodes at once, so it is faster than generation of the same sc-nodes one by one.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param type Type of the new sc-nodes.
+ * @param count Count of the new sc-nodes.
+ * @param addrs Array of size `count` that will store sc-addrs of the created sc-nodes.
+ *
+ * @return Returns the result of the operation. If it isn't SC_RESULT_OK, then no sc-node is created and all sc-addrs
+ *         in `addrs` are empty.
+ *
+ * @note This function is thread-safe.
+ *
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ELEMENT_IS_NOT_NODE The specified sc-type is not valid for a sc-node.
+ * @retval SC_RESULT_ERROR_FULL_MEMORY Unable to allocate memory for all new sc-nodes.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED The specified sc-memory context is not authenticated.
+ */
+_SC_EXTERN sc_result
+sc_memory_nodes_new_batch(sc_memory_context const * ctx, sc_type type, sc_uint32 count, sc_addr * addrs);
+
 /*!
  * @brief Generates a new sc-link with the specified type.
  *
@@ -416,6 +528,45 @@ _SC_EXTERN sc_addr sc_memory_arc_new_ext(
     sc_addr end_addr,
     sc_result * result);
 
+/*!
+ * @brief Generates sc-connectors in batch.
+ *
+ * This function creates sc-connectors with types, begin and end sc-elements specified in `triples` and stores their
+ * sc-addrs in `connectors`. Sc-addrs are reserved in sc-segments for all sc-connectors at once, permissions of the
+ * sc-memory context are checked before any sc-connector is created, and sc-connectors are linked with their begin and
+ * end sc-elements in groups that share the same locks.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param count Count of the new sc-connectors.
+ * @param triples Array of size `count` with types, begin and end sc-elements of the new sc-connectors.
+ * @param connectors Array of size `count` that will store sc-addrs of the created sc-connectors.
+ * @param emit_events Boolean indicating whether to emit events of the generated sc-connectors. If it is SC_FALSE, then
+ *                    no sc-event is emitted.
+ *
+ * @return Returns the result of the operation. If the begin or end sc-element of some sc-connector doesn't exist, then
+ *         this sc-connector isn't created and its sc-addr in `connectors` is empty, but other sc-connectors are
+ *         created.
+ *         Otherwise, if the result isn't SC_RESULT_OK, then no sc-connector is created.
+ *
+ * @note This function is thread-safe.
+ *
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR Some specified type is not a valid sc-connector type.
+ * @retval SC_RESULT_ERROR_ADDR_IS_NOT_VALID Some begin or end sc-addr is not valid.
+ * @retval SC_RESULT_ERROR_FULL_MEMORY Unable to allocate memory for all new sc-connectors.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED The specified sc-memory context is not authenticated.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS The specified sc-memory context does not have
+ * write permissions.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_WRITE_PERMISSIONS The specified sc-memory context
+ * does not have permissions to write permissions.
+ */
+_SC_EXTERN sc_result sc_memory_arcs_new_batch(
+    sc_memory_context const * ctx,
+    sc_uint32 count,
+    sc_connector_triple const * triples,
+    sc_addr * connectors,
+    sc_bool emit_events);
+
 /*!
  * @brief Retrieves the count of output connectors for the specified sc-element.
  *
@@ -896,6 +1047,26 @@ _SC_EXTERN sc_result sc_memory_find_links_contents_by_content_substring_ext(
  */
 _SC_EXTERN sc_result sc_memory_stat(sc_memory_context const * ctx, sc_stat * stat);
 
+/*!
+ * @brief Enables or disables index of sc-connectors by pairs of their begin and end sc-elements at runtime.
+ *
+ * Enabled index is built from existing sc-connectors, so f_a_f iterators don't walk sc-connectors of sc-elements.
+ * Disabled index is cleared. Initial state of the index is set by `connectors_index` of sc-memory params.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param is_enabled SC_TRUE to enable index of sc-connectors, SC_FALSE to disable it.
+ *
+ * @return Returns the result of the operation. If successful, it returns SC_RESULT_OK.
+ *
+ * @note Other threads may use sc-memory, but they wait until the index is switched, since it is switched under locks
+ * of all sc-elements. Iterations started before the switch are continued without duplicated sc-connectors.
+ *
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHORIZED The specified sc-memory context is not authorized.
+ * @retval SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS The specified sc-memory context does not have
+ * write permissions.
+ */
+_SC_EXTERN sc_result sc_memory_set_connectors_index(sc_memory_context const * ctx, sc_bool is_enabled);
+
 /*!
  * @brief Saves the current state of the sc-storage to persistent storage.
  *
@@ -11,11 +11,22 @@
 #include "sc-core/sc_memory_version.h"
 
 #define DEFAULT_MAX_LOADED_SEGMENTS 1000
+#define DEFAULT_SEGMENTS_HUGE_PAGES SC_FALSE
+#define DEFAULT_SEGMENTS_NUMA_POLICY "None"
+#define DEFAULT_SEGMENTS_MEMORY_LIMIT 0
+#define DEFAULT_ARCS_INDEX_THRESHOLD 1000
+#define DEFAULT_CONNECTORS_INDEX SC_FALSE
 #define DEFAULT_LIMIT_MAX_THREADS_BY_MAX_PHYSICAL_CORES SC_TRUE
 #define DEFAULT_MAX_EVENTS_AND_AGENTS_THREADS 32
 #define DEFAULT_MIN_EVENTS_AND_AGENTS_THREADS 1
 #define DEFAULT_DUMP_MEMORY SC_TRUE
 #define DEFAULT_DUMP_MEMORY_PERIOD 32000
+#define DEFAULT_DUMP_MEMORY_DELTAS_COUNT 0
+#define DEFAULT_DUMP_MEMORY_COMPRESSION "None"
+#define DEFAULT_SKIP_CORRUPTED_SEGMENTS SC_FALSE
+#define DEFAULT_WRITE_AHEAD_LOG SC_FALSE
+#define DEFAULT_WRITE_AHEAD_LOG_SYNC_POLICY "Commit"
+#define DEFAULT_WRITE_AHEAD_LOG_SYNC_PERIOD 100
 #define DEFAULT_DUMP_MEMORY_STATISTICS SC_TRUE
 #define DEFAULT_DUMP_MEMORY_STATISTICS_PERIOD 16000
 #define DEFAULT_LOG_TYPE "Console"
@@ -26,6 +37,7 @@
 #define DEFAULT_MAX_SEARCHABLE_STRING_SIZE 1000
 #define DEFAULT_TERM_SEPARATORS " _"
 #define DEFAULT_SEARCH_BY_SUBSTRING SC_TRUE
+#define DEFAULT_LINK_CONTENTS_INDEX "Dictionary"
 
 /*! Structure representing parameters for configuring the sc-memory.
  * @note This structure holds various configuration parameters that control the behavior of the sc-memory.
@@ -41,7 +53,15 @@ typedef struct
   sc_uint32 extensions_directories_count;   ///< Size of extensions directories array.
   sc_char const ** enabled_extensions;      ///< Array of enabled extensions.
 
-  sc_uint32 max_loaded_segments;  ///< Maximum number of loaded segments.
+  sc_uint32 max_loaded_segments;  ///< Initial capacity of table of segments, it grows up to SC_ADDR_SEG_MAX.
+  sc_bool segments_huge_pages;    ///< Boolean indicating whether to allocate segments in huge pages (Linux only).
+  ///< NUMA policy of segments memory (e.g., "None", "Interleave", "Bind"). By default, it is "None".
+  sc_char const * segments_numa_policy;
+  ///< Size (in megabytes) of memory of sc-segments mapped from dump after which cold ones are paged out. 0 disables it.
+  sc_uint32 segments_memory_limit;
+  ///< Count of outgoing or incoming sc-arcs of sc-element after which its sc-arcs are indexed by types. 0 disables it.
+  sc_uint32 arcs_index_threshold;
+  sc_bool connectors_index;  ///< Boolean indicating whether to index sc-connectors by their begin and end sc-elements.
 
   ///< Boolean indicating whether sc-memory limit `max_events_and_agents_threads` by maximum physical core number.
   sc_bool limit_max_threads_by_max_physical_cores;
@@ -50,6 +70,18 @@ typedef struct
   ///< Boolean indicating whether automatic saving of sc-memory state. By default, it is SC_TRUE.
   sc_bool dump_memory;
   sc_uint32 dump_memory_period;  ///< Period (in seconds) for automatic saving of sc-memory state.
+  ///< Count of automatic savings of only changed segments between savings of the whole sc-memory state. 0 disables it.
+  sc_uint32 dump_memory_deltas_count;
+  ///< Compression of sc-segments in dumps of the whole sc-memory state (e.g., "None", "LZ4"). By default, it is "None".
+  sc_char const * dump_memory_compression;
+  ///< Boolean indicating whether to load corrupted sc-segments empty instead of failing. By default, it is SC_FALSE.
+  sc_bool skip_corrupted_segments;
+
+  ///< Boolean indicating whether to log changes of sc-memory and to apply them after crash. By default, it is SC_FALSE.
+  sc_bool write_ahead_log;
+  ///< Synchronization of write-ahead log with disk (e.g., "Commit", "Periodic", "None"). By default, it is "Commit".
+  sc_char const * write_ahead_log_sync_policy;
+  sc_uint32 write_ahead_log_sync_period;  ///< Period (in milliseconds) for synchronization of write-ahead log.
 
   ///< Boolean indicating whether automatic dumping statistics of sc-memory state. By default, it is SC_TRUE.
   sc_bool dump_memory_statistics;
@@ -69,6 +101,8 @@ typedef struct
   sc_uint32 max_searchable_string_size;  ///< Maximum size of a searchable string.
   sc_char const * term_separators;       ///< String containing term separators used in string operations.
   sc_bool search_by_substring;           ///< Boolean indicating whether to allow searching by substring.
+  ///< Index of contents of sc-links (e.g., "Dictionary", "Hash", "ART"). By default, it is "Dictionary".
+  sc_char const * link_contents_index;
 } sc_memory_params;
 
 _SC_EXTERN void sc_memory_params_clear(sc_memory_params * params);
@@ -233,6 +233,8 @@ typedef sc_uint16 sc_states;
 #  define SC_STATE_REQUEST_ERASURE 0x1
 #  define SC_STATE_IS_ERASABLE 0x200
 #  define SC_STATE_ELEMENT_EXIST 0x2
+#  define SC_STATE_HAS_OUTGOING_ARCS_INDEX 0x400
+#  define SC_STATE_HAS_INCOMING_ARCS_INDEX 0x800
 
 // results
 enum _sc_result
@@ -268,12 +270,24 @@ enum _sc_result
   SC_RESULT_COUNT,  // number of result types
 };
 
+// structure to store sc-connector that is generated in batch
+struct _sc_connector_triple
+{
+  sc_type type;            // type of sc-connector
+  struct _sc_addr begin;  // sc-addr of begin sc-element
+  struct _sc_addr end;    // sc-addr of end sc-element
+};
+
 // structure to store statistics info
 struct _sc_stat
 {
-  sc_uint64 node_count;       // amount of all sc-nodes stored in memory
-  sc_uint64 connector_count;  // amount of all sc-connectors stored in memory
-  sc_uint64 link_count;       // amount of all sc-links stored in memory
+  sc_uint64 node_count;                // amount of all sc-nodes stored in memory
+  sc_uint64 connector_count;           // amount of all sc-connectors stored in memory
+  sc_uint64 link_count;                // amount of all sc-links stored in memory
+  sc_uint64 connectors_index_size;     // size of memory used by index of sc-connectors in bytes
+  sc_uint64 resident_segments_size;    // size of memory of resident segments mapped from dump in bytes
+  sc_uint64 paged_out_segments_count;  // amount of paged out segments mapped from dump
+  sc_uint64 accessed_segments_count;   // amount of segments accessed after the last reset of their access counts
 };
 
 #endif
@@ -294,3 +308,4 @@ typedef struct _sc_iterator5 sc_iterator5;
 typedef struct _sc_event_subscription sc_event_subscription;
 typedef enum _sc_result sc_result;
 typedef struct _sc_stat sc_stat;
+typedef struct _sc_connector_triple sc_connector_triple;
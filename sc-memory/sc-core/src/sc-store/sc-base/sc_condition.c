@@ -18,6 +18,12 @@ void sc_cond_wait(sc_condition * condition, sc_mutex * mutex)
   g_cond_wait(&condition->instance, &mutex->instance);
 }
 
+sc_bool sc_cond_wait_for(sc_condition * condition, sc_mutex * mutex, sc_uint32 timeout_ms)
+{
+  sc_int64 const end_time = g_get_monotonic_time() + (sc_int64)timeout_ms * G_TIME_SPAN_MILLISECOND;
+  return g_cond_wait_until(&condition->instance, &mutex->instance, end_time);
+}
+
 void sc_cond_signal(sc_condition * condition)
 {
   g_cond_signal(&condition->instance);
@@ -11,7 +11,9 @@
 #include "sc-store/sc-base/sc_condition_private.h"
 #include "sc-store/sc-base/sc_thread.h"
 
-#define SC_MONITOR_FREE_PERIOD_CHECK 10
+#ifndef SC_ATOMIC_MONITOR
+
+#  define SC_MONITOR_FREE_PERIOD_CHECK 10
 
 struct _sc_request
 {
@@ -150,6 +152,30 @@ void sc_monitor_release_write(sc_monitor * monitor)
   sc_monitor_release(monitor);
 }
 
+sc_bool sc_monitor_try_acquire_write(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return SC_TRUE;
+
+  sc_monitor_acquire(monitor);
+
+  sc_mutex_lock(&monitor->rw_mutex);
+
+  sc_bool const is_acquired =
+      sc_queue_empty(&monitor->queue) && !monitor->active_writer && monitor->active_readers == 0;
+  if (is_acquired)
+    monitor->active_writer = 1;
+
+  sc_mutex_unlock(&monitor->rw_mutex);
+
+  if (!is_acquired)
+    sc_monitor_release(monitor);
+
+  return is_acquired;
+}
+
+#endif
+
 sc_int32 compare_monitors(void const * a, void const * b)
 {
   sc_monitor * monitor_a = *(sc_monitor **)a;
@@ -284,3 +310,44 @@ void sc_monitor_release_write_n(sc_uint32 n, ...)
 
   va_end(args);
 }
+
+sc_bool sc_monitor_try_acquire_write_n(sc_uint32 n, ...)
+{
+  va_list args;
+  va_start(args, n);
+  sc_monitor * monitors[n];
+  sc_uint32 unique_count = 0;
+
+  for (sc_uint32 i = 0; i < n; ++i)
+  {
+    sc_monitor * temp = va_arg(args, sc_monitor *);
+    if (temp == null_ptr)
+      continue;
+
+    sc_uint32 j;
+    for (j = 0; j < unique_count; ++j)
+    {
+      if (monitors[j]->id == temp->id)
+        break;
+    }
+    if (j == unique_count)
+      monitors[unique_count++] = temp;
+  }
+
+  va_end(args);
+
+  n = unique_count;
+  qsort(monitors, n, sizeof(sc_monitor *), compare_monitors);
+
+  for (sc_uint32 i = 0; i < n; ++i)
+  {
+    if (sc_monitor_try_acquire_write(monitors[i]))
+      continue;
+
+    for (sc_int32 j = (sc_int32)i - 1; j >= 0; --j)
+      sc_monitor_release_write(monitors[j]);
+    return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
@@ -0,0 +1,177 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifdef SC_ATOMIC_MONITOR
+
+#  include "sc-core/sc-base/sc_monitor.h"
+
+#  include "sc-store/sc-base/sc_monitor_private.h"
+
+#  define SC_MONITOR_FREE_PERIOD_CHECK 10
+#  define SC_MONITOR_SPIN_COUNT 64
+
+void sc_monitor_init(sc_monitor * monitor)
+{
+  monitor->state = 0;
+  monitor->waiting_writers = 0;
+  monitor->sleepers = 0;
+  sc_mutex_init(&monitor->mutex);
+  sc_cond_init(&monitor->condition);
+  monitor->id = 1;
+  monitor->ref_count = 0;
+}
+
+void sc_monitor_destroy(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return;
+
+  while (g_atomic_int_get(&monitor->ref_count) > 0)
+    g_usleep(SC_MONITOR_FREE_PERIOD_CHECK);
+
+  sc_cond_destroy(&monitor->condition);
+  sc_mutex_destroy(&monitor->mutex);
+  monitor->state = 0;
+  monitor->waiting_writers = 0;
+  monitor->sleepers = 0;
+  monitor->id = 0;
+}
+
+void sc_monitor_acquire(sc_monitor * monitor)
+{
+  g_atomic_int_inc(&monitor->ref_count);
+}
+
+void sc_monitor_release(sc_monitor * monitor)
+{
+  g_atomic_int_add(&monitor->ref_count, -1);
+}
+
+sc_bool _sc_monitor_can_read(sc_monitor * monitor)
+{
+  return g_atomic_int_get(&monitor->state) != SC_MONITOR_WRITER_STATE
+         && g_atomic_int_get(&monitor->waiting_writers) == 0;
+}
+
+sc_bool _sc_monitor_can_write(sc_monitor * monitor)
+{
+  return g_atomic_int_get(&monitor->state) == 0;
+}
+
+sc_bool _sc_monitor_try_read(sc_monitor * monitor)
+{
+  gint const state = g_atomic_int_get(&monitor->state);
+  return state != SC_MONITOR_WRITER_STATE && g_atomic_int_get(&monitor->waiting_writers) == 0
+         && g_atomic_int_compare_and_exchange(&monitor->state, state, state + 1);
+}
+
+sc_bool _sc_monitor_try_write(sc_monitor * monitor)
+{
+  return g_atomic_int_compare_and_exchange(&monitor->state, 0, SC_MONITOR_WRITER_STATE);
+}
+
+//! Sleeps until `can_enter` becomes true. Sleepers are counted before the check, so releasers can't miss them.
+void _sc_monitor_wait(sc_monitor * monitor, sc_bool (*can_enter)(sc_monitor *))
+{
+  sc_mutex_lock(&monitor->mutex);
+  g_atomic_int_inc(&monitor->sleepers);
+  while (!can_enter(monitor))
+    sc_cond_wait(&monitor->condition, &monitor->mutex);
+  g_atomic_int_add(&monitor->sleepers, -1);
+  sc_mutex_unlock(&monitor->mutex);
+}
+
+void _sc_monitor_wake_sleepers(sc_monitor * monitor)
+{
+  if (g_atomic_int_get(&monitor->sleepers) == 0)
+    return;
+
+  sc_mutex_lock(&monitor->mutex);
+  sc_cond_broadcast(&monitor->condition);
+  sc_mutex_unlock(&monitor->mutex);
+}
+
+void sc_monitor_acquire_read(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return;
+
+  sc_monitor_acquire(monitor);
+
+  sc_uint32 spins = 0;
+  while (!_sc_monitor_try_read(monitor))
+  {
+    if (++spins < SC_MONITOR_SPIN_COUNT)
+      continue;
+
+    _sc_monitor_wait(monitor, _sc_monitor_can_read);
+    spins = 0;
+  }
+}
+
+void sc_monitor_release_read(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return;
+
+  if (g_atomic_int_dec_and_test(&monitor->state))
+    _sc_monitor_wake_sleepers(monitor);
+
+  sc_monitor_release(monitor);
+}
+
+void sc_monitor_acquire_write(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return;
+
+  sc_monitor_acquire(monitor);
+
+  if (_sc_monitor_try_write(monitor))
+    return;
+
+  // waiting writers stop new readers, so a writer isn't starved by a stream of readers
+  g_atomic_int_inc(&monitor->waiting_writers);
+
+  sc_uint32 spins = 0;
+  while (!_sc_monitor_try_write(monitor))
+  {
+    if (++spins < SC_MONITOR_SPIN_COUNT)
+      continue;
+
+    _sc_monitor_wait(monitor, _sc_monitor_can_write);
+    spins = 0;
+  }
+
+  g_atomic_int_add(&monitor->waiting_writers, -1);
+}
+
+void sc_monitor_release_write(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return;
+
+  g_atomic_int_set(&monitor->state, 0);
+  _sc_monitor_wake_sleepers(monitor);
+
+  sc_monitor_release(monitor);
+}
+
+sc_bool sc_monitor_try_acquire_write(sc_monitor * monitor)
+{
+  if (monitor == null_ptr || monitor->id == 0)
+    return SC_TRUE;
+
+  sc_monitor_acquire(monitor);
+
+  if (_sc_monitor_try_write(monitor))
+    return SC_TRUE;
+
+  sc_monitor_release(monitor);
+  return SC_FALSE;
+}
+
+#endif
@@ -13,6 +13,26 @@
 
 #include "sc_mutex_private.h"
 
+#ifdef SC_ATOMIC_MONITOR
+
+#  include "sc_condition_private.h"
+
+//! Value of `state` while a writer holds the monitor
+#  define SC_MONITOR_WRITER_STATE -1
+
+struct _sc_monitor
+{
+  volatile gint state;            // Number of active readers or SC_MONITOR_WRITER_STATE if a writer is active
+  volatile gint waiting_writers;  // Number of writers waiting for the monitor, new readers don't enter while it is set
+  volatile gint sleepers;         // Number of threads that are waiting on condition
+  sc_mutex mutex;                 // Mutex for waiting on condition only, it is not locked in uncontended cases
+  sc_condition condition;         // Condition variable to wake up sleeping readers and writers
+  sc_uint32 id;                   // Unique identifier of monitor
+  volatile gint ref_count;
+};
+
+#else
+
 struct _sc_monitor
 {
   sc_mutex rw_mutex;         // Mutex for data protection
@@ -25,3 +45,5 @@ struct _sc_monitor
 };
 
 #endif
+
+#endif
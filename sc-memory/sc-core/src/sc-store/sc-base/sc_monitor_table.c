@@ -11,104 +11,86 @@
 #include "sc-store/sc-base/sc_monitor_private.h"
 #include "sc-store/sc-base/sc_monitor_table_private.h"
 
-#define SC_MONITOR_TABLE_CLEAN_SIZE_THRESHOLD 10000
-#define SC_MONITOR_TABLE_CLEAN_INTERVAL_CHECK 10
-
-void _sc_monitor_destroy(void * monitor)
+//! Mixes bits of sc-addr hash so that sc-elements with equal offsets in different segments get different stripes
+sc_uint32 _sc_monitor_table_addr_hash(sc_addr_hash hash)
 {
-  sc_monitor_destroy((sc_monitor *)monitor);
-  sc_mem_free(monitor);
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
 }
 
-void * _sc_monitor_table_clean_periodic(void * arg)
+void _sc_monitor_table_init(sc_monitor_table * table, sc_uint32 size)
 {
-  sc_monitor_table * table = arg;
+  sc_uint32 stripes = 1;
+  while (stripes < size)
+    stripes <<= 1;
 
-  sc_hash_table * previous_monitors = null_ptr;
+  table->monitors = sc_mem_new(sc_monitor, stripes);
+  table->size = stripes;
+  table->mask = stripes - 1;
 
-  while (table->is_working == SC_TRUE)
+  for (sc_uint32 i = 0; i < table->size; ++i)
   {
-    g_usleep(SC_MONITOR_TABLE_CLEAN_INTERVAL_CHECK);
-
-    sc_mutex_lock(&table->rw_mutex);
-    sc_uint64 const size = sc_hash_table_size(table->monitors);
-    sc_mutex_unlock(&table->rw_mutex);
-    if (size < SC_MONITOR_TABLE_CLEAN_SIZE_THRESHOLD)
-      continue;
-
-    if (previous_monitors != null_ptr)
-      sc_hash_table_destroy(previous_monitors);
-
-    sc_mutex_lock(&table->rw_mutex);
-    table->global_monitor_id_counter = 1;
-    previous_monitors = table->monitors;
-    table->monitors = sc_hash_table_init(
-        sc_hash_table_default_hash_func, sc_hash_table_default_equal_func, null_ptr, _sc_monitor_destroy);
-    sc_mutex_unlock(&table->rw_mutex);
+    sc_monitor_init(&table->monitors[i]);
+    // ids are used to order monitors in `sc_monitor_acquire_*_n`, they must be unique and non-zero
+    table->monitors[i].id = i + 1;
   }
-
-  if (previous_monitors != null_ptr)
-    sc_hash_table_destroy(previous_monitors);
-
-  pthread_exit(null_ptr);
 }
 
-sc_cleaner _sc_monitor_table_create_cleaner(sc_monitor_table * table)
+void _sc_monitor_table_destroy(sc_monitor_table * table)
 {
-  sc_cleaner cleaner;
-  pthread_create(&cleaner, null_ptr, _sc_monitor_table_clean_periodic, table);
-  return cleaner;
-}
+  if (table->monitors == null_ptr)
+    return;
 
-void _sc_monitor_table_delete_cleaner(sc_cleaner cleaner)
-{
-  pthread_join(cleaner, null_ptr);
-}
+  for (sc_uint32 i = 0; i < table->size; ++i)
+    sc_monitor_destroy(&table->monitors[i]);
 
-void _sc_monitor_table_init(sc_monitor_table * table)
-{
-  table->monitors = sc_hash_table_init(
-      sc_hash_table_default_hash_func, sc_hash_table_default_equal_func, null_ptr, _sc_monitor_destroy);
-  sc_mutex_init(&table->rw_mutex);
-  table->global_monitor_id_counter = 1;
-  table->is_working = SC_TRUE;
-  table->cleaner = _sc_monitor_table_create_cleaner(table);
+  sc_mem_free(table->monitors);
+  table->monitors = null_ptr;
+  table->size = 0;
+  table->mask = 0;
 }
 
-void _sc_monitor_table_destroy(sc_monitor_table * table)
+void _sc_monitor_table_acquire_all_write(sc_monitor_table * table)
 {
-  if (table->is_working == SC_TRUE)
+  sc_uint32 acquired_count = 0;
+  while (acquired_count < table->size)
   {
-    table->is_working = SC_FALSE;
-    _sc_monitor_table_delete_cleaner(table->cleaner);
+    sc_monitor * monitor = &table->monitors[acquired_count];
+    if (sc_monitor_try_acquire_write(monitor))
+    {
+      ++acquired_count;
+      continue;
+    }
+
+    // the held monitor is waited for without other ones, so its holder isn't blocked by them
+    while (acquired_count > 0)
+      sc_monitor_release_write(&table->monitors[--acquired_count]);
+    sc_monitor_acquire_write(monitor);
+    sc_monitor_release_write(monitor);
   }
+}
 
-  sc_hash_table_destroy(table->monitors);
-  sc_mutex_destroy(&table->rw_mutex);
-  table->global_monitor_id_counter = 1;
+void _sc_monitor_table_release_all_write(sc_monitor_table * table)
+{
+  for (sc_uint32 i = table->size; i > 0; --i)
+    sc_monitor_release_write(&table->monitors[i - 1]);
 }
 
 sc_monitor * sc_monitor_table_get_monitor_for_addr(sc_monitor_table * table, sc_addr addr)
 {
-  sc_pointer key = (sc_addr_hash_to_sc_pointer)SC_ADDR_LOCAL_TO_INT(addr);
-  return key == null_ptr ? null_ptr : sc_monitor_table_get_monitor_from_table(table, key);
+  sc_addr_hash const hash = SC_ADDR_LOCAL_TO_INT(addr);
+  if (hash == 0)
+    return null_ptr;
+
+  return sc_monitor_table_get_monitor_from_table(
+      table, (sc_addr_hash_to_sc_pointer)_sc_monitor_table_addr_hash(hash));
 }
 
 sc_monitor * sc_monitor_table_get_monitor_from_table(sc_monitor_table * table, sc_pointer key)
 {
-  sc_mutex_lock(&table->rw_mutex);
-
-  sc_monitor * monitor = (sc_monitor *)sc_hash_table_get(table->monitors, key);
-
-  if (monitor == null_ptr)
-  {
-    monitor = sc_mem_new(sc_monitor, 1);
-    sc_monitor_init(monitor);
-    monitor->id = table->global_monitor_id_counter++;
-    sc_hash_table_insert(table->monitors, key, monitor);
-  }
-
-  sc_mutex_unlock(&table->rw_mutex);
-
-  return monitor;
+  return &table->monitors[(sc_uint64)key & table->mask];
 }
@@ -7,39 +7,56 @@
 #ifndef _sc_monitor_table_h_
 #define _sc_monitor_table_h_
 
-#include "sc-core/sc-base/sc_mutex.h"
-#include "sc-core/sc-base/sc_condition.h"
-
-#include "sc-core/sc-container/sc_queue.h"
 #include "sc-core/sc-base/sc_monitor.h"
 
 #include "sc-core/sc_types.h"
 
-#include "sc-store/sc-container/sc_hash_table.h"
-#include "sc-store/sc-base/sc_thread.h"
+//! Default number of stripes in monitor table used to lock sc-elements by their sc-addrs
+#define SC_MONITOR_TABLE_DEFAULT_SIZE (1 << 16)
 
 typedef struct _sc_monitor_table sc_monitor_table;
 
-/*! Initializes the global monitor table
+/*! Initializes the monitor table as a fixed-size striped array of monitors
  * @param table Pointer to the sc_monitor_table to be initialized
- * @remarks This function prepares the monitor table for use (for internal usage)
+ * @param size Minimum number of stripes, it is rounded up to the nearest power of two
+ * @remarks This function prepares the monitor table for use (for internal usage). All monitors are allocated here,
+ * so lookups take no locks and do no heap allocations.
  */
-_SC_EXTERN void _sc_monitor_table_init(sc_monitor_table * table);
+_SC_EXTERN void _sc_monitor_table_init(sc_monitor_table * table, sc_uint32 size);
 
-/*! Destroys the global monitor table
+/*! Destroys the monitor table
  * @param table Pointer to the sc_monitor_table to be destroyed
  * @remarks This function cleans up the monitor table and its resources (for internal usage)
  */
 _SC_EXTERN void _sc_monitor_table_destroy(sc_monitor_table * table);
 
-/*! Fetches or creates a monitor for a specific address
+/*! Acquires all monitors of the table for writing, so no other thread holds any of them until they are released
+ * @param table Pointer to the sc_monitor_table
+ * @remarks Monitors are tried in order of their ids and all acquired ones are released, if some monitor is held, since
+ * other threads can wait for monitors with lesser ids while holding ones with greater ids (for internal usage).
+ */
+_SC_EXTERN void _sc_monitor_table_acquire_all_write(sc_monitor_table * table);
+
+/*! Releases all monitors of the table acquired by `_sc_monitor_table_acquire_all_write`
  * @param table Pointer to the sc_monitor_table
- * @param addr Address for which a monitor should be fetched or created
- * @return Returns pointer to the associated sc_monitor
- * @remarks If a monitor for the address does not exist, one is created
+ */
+_SC_EXTERN void _sc_monitor_table_release_all_write(sc_monitor_table * table);
+
+/*! Fetches a monitor for a specific address
+ * @param table Pointer to the sc_monitor_table
+ * @param addr Address for which a monitor should be fetched
+ * @return Returns pointer to the associated sc_monitor or null_ptr if addr is empty
+ * @remarks Different addresses can share the same monitor (stripe). Callers that lock several addresses at once must
+ * compare monitors, not addresses, to avoid acquiring the same stripe twice.
  */
 _SC_EXTERN sc_monitor * sc_monitor_table_get_monitor_for_addr(sc_monitor_table * table, sc_addr addr);
 
+/*! Fetches a monitor for a specific key
+ * @param table Pointer to the sc_monitor_table
+ * @param key Key for which a monitor should be fetched
+ * @return Returns pointer to the associated sc_monitor
+ * @remarks Keys less than table size are mapped to different monitors.
+ */
 _SC_EXTERN sc_monitor * sc_monitor_table_get_monitor_from_table(sc_monitor_table * table, sc_pointer key);
 
 #endif
@@ -9,19 +9,13 @@
 
 #include "sc_monitor_table.h"
 
-#include "sc-store/sc-container/sc_hash_table.h"
-
-#include "sc_mutex_private.h"
-
-typedef pthread_t sc_cleaner;
+#include "sc_monitor_private.h"
 
 struct _sc_monitor_table
 {
-  sc_bool is_working;
-  sc_hash_table * monitors;             // Hash table storing addr_monitors_table for each identifier;
-  sc_uint32 global_monitor_id_counter;  // Monitors count
-  sc_mutex rw_mutex;                    // Mutex for data protection
-  sc_cleaner cleaner;
+  sc_monitor * monitors;  // Fixed-size array of monitors (stripes), allocated once on initialization
+  sc_uint32 size;         // Number of stripes, it is always a power of two
+  sc_uint32 mask;         // Mask to get stripe index from key
 };
 
 #endif
@@ -13,4 +13,10 @@ typedef GThread sc_thread;
 
 #define sc_thread_self g_thread_self
 
+typedef GPrivate sc_thread_local;
+
+#define SC_THREAD_LOCAL_INIT(destroy_func) G_PRIVATE_INIT(destroy_func)
+#define sc_thread_local_get g_private_get
+#define sc_thread_local_set g_private_set
+
 #endif
@@ -17,6 +17,9 @@
 #define SC_DICTIONARY_NODE_IS_VALID(__node) ((__node) != null_ptr)
 #define SC_DICTIONARY_NODE_IS_NOT_VALID(__node) ((__node) == null_ptr)
 
+//! Checks, if sc-dictionary stores strings in hash table or adaptive radix tree instead of tree
+#define SC_DICTIONARY_HAS_INDEX(__dictionary) ((__dictionary)->table != null_ptr || (__dictionary)->art != null_ptr)
+
 sc_bool sc_dictionary_initialize(
     sc_dictionary ** dictionary,
     sc_uint8 children_size,
@@ -26,6 +29,34 @@ sc_bool sc_dictionary_initialize(
   (*dictionary)->size = children_size;
   (*dictionary)->root = _sc_dictionary_node_initialize(children_size);
   (*dictionary)->char_to_int = char_to_int;
+  (*dictionary)->table = null_ptr;
+  (*dictionary)->art = null_ptr;
+  sc_monitor_init(&(*dictionary)->monitor);
+
+  return SC_TRUE;
+}
+
+sc_bool sc_dictionary_initialize_hashed(sc_dictionary ** dictionary)
+{
+  *dictionary = sc_mem_new(sc_dictionary, 1);
+  (*dictionary)->size = 0;
+  (*dictionary)->root = null_ptr;
+  (*dictionary)->char_to_int = null_ptr;
+  (*dictionary)->table = _sc_dictionary_hash_table_initialize();
+  (*dictionary)->art = null_ptr;
+  sc_monitor_init(&(*dictionary)->monitor);
+
+  return SC_TRUE;
+}
+
+sc_bool sc_dictionary_initialize_art(sc_dictionary ** dictionary)
+{
+  *dictionary = sc_mem_new(sc_dictionary, 1);
+  (*dictionary)->size = 0;
+  (*dictionary)->root = null_ptr;
+  (*dictionary)->char_to_int = null_ptr;
+  (*dictionary)->table = null_ptr;
+  (*dictionary)->art = _sc_dictionary_art_initialize();
   sc_monitor_init(&(*dictionary)->monitor);
 
   return SC_TRUE;
@@ -96,11 +127,18 @@ sc_bool sc_dictionary_destroy(sc_dictionary * dictionary, void (*node_clear)(sc_
   if (dictionary == null_ptr)
     return SC_FALSE;
 
-  _sc_dictionary_up_destroy_node(dictionary, dictionary->root, node_clear);
+  if (dictionary->table != null_ptr)
+    _sc_dictionary_hash_table_destroy(dictionary->table, node_clear);
+  else if (dictionary->art != null_ptr)
+    _sc_dictionary_art_destroy(dictionary->art, node_clear);
+  else
+  {
+    _sc_dictionary_up_destroy_node(dictionary, dictionary->root, node_clear);
 
-  if (node_clear != null_ptr)
-    node_clear(dictionary->root);
-  _sc_dictionary_node_destroy(dictionary->root);
+    if (node_clear != null_ptr)
+      node_clear(dictionary->root);
+    _sc_dictionary_node_destroy(dictionary->root);
+  }
 
   sc_monitor_destroy(&dictionary->monitor);
 
@@ -218,6 +256,19 @@ sc_dictionary_node * sc_dictionary_append(
     void * value)
 {
   sc_monitor_acquire_write(&dictionary->monitor);
+  if (dictionary->table != null_ptr)
+  {
+    _sc_dictionary_hash_table_append(dictionary->table, string, size, value);
+    sc_monitor_release_write(&dictionary->monitor);
+    return null_ptr;
+  }
+  if (dictionary->art != null_ptr)
+  {
+    _sc_dictionary_art_append(dictionary->art, string, size, value);
+    sc_monitor_release_write(&dictionary->monitor);
+    return null_ptr;
+  }
+
   sc_dictionary_node * node = sc_dictionary_append_to_node(dictionary, string, size);
   sc_monitor_release_write(&dictionary->monitor);
 
@@ -259,8 +310,42 @@ sc_dictionary_node const * sc_dictionary_get_last_node_from_node(
   return result_node;
 }
 
+//! Gets data by string from hash table or adaptive radix tree of sc-dictionary
+sc_bool _sc_dictionary_get_from_index(
+    sc_dictionary * dictionary,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data)
+{
+  sc_monitor_acquire_read(&dictionary->monitor);
+  sc_bool const is_found = dictionary->table != null_ptr
+                               ? _sc_dictionary_hash_table_get(dictionary->table, string, string_size, data)
+                               : _sc_dictionary_art_get(dictionary->art, string, string_size, data);
+  sc_monitor_release_read(&dictionary->monitor);
+  return is_found;
+}
+
+//! Visits strings with prefix in hash table or adaptive radix tree of sc-dictionary
+sc_bool _sc_dictionary_visit_index_by_prefix(
+    sc_dictionary * dictionary,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  return dictionary->table != null_ptr
+             ? _sc_dictionary_hash_table_visit_by_prefix(dictionary->table, string, string_size, callable, dest)
+             : _sc_dictionary_art_visit_by_prefix(dictionary->art, string, string_size, callable, dest);
+}
+
 sc_bool sc_dictionary_has(sc_dictionary * dictionary, sc_char const * string, sc_uint32 string_size)
 {
+  if (SC_DICTIONARY_HAS_INDEX(dictionary))
+  {
+    void * data;
+    return _sc_dictionary_get_from_index(dictionary, string, string_size, &data);
+  }
+
   sc_dictionary_node const * last =
       sc_dictionary_get_last_node_from_node(dictionary, dictionary->root, string, string_size);
 
@@ -269,6 +354,13 @@ sc_bool sc_dictionary_has(sc_dictionary * dictionary, sc_char const * string, sc
 
 void * _sc_dictionary_get_by_key(sc_dictionary * dictionary, sc_char const * string, sc_uint32 const string_size)
 {
+  if (SC_DICTIONARY_HAS_INDEX(dictionary))
+  {
+    void * data = null_ptr;
+    _sc_dictionary_get_from_index(dictionary, string, string_size, &data);
+    return data;
+  }
+
   sc_dictionary_node const * last =
       sc_dictionary_get_last_node_from_node(dictionary, dictionary->root, string, string_size);
 
@@ -341,7 +433,9 @@ sc_bool sc_dictionary_get_by_key_prefix(
     void ** dest)
 {
   sc_monitor_acquire_read(&dictionary->monitor);
-  sc_bool const status = _sc_dictionary_get_by_key_prefix(dictionary, string, string_size, callable, dest);
+  sc_bool const status = SC_DICTIONARY_HAS_INDEX(dictionary)
+                             ? _sc_dictionary_visit_index_by_prefix(dictionary, string, string_size, callable, dest)
+                             : _sc_dictionary_get_by_key_prefix(dictionary, string, string_size, callable, dest);
   sc_monitor_release_read(&dictionary->monitor);
   return status;
 }
@@ -380,7 +474,9 @@ sc_bool sc_dictionary_visit_down_nodes(
     void ** dest)
 {
   sc_monitor_acquire_read(&dictionary->monitor);
-  sc_bool status = sc_dictionary_visit_down_node_from_node(dictionary, dictionary->root, callable, dest);
+  sc_bool status = SC_DICTIONARY_HAS_INDEX(dictionary)
+                       ? _sc_dictionary_visit_index_by_prefix(dictionary, "", 0, callable, dest)
+                       : sc_dictionary_visit_down_node_from_node(dictionary, dictionary->root, callable, dest);
   sc_monitor_release_read(&dictionary->monitor);
   return status;
 }
@@ -419,7 +515,52 @@ sc_bool sc_dictionary_visit_up_nodes(
     void ** dest)
 {
   sc_monitor_acquire_read(&dictionary->monitor);
-  sc_bool status = sc_dictionary_visit_up_node_from_node(dictionary, dictionary->root, callable, dest);
+  sc_bool status = SC_DICTIONARY_HAS_INDEX(dictionary)
+                       ? _sc_dictionary_visit_index_by_prefix(dictionary, "", 0, callable, dest)
+                       : sc_dictionary_visit_up_node_from_node(dictionary, dictionary->root, callable, dest);
   sc_monitor_release_read(&dictionary->monitor);
   return status;
 }
+
+typedef struct
+{
+  sc_uint64 strings_count;
+  sc_uint64 memory_size;
+  sc_uint64 buckets_count;
+} sc_dictionary_memory_size;
+
+sc_bool _sc_dictionary_node_count_memory(sc_dictionary_node * node, void ** dest)
+{
+  sc_dictionary_memory_size * size = (sc_dictionary_memory_size *)dest;
+  if (node->data != null_ptr)
+    ++size->strings_count;
+
+  size->memory_size += sizeof(sc_dictionary_node) + node->offset_size;
+  size->memory_size += size->buckets_count * sizeof(sc_dictionary_node **);
+  for (sc_uint64 bucket_idx = 0; bucket_idx < size->buckets_count; ++bucket_idx)
+  {
+    if (node->next[bucket_idx] != null_ptr)
+      size->memory_size += SC_DICTIONARY_NODE_BUCKET_SIZE * sizeof(sc_dictionary_node *);
+  }
+
+  return SC_TRUE;
+}
+
+void sc_dictionary_get_memory_size(sc_dictionary * dictionary, sc_uint64 * strings_count, sc_uint64 * memory_size)
+{
+  sc_monitor_acquire_read(&dictionary->monitor);
+  if (dictionary->table != null_ptr)
+    _sc_dictionary_hash_table_get_memory_size(dictionary->table, strings_count, memory_size);
+  else if (dictionary->art != null_ptr)
+    _sc_dictionary_art_get_memory_size(dictionary->art, strings_count, memory_size);
+  else
+  {
+    sc_dictionary_memory_size size = {0, sizeof(sc_dictionary), SC_DICTIONARY_GET_BUCKET_NUM(dictionary->size) + 1};
+    _sc_dictionary_node_count_memory(dictionary->root, (void **)&size);
+    sc_dictionary_visit_down_node_from_node(
+        dictionary, dictionary->root, _sc_dictionary_node_count_memory, (void **)&size);
+    *strings_count = size.strings_count;
+    *memory_size = size.memory_size;
+  }
+  sc_monitor_release_read(&dictionary->monitor);
+}
@@ -0,0 +1,871 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_dictionary_private.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+//! Count of bytes of prefix stored in node, longer prefixes are checked by leaves
+#define SC_DICTIONARY_ART_MAX_PREFIX_SIZE 8
+
+#define SC_DICTIONARY_ART_IS_LEAF(__node) (((uintptr_t)(__node)) & 1)
+#define SC_DICTIONARY_ART_TO_LEAF(__leaf) ((sc_dictionary_art_node *)((uintptr_t)(__leaf) | 1))
+#define SC_DICTIONARY_ART_GET_LEAF(__node) ((sc_dictionary_art_leaf *)((uintptr_t)(__node) & ~(uintptr_t)1))
+
+typedef enum
+{
+  SC_DICTIONARY_ART_NODE_4 = 1,
+  SC_DICTIONARY_ART_NODE_16,
+  SC_DICTIONARY_ART_NODE_48,
+  SC_DICTIONARY_ART_NODE_256,
+} sc_dictionary_art_node_type;
+
+//! Header of inner node of adaptive radix tree, pointers to leaves are tagged by the lowest bit
+typedef struct
+{
+  sc_uint8 type;
+  sc_uint16 children_count;
+  sc_uint32 prefix_size;  // size of common prefix of strings of node after byte of its parent
+  sc_uchar prefix[SC_DICTIONARY_ART_MAX_PREFIX_SIZE];
+} sc_dictionary_art_node;
+
+typedef struct
+{
+  sc_dictionary_art_node node;
+  sc_uchar keys[4];  // sorted bytes of children
+  sc_dictionary_art_node * children[4];
+} sc_dictionary_art_node4;
+
+typedef struct
+{
+  sc_dictionary_art_node node;
+  sc_uchar keys[16];  // sorted bytes of children
+  sc_dictionary_art_node * children[16];
+} sc_dictionary_art_node16;
+
+typedef struct
+{
+  sc_dictionary_art_node node;
+  sc_uchar child_indices[256];  // indices of children incremented by one, zero if byte has no child
+  sc_dictionary_art_node * children[48];
+} sc_dictionary_art_node48;
+
+typedef struct
+{
+  sc_dictionary_art_node node;
+  sc_dictionary_art_node * children[256];
+} sc_dictionary_art_node256;
+
+//! Leaf of adaptive radix tree, it stores the whole null-terminated string, strings with zero bytes are escaped
+typedef struct
+{
+  void * data;
+  sc_uint32 string_size;
+  sc_char string[];
+} sc_dictionary_art_leaf;
+
+struct _sc_dictionary_art
+{
+  sc_dictionary_art_node * root;
+};
+
+//! Byte that starts escaped zero byte or escaped itself in strings of tree
+#define SC_DICTIONARY_ART_ESCAPE_BYTE 1
+
+//! Strings end with zero byte in tree, so strings that are prefixes of other strings are stored in leaves too
+sc_uchar _sc_dictionary_art_get_byte(sc_char const * string, sc_uint32 string_size, sc_uint32 depth)
+{
+  return depth < string_size ? (sc_uchar)string[depth] : 0;
+}
+
+sc_dictionary_art_leaf * _sc_dictionary_art_leaf_new(sc_char const * string, sc_uint32 string_size, void * data)
+{
+  sc_dictionary_art_leaf * leaf = _sc_mem_new(sizeof(sc_dictionary_art_leaf) + string_size + 1);
+  leaf->data = data;
+  leaf->string_size = string_size;
+  memcpy(leaf->string, string, string_size);
+  leaf->string[string_size] = '\0';
+  return leaf;
+}
+
+/*! Escapes string with zero bytes, so they don't end it in tree: zero byte and escape byte are replaced by escape byte
+ * followed by 1 and 2 respectively. Escaped strings keep order of strings and their prefixes.
+ * @returns SC_FALSE, if string has no bytes to escape and it is stored as is, otherwise SC_TRUE.
+ */
+sc_bool _sc_dictionary_art_escape_string(
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_char ** escaped_string,
+    sc_uint32 * escaped_string_size)
+{
+  sc_uint32 escaped_bytes_count = 0;
+  for (sc_uint32 i = 0; i < string_size; ++i)
+  {
+    if ((sc_uchar)string[i] <= SC_DICTIONARY_ART_ESCAPE_BYTE)
+      ++escaped_bytes_count;
+  }
+  if (escaped_bytes_count == 0)
+    return SC_FALSE;
+
+  *escaped_string_size = string_size + escaped_bytes_count;
+  *escaped_string = sc_mem_new(sc_char, *escaped_string_size);
+  sc_uint32 size = 0;
+  for (sc_uint32 i = 0; i < string_size; ++i)
+  {
+    sc_uchar const byte = (sc_uchar)string[i];
+    if (byte <= SC_DICTIONARY_ART_ESCAPE_BYTE)
+    {
+      (*escaped_string)[size++] = SC_DICTIONARY_ART_ESCAPE_BYTE;
+      (*escaped_string)[size++] = (sc_char)(byte + 1);
+    }
+    else
+      (*escaped_string)[size++] = string[i];
+  }
+
+  return SC_TRUE;
+}
+
+//! Restores escaped string of leaf to null-terminated string, returns SC_FALSE if string of leaf isn't escaped
+sc_bool _sc_dictionary_art_unescape_string(
+    sc_char const * escaped_string,
+    sc_uint32 escaped_string_size,
+    sc_char ** string,
+    sc_uint32 * string_size)
+{
+  if (memchr(escaped_string, SC_DICTIONARY_ART_ESCAPE_BYTE, escaped_string_size) == null_ptr)
+    return SC_FALSE;
+
+  *string = sc_mem_new(sc_char, escaped_string_size + 1);
+  sc_uint32 size = 0;
+  for (sc_uint32 i = 0; i < escaped_string_size; ++i)
+  {
+    if ((sc_uchar)escaped_string[i] == SC_DICTIONARY_ART_ESCAPE_BYTE)
+      (*string)[size++] = (sc_char)(escaped_string[++i] - 1);
+    else
+      (*string)[size++] = escaped_string[i];
+  }
+  *string_size = size;
+
+  return SC_TRUE;
+}
+
+sc_bool _sc_dictionary_art_leaf_is_equal(
+    sc_dictionary_art_leaf const * leaf,
+    sc_char const * string,
+    sc_uint32 string_size)
+{
+  return leaf->string_size == string_size && memcmp(leaf->string, string, string_size) == 0;
+}
+
+sc_dictionary_art_node * _sc_dictionary_art_node_new(sc_dictionary_art_node_type type)
+{
+  sc_dictionary_art_node * node;
+  switch (type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+    node = (sc_dictionary_art_node *)sc_mem_new(sc_dictionary_art_node4, 1);
+    break;
+  case SC_DICTIONARY_ART_NODE_16:
+    node = (sc_dictionary_art_node *)sc_mem_new(sc_dictionary_art_node16, 1);
+    break;
+  case SC_DICTIONARY_ART_NODE_48:
+    node = (sc_dictionary_art_node *)sc_mem_new(sc_dictionary_art_node48, 1);
+    break;
+  default:
+    node = (sc_dictionary_art_node *)sc_mem_new(sc_dictionary_art_node256, 1);
+    break;
+  }
+  node->type = type;
+  return node;
+}
+
+void _sc_dictionary_art_node_copy_header(sc_dictionary_art_node * dest, sc_dictionary_art_node const * src)
+{
+  dest->children_count = src->children_count;
+  dest->prefix_size = src->prefix_size;
+  memcpy(dest->prefix, src->prefix, sc_min(src->prefix_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE));
+}
+
+sc_dictionary_art_node ** _sc_dictionary_art_find_child(sc_dictionary_art_node * node, sc_uchar byte)
+{
+  switch (node->type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+  {
+    sc_dictionary_art_node4 * node4 = (sc_dictionary_art_node4 *)node;
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+    {
+      if (node4->keys[i] == byte)
+        return &node4->children[i];
+    }
+    return null_ptr;
+  }
+  case SC_DICTIONARY_ART_NODE_16:
+  {
+    sc_dictionary_art_node16 * node16 = (sc_dictionary_art_node16 *)node;
+#if defined(__SSE2__)
+    // all keys are compared with byte by one instruction
+    __m128i const matches =
+        _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((__m128i const *)node16->keys));
+    sc_uint32 const mask = _mm_movemask_epi8(matches) & ((1u << node->children_count) - 1);
+    return mask == 0 ? null_ptr : &node16->children[__builtin_ctz(mask)];
+#else
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+    {
+      if (node16->keys[i] == byte)
+        return &node16->children[i];
+    }
+    return null_ptr;
+#endif
+  }
+  case SC_DICTIONARY_ART_NODE_48:
+  {
+    sc_dictionary_art_node48 * node48 = (sc_dictionary_art_node48 *)node;
+    sc_uchar const idx = node48->child_indices[byte];
+    return idx == 0 ? null_ptr : &node48->children[idx - 1];
+  }
+  default:
+  {
+    sc_dictionary_art_node256 * node256 = (sc_dictionary_art_node256 *)node;
+    return node256->children[byte] == null_ptr ? null_ptr : &node256->children[byte];
+  }
+  }
+}
+
+sc_dictionary_art_leaf * _sc_dictionary_art_get_minimum_leaf(sc_dictionary_art_node const * node)
+{
+  while (!SC_DICTIONARY_ART_IS_LEAF(node))
+  {
+    switch (node->type)
+    {
+    case SC_DICTIONARY_ART_NODE_4:
+      node = ((sc_dictionary_art_node4 const *)node)->children[0];
+      break;
+    case SC_DICTIONARY_ART_NODE_16:
+      node = ((sc_dictionary_art_node16 const *)node)->children[0];
+      break;
+    case SC_DICTIONARY_ART_NODE_48:
+    {
+      sc_dictionary_art_node48 const * node48 = (sc_dictionary_art_node48 const *)node;
+      sc_uint16 byte = 0;
+      while (node48->child_indices[byte] == 0)
+        ++byte;
+      node = node48->children[node48->child_indices[byte] - 1];
+      break;
+    }
+    default:
+    {
+      sc_dictionary_art_node256 const * node256 = (sc_dictionary_art_node256 const *)node;
+      sc_uint16 byte = 0;
+      while (node256->children[byte] == null_ptr)
+        ++byte;
+      node = node256->children[byte];
+      break;
+    }
+    }
+  }
+
+  return SC_DICTIONARY_ART_GET_LEAF(node);
+}
+
+void _sc_dictionary_art_add_child256(
+    sc_dictionary_art_node256 * node,
+    sc_uchar byte,
+    sc_dictionary_art_node * child)
+{
+  ++node->node.children_count;
+  node->children[byte] = child;
+}
+
+void _sc_dictionary_art_add_child48(
+    sc_dictionary_art_node48 * node,
+    sc_dictionary_art_node ** node_ref,
+    sc_uchar byte,
+    sc_dictionary_art_node * child)
+{
+  if (node->node.children_count < 48)
+  {
+    sc_uint16 idx = 0;
+    while (node->children[idx] != null_ptr)
+      ++idx;
+    node->children[idx] = child;
+    node->child_indices[byte] = idx + 1;
+    ++node->node.children_count;
+    return;
+  }
+
+  sc_dictionary_art_node256 * new_node =
+      (sc_dictionary_art_node256 *)_sc_dictionary_art_node_new(SC_DICTIONARY_ART_NODE_256);
+  for (sc_uint16 i = 0; i < 256; ++i)
+  {
+    if (node->child_indices[i] != 0)
+      new_node->children[i] = node->children[node->child_indices[i] - 1];
+  }
+  _sc_dictionary_art_node_copy_header(&new_node->node, &node->node);
+  *node_ref = &new_node->node;
+  sc_mem_free(node);
+  _sc_dictionary_art_add_child256(new_node, byte, child);
+}
+
+void _sc_dictionary_art_add_child16(
+    sc_dictionary_art_node16 * node,
+    sc_dictionary_art_node ** node_ref,
+    sc_uchar byte,
+    sc_dictionary_art_node * child)
+{
+  if (node->node.children_count < 16)
+  {
+    sc_uint16 idx = 0;
+    while (idx < node->node.children_count && node->keys[idx] < byte)
+      ++idx;
+    memmove(node->keys + idx + 1, node->keys + idx, node->node.children_count - idx);
+    memmove(
+        node->children + idx + 1,
+        node->children + idx,
+        (node->node.children_count - idx) * sizeof(sc_dictionary_art_node *));
+    node->keys[idx] = byte;
+    node->children[idx] = child;
+    ++node->node.children_count;
+    return;
+  }
+
+  sc_dictionary_art_node48 * new_node =
+      (sc_dictionary_art_node48 *)_sc_dictionary_art_node_new(SC_DICTIONARY_ART_NODE_48);
+  memcpy(new_node->children, node->children, sizeof(node->children));
+  for (sc_uint16 i = 0; i < node->node.children_count; ++i)
+    new_node->child_indices[node->keys[i]] = i + 1;
+  _sc_dictionary_art_node_copy_header(&new_node->node, &node->node);
+  *node_ref = &new_node->node;
+  sc_mem_free(node);
+  _sc_dictionary_art_add_child48(new_node, node_ref, byte, child);
+}
+
+void _sc_dictionary_art_add_child4(
+    sc_dictionary_art_node4 * node,
+    sc_dictionary_art_node ** node_ref,
+    sc_uchar byte,
+    sc_dictionary_art_node * child)
+{
+  if (node->node.children_count < 4)
+  {
+    sc_uint16 idx = 0;
+    while (idx < node->node.children_count && node->keys[idx] < byte)
+      ++idx;
+    memmove(node->keys + idx + 1, node->keys + idx, node->node.children_count - idx);
+    memmove(
+        node->children + idx + 1,
+        node->children + idx,
+        (node->node.children_count - idx) * sizeof(sc_dictionary_art_node *));
+    node->keys[idx] = byte;
+    node->children[idx] = child;
+    ++node->node.children_count;
+    return;
+  }
+
+  sc_dictionary_art_node16 * new_node =
+      (sc_dictionary_art_node16 *)_sc_dictionary_art_node_new(SC_DICTIONARY_ART_NODE_16);
+  memcpy(new_node->keys, node->keys, sizeof(node->keys));
+  memcpy(new_node->children, node->children, sizeof(node->children));
+  _sc_dictionary_art_node_copy_header(&new_node->node, &node->node);
+  *node_ref = &new_node->node;
+  sc_mem_free(node);
+  _sc_dictionary_art_add_child16(new_node, node_ref, byte, child);
+}
+
+void _sc_dictionary_art_add_child(
+    sc_dictionary_art_node * node,
+    sc_dictionary_art_node ** node_ref,
+    sc_uchar byte,
+    sc_dictionary_art_node * child)
+{
+  switch (node->type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+    _sc_dictionary_art_add_child4((sc_dictionary_art_node4 *)node, node_ref, byte, child);
+    break;
+  case SC_DICTIONARY_ART_NODE_16:
+    _sc_dictionary_art_add_child16((sc_dictionary_art_node16 *)node, node_ref, byte, child);
+    break;
+  case SC_DICTIONARY_ART_NODE_48:
+    _sc_dictionary_art_add_child48((sc_dictionary_art_node48 *)node, node_ref, byte, child);
+    break;
+  default:
+    _sc_dictionary_art_add_child256((sc_dictionary_art_node256 *)node, byte, child);
+    break;
+  }
+}
+
+/*! Gets count of bytes of prefix of node that are equal to bytes of string from depth, but not more than `max_size`.
+ * Bytes of prefix that aren't stored in node are taken from its minimum leaf.
+ */
+sc_uint32 _sc_dictionary_art_get_prefix_mismatch(
+    sc_dictionary_art_node const * node,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_uint32 depth,
+    sc_uint32 max_size)
+{
+  sc_uint32 const stored_size = sc_min(max_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE);
+
+  sc_uint32 idx = 0;
+  for (; idx < stored_size; ++idx)
+  {
+    if (node->prefix[idx] != _sc_dictionary_art_get_byte(string, string_size, depth + idx))
+      return idx;
+  }
+
+  if (max_size > SC_DICTIONARY_ART_MAX_PREFIX_SIZE)
+  {
+    sc_dictionary_art_leaf const * leaf = _sc_dictionary_art_get_minimum_leaf(node);
+    for (; idx < max_size; ++idx)
+    {
+      if (_sc_dictionary_art_get_byte(leaf->string, leaf->string_size, depth + idx)
+          != _sc_dictionary_art_get_byte(string, string_size, depth + idx))
+        return idx;
+    }
+  }
+
+  return idx;
+}
+
+void _sc_dictionary_art_insert(
+    sc_dictionary_art_node ** node_ref,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_uint32 depth,
+    void * data)
+{
+  sc_dictionary_art_node * node = *node_ref;
+  if (node == null_ptr)
+  {
+    *node_ref = SC_DICTIONARY_ART_TO_LEAF(_sc_dictionary_art_leaf_new(string, string_size, data));
+    return;
+  }
+
+  // split leaf by node with common prefix of its string and appended string
+  if (SC_DICTIONARY_ART_IS_LEAF(node))
+  {
+    sc_dictionary_art_leaf * leaf = SC_DICTIONARY_ART_GET_LEAF(node);
+    if (_sc_dictionary_art_leaf_is_equal(leaf, string, string_size))
+    {
+      leaf->data = data;
+      return;
+    }
+
+    sc_uint32 const max_prefix_size = sc_max(leaf->string_size, string_size);
+    sc_uint32 prefix_size = 0;
+    while (prefix_size < max_prefix_size
+           && _sc_dictionary_art_get_byte(leaf->string, leaf->string_size, depth + prefix_size)
+           == _sc_dictionary_art_get_byte(string, string_size, depth + prefix_size))
+      ++prefix_size;
+
+    sc_dictionary_art_node * new_node = _sc_dictionary_art_node_new(SC_DICTIONARY_ART_NODE_4);
+    new_node->prefix_size = prefix_size;
+    memcpy(new_node->prefix, string + depth, sc_min(prefix_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE));
+    *node_ref = new_node;
+
+    depth += prefix_size;
+    _sc_dictionary_art_add_child(
+        new_node, node_ref, _sc_dictionary_art_get_byte(leaf->string, leaf->string_size, depth), node);
+    _sc_dictionary_art_add_child(
+        new_node,
+        node_ref,
+        _sc_dictionary_art_get_byte(string, string_size, depth),
+        SC_DICTIONARY_ART_TO_LEAF(_sc_dictionary_art_leaf_new(string, string_size, data)));
+    return;
+  }
+
+  // split prefix of node by new node with common prefix of node and appended string
+  if (node->prefix_size != 0)
+  {
+    sc_uint32 const prefix_size = _sc_dictionary_art_get_prefix_mismatch(
+        node, string, string_size, depth, sc_min(node->prefix_size, string_size + 1 - depth));
+    if (prefix_size < node->prefix_size)
+    {
+      sc_dictionary_art_node * new_node = _sc_dictionary_art_node_new(SC_DICTIONARY_ART_NODE_4);
+      new_node->prefix_size = prefix_size;
+      memcpy(new_node->prefix, node->prefix, sc_min(prefix_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE));
+      *node_ref = new_node;
+
+      sc_uchar byte;
+      if (node->prefix_size <= SC_DICTIONARY_ART_MAX_PREFIX_SIZE)
+      {
+        byte = node->prefix[prefix_size];
+        node->prefix_size -= prefix_size + 1;
+        memmove(node->prefix, node->prefix + prefix_size + 1, node->prefix_size);
+      }
+      else
+      {
+        sc_dictionary_art_leaf const * leaf = _sc_dictionary_art_get_minimum_leaf(node);
+        byte = _sc_dictionary_art_get_byte(leaf->string, leaf->string_size, depth + prefix_size);
+        node->prefix_size -= prefix_size + 1;
+        memcpy(
+            node->prefix,
+            leaf->string + depth + prefix_size + 1,
+            sc_min(node->prefix_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE));
+      }
+
+      _sc_dictionary_art_add_child(new_node, node_ref, byte, node);
+      _sc_dictionary_art_add_child(
+          new_node,
+          node_ref,
+          _sc_dictionary_art_get_byte(string, string_size, depth + prefix_size),
+          SC_DICTIONARY_ART_TO_LEAF(_sc_dictionary_art_leaf_new(string, string_size, data)));
+      return;
+    }
+
+    depth += node->prefix_size;
+  }
+
+  sc_uchar const byte = _sc_dictionary_art_get_byte(string, string_size, depth);
+  sc_dictionary_art_node ** child_ref = _sc_dictionary_art_find_child(node, byte);
+  if (child_ref != null_ptr)
+  {
+    _sc_dictionary_art_insert(child_ref, string, string_size, depth + 1, data);
+    return;
+  }
+
+  _sc_dictionary_art_add_child(
+      node, node_ref, byte, SC_DICTIONARY_ART_TO_LEAF(_sc_dictionary_art_leaf_new(string, string_size, data)));
+}
+
+sc_bool _sc_dictionary_art_visit_leaf(
+    sc_dictionary_art_leaf * leaf,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  sc_char * string;
+  sc_uint32 string_size;
+  if (!_sc_dictionary_art_unescape_string(leaf->string, leaf->string_size, &string, &string_size))
+  {
+    sc_dictionary_node node = {null_ptr, leaf->string, leaf->string_size, leaf->data, 0};
+    return callable(&node, dest);
+  }
+
+  // visitors get strings as they are appended
+  sc_dictionary_node node = {null_ptr, string, string_size, leaf->data, 0};
+  sc_bool const result = callable(&node, dest);
+  sc_mem_free(string);
+  return result;
+}
+
+//! Visits leaves of node in order of their strings
+sc_bool _sc_dictionary_art_visit_node(
+    sc_dictionary_art_node * node,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  if (SC_DICTIONARY_ART_IS_LEAF(node))
+    return _sc_dictionary_art_visit_leaf(SC_DICTIONARY_ART_GET_LEAF(node), callable, dest);
+
+  switch (node->type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+  case SC_DICTIONARY_ART_NODE_16:
+  {
+    sc_dictionary_art_node ** children = node->type == SC_DICTIONARY_ART_NODE_4
+                                             ? ((sc_dictionary_art_node4 *)node)->children
+                                             : ((sc_dictionary_art_node16 *)node)->children;
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+    {
+      if (!_sc_dictionary_art_visit_node(children[i], callable, dest))
+        return SC_FALSE;
+    }
+    break;
+  }
+  case SC_DICTIONARY_ART_NODE_48:
+  {
+    sc_dictionary_art_node48 * node48 = (sc_dictionary_art_node48 *)node;
+    for (sc_uint16 byte = 0; byte < 256; ++byte)
+    {
+      sc_uchar const idx = node48->child_indices[byte];
+      if (idx != 0 && !_sc_dictionary_art_visit_node(node48->children[idx - 1], callable, dest))
+        return SC_FALSE;
+    }
+    break;
+  }
+  default:
+  {
+    sc_dictionary_art_node256 * node256 = (sc_dictionary_art_node256 *)node;
+    for (sc_uint16 byte = 0; byte < 256; ++byte)
+    {
+      sc_dictionary_art_node * child = node256->children[byte];
+      if (child != null_ptr && !_sc_dictionary_art_visit_node(child, callable, dest))
+        return SC_FALSE;
+    }
+    break;
+  }
+  }
+
+  return SC_TRUE;
+}
+
+void _sc_dictionary_art_destroy_node(sc_dictionary_art_node * node, void (*node_clear)(sc_dictionary_node *))
+{
+  if (SC_DICTIONARY_ART_IS_LEAF(node))
+  {
+    sc_dictionary_art_leaf * leaf = SC_DICTIONARY_ART_GET_LEAF(node);
+    if (node_clear != null_ptr)
+    {
+      sc_dictionary_node cleared_node = {null_ptr, leaf->string, leaf->string_size, leaf->data, 0};
+      node_clear(&cleared_node);
+    }
+    sc_mem_free(leaf);
+    return;
+  }
+
+  switch (node->type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+      _sc_dictionary_art_destroy_node(((sc_dictionary_art_node4 *)node)->children[i], node_clear);
+    break;
+  case SC_DICTIONARY_ART_NODE_16:
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+      _sc_dictionary_art_destroy_node(((sc_dictionary_art_node16 *)node)->children[i], node_clear);
+    break;
+  case SC_DICTIONARY_ART_NODE_48:
+    for (sc_uint16 i = 0; i < 48; ++i)
+    {
+      sc_dictionary_art_node * child = ((sc_dictionary_art_node48 *)node)->children[i];
+      if (child != null_ptr)
+        _sc_dictionary_art_destroy_node(child, node_clear);
+    }
+    break;
+  default:
+    for (sc_uint16 byte = 0; byte < 256; ++byte)
+    {
+      sc_dictionary_art_node * child = ((sc_dictionary_art_node256 *)node)->children[byte];
+      if (child != null_ptr)
+        _sc_dictionary_art_destroy_node(child, node_clear);
+    }
+    break;
+  }
+
+  sc_mem_free(node);
+}
+
+sc_bool _sc_dictionary_art_count_leaf(sc_dictionary_node * node, void ** dest)
+{
+  sc_uint64 * counters = (sc_uint64 *)dest;
+  if (node->data != null_ptr)
+    ++counters[0];
+  counters[1] += sizeof(sc_dictionary_art_leaf) + node->offset_size + 1;
+  return SC_TRUE;
+}
+
+void _sc_dictionary_art_count_nodes(sc_dictionary_art_node const * node, sc_uint64 * memory_size)
+{
+  if (SC_DICTIONARY_ART_IS_LEAF(node))
+    return;
+
+  switch (node->type)
+  {
+  case SC_DICTIONARY_ART_NODE_4:
+    *memory_size += sizeof(sc_dictionary_art_node4);
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+      _sc_dictionary_art_count_nodes(((sc_dictionary_art_node4 const *)node)->children[i], memory_size);
+    break;
+  case SC_DICTIONARY_ART_NODE_16:
+    *memory_size += sizeof(sc_dictionary_art_node16);
+    for (sc_uint16 i = 0; i < node->children_count; ++i)
+      _sc_dictionary_art_count_nodes(((sc_dictionary_art_node16 const *)node)->children[i], memory_size);
+    break;
+  case SC_DICTIONARY_ART_NODE_48:
+    *memory_size += sizeof(sc_dictionary_art_node48);
+    for (sc_uint16 i = 0; i < 48; ++i)
+    {
+      sc_dictionary_art_node const * child = ((sc_dictionary_art_node48 const *)node)->children[i];
+      if (child != null_ptr)
+        _sc_dictionary_art_count_nodes(child, memory_size);
+    }
+    break;
+  default:
+    *memory_size += sizeof(sc_dictionary_art_node256);
+    for (sc_uint16 byte = 0; byte < 256; ++byte)
+    {
+      sc_dictionary_art_node const * child = ((sc_dictionary_art_node256 const *)node)->children[byte];
+      if (child != null_ptr)
+        _sc_dictionary_art_count_nodes(child, memory_size);
+    }
+    break;
+  }
+}
+
+sc_dictionary_art * _sc_dictionary_art_initialize(void)
+{
+  return sc_mem_new(sc_dictionary_art, 1);
+}
+
+void _sc_dictionary_art_destroy(sc_dictionary_art * art, void (*node_clear)(sc_dictionary_node *))
+{
+  if (art->root != null_ptr)
+    _sc_dictionary_art_destroy_node(art->root, node_clear);
+  sc_mem_free(art);
+}
+
+void _sc_dictionary_art_append(sc_dictionary_art * art, sc_char const * string, sc_uint32 string_size, void * data)
+{
+  sc_char * escaped_string;
+  sc_uint32 escaped_string_size;
+  if (!_sc_dictionary_art_escape_string(string, string_size, &escaped_string, &escaped_string_size))
+  {
+    _sc_dictionary_art_insert(&art->root, string, string_size, 0, data);
+    return;
+  }
+
+  _sc_dictionary_art_insert(&art->root, escaped_string, escaped_string_size, 0, data);
+  sc_mem_free(escaped_string);
+}
+
+sc_bool _sc_dictionary_art_get_escaped(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data)
+{
+  *data = null_ptr;
+
+  sc_uint32 depth = 0;
+  sc_dictionary_art_node * node = art->root;
+  while (node != null_ptr)
+  {
+    if (SC_DICTIONARY_ART_IS_LEAF(node))
+    {
+      sc_dictionary_art_leaf const * leaf = SC_DICTIONARY_ART_GET_LEAF(node);
+      if (!_sc_dictionary_art_leaf_is_equal(leaf, string, string_size))
+        return SC_FALSE;
+
+      *data = leaf->data;
+      return SC_TRUE;
+    }
+
+    // only stored bytes of prefix are checked, the whole string is checked by leaf
+    if (node->prefix_size != 0)
+    {
+      sc_uint32 const stored_size = sc_min(node->prefix_size, SC_DICTIONARY_ART_MAX_PREFIX_SIZE);
+      for (sc_uint32 i = 0; i < stored_size; ++i)
+      {
+        if (node->prefix[i] != _sc_dictionary_art_get_byte(string, string_size, depth + i))
+          return SC_FALSE;
+      }
+      depth += node->prefix_size;
+    }
+
+    if (depth > string_size)
+      return SC_FALSE;
+
+    sc_dictionary_art_node ** child_ref =
+        _sc_dictionary_art_find_child(node, _sc_dictionary_art_get_byte(string, string_size, depth));
+    node = child_ref == null_ptr ? null_ptr : *child_ref;
+    ++depth;
+  }
+
+  return SC_FALSE;
+}
+
+sc_bool _sc_dictionary_art_get(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data)
+{
+  sc_char * escaped_string;
+  sc_uint32 escaped_string_size;
+  if (!_sc_dictionary_art_escape_string(string, string_size, &escaped_string, &escaped_string_size))
+    return _sc_dictionary_art_get_escaped(art, string, string_size, data);
+
+  sc_bool const is_found = _sc_dictionary_art_get_escaped(art, escaped_string, escaped_string_size, data);
+  sc_mem_free(escaped_string);
+  return is_found;
+}
+
+sc_bool _sc_dictionary_art_visit_by_escaped_prefix(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  sc_uint32 depth = 0;
+  sc_dictionary_art_node * node = art->root;
+  while (node != null_ptr)
+  {
+    if (SC_DICTIONARY_ART_IS_LEAF(node))
+    {
+      sc_dictionary_art_leaf * leaf = SC_DICTIONARY_ART_GET_LEAF(node);
+      if (leaf->string_size < string_size || memcmp(leaf->string, string, string_size) != 0)
+        return SC_TRUE;
+
+      return _sc_dictionary_art_visit_leaf(leaf, callable, dest);
+    }
+
+    if (depth == string_size)
+      return _sc_dictionary_art_visit_node(node, callable, dest);
+
+    // prefix ends in prefix of node or the whole prefix of node is equal to bytes of prefix
+    if (node->prefix_size != 0)
+    {
+      sc_uint32 const prefix_size = _sc_dictionary_art_get_prefix_mismatch(
+          node, string, string_size, depth, sc_min(node->prefix_size, string_size - depth));
+      if (depth + prefix_size == string_size)
+        return _sc_dictionary_art_visit_node(node, callable, dest);
+      if (prefix_size < node->prefix_size)
+        return SC_TRUE;
+
+      depth += node->prefix_size;
+      if (depth == string_size)
+        return _sc_dictionary_art_visit_node(node, callable, dest);
+    }
+
+    sc_dictionary_art_node ** child_ref = _sc_dictionary_art_find_child(node, (sc_uchar)string[depth]);
+    node = child_ref == null_ptr ? null_ptr : *child_ref;
+    ++depth;
+  }
+
+  return SC_TRUE;
+}
+
+sc_bool _sc_dictionary_art_visit_by_prefix(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  sc_char * escaped_string;
+  sc_uint32 escaped_string_size;
+  if (!_sc_dictionary_art_escape_string(string, string_size, &escaped_string, &escaped_string_size))
+    return _sc_dictionary_art_visit_by_escaped_prefix(art, string, string_size, callable, dest);
+
+  sc_bool const status =
+      _sc_dictionary_art_visit_by_escaped_prefix(art, escaped_string, escaped_string_size, callable, dest);
+  sc_mem_free(escaped_string);
+  return status;
+}
+
+void _sc_dictionary_art_get_memory_size(
+    sc_dictionary_art const * art,
+    sc_uint64 * strings_count,
+    sc_uint64 * memory_size)
+{
+  sc_uint64 counters[2] = {0, sizeof(sc_dictionary_art)};
+  if (art->root != null_ptr)
+  {
+    _sc_dictionary_art_visit_node(art->root, _sc_dictionary_art_count_leaf, (void **)counters);
+    _sc_dictionary_art_count_nodes(art->root, &counters[1]);
+  }
+
+  *strings_count = counters[0];
+  *memory_size = counters[1];
+}
@@ -0,0 +1,237 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_dictionary_private.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include <string.h>
+
+#define SC_DICTIONARY_HASH_TABLE_INITIAL_CAPACITY 64
+#define SC_DICTIONARY_HASH_TABLE_STRINGS_CHUNK_SIZE 65536
+
+//! Slot of hash table, strings of slots are stored in chunks of hash table
+typedef struct
+{
+  sc_char * string;  // copied string, or null_ptr if slot is empty
+  sc_uint32 string_size;
+  sc_uint32 hash;
+  void * data;
+} sc_dictionary_hash_slot;
+
+//! Chunk of memory where strings of hash table are copied one after another
+typedef struct _sc_dictionary_strings_chunk
+{
+  struct _sc_dictionary_strings_chunk * next;
+  sc_uint64 size;
+  sc_uint64 used_size;
+  sc_char * strings;
+} sc_dictionary_strings_chunk;
+
+struct _sc_dictionary_hash_table
+{
+  sc_dictionary_hash_slot * slots;  // slots with linear probing, count of them is power of two
+  sc_uint64 capacity;
+  sc_uint64 size;
+  sc_dictionary_strings_chunk * chunks;  // chunks of strings, the last allocated chunk is the first
+  sc_uint64 chunks_size;                 // size of memory of all chunks of strings
+};
+
+sc_uint32 _sc_dictionary_hash_table_hash(sc_char const * string, sc_uint32 string_size)
+{
+  // FNV-1a with finalizer of MurmurHash3, so low bits of hash are mixed for masks of slots
+  sc_uint32 hash = 2166136261u;
+  for (sc_uint32 i = 0; i < string_size; ++i)
+  {
+    hash ^= (sc_uchar)string[i];
+    hash *= 16777619u;
+  }
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+sc_char * _sc_dictionary_hash_table_copy_string(
+    sc_dictionary_hash_table * table,
+    sc_char const * string,
+    sc_uint32 string_size)
+{
+  // strings are null-terminated, so visitors can use them as offsets of nodes
+  sc_uint64 const size = (sc_uint64)string_size + 1;
+  sc_dictionary_strings_chunk * chunk = table->chunks;
+  if (chunk == null_ptr || chunk->size - chunk->used_size < size)
+  {
+    chunk = sc_mem_new(sc_dictionary_strings_chunk, 1);
+    chunk->size = sc_max(size, SC_DICTIONARY_HASH_TABLE_STRINGS_CHUNK_SIZE);
+    chunk->used_size = 0;
+    chunk->strings = sc_mem_new(sc_char, chunk->size);
+    chunk->next = table->chunks;
+    table->chunks = chunk;
+    table->chunks_size += chunk->size;
+  }
+
+  sc_char * copied_string = chunk->strings + chunk->used_size;
+  memcpy(copied_string, string, string_size);
+  copied_string[string_size] = '\0';
+  chunk->used_size += size;
+
+  return copied_string;
+}
+
+sc_dictionary_hash_slot * _sc_dictionary_hash_table_find_slot(
+    sc_dictionary_hash_slot * slots,
+    sc_uint64 capacity,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_uint32 hash)
+{
+  sc_uint64 const mask = capacity - 1;
+  for (sc_uint64 idx = hash & mask;; idx = (idx + 1) & mask)
+  {
+    sc_dictionary_hash_slot * slot = &slots[idx];
+    if (slot->string == null_ptr)
+      return slot;
+
+    if (slot->hash == hash && slot->string_size == string_size && memcmp(slot->string, string, string_size) == 0)
+      return slot;
+  }
+}
+
+void _sc_dictionary_hash_table_grow(sc_dictionary_hash_table * table)
+{
+  sc_uint64 const capacity = table->capacity * 2;
+  sc_dictionary_hash_slot * slots = sc_mem_new(sc_dictionary_hash_slot, capacity);
+
+  for (sc_uint64 i = 0; i < table->capacity; ++i)
+  {
+    sc_dictionary_hash_slot const * slot = &table->slots[i];
+    if (slot->string == null_ptr)
+      continue;
+
+    *_sc_dictionary_hash_table_find_slot(slots, capacity, slot->string, slot->string_size, slot->hash) = *slot;
+  }
+
+  sc_mem_free(table->slots);
+  table->slots = slots;
+  table->capacity = capacity;
+}
+
+sc_dictionary_hash_table * _sc_dictionary_hash_table_initialize(void)
+{
+  sc_dictionary_hash_table * table = sc_mem_new(sc_dictionary_hash_table, 1);
+  table->capacity = SC_DICTIONARY_HASH_TABLE_INITIAL_CAPACITY;
+  table->slots = sc_mem_new(sc_dictionary_hash_slot, table->capacity);
+  return table;
+}
+
+void _sc_dictionary_hash_table_destroy(sc_dictionary_hash_table * table, void (*node_clear)(sc_dictionary_node *))
+{
+  if (node_clear != null_ptr)
+  {
+    for (sc_uint64 i = 0; i < table->capacity; ++i)
+    {
+      sc_dictionary_hash_slot const * slot = &table->slots[i];
+      if (slot->string == null_ptr)
+        continue;
+
+      sc_dictionary_node node = {null_ptr, slot->string, slot->string_size, slot->data, 0};
+      node_clear(&node);
+    }
+  }
+  sc_mem_free(table->slots);
+
+  while (table->chunks != null_ptr)
+  {
+    sc_dictionary_strings_chunk * chunk = table->chunks;
+    table->chunks = chunk->next;
+    sc_mem_free(chunk->strings);
+    sc_mem_free(chunk);
+  }
+
+  sc_mem_free(table);
+}
+
+void _sc_dictionary_hash_table_append(
+    sc_dictionary_hash_table * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void * data)
+{
+  sc_uint32 const hash = _sc_dictionary_hash_table_hash(string, string_size);
+  sc_dictionary_hash_slot * slot =
+      _sc_dictionary_hash_table_find_slot(table->slots, table->capacity, string, string_size, hash);
+  if (slot->string != null_ptr)
+  {
+    slot->data = data;
+    return;
+  }
+
+  // load factor of hash table is kept below 3/4, so probing sequences are short
+  if ((table->size + 1) * 4 > table->capacity * 3)
+  {
+    _sc_dictionary_hash_table_grow(table);
+    slot = _sc_dictionary_hash_table_find_slot(table->slots, table->capacity, string, string_size, hash);
+  }
+
+  slot->string = _sc_dictionary_hash_table_copy_string(table, string, string_size);
+  slot->string_size = string_size;
+  slot->hash = hash;
+  slot->data = data;
+  ++table->size;
+}
+
+sc_bool _sc_dictionary_hash_table_get(
+    sc_dictionary_hash_table const * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data)
+{
+  sc_dictionary_hash_slot const * slot = _sc_dictionary_hash_table_find_slot(
+      table->slots, table->capacity, string, string_size, _sc_dictionary_hash_table_hash(string, string_size));
+  *data = slot->data;
+  return slot->string != null_ptr;
+}
+
+sc_bool _sc_dictionary_hash_table_visit_by_prefix(
+    sc_dictionary_hash_table const * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest)
+{
+  for (sc_uint64 i = 0; i < table->capacity; ++i)
+  {
+    sc_dictionary_hash_slot const * slot = &table->slots[i];
+    if (slot->string == null_ptr || slot->string_size < string_size || memcmp(slot->string, string, string_size) != 0)
+      continue;
+
+    sc_dictionary_node node = {null_ptr, slot->string, slot->string_size, slot->data, 0};
+    if (!callable(&node, dest))
+      return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+void _sc_dictionary_hash_table_get_memory_size(
+    sc_dictionary_hash_table const * table,
+    sc_uint64 * strings_count,
+    sc_uint64 * memory_size)
+{
+  *strings_count = 0;
+  for (sc_uint64 i = 0; i < table->capacity; ++i)
+  {
+    if (table->slots[i].string != null_ptr && table->slots[i].data != null_ptr)
+      ++*strings_count;
+  }
+
+  *memory_size = sizeof(sc_dictionary_hash_table) + table->capacity * sizeof(sc_dictionary_hash_slot)
+                 + table->chunks_size;
+}
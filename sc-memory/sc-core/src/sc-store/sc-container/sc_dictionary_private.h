@@ -24,15 +24,102 @@ typedef struct _sc_dictionary_node
   sc_uint8 mask;                        // mask for rights checking and memory optimization
 } sc_dictionary_node;
 
+typedef struct _sc_dictionary_hash_table sc_dictionary_hash_table;
+typedef struct _sc_dictionary_art sc_dictionary_art;
+
 //! A sc-dictionary structure node to store pairs of <string, object> type
 typedef struct _sc_dictionary
 {
   sc_dictionary_node * root;  // sc-dictionary tree root node
   sc_uint8 size;              // default sc-dictionary node children size
   void (*char_to_int)(sc_char, sc_uint8 *, sc_uint8 const *);
+  sc_dictionary_hash_table * table;  // hash table of strings, if sc-dictionary is hashed, then it has no tree
+  sc_dictionary_art * art;           // adaptive radix tree of strings, if it exists, then sc-dictionary has no tree
   sc_monitor monitor;
 } sc_dictionary;
 
+/*! Initializes hashed sc-dictionary. It stores strings in open-addressing hash table instead of tree, and strings are
+ * copied to shared chunks of memory, so it takes less memory and strings are found faster than in tree. Strings are
+ * found by prefix by visiting of all strings. Nodes passed to visitors of hashed sc-dictionary are temporary, they
+ * have strings as offsets and they don't have children.
+ * @param[out] dictionary Pointer to a sc-dictionary pointer to initialize
+ * @returns Returns SC_TRUE.
+ */
+sc_bool sc_dictionary_initialize_hashed(sc_dictionary ** dictionary);
+
+/*! Initializes sc-dictionary based on adaptive radix tree. Its inner nodes have 4, 16, 48 or 256 children depending on
+ * count of them, and they store common prefixes of strings, so it takes less memory than tree with children arrays of
+ * the same size, and it is shallower. Strings are stored in leaves and visited in their order. Nodes passed to
+ * visitors of such sc-dictionary are temporary, they have strings as offsets and they don't have children.
+ * @param[out] dictionary Pointer to a sc-dictionary pointer to initialize
+ * @returns Returns SC_TRUE.
+ * @note Zero bytes end strings in tree, so strings with zero bytes are stored escaped, and they are found and visited
+ * as they are appended.
+ */
+sc_bool sc_dictionary_initialize_art(sc_dictionary ** dictionary);
+
+/*! Gets count of strings with data and size of memory used by a sc-dictionary.
+ * @param dictionary A sc-dictionary pointer
+ * @param[out] strings_count Count of strings with data
+ * @param[out] memory_size Size of memory used by sc-dictionary nodes, hash table or adaptive radix tree in bytes
+ */
+void sc_dictionary_get_memory_size(sc_dictionary * dictionary, sc_uint64 * strings_count, sc_uint64 * memory_size);
+
+sc_dictionary_hash_table * _sc_dictionary_hash_table_initialize(void);
+
+void _sc_dictionary_hash_table_destroy(sc_dictionary_hash_table * table, void (*node_clear)(sc_dictionary_node *));
+
+void _sc_dictionary_hash_table_append(
+    sc_dictionary_hash_table * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void * data);
+
+sc_bool _sc_dictionary_hash_table_get(
+    sc_dictionary_hash_table const * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data);
+
+/*! Visits strings with prefix in hash table. Hash table isn't ordered, so all its slots are checked, and it takes time
+ * proportional to capacity of hash table for any prefix.
+ */
+sc_bool _sc_dictionary_hash_table_visit_by_prefix(
+    sc_dictionary_hash_table const * table,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest);
+
+void _sc_dictionary_hash_table_get_memory_size(
+    sc_dictionary_hash_table const * table,
+    sc_uint64 * strings_count,
+    sc_uint64 * memory_size);
+
+sc_dictionary_art * _sc_dictionary_art_initialize(void);
+
+void _sc_dictionary_art_destroy(sc_dictionary_art * art, void (*node_clear)(sc_dictionary_node *));
+
+void _sc_dictionary_art_append(sc_dictionary_art * art, sc_char const * string, sc_uint32 string_size, void * data);
+
+sc_bool _sc_dictionary_art_get(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    void ** data);
+
+sc_bool _sc_dictionary_art_visit_by_prefix(
+    sc_dictionary_art const * art,
+    sc_char const * string,
+    sc_uint32 string_size,
+    sc_bool (*callable)(sc_dictionary_node *, void **),
+    void ** dest);
+
+void _sc_dictionary_art_get_memory_size(
+    sc_dictionary_art const * art,
+    sc_uint64 * strings_count,
+    sc_uint64 * memory_size);
+
 sc_dictionary_node * _sc_dictionary_node_initialize(sc_uint8 children_size);
 
 sc_dictionary_node * _sc_dictionary_get_next_node(
@@ -44,6 +44,12 @@ struct _sc_event_subscription
  */
 sc_result sc_event_notify_element_deleted(sc_addr addr);
 
+/*! Notify about deletion of sc-elements in batch. Table of events is locked once for all sc-elements.
+ * @param addrs sc-addresses of deleted sc-elements
+ * @param count Count of deleted sc-elements
+ */
+sc_result sc_event_notify_elements_deleted(sc_addr const * addrs, sc_uint32 count);
+
 /*! Emits event with \p type for sc-element \p subscription_addr with argument \p arg.
  * If \ctx is in a pending mode, then event will be pend for emit
  * @param ctx A pointer to context, that emits event
@@ -11,15 +11,32 @@
 
 #  include "sc-core/sc-base/sc_allocator.h"
 #  include "sc-core/sc-container/sc_string.h"
+#  include "sc-core/sc_stream_memory.h"
 
 #  include "sc-store/sc-container/sc_dictionary_private.h"
 #  include "sc-store/sc-container/sc_struct_node.h"
 
 #  include "sc_file_system.h"
+#  include "sc_fs_memory_checksum.h"
 #  include "sc_io.h"
 
+#  include <errno.h>
+#  include <limits.h>
+#  include <pthread.h>
+#  include <string.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+
 #  define DEFAULT_STRING_INT_SIZE 20
 #  define DEFAULT_MAX_SEARCHABLE_STRING_SIZE 1000
+//! Count of pages of `link_string_offsets`, they are indexed by segments of link hashes
+#  define SC_DICTIONARY_FS_MEMORY_LINK_STRING_OFFSETS_PAGES_COUNT (SC_ADDR_SEG_MAX + 1)
+//! Count of string offsets of sc-links in page of `link_string_offsets`, it is indexed by offsets of link hashes
+#  define SC_DICTIONARY_FS_MEMORY_LINK_STRING_OFFSETS_PAGE_SIZE (SC_ADDR_OFFSET_MAX + 1)
+//! Count of keys of every index of sc-link contents that are looked up to measure its lookup time after loading
+#  define SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT 1000
+//! Count of lookups of every sampled key
+#  define SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_ROUNDS 10
 
 typedef struct
 {
@@ -27,6 +44,26 @@ typedef struct
   sc_uint64 string_offset;
 } sc_link_hash_content;
 
+sc_char * _sc_dictionary_fs_memory_get_strings_channel_path(sc_dictionary_fs_memory const * memory, sc_uint64 idx)
+{
+  sc_char strings_channel_number[DEFAULT_STRING_INT_SIZE];
+  {
+    sc_uint64 strings_channel_number_size;
+    sc_int_to_str_int(idx + 1, strings_channel_number, strings_channel_number_size);
+    (void)strings_channel_number_size;
+  }
+  static sc_char const * strings_postfix = "strings";
+  sc_char * strings_channel_name;
+  {
+    sc_str_concat(strings_postfix, strings_channel_number, strings_channel_name);
+  }
+  sc_char * strings_path;
+  sc_fs_concat_path_ext(memory->path, strings_channel_name, SC_FS_EXT, &strings_path);
+  sc_mem_free(strings_channel_name);
+
+  return strings_path;
+}
+
 sc_io_channel * _sc_dictionary_fs_memory_get_strings_channel_by_offset(
     sc_dictionary_fs_memory * memory,
     sc_uint64 strings_offset,
@@ -43,55 +80,39 @@ sc_io_channel * _sc_dictionary_fs_memory_get_strings_channel_by_offset(
     return null_ptr;
   }
 
-  sc_monitor_acquire_read(&memory->monitor);
-  sc_io_channel * channel = memory->strings_channels[idx];
-  sc_monitor_release_read(&memory->monitor);
+  // created channels are published atomically, so readers get them without locks
+  *channel_monitor = sc_monitor_table_get_monitor_from_table(&memory->strings_channels_monitors_table, (sc_pointer)idx);
+  sc_io_channel * channel = g_atomic_pointer_get(&memory->strings_channels[idx]);
   if (channel != null_ptr)
-  {
-    *channel_monitor =
-        sc_monitor_table_get_monitor_from_table(&memory->strings_channels_monitors_table, (sc_pointer)idx);
     return channel;
-  }
-
-  sc_monitor_acquire_read(&memory->monitor);
-  if (idx > 0 && memory->strings_channels[idx - 1] != null_ptr)
-    sc_io_channel_flush(memory->strings_channels[idx - 1], null_ptr);
-  sc_monitor_release_read(&memory->monitor);
-
-  sc_char strings_channel_number[DEFAULT_STRING_INT_SIZE];
-  {
-    sc_uint64 strings_channel_number_size;
-    sc_int_to_str_int(idx + 1, strings_channel_number, strings_channel_number_size);
-    (void)strings_channel_number_size;
-  }
-  static sc_char const * strings_postfix = "strings";
-  sc_char * strings_channel_name;
-  {
-    sc_str_concat(strings_postfix, strings_channel_number, strings_channel_name);
-  }
-  sc_char * strings_path;
-  sc_fs_concat_path_ext(memory->path, strings_channel_name, SC_FS_EXT, &strings_path);
-  sc_mem_free(strings_channel_name);
 
+  sc_char * strings_path = _sc_dictionary_fs_memory_get_strings_channel_path(memory, idx);
   sc_bool is_path = sc_fs_is_file(strings_path);
 
   sc_monitor_acquire_write(&memory->monitor);
 
-  if (is_path == SC_FALSE || memory->clear == SC_TRUE)
-    memory->strings_channels[idx] = sc_io_new_write_channel(strings_path, null_ptr);
-  else
-    memory->strings_channels[idx] = sc_io_new_append_channel(strings_path, null_ptr);
-  sc_io_channel_set_encoding(memory->strings_channels[idx], null_ptr, null_ptr);
+  channel = memory->strings_channels[idx];
+  if (channel == null_ptr)
+  {
+    if (is_path == SC_FALSE || memory->clear == SC_TRUE)
+      channel = sc_io_new_write_channel(strings_path, null_ptr);
+    else
+      channel = sc_io_new_append_channel(strings_path, null_ptr);
+    sc_io_channel_set_encoding(channel, null_ptr, null_ptr);
+
+    // strings are appended to file of strings channel after the end of its mapping by writers, so pages of mapping
+    // are read only at positions of written strings
+    sc_char * region =
+        mmap(null_ptr, memory->max_strings_channel_size, PROT_READ, MAP_SHARED, sc_io_channel_get_fd(channel), 0);
+    if (region != MAP_FAILED)
+      g_atomic_pointer_set(&memory->strings_regions[idx], region);
+    g_atomic_pointer_set(&memory->strings_channels[idx], channel);
+  }
 
   sc_monitor_release_write(&memory->monitor);
-  *channel_monitor = sc_monitor_table_get_monitor_from_table(&memory->strings_channels_monitors_table, (sc_pointer)idx);
 
   sc_mem_free(strings_path);
 
-  sc_monitor_acquire_read(&memory->monitor);
-  channel = memory->strings_channels[idx];
-  sc_monitor_release_read(&memory->monitor);
-
   return channel;
 }
 
@@ -101,6 +122,102 @@ sc_uint64 _sc_dictionary_fs_memory_normalize_offset(sc_dictionary_fs_memory cons
   return strings_offset - memory->max_strings_channel_size * channel_idx;
 }
 
+/*! Gets bytes of string at specified string offset in mapping of strings channel.
+ * @param memory Dictionary fs-memory
+ * @param string_offset Offset of string
+ * @param position Position of bytes from beginning of string, it includes size of string
+ * @param size Count of bytes
+ * @returns Pointer to bytes, or null_ptr if strings channel isn't mapped or bytes are out of its mapping.
+ */
+sc_char const * _sc_dictionary_fs_memory_get_mapped_string_bytes(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_uint64 const position,
+    sc_uint64 const size)
+{
+  sc_uint64 const idx = string_offset / memory->max_strings_channel_size;
+  if (idx >= memory->max_strings_channels)
+    return null_ptr;
+
+  sc_char const * region = g_atomic_pointer_get(&memory->strings_regions[idx]);
+  sc_uint64 const offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset) + position;
+  if (region == null_ptr || offset + size > memory->max_strings_channel_size)
+    return null_ptr;
+
+  return region + offset;
+}
+
+/*! Reads bytes of string at specified string offset. Bytes are read by their positions in file of strings channel, so
+ * readers don't lock strings channel. Strings are flushed before their offsets are published, so they are read from
+ * file completely.
+ * @param memory Dictionary fs-memory
+ * @param string_offset Offset of string
+ * @param position Position of bytes from beginning of string, it includes size of string
+ * @param[out] data Read bytes
+ * @param size Count of bytes to read
+ * @returns SC_TRUE, if all bytes are read.
+ */
+sc_bool _sc_dictionary_fs_memory_read_string_bytes(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_uint64 position,
+    void * data,
+    sc_uint64 size)
+{
+  sc_monitor * channel_monitor;
+  sc_io_channel * strings_channel =
+      _sc_dictionary_fs_memory_get_strings_channel_by_offset(memory, string_offset, &channel_monitor);
+  if (strings_channel == null_ptr)
+    return SC_FALSE;
+
+  sc_int32 const fd = sc_io_channel_get_fd(strings_channel);
+  sc_uint64 offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset) + position;
+  sc_char * bytes = data;
+  while (size > 0)
+  {
+    ssize_t const read_bytes = pread(fd, bytes, size, (off_t)offset);
+    if (read_bytes < 0 && errno == EINTR)
+      continue;
+    if (read_bytes <= 0)
+      return SC_FALSE;
+
+    bytes += read_bytes;
+    offset += read_bytes;
+    size -= read_bytes;
+  }
+
+  return SC_TRUE;
+}
+
+sc_bool _sc_dictionary_fs_memory_read_string_size(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_uint64 * string_size)
+{
+  return _sc_dictionary_fs_memory_read_string_bytes(memory, string_offset, 0, string_size, sizeof(sc_uint64));
+}
+
+/*! Reads string with known size at specified string offset without locks.
+ * @param memory Dictionary fs-memory
+ * @param string_offset Offset of string
+ * @param string_size Size of string read by `_sc_dictionary_fs_memory_read_string_size`
+ * @returns Null-terminated string, or null_ptr if it can't be read.
+ */
+sc_char * _sc_dictionary_fs_memory_read_string(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_uint64 const string_size)
+{
+  sc_char * string = sc_mem_new(sc_char, string_size + 1);
+  if (!_sc_dictionary_fs_memory_read_string_bytes(memory, string_offset, sizeof(sc_uint64), string, string_size))
+  {
+    sc_mem_free(string);
+    return null_ptr;
+  }
+
+  return string;
+}
+
 sc_dictionary_fs_memory_status sc_dictionary_fs_memory_initialize_ext(
     sc_dictionary_fs_memory ** memory,
     sc_memory_params const * params)
@@ -138,21 +255,50 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_initialize_ext(
       (*memory)->max_searchable_string_size = sc_boundary(params->max_searchable_string_size, 10, 100000);
       (*memory)->term_separators = params->term_separators;
       (*memory)->search_by_substring = params->search_by_substring;
+
+      sc_char const * index = params->link_contents_index;
+      if (index == null_ptr || sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_DICTIONARY))
+        (*memory)->link_contents_index = SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_DICTIONARY;
+      else if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_HASH))
+        (*memory)->link_contents_index = SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_HASH;
+      else if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_ART))
+        (*memory)->link_contents_index = SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_ART;
+      else
+      {
+        sc_fs_memory_warning("Unknown index of sc-links contents `%s`, sc-dictionary is used", index);
+        (*memory)->link_contents_index = SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_DICTIONARY;
+      }
     }
     {
-      _sc_uchar_dictionary_initialize(&(*memory)->terms_string_offsets_dictionary);
+      _sc_uchar_dictionary_initialize(
+          &(*memory)->terms_string_offsets_dictionary, (*memory)->link_contents_index);
       static sc_char const * term_string_offsets = "term_string_offsets" SC_FS_EXT;
       sc_fs_concat_path((*memory)->path, term_string_offsets, &(*memory)->terms_string_offsets_path);
+      (*memory)->string_trigrams = (*memory)->search_by_substring ? sc_fs_memory_trigrams_new() : null_ptr;
 
       (*memory)->strings_channels = (void **)sc_mem_new(sc_io_channel *, (*memory)->max_strings_channels);
-      _sc_monitor_table_init(&(*memory)->strings_channels_monitors_table);
+      (*memory)->strings_regions = sc_mem_new(sc_char *, (*memory)->max_strings_channels);
+      _sc_monitor_table_init(&(*memory)->strings_channels_monitors_table, (*memory)->max_strings_channels);
       (*memory)->last_string_offset = 0;
       sc_monitor_init(&(*memory)->monitor);
       sc_monitor_init(&(*memory)->resolve_string_offset_monitor);
+
+      static sc_char const * strings_checksums = "strings_checksums" SC_FS_EXT;
+      sc_fs_concat_path((*memory)->path, strings_checksums, &(*memory)->strings_checksums_path);
+      (*memory)->strings_checksums =
+          sc_mem_new(sc_dictionary_fs_memory_strings_checksum, (*memory)->max_strings_channels);
+      // strings channels are verified by the same count of threads as sc-segments are loaded
+      (*memory)->strings_threads_count =
+          params->limit_max_threads_by_max_physical_cores
+              ? sc_boundary(params->max_events_and_agents_threads, 1, g_get_num_processors())
+              : sc_max(1, params->max_events_and_agents_threads);
     }
 
-    _sc_number_dictionary_initialize(&(*memory)->link_hashes_string_offsets_dictionary);
-    _sc_number_dictionary_initialize(&(*memory)->string_offsets_link_hashes_dictionary);
+    _sc_number_dictionary_initialize(
+        &(*memory)->link_hashes_string_offsets_dictionary, (*memory)->link_contents_index);
+    _sc_number_dictionary_initialize(
+        &(*memory)->string_offsets_link_hashes_dictionary, (*memory)->link_contents_index);
+    (*memory)->link_string_offsets = sc_mem_new(sc_pointer *, SC_DICTIONARY_FS_MEMORY_LINK_STRING_OFFSETS_PAGES_COUNT);
     static sc_char const * string_offsets_link_hashes = "string_offsets_link_hashes" SC_FS_EXT;
     sc_fs_concat_path((*memory)->path, string_offsets_link_hashes, &(*memory)->string_offsets_link_hashes_path);
   }
@@ -168,6 +314,7 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_initialize_ext(
   sc_message("\tMax strings channel size: %d", (*memory)->max_strings_channel_size);
   sc_message("\tMax searchable string size: %d", (*memory)->max_searchable_string_size);
   sc_message("\tTerm separators: \"%s\"", (*memory)->term_separators);
+  sc_message("\tLink contents index: %s", (*memory)->link_contents_index);
 
   sc_fs_memory_info("Successfully initialized");
 
@@ -207,20 +354,31 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_shutdown(sc_dictionary_fs
     {
       sc_dictionary_destroy(memory->terms_string_offsets_dictionary, _sc_dictionary_fs_memory_node_clear);
       sc_mem_free(memory->terms_string_offsets_path);
+      sc_fs_memory_trigrams_free(memory->string_trigrams);
 
       for (sc_uint64 i = 0; i < memory->max_strings_channels && memory->strings_channels[i] != null_ptr; ++i)
       {
+        if (memory->strings_regions[i] != null_ptr)
+          munmap(memory->strings_regions[i], memory->max_strings_channel_size);
         sc_io_channel_shutdown(memory->strings_channels[i], SC_TRUE, null_ptr);
       }
       sc_mem_free(memory->strings_channels);
+      sc_mem_free(memory->strings_regions);
       _sc_monitor_table_destroy(&memory->strings_channels_monitors_table);
       sc_monitor_destroy(&memory->monitor);
       sc_monitor_destroy(&memory->resolve_string_offset_monitor);
+
+      sc_mem_free(memory->strings_checksums_path);
+      sc_mem_free(memory->strings_checksums);
     }
 
     sc_dictionary_destroy(memory->link_hashes_string_offsets_dictionary, _sc_dictionary_fs_memory_string_node_clear);
     sc_dictionary_destroy(memory->string_offsets_link_hashes_dictionary, _sc_dictionary_fs_memory_link_node_clear);
     sc_mem_free(memory->string_offsets_link_hashes_path);
+
+    for (sc_uint32 i = 0; i < SC_DICTIONARY_FS_MEMORY_LINK_STRING_OFFSETS_PAGES_COUNT; ++i)
+      sc_mem_free(memory->link_string_offsets[i]);
+    sc_mem_free(memory->link_string_offsets);
   }
   sc_mem_free(memory);
 
@@ -253,6 +411,46 @@ sc_bool _sc_addr_hash_compare(void * addr_hash, void * other_addr_hash)
   return addr_hash == other_addr_hash;
 }
 
+/*! Publishes string offset of sc-link for readers. It is called by writers under `monitor`, readers get string offsets
+ * without locks, and pages of string offsets aren't freed until shutdown.
+ * @param memory Dictionary fs-memory
+ * @param link_hash Hash of sc-link
+ * @param string_offset Offset of string of sc-link, or INVALID_STRING_OFFSET if sc-link doesn't have string
+ */
+void _sc_dictionary_fs_memory_publish_link_string_offset(
+    sc_dictionary_fs_memory * memory,
+    sc_addr_hash const link_hash,
+    sc_uint64 const string_offset)
+{
+  sc_addr_seg const seg = SC_ADDR_LOCAL_SEG_FROM_INT(link_hash);
+  sc_pointer * page = memory->link_string_offsets[seg];
+  if (page == null_ptr)
+  {
+    if (string_offset == INVALID_STRING_OFFSET)
+      return;
+
+    page = sc_mem_new(sc_pointer, SC_DICTIONARY_FS_MEMORY_LINK_STRING_OFFSETS_PAGE_SIZE);
+    g_atomic_pointer_set(&memory->link_string_offsets[seg], page);
+  }
+
+  // string offsets are stored incremented, so zero means that sc-link doesn't have string
+  sc_uint64 const stored_string_offset = string_offset == INVALID_STRING_OFFSET ? 0 : string_offset + 1;
+  g_atomic_pointer_set(&page[SC_ADDR_LOCAL_OFFSET_FROM_INT(link_hash)], (sc_pointer)stored_string_offset);
+}
+
+sc_uint64 _sc_dictionary_fs_memory_get_link_string_offset(
+    sc_dictionary_fs_memory * memory,
+    sc_addr_hash const link_hash)
+{
+  sc_pointer * page = g_atomic_pointer_get(&memory->link_string_offsets[SC_ADDR_LOCAL_SEG_FROM_INT(link_hash)]);
+  if (page == null_ptr)
+    return INVALID_STRING_OFFSET;
+
+  sc_uint64 const stored_string_offset =
+      (sc_uint64)g_atomic_pointer_get(&page[SC_ADDR_LOCAL_OFFSET_FROM_INT(link_hash)]);
+  return stored_string_offset == 0 ? INVALID_STRING_OFFSET : stored_string_offset - 1;
+}
+
 void _sc_dictionary_fs_memory_append_link_string_unique(
     sc_dictionary_fs_memory * memory,
     sc_addr_hash const link_hash,
@@ -300,6 +498,8 @@ void _sc_dictionary_fs_memory_append_link_string_unique(
       sc_list_push_back(content->link_hashes, (sc_addr_hash_to_sc_pointer)link_hash);
     }
   }
+
+  _sc_dictionary_fs_memory_publish_link_string_offset(memory, link_hash, string_offset);
 }
 
 sc_list * _sc_dictionary_fs_memory_get_string_offsets_by_term(
@@ -329,49 +529,23 @@ sc_dictionary_fs_memory_status _sc_dictionary_node_fs_memory_get_string_offset_b
     sc_uint64 const string_offset = (sc_uint64)sc_iterator_get(string_offset_it);
 
     // read string with size from fs-memory
-    sc_uint64 read_bytes;
-    sc_monitor * channel_monitor;
-    sc_io_channel * strings_channel =
-        _sc_dictionary_fs_memory_get_strings_channel_by_offset(memory, string_offset, &channel_monitor);
-    sc_monitor_acquire_read(channel_monitor);
-    sc_uint64 const normalized_string_offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset);
-    sc_io_channel_seek(strings_channel, normalized_string_offset, SC_FS_IO_SEEK_SET, null_ptr);
-    {
-      sc_uint64 other_string_size;
-      if (sc_io_channel_read_chars(
-              strings_channel, (sc_char *)&other_string_size, sizeof(sc_uint64), &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || sizeof(sc_uint64) != read_bytes)
-      {
-        sc_monitor_release_read(channel_monitor);
-        goto error;
-      }
+    sc_uint64 other_string_size;
+    if (!_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &other_string_size))
+      goto error;
 
-      if (other_string_size != string_size)
-      {
-        sc_monitor_release_read(channel_monitor);
-        continue;
-      }
+    if (other_string_size != string_size)
+      continue;
 
-      sc_char other_string[other_string_size + 1];
-      if (sc_io_channel_read_chars(strings_channel, other_string, other_string_size, &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || other_string_size != read_bytes)
-      {
-        sc_monitor_release_read(channel_monitor);
-        goto error;
-      }
-      other_string[other_string_size] = '\0';
+    sc_char * other_string = _sc_dictionary_fs_memory_read_string(memory, string_offset, other_string_size);
+    if (other_string == null_ptr)
+      goto error;
 
-      if (sc_str_cmp(string, other_string) == SC_FALSE)
-      {
-        sc_monitor_release_read(channel_monitor);
-        continue;
-      }
-    }
+    sc_bool const is_equal = sc_str_cmp(string, other_string);
+    sc_mem_free(other_string);
+    if (is_equal == SC_FALSE)
+      continue;
 
     *found_string_offset = string_offset;
-    sc_monitor_release_read(channel_monitor);
     break;
   }
 
@@ -453,6 +627,9 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_write_string(
     }
 
     memory->last_string_offset += written_bytes;
+
+    // string is read from file by readers after its offset is published
+    sc_io_channel_flush(strings_channel, null_ptr);
   }
 
   sc_monitor_release_write(channel_monitor);
@@ -530,11 +707,17 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_link_string_ext(
 
   // cache string offset and link hash data
   {
+    sc_monitor_acquire_write(&memory->monitor);
     _sc_dictionary_fs_memory_append_link_string_unique(memory, link_hash, string_offset);
+    sc_monitor_release_write(&memory->monitor);
   }
 
   if (is_searchable_string && is_not_exist)
+  {
     status = _sc_dictionary_fs_memory_write_string_terms_string_offset(memory, string_offset, string_terms);
+    if (memory->string_trigrams != null_ptr)
+      sc_fs_memory_trigrams_append(memory->string_trigrams, string, string_size, string_offset);
+  }
 
 exit:
   sc_list_clear(string_terms);
@@ -572,6 +755,7 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_unlink_string(
 
   // set empty link
   sc_dictionary_append(memory->link_hashes_string_offsets_dictionary, link_hash_str, link_hash_str_size, null_ptr);
+  _sc_dictionary_fs_memory_publish_link_string_offset(memory, link_hash, INVALID_STRING_OFFSET);
 
 result:
   sc_monitor_release_write(&memory->monitor);
@@ -579,51 +763,75 @@ result:
   return SC_FS_MEMORY_OK;
 }
 
-sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_read_string_by_offset(
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_move_link_string(
     sc_dictionary_fs_memory * memory,
-    sc_uint64 const string_offset,
-    sc_char ** string)
+    sc_addr_hash link_hash,
+    sc_addr_hash new_link_hash)
 {
-  sc_monitor * channel_monitor;
-  sc_io_channel * strings_channel =
-      _sc_dictionary_fs_memory_get_strings_channel_by_offset(memory, string_offset, &channel_monitor);
-  if (strings_channel == null_ptr)
+  if (memory == null_ptr)
   {
-    sc_fs_memory_error("Path `%s` doesn't exist", "path");
-    return SC_FS_MEMORY_READ_ERROR;
+    sc_fs_memory_info("Memory is empty to move string");
+    return SC_FS_MEMORY_NO;
   }
 
-  // read string with size from fs-memory
-  sc_uint64 read_bytes;
-  sc_uint64 const normalized_string_offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset);
-  sc_monitor_acquire_write(channel_monitor);
-  sc_io_channel_seek(strings_channel, normalized_string_offset, SC_FS_IO_SEEK_SET, null_ptr);
-  {
-    sc_uint64 string_size;
-    if (sc_io_channel_read_chars(strings_channel, (sc_char *)&string_size, sizeof(sc_uint64), &read_bytes, null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || sizeof(sc_uint64) != read_bytes)
-    {
-      *string = null_ptr;
-      goto error;
-    }
+  sc_monitor_acquire_write(&memory->monitor);
 
-    *string = sc_mem_new(sc_char, string_size + 1);
-    if (sc_io_channel_read_chars(strings_channel, *string, string_size, &read_bytes, null_ptr) != SC_FS_IO_STATUS_NORMAL
-        || string_size != read_bytes)
-    {
-      sc_mem_free(*string);
-      *string = null_ptr;
-      goto error;
-    }
+  sc_char link_hash_str[DEFAULT_STRING_INT_SIZE];
+  sc_uint64 link_hash_str_size;
+  sc_int_to_str_int(link_hash, link_hash_str, link_hash_str_size);
+
+  sc_link_hash_content * link_hash_content =
+      sc_dictionary_get_by_key(memory->link_hashes_string_offsets_dictionary, link_hash_str, link_hash_str_size);
+  if (link_hash_content == null_ptr)
+    goto result;
+
+  sc_char new_link_hash_str[DEFAULT_STRING_INT_SIZE];
+  sc_uint64 new_link_hash_str_size;
+  sc_int_to_str_int(new_link_hash, new_link_hash_str, new_link_hash_str_size);
+
+  // string of new sc-link hash is replaced, as it is replaced by linking of string
+  sc_link_hash_content * new_link_hash_content = sc_dictionary_get_by_key(
+      memory->link_hashes_string_offsets_dictionary, new_link_hash_str, new_link_hash_str_size);
+  if (new_link_hash_content != null_ptr)
+  {
+    sc_list_remove_if(
+        new_link_hash_content->link_hashes, (sc_addr_hash_to_sc_pointer)new_link_hash, _sc_addr_hash_compare);
+    sc_mem_free(new_link_hash_content);
   }
 
-  sc_monitor_release_write(channel_monitor);
+  sc_list_remove_if(link_hash_content->link_hashes, (sc_addr_hash_to_sc_pointer)link_hash, _sc_addr_hash_compare);
+  sc_list_push_back(link_hash_content->link_hashes, (sc_addr_hash_to_sc_pointer)new_link_hash);
+  sc_dictionary_append(
+      memory->link_hashes_string_offsets_dictionary, new_link_hash_str, new_link_hash_str_size, link_hash_content);
+
+  // set empty link
+  sc_dictionary_append(memory->link_hashes_string_offsets_dictionary, link_hash_str, link_hash_str_size, null_ptr);
+  _sc_dictionary_fs_memory_publish_link_string_offset(
+      memory, new_link_hash, (sc_uint64)link_hash_content->string_offset - 1);
+  _sc_dictionary_fs_memory_publish_link_string_offset(memory, link_hash, INVALID_STRING_OFFSET);
+
+result:
+  sc_monitor_release_write(&memory->monitor);
+
   return SC_FS_MEMORY_OK;
+}
 
-error:
-  sc_monitor_release_write(channel_monitor);
-  return SC_FS_MEMORY_READ_ERROR;
+sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_read_string_by_offset(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_char ** string)
+{
+  sc_uint64 string_size;
+  *string = null_ptr;
+  if (_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &string_size))
+    *string = _sc_dictionary_fs_memory_read_string(memory, string_offset, string_size);
+  if (*string == null_ptr)
+  {
+    sc_fs_memory_error("Can't read string at offset %" PRIu64, string_offset);
+    return SC_FS_MEMORY_READ_ERROR;
+  }
+
+  return SC_FS_MEMORY_OK;
 }
 
 void _sc_dictionary_fs_memory_read_file(sc_char * file_path, sc_char ** content, sc_uint32 * size)
@@ -651,20 +859,15 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_string_by_link_hash(
     return SC_FS_MEMORY_NO;
   }
 
-  sc_char link_hash_str[DEFAULT_STRING_INT_SIZE];
-  sc_uint64 link_hash_str_size;
-  sc_int_to_str_int(link_hash, link_hash_str, link_hash_str_size);
-  sc_link_hash_content * content =
-      sc_dictionary_get_by_key(memory->link_hashes_string_offsets_dictionary, link_hash_str, link_hash_str_size);
-
-  if (content == null_ptr)
+  // string offset and string are read without locks, as strings aren't changed after they are written
+  sc_uint64 const string_offset = _sc_dictionary_fs_memory_get_link_string_offset(memory, link_hash);
+  if (string_offset == INVALID_STRING_OFFSET)
   {
     *string = null_ptr;
     *string_size = 0;
     return SC_FS_MEMORY_NO_STRING;
   }
 
-  sc_uint64 const string_offset = (sc_uint64)content->string_offset - 1;
   sc_dictionary_fs_memory_status const status =
       _sc_dictionary_fs_memory_read_string_by_offset(memory, string_offset, string);
   if (status != SC_FS_MEMORY_OK)
@@ -688,6 +891,133 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_string_by_link_hash(
   return SC_FS_MEMORY_OK;
 }
 
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_stream_by_link_hash(
+    sc_dictionary_fs_memory * memory,
+    sc_addr_hash const link_hash,
+    sc_stream ** stream)
+{
+  *stream = null_ptr;
+  if (memory == null_ptr)
+  {
+    sc_fs_memory_info("Memory is empty to get stream by link hash");
+    return SC_FS_MEMORY_NO;
+  }
+
+  sc_uint64 const string_offset = _sc_dictionary_fs_memory_get_link_string_offset(memory, link_hash);
+  if (string_offset == INVALID_STRING_OFFSET)
+    return SC_FS_MEMORY_NO_STRING;
+
+  // size of string is read from file, so strings out of file aren't read from its mapping
+  sc_uint64 string_size;
+  if (!_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &string_size))
+  {
+    sc_fs_memory_error("Can't read string at offset %" PRIu64, string_offset);
+    return SC_FS_MEMORY_READ_ERROR;
+  }
+
+  sc_char const * string =
+      _sc_dictionary_fs_memory_get_mapped_string_bytes(memory, string_offset, sizeof(sc_uint64), string_size);
+  if (string != null_ptr)
+  {
+    // content is read until its first null character as by `sc_dictionary_fs_memory_get_string_by_link_hash`
+    sc_char const * string_end = memchr(string, '\0', string_size);
+    if (string_end != null_ptr)
+      string_size = string_end - string;
+
+    // content that is path to file is replaced by content of the file
+    sc_bool is_file = SC_FALSE;
+    if (string_size < PATH_MAX && (memchr(string, '.', string_size) || memchr(string, '/', string_size)))
+    {
+      sc_char file_path[PATH_MAX];
+      sc_mem_cpy(file_path, string, string_size);
+      file_path[string_size] = '\0';
+      is_file = sc_fs_is_file(file_path);
+    }
+
+    if (!is_file)
+    {
+      *stream = sc_stream_memory_new(string, string_size, SC_STREAM_FLAG_READ, SC_FALSE);
+      return SC_FS_MEMORY_OK;
+    }
+  }
+
+  sc_char * copied_string;
+  sc_dictionary_fs_memory_status const status =
+      sc_dictionary_fs_memory_get_string_by_link_hash(memory, link_hash, &copied_string, &string_size);
+  if (status != SC_FS_MEMORY_OK)
+    return status;
+
+  *stream = sc_stream_memory_new(copied_string, string_size, SC_STREAM_FLAG_READ, SC_TRUE);
+  return SC_FS_MEMORY_OK;
+}
+
+/*! Checks if string at specified string offset contains substring or begins with it. String is checked in mapping of
+ * strings channel without copying, if it is mapped. Strings are checked until their first null characters, as copied
+ * strings are checked.
+ * @param memory Dictionary fs-memory
+ * @param string_offset Offset of string
+ * @param string_size Size of string read by `_sc_dictionary_fs_memory_read_string_size`
+ * @param substring Null-terminated substring
+ * @param substring_size Size of substring
+ * @param to_search_as_prefix Whether string must begin with substring
+ * @param[out] has_substring Whether string contains substring
+ * @returns SC_FALSE, if string can't be read.
+ */
+sc_bool _sc_dictionary_fs_memory_string_has_substring(
+    sc_dictionary_fs_memory * memory,
+    sc_uint64 const string_offset,
+    sc_uint64 string_size,
+    sc_char const * substring,
+    sc_uint64 const substring_size,
+    sc_bool const to_search_as_prefix,
+    sc_bool * has_substring)
+{
+  sc_char const * string =
+      _sc_dictionary_fs_memory_get_mapped_string_bytes(memory, string_offset, sizeof(sc_uint64), string_size);
+  if (string == null_ptr)
+  {
+    sc_char * copied_string = _sc_dictionary_fs_memory_read_string(memory, string_offset, string_size);
+    if (copied_string == null_ptr)
+      return SC_FALSE;
+
+    *has_substring =
+        to_search_as_prefix ? sc_str_has_prefix(copied_string, substring) : sc_str_find(copied_string, substring);
+    sc_mem_free(copied_string);
+    return SC_TRUE;
+  }
+
+  sc_char const * string_end = memchr(string, '\0', string_size);
+  if (string_end != null_ptr)
+    string_size = string_end - string;
+
+  *has_substring = SC_FALSE;
+  if (string_size < substring_size)
+    return SC_TRUE;
+
+  if (to_search_as_prefix || substring_size == 0)
+  {
+    *has_substring = memcmp(string, substring, substring_size) == 0;
+    return SC_TRUE;
+  }
+
+  // positions of the first byte of substring are found by `memchr`, and the rest bytes are compared there
+  sc_char const * last_position = string + (string_size - substring_size);
+  for (sc_char const * position = string; position <= last_position; ++position)
+  {
+    position = memchr(position, substring[0], last_position - position + 1);
+    if (position == null_ptr)
+      break;
+
+    if (memcmp(position + 1, substring + 1, substring_size - 1) == 0)
+    {
+      *has_substring = SC_TRUE;
+      break;
+    }
+  }
+
+  return SC_TRUE;
+}
+
 sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_get_link_hashes_by_string_term(
     sc_dictionary_fs_memory * memory,
     sc_char const * string,
@@ -702,62 +1032,37 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_get_link_hashes_by_strin
   if (!sc_iterator_next(string_offset_it))
     return SC_FS_MEMORY_NO_STRING;
 
-  sc_monitor * channel_monitor;
   while (sc_iterator_next(string_offset_it))
   {
     sc_uint64 const string_offset = (sc_uint64)sc_iterator_get(string_offset_it);
 
-    sc_io_channel * strings_channel =
-        _sc_dictionary_fs_memory_get_strings_channel_by_offset(memory, string_offset, &channel_monitor);
-    if (strings_channel == null_ptr)
-    {
-      sc_fs_memory_error("Path `%s` doesn't exist", "path");
-      return SC_FS_MEMORY_READ_ERROR;
-    }
-
     // read string with size from fs-memory
-    sc_uint64 read_bytes;
-    sc_uint64 const normalized_string_offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset);
+    sc_uint64 other_string_size;
+    if (!_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &other_string_size))
+      goto error;
 
-    sc_bool go_to_next = SC_FALSE;
-    sc_monitor_acquire_write(channel_monitor);
-    sc_io_channel_seek(strings_channel, normalized_string_offset, SC_FS_IO_SEEK_SET, null_ptr);
+    // optimize needed string search
+    if ((is_substring && other_string_size < string_size) || (!is_substring && other_string_size != string_size))
+      continue;
+
+    sc_bool is_found;
+    if (is_substring)
     {
-      sc_uint64 other_string_size;
-      if (sc_io_channel_read_chars(
-              strings_channel, (sc_char *)&other_string_size, sizeof(sc_uint64), &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || sizeof(sc_uint64) != read_bytes)
+      if (!_sc_dictionary_fs_memory_string_has_substring(
+              memory, string_offset, other_string_size, string, string_size, to_search_as_prefix, &is_found))
         goto error;
-
-      // optimize needed string search
-      if ((is_substring && other_string_size < string_size) || (!is_substring && other_string_size != string_size))
-      {
-        go_to_next = SC_TRUE;
-        goto cont;
-      }
-
-      sc_char other_string[other_string_size + 1];
-      if (sc_io_channel_read_chars(strings_channel, other_string, other_string_size, &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || other_string_size != read_bytes)
+    }
+    else
+    {
+      sc_char * other_string = _sc_dictionary_fs_memory_read_string(memory, string_offset, other_string_size);
+      if (other_string == null_ptr)
         goto error;
 
-      other_string[other_string_size] = '\0';
-
-      if ((is_substring
-           && ((to_search_as_prefix && sc_str_has_prefix(other_string, string) == SC_FALSE)
-               || (!to_search_as_prefix && sc_str_find(other_string, string) == SC_FALSE)))
-          || (!is_substring && sc_str_cmp(string, other_string) == SC_FALSE))
-      {
-        go_to_next = SC_TRUE;
-        goto cont;
-      }
+      is_found = sc_str_cmp(string, other_string);
+      sc_mem_free(other_string);
     }
 
-  cont:
-    sc_monitor_release_write(channel_monitor);
-    if (go_to_next)
+    if (!is_found)
       continue;
 
     sc_char string_offset_str[DEFAULT_STRING_INT_SIZE];
@@ -782,11 +1087,21 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_get_link_hashes_by_strin
   return SC_FS_MEMORY_OK;
 
 error:
-  sc_monitor_release_write(channel_monitor);
   sc_iterator_destroy(string_offset_it);
   return SC_FS_MEMORY_READ_ERROR;
 }
 
+sc_bool _sc_dictionary_fs_memory_is_string_linked(sc_dictionary_fs_memory const * memory, sc_uint64 string_offset)
+{
+  sc_char string_offset_str[DEFAULT_STRING_INT_SIZE];
+  sc_uint64 string_offset_str_size;
+  sc_int_to_str_int(string_offset, string_offset_str, string_offset_str_size);
+
+  sc_list * link_hashes = sc_dictionary_get_by_key(
+      memory->string_offsets_link_hashes_dictionary, string_offset_str, string_offset_str_size);
+  return link_hashes != null_ptr && link_hashes->size != 0;
+}
+
 sc_bool _sc_dictionary_fs_memory_visit_string_offsets_by_term_prefix(sc_dictionary_node * node, void ** arguments)
 {
   if (node->data == null_ptr)
@@ -804,14 +1119,9 @@ sc_bool _sc_dictionary_fs_memory_visit_string_offsets_by_term_prefix(sc_dictiona
   while (sc_iterator_next(it))
   {
     sc_uint64 const string_offset = (sc_uint64)sc_iterator_get(it);
-    sc_char string_offset_str[DEFAULT_STRING_INT_SIZE];
-    sc_uint64 string_offset_str_size;
-    sc_int_to_str_int(string_offset, string_offset_str, string_offset_str_size);
 
     // skip strings without links
-    sc_list * link_hashes = sc_dictionary_get_by_key(
-        memory->string_offsets_link_hashes_dictionary, string_offset_str, string_offset_str_size);
-    if (link_hashes != null_ptr && link_hashes->size != 0)
+    if (_sc_dictionary_fs_memory_is_string_linked(memory, string_offset))
       sc_list_push_back(string_offsets, (void *)string_offset);
   }
   sc_iterator_destroy(it);
@@ -842,6 +1152,43 @@ sc_list * _sc_dictionary_fs_memory_get_string_offsets_by_term_prefix(
   return string_offsets;
 }
 
+/*! Gets offsets of linked strings that contain all trigrams of substring. Unlike search by prefixes of terms, it finds
+ * strings containing substring in any place of their terms.
+ * @param memory Dictionary fs-memory
+ * @param string Substring
+ * @param string_size Size of substring
+ * @returns List of string offsets with empty first element, as lists of strings offsets of terms, or null_ptr if search
+ * by substring is off or substring is shorter than trigram.
+ */
+sc_list * _sc_dictionary_fs_memory_get_string_offsets_by_trigrams(
+    sc_dictionary_fs_memory const * memory,
+    sc_char const * string,
+    sc_uint64 const string_size)
+{
+  if (memory->string_trigrams == null_ptr)
+    return null_ptr;
+
+  sc_uint64 * found_string_offsets;
+  sc_uint32 found_string_offsets_count;
+  if (!sc_fs_memory_trigrams_find(
+          memory->string_trigrams, string, string_size, &found_string_offsets, &found_string_offsets_count))
+    return null_ptr;
+
+  sc_list * string_offsets;
+  sc_list_init(&string_offsets);
+  sc_list_push_back(string_offsets, null_ptr);
+
+  for (sc_uint32 i = 0; i < found_string_offsets_count; ++i)
+  {
+    // skip strings without links
+    if (_sc_dictionary_fs_memory_is_string_linked(memory, found_string_offsets[i]))
+      sc_list_push_back(string_offsets, (void *)found_string_offsets[i]);
+  }
+  sc_mem_free(found_string_offsets);
+
+  return string_offsets;
+}
+
 sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_link_hashes_by_string_ext(
     sc_dictionary_fs_memory * memory,
     sc_char const * string,
@@ -857,13 +1204,19 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_link_hashes_by_string
     return SC_FS_MEMORY_NO;
   }
 
-  sc_char * term = _sc_dictionary_fs_memory_get_first_term(string, memory->term_separators);
   sc_list * string_offsets = null_ptr;
   if (is_substring)
-    string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term_prefix(memory, term);
-  else
-    string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term(memory, term);
-  sc_mem_free(term);
+    string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_trigrams(memory, string, string_size);
+
+  if (string_offsets == null_ptr)
+  {
+    sc_char * term = _sc_dictionary_fs_memory_get_first_term(string, memory->term_separators);
+    if (is_substring)
+      string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term_prefix(memory, term);
+    else
+      string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term(memory, term);
+    sc_mem_free(term);
+  }
 
   sc_dictionary_fs_memory_status const status = _sc_dictionary_fs_memory_get_link_hashes_by_string_term(
       memory, string, string_size, is_substring, to_search_as_prefix, string_offsets, data, callback);
@@ -921,72 +1274,38 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_get_strings_by_substring
   if (!sc_iterator_next(string_offset_it))
     return SC_FS_MEMORY_READ_ERROR;
 
-  sc_monitor * channel_monitor;
   while (sc_iterator_next(string_offset_it))
   {
     sc_uint64 const string_offset = (sc_uint64)sc_iterator_get(string_offset_it);
 
-    sc_io_channel * strings_channel =
-        _sc_dictionary_fs_memory_get_strings_channel_by_offset(memory, string_offset, &channel_monitor);
-    if (strings_channel == null_ptr)
-    {
-      sc_fs_memory_error("Path `%s` doesn't exist", "path");
-      return SC_FS_MEMORY_READ_ERROR;
-    }
-
     // read string with size from fs-memory
-    sc_uint64 read_bytes;
-    sc_uint64 const normalized_string_offset = _sc_dictionary_fs_memory_normalize_offset(memory, string_offset);
-
-    sc_bool go_to_next = SC_FALSE;
-    sc_monitor_acquire_write(channel_monitor);
-    sc_io_channel_seek(strings_channel, normalized_string_offset, SC_FS_IO_SEEK_SET, null_ptr);
-    {
-      sc_uint64 other_string_size;
-      if (sc_io_channel_read_chars(
-              strings_channel, (sc_char *)&other_string_size, sizeof(sc_uint64), &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || sizeof(sc_uint64) != read_bytes)
-        goto error;
+    sc_uint64 other_string_size;
+    if (!_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &other_string_size))
+      goto error;
 
-      if (other_string_size < string_size)
-      {
-        go_to_next = SC_TRUE;
-        goto cont;
-      }
+    if (other_string_size < string_size)
+      continue;
 
-      sc_char * other_string = sc_mem_new(sc_char, other_string_size + 1);
-      if (sc_io_channel_read_chars(strings_channel, other_string, other_string_size, &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || other_string_size != read_bytes)
-      {
-        sc_mem_free(other_string);
-        goto error;
-      }
+    sc_bool has_substring;
+    if (!_sc_dictionary_fs_memory_string_has_substring(
+            memory, string_offset, other_string_size, string, string_size, to_search_as_prefix, &has_substring))
+      goto error;
 
-      if ((to_search_as_prefix && sc_str_has_prefix(other_string, string) == SC_FALSE)
-          || (!to_search_as_prefix && sc_str_find(other_string, string) == SC_FALSE))
-      {
-        sc_mem_free(other_string);
-        go_to_next = SC_TRUE;
-        goto cont;
-      }
+    if (!has_substring)
+      continue;
 
-    cont:
-      sc_monitor_release_write(channel_monitor);
-      if (go_to_next)
-        continue;
+    sc_char * other_string = _sc_dictionary_fs_memory_read_string(memory, string_offset, other_string_size);
+    if (other_string == null_ptr)
+      goto error;
 
-      callback(data, SC_ADDR_EMPTY, other_string);
-      sc_mem_free(other_string);
-    }
+    callback(data, SC_ADDR_EMPTY, other_string);
+    sc_mem_free(other_string);
   }
   sc_iterator_destroy(string_offset_it);
 
   return SC_FS_MEMORY_OK;
 
 error:
-  sc_monitor_release_write(channel_monitor);
   sc_iterator_destroy(string_offset_it);
   return SC_FS_MEMORY_READ_ERROR;
 }
@@ -1005,9 +1324,13 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_get_strings_by_substring
     return SC_FS_MEMORY_NO;
   }
 
-  sc_char * term = _sc_dictionary_fs_memory_get_first_term(string, memory->term_separators);
-  sc_list * string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term_prefix(memory, term);
-  sc_mem_free(term);
+  sc_list * string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_trigrams(memory, string, string_size);
+  if (string_offsets == null_ptr)
+  {
+    sc_char * term = _sc_dictionary_fs_memory_get_first_term(string, memory->term_separators);
+    string_offsets = _sc_dictionary_fs_memory_get_string_offsets_by_term_prefix(memory, term);
+    sc_mem_free(term);
+  }
 
   sc_dictionary_fs_memory_status const status = _sc_dictionary_fs_memory_get_strings_by_substring_term(
       memory, string, string_size, to_search_as_prefix, string_offsets, data, callback);
@@ -1072,7 +1395,7 @@ void _sc_dictionary_fs_memory_get_string_offsets_by_terms(
     sc_list const * terms,
     sc_dictionary ** string_offsets_terms_dictionary)
 {
-  _sc_uchar_dictionary_initialize(string_offsets_terms_dictionary);
+  _sc_uchar_dictionary_initialize(string_offsets_terms_dictionary, memory->link_contents_index);
 
   sc_iterator * term_it = sc_list_iterator(terms);
   while (sc_iterator_next(term_it))
@@ -1260,6 +1583,117 @@ void _sc_dictionary_fs_memory_read_terms_string_offsets(sc_dictionary_fs_memory
   }
 }
 
+//! Offsets of strings collected from index of terms
+typedef struct
+{
+  sc_uint64 * string_offsets;
+  sc_uint64 count;
+  sc_uint64 capacity;
+} sc_dictionary_fs_memory_string_offsets;
+
+sc_bool _sc_dictionary_fs_memory_collect_term_string_offsets(sc_dictionary_node * node, void ** arguments)
+{
+  if (node->data == null_ptr)
+    return SC_TRUE;
+
+  sc_dictionary_fs_memory_string_offsets * collected = (sc_dictionary_fs_memory_string_offsets *)arguments;
+  sc_iterator * it = sc_list_iterator(node->data);
+  if (!sc_iterator_next(it))
+  {
+    sc_iterator_destroy(it);
+    return SC_TRUE;
+  }
+
+  while (sc_iterator_next(it))
+  {
+    if (collected->count == collected->capacity)
+    {
+      collected->capacity = sc_max(collected->capacity * 2, 1024);
+      sc_uint64 * string_offsets = sc_mem_new(sc_uint64, collected->capacity);
+      if (collected->string_offsets != null_ptr)
+        memcpy(string_offsets, collected->string_offsets, collected->count * sizeof(sc_uint64));
+      sc_mem_free(collected->string_offsets);
+      collected->string_offsets = string_offsets;
+    }
+
+    collected->string_offsets[collected->count++] = (sc_uint64)sc_iterator_get(it);
+  }
+  sc_iterator_destroy(it);
+
+  return SC_TRUE;
+}
+
+int _sc_dictionary_fs_memory_compare_string_offsets(void const * string_offset, void const * other_string_offset)
+{
+  sc_uint64 const a = *(sc_uint64 const *)string_offset;
+  sc_uint64 const b = *(sc_uint64 const *)other_string_offset;
+  return (a > b) - (a < b);
+}
+
+/*! Builds index of strings by trigrams from strings of index of terms. Strings of every term are indexed once, both
+ * linked and unlinked ones, since unlinked strings are found by terms to be linked again.
+ * @param memory Dictionary fs-memory with loaded index of terms
+ */
+void _sc_dictionary_fs_memory_load_string_trigrams(sc_dictionary_fs_memory * memory)
+{
+  sc_uint64 strings_count;
+  sc_uint64 trigrams_count;
+  sc_uint64 memory_size;
+  sc_fs_memory_trigrams_get_memory_size(memory->string_trigrams, &strings_count, &trigrams_count, &memory_size);
+  // strings of deprecated dictionaries are indexed while they are linked
+  if (strings_count != 0)
+    return;
+
+  sc_dictionary_fs_memory_string_offsets collected = {null_ptr, 0, 0};
+  sc_dictionary_visit_down_nodes(
+      memory->terms_string_offsets_dictionary,
+      _sc_dictionary_fs_memory_collect_term_string_offsets,
+      (void **)&collected);
+
+  if (collected.count != 0)
+  {
+    qsort(
+        collected.string_offsets,
+        collected.count,
+        sizeof(sc_uint64),
+        _sc_dictionary_fs_memory_compare_string_offsets);
+  }
+
+  for (sc_uint64 i = 0; i < collected.count; ++i)
+  {
+    sc_uint64 const string_offset = collected.string_offsets[i];
+    if (i != 0 && collected.string_offsets[i - 1] == string_offset)
+      continue;
+
+    sc_uint64 string_size;
+    if (!_sc_dictionary_fs_memory_read_string_size(memory, string_offset, &string_size))
+      continue;
+
+    sc_char const * string =
+        _sc_dictionary_fs_memory_get_mapped_string_bytes(memory, string_offset, sizeof(sc_uint64), string_size);
+    if (string != null_ptr)
+    {
+      sc_fs_memory_trigrams_append(memory->string_trigrams, string, string_size, string_offset);
+      continue;
+    }
+
+    sc_char * copied_string = _sc_dictionary_fs_memory_read_string(memory, string_offset, string_size);
+    if (copied_string == null_ptr)
+      continue;
+
+    sc_fs_memory_trigrams_append(memory->string_trigrams, copied_string, string_size, string_offset);
+    sc_mem_free(copied_string);
+  }
+  sc_mem_free(collected.string_offsets);
+
+  sc_fs_memory_trigrams_get_memory_size(memory->string_trigrams, &strings_count, &trigrams_count, &memory_size);
+  sc_fs_memory_info(
+      "Index of strings by trigrams built: %" PRIu64 " strings, %" PRIu64 " trigrams, %.2f MB",
+      strings_count,
+      trigrams_count,
+      memory_size / (1024.0 * 1024.0));
+}
+
 sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_load_terms_offsets(sc_dictionary_fs_memory * memory)
 {
   sc_fs_memory_info("Load `term - offsets` dictionary from %s", memory->terms_string_offsets_path);
@@ -1409,6 +1843,268 @@ sc_fs_memory_status _sc_dictionary_fs_memory_load_deprecated_dictionaries(sc_dic
   return SC_FS_MEMORY_OK;
 }
 
+sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_load_strings_checksums(
+    sc_dictionary_fs_memory * memory,
+    sc_uint32 * channels_count)
+{
+  *channels_count = 0;
+  sc_io_channel * channel = sc_io_new_read_channel(memory->strings_checksums_path, null_ptr);
+  if (channel == null_ptr)
+  {
+    sc_fs_memory_info("Path `%s` doesn't exist. Nothing to verify", memory->strings_checksums_path);
+    return SC_FS_MEMORY_NO;
+  }
+  sc_io_channel_set_encoding(channel, null_ptr, null_ptr);
+
+  sc_uint64 read_bytes = 0;
+  if (sc_io_channel_read_chars(channel, (sc_char *)channels_count, sizeof(sc_uint32), &read_bytes, null_ptr)
+          != SC_FS_IO_STATUS_NORMAL
+      || sizeof(sc_uint32) != read_bytes || *channels_count > memory->max_strings_channels)
+    goto error;
+
+  for (sc_uint32 i = 0; i < *channels_count; ++i)
+  {
+    sc_dictionary_fs_memory_strings_checksum * checksum = &memory->strings_checksums[i];
+    if (sc_io_channel_read_chars(channel, (sc_char *)&checksum->size, sizeof(sc_uint64), &read_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || sizeof(sc_uint64) != read_bytes)
+      goto error;
+
+    if (sc_io_channel_read_chars(channel, (sc_char *)&checksum->checksum, sizeof(sc_uint32), &read_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || sizeof(sc_uint32) != read_bytes)
+      goto error;
+  }
+
+  sc_io_channel_shutdown(channel, SC_TRUE, null_ptr);
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  sc_fs_memory_error("Checksums of strings channels are corrupted, so strings channels can't be verified");
+  sc_mem_set(memory->strings_checksums, 0, sizeof(sc_dictionary_fs_memory_strings_checksum) * *channels_count);
+  *channels_count = 0;
+  sc_io_channel_shutdown(channel, SC_TRUE, null_ptr);
+  return SC_FS_MEMORY_READ_ERROR;
+}
+}
+
+//! Verification of strings channels by several workers. Workers take indices of the next channels one by one.
+typedef struct
+{
+  sc_dictionary_fs_memory * memory;
+  sc_uint32 channels_count;
+  sc_uint32 next_idx;         // index of the next strings channel to verify, it is accessed atomically
+  sc_uint32 corrupted_count;  // it is accessed atomically
+} sc_dictionary_fs_memory_strings_verifying;
+
+void * _sc_dictionary_fs_memory_verify_strings_channels_by_worker(void * arg)
+{
+  sc_dictionary_fs_memory_strings_verifying * verifying = arg;
+  sc_dictionary_fs_memory * memory = verifying->memory;
+
+  while (SC_TRUE)
+  {
+    sc_uint32 const idx = g_atomic_int_add(&verifying->next_idx, 1);
+    if (idx >= verifying->channels_count)
+      break;
+
+    // only bytes saved by the last dump are verified, strings written after it aren't checksummed yet
+    sc_dictionary_fs_memory_strings_checksum * checksum = &memory->strings_checksums[idx];
+    if (checksum->size == 0)
+      continue;
+
+    sc_char * strings_path = _sc_dictionary_fs_memory_get_strings_channel_path(memory, idx);
+    sc_uint32 actual_checksum = 0;
+    if (sc_fs_memory_checksum_file(strings_path, 0, checksum->size, &actual_checksum) == SC_FALSE
+        || actual_checksum != checksum->checksum)
+    {
+      sc_fs_memory_error("Strings channel `%s` is corrupted", strings_path);
+      g_atomic_int_inc(&verifying->corrupted_count);
+      // strings can't be restored, so checksum of corrupted strings channel is calculated again by the next dump
+      checksum->size = 0;
+      checksum->checksum = 0;
+    }
+    sc_mem_free(strings_path);
+  }
+
+  // it is called by the verifying thread too, so it doesn't exit thread
+  return null_ptr;
+}
+
+/*! Verifies checksums of strings channels saved by the last dump. Strings channels are independent files, so they are
+ * verified in parallel by `strings_threads_count` workers. The calling thread is one of workers.
+ * @param memory A pointer to file memory
+ * @param[out] corrupted_count Count of corrupted strings channels
+ * @returns SC_FS_MEMORY_OK, if checksums of strings channels are read or if they aren't saved yet.
+ */
+sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_verify_strings_channels(
+    sc_dictionary_fs_memory * memory,
+    sc_uint32 * corrupted_count)
+{
+  *corrupted_count = 0;
+
+  sc_uint32 channels_count;
+  sc_dictionary_fs_memory_status const status =
+      _sc_dictionary_fs_memory_load_strings_checksums(memory, &channels_count);
+  if (status != SC_FS_MEMORY_OK)
+    return status == SC_FS_MEMORY_NO ? SC_FS_MEMORY_OK : status;
+
+  sc_fs_memory_info("Verify strings channels");
+  sc_dictionary_fs_memory_strings_verifying verifying = {
+      .memory = memory,
+      .channels_count = channels_count,
+  };
+
+  sc_uint32 const threads_count = sc_max(1, sc_min(memory->strings_threads_count, channels_count));
+  pthread_t * threads = sc_mem_new(pthread_t, threads_count);
+  sc_uint32 started_threads_count = 1;
+  for (; started_threads_count < threads_count; ++started_threads_count)
+  {
+    if (pthread_create(
+            &threads[started_threads_count],
+            null_ptr,
+            _sc_dictionary_fs_memory_verify_strings_channels_by_worker,
+            &verifying)
+        != 0)
+      break;
+  }
+
+  _sc_dictionary_fs_memory_verify_strings_channels_by_worker(&verifying);
+  for (sc_uint32 i = 1; i < started_threads_count; ++i)
+    pthread_join(threads[i], null_ptr);
+  sc_mem_free(threads);
+
+  *corrupted_count = verifying.corrupted_count;
+  if (*corrupted_count == 0)
+    sc_fs_memory_info("Strings channels verified");
+  return SC_FS_MEMORY_OK;
+}
+
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_verify(
+    sc_dictionary_fs_memory * memory,
+    sc_uint32 * corrupted_count)
+{
+  *corrupted_count = 0;
+  if (memory == null_ptr)
+  {
+    sc_fs_memory_info("Memory is empty to verify strings");
+    return SC_FS_MEMORY_NO;
+  }
+
+  return _sc_dictionary_fs_memory_verify_strings_channels(memory, corrupted_count);
+}
+
+sc_bool _sc_dictionary_fs_memory_sample_term(sc_dictionary_node * node, void ** arguments)
+{
+  if (node->data == null_ptr)
+    return SC_TRUE;
+
+  sc_char const ** terms = arguments[0];
+  sc_uint32 * terms_count = arguments[1];
+  terms[(*terms_count)++] = ((sc_list *)node->data)->begin->data;
+  return *terms_count < SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT;
+}
+
+sc_bool _sc_dictionary_fs_memory_sample_link_hash(sc_dictionary_node * node, void ** arguments)
+{
+  sc_list * link_hashes = node->data;
+  if (link_hashes == null_ptr || link_hashes->size == 0)
+    return SC_TRUE;
+
+  sc_addr_hash * sampled_link_hashes = arguments[0];
+  sc_uint32 * link_hashes_count = arguments[1];
+  sampled_link_hashes[(*link_hashes_count)++] = (sc_pointer_to_sc_addr_hash)link_hashes->begin->data;
+  return *link_hashes_count < SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT;
+}
+
+void _sc_dictionary_fs_memory_log_index(
+    sc_char const * name,
+    sc_dictionary * dictionary,
+    sc_char const ** keys,
+    sc_uint32 const keys_count)
+{
+  sc_uint64 strings_count;
+  sc_uint64 memory_size;
+  sc_dictionary_get_memory_size(dictionary, &strings_count, &memory_size);
+
+  sc_int64 const begin_time = g_get_monotonic_time();
+  for (sc_uint32 round = 0; round < SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_ROUNDS; ++round)
+  {
+    for (sc_uint32 i = 0; i < keys_count; ++i)
+      sc_dictionary_get_by_key(dictionary, keys[i], sc_str_len(keys[i]));
+  }
+  sc_int64 const lookups_time = g_get_monotonic_time() - begin_time;
+  sc_uint64 const lookups_count = (sc_uint64)keys_count * SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_ROUNDS;
+
+  sc_message(
+      "	%s: %" PRIu64 " keys, %.2f MB, %.1f ns per lookup",
+      name,
+      strings_count,
+      (double)memory_size / (1024 * 1024),
+      lookups_count == 0 ? 0.0 : (double)lookups_time * 1000 / lookups_count);
+}
+
+/*! Logs count of keys, size of memory and average lookup time of every index of sc-link contents. Lookup time is
+ * measured by keys sampled from indexes.
+ * @param memory Loaded dictionary fs-memory
+ */
+void _sc_dictionary_fs_memory_log_indexes(sc_dictionary_fs_memory * memory)
+{
+  sc_fs_memory_info("Link contents indexes (%s):", memory->link_contents_index);
+
+  sc_char const ** keys = sc_mem_new(sc_char const *, SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT);
+  sc_uint32 keys_count = 0;
+  void * arguments[2];
+  arguments[0] = keys;
+  arguments[1] = &keys_count;
+  sc_dictionary_visit_down_nodes(
+      memory->terms_string_offsets_dictionary, _sc_dictionary_fs_memory_sample_term, arguments);
+  _sc_dictionary_fs_memory_log_index("Terms", memory->terms_string_offsets_dictionary, keys, keys_count);
+
+  sc_addr_hash * link_hashes = sc_mem_new(sc_addr_hash, SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT);
+  sc_uint32 link_hashes_count = 0;
+  arguments[0] = link_hashes;
+  arguments[1] = &link_hashes_count;
+  sc_dictionary_visit_down_nodes(
+      memory->string_offsets_link_hashes_dictionary, _sc_dictionary_fs_memory_sample_link_hash, arguments);
+
+  // keys of link hashes and string offsets are their decimal numbers
+  sc_char * link_hashes_keys =
+      sc_mem_new(sc_char, SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT * DEFAULT_STRING_INT_SIZE);
+  sc_char * string_offsets_keys =
+      sc_mem_new(sc_char, SC_DICTIONARY_FS_MEMORY_INDEX_SAMPLES_COUNT * DEFAULT_STRING_INT_SIZE);
+  sc_uint32 string_offsets_count = 0;
+  for (sc_uint32 i = 0; i < link_hashes_count; ++i)
+  {
+    sc_uint64 key_size;
+    sc_char * link_hash_key = link_hashes_keys + i * DEFAULT_STRING_INT_SIZE;
+    sc_int_to_str_int(link_hashes[i], link_hash_key, key_size);
+    keys[i] = link_hash_key;
+
+    sc_uint64 const string_offset = _sc_dictionary_fs_memory_get_link_string_offset(memory, link_hashes[i]);
+    if (string_offset != INVALID_STRING_OFFSET)
+    {
+      sc_char * string_offset_key = string_offsets_keys + string_offsets_count * DEFAULT_STRING_INT_SIZE;
+      sc_int_to_str_int(string_offset, string_offset_key, key_size);
+      ++string_offsets_count;
+    }
+    (void)key_size;
+  }
+  _sc_dictionary_fs_memory_log_index(
+      "Link hashes", memory->link_hashes_string_offsets_dictionary, keys, link_hashes_count);
+
+  for (sc_uint32 i = 0; i < string_offsets_count; ++i)
+    keys[i] = string_offsets_keys + i * DEFAULT_STRING_INT_SIZE;
+  _sc_dictionary_fs_memory_log_index(
+      "String offsets", memory->string_offsets_link_hashes_dictionary, keys, string_offsets_count);
+
+  sc_mem_free(string_offsets_keys);
+  sc_mem_free(link_hashes_keys);
+  sc_mem_free(link_hashes);
+  sc_mem_free(keys);
+}
+
 sc_dictionary_fs_memory_status sc_dictionary_fs_memory_load(sc_dictionary_fs_memory * memory)
 {
   if (memory == null_ptr)
@@ -1426,6 +2122,17 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_load(sc_dictionary_fs_mem
 
   _sc_dictionary_fs_memory_load_string_offsets_link_hashes(memory);
 
+  if (memory->string_trigrams != null_ptr)
+    _sc_dictionary_fs_memory_load_string_trigrams(memory);
+
+  // corrupted strings are reported, but they don't fail loading of other sc-link contents
+  sc_uint32 corrupted_channels_count;
+  _sc_dictionary_fs_memory_verify_strings_channels(memory, &corrupted_channels_count);
+  if (corrupted_channels_count != 0)
+    sc_fs_memory_error("Corrupted strings channels: %d. Some sc-link contents may be wrong", corrupted_channels_count);
+
+  _sc_dictionary_fs_memory_log_indexes(memory);
+
   sc_fs_memory_info("All sc-fs-memory dictionaries loaded");
 
   return SC_FS_MEMORY_OK;
@@ -1600,7 +2307,112 @@ sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_save_string_offsets_link
   return SC_FS_MEMORY_OK;
 }
 
-sc_dictionary_fs_memory_status sc_dictionary_fs_memory_save(sc_dictionary_fs_memory const * memory)
+/*! Saves checksums of strings channels. Strings are only appended to strings channels, so checksums of saved bytes
+ * are continued by bytes appended after the previous dump instead of reading of whole strings channels.
+ * @param memory A pointer to file memory
+ * @returns SC_FS_MEMORY_OK, if checksums are saved.
+ */
+sc_dictionary_fs_memory_status _sc_dictionary_fs_memory_save_strings_checksums(sc_dictionary_fs_memory * memory)
+{
+  // channel of the last string offset may be not created yet, it is saved with empty checksum
+  sc_uint32 const channels_count =
+      memory->last_string_offset == 0
+          ? 0
+          : sc_min(memory->max_strings_channels, memory->last_string_offset / memory->max_strings_channel_size + 1);
+  sc_uint64 * sizes = channels_count == 0 ? null_ptr : sc_mem_new(sc_uint64, channels_count);
+
+  // strings aren't written while buffered strings are flushed and sizes of strings channels are fixed
+  sc_monitor_acquire_read(&memory->monitor);
+  for (sc_uint32 idx = 0; idx < channels_count; ++idx)
+  {
+    sc_io_channel * channel = memory->strings_channels[idx];
+    if (channel != null_ptr)
+    {
+      sc_monitor * channel_monitor =
+          sc_monitor_table_get_monitor_from_table(&memory->strings_channels_monitors_table, (sc_pointer)(sc_uint64)idx);
+      sc_monitor_acquire_write(channel_monitor);
+      sc_io_channel_flush(channel, null_ptr);
+      sc_monitor_release_write(channel_monitor);
+    }
+
+    sc_char * strings_path = _sc_dictionary_fs_memory_get_strings_channel_path(memory, idx);
+    sizes[idx] = sc_fs_get_file_size(strings_path);
+    sc_mem_free(strings_path);
+  }
+  sc_monitor_release_read(&memory->monitor);
+
+  sc_dictionary_fs_memory_status status = SC_FS_MEMORY_OK;
+  for (sc_uint32 idx = 0; idx < channels_count; ++idx)
+  {
+    sc_dictionary_fs_memory_strings_checksum * checksum = &memory->strings_checksums[idx];
+    // strings channel is cleared after the previous dump
+    if (sizes[idx] < checksum->size)
+    {
+      checksum->size = 0;
+      checksum->checksum = 0;
+    }
+
+    sc_char * strings_path = _sc_dictionary_fs_memory_get_strings_channel_path(memory, idx);
+    if (sc_fs_memory_checksum_file(strings_path, checksum->size, sizes[idx], &checksum->checksum) == SC_FALSE)
+    {
+      sc_fs_memory_error("Can't read strings channel `%s` to calculate its checksum", strings_path);
+      checksum->size = 0;
+      checksum->checksum = 0;
+      status = SC_FS_MEMORY_READ_ERROR;
+    }
+    else
+      checksum->size = sizes[idx];
+    sc_mem_free(strings_path);
+  }
+  sc_mem_free(sizes);
+  if (status != SC_FS_MEMORY_OK)
+    return status;
+
+  sc_io_channel * channel = sc_io_new_write_channel(memory->strings_checksums_path, null_ptr);
+  sc_io_channel_set_encoding(channel, null_ptr, null_ptr);
+
+  sc_uint64 written_bytes = 0;
+  if (sc_io_channel_write_chars(channel, (sc_char *)&channels_count, sizeof(sc_uint32), &written_bytes, null_ptr)
+          != SC_FS_IO_STATUS_NORMAL
+      || sizeof(sc_uint32) != written_bytes)
+  {
+    sc_fs_memory_error("Error while attribute `channels_count` writing");
+    goto error;
+  }
+
+  for (sc_uint32 idx = 0; idx < channels_count; ++idx)
+  {
+    sc_dictionary_fs_memory_strings_checksum const * checksum = &memory->strings_checksums[idx];
+    if (sc_io_channel_write_chars(channel, (sc_char *)&checksum->size, sizeof(sc_uint64), &written_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || sizeof(sc_uint64) != written_bytes)
+    {
+      sc_fs_memory_error("Error while attribute `size` writing");
+      goto error;
+    }
+
+    if (sc_io_channel_write_chars(
+            channel, (sc_char *)&checksum->checksum, sizeof(sc_uint32), &written_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || sizeof(sc_uint32) != written_bytes)
+    {
+      sc_fs_memory_error("Error while attribute `checksum` writing");
+      goto error;
+    }
+  }
+
+  sc_io_channel_shutdown(channel, SC_TRUE, null_ptr);
+  sc_fs_memory_info("Checksums of strings channels written");
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  sc_io_channel_shutdown(channel, SC_TRUE, null_ptr);
+  return SC_FS_MEMORY_WRITE_ERROR;
+}
+}
+
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_save(sc_dictionary_fs_memory * memory)
 {
   if (memory == null_ptr)
   {
@@ -1617,6 +2429,10 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_save(sc_dictionary_fs_mem
   if (status != SC_FS_MEMORY_OK)
     return status;
 
+  status = _sc_dictionary_fs_memory_save_strings_checksums(memory);
+  if (status != SC_FS_MEMORY_OK)
+    return status;
+
   sc_message("\tLast string offset: %" PRIu64, memory->last_string_offset);
 
   sc_fs_memory_info("All sc-fs-memory dictionaries saved");
@@ -82,6 +82,17 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_unlink_string(
     sc_dictionary_fs_memory * memory,
     sc_addr_hash link_hash);
 
+/*! Moves sc-link content string to another sc-link hash. Sc-links with the moved content are found by new sc-link hash.
+ * @param memory A pointer to file memory
+ * @param link_hash A sc-link hash with content string
+ * @param new_link_hash A sc-link hash without content string
+ * @returns SC_FS_MEMORY_OK, if are no reading and writing errors.
+ */
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_move_link_string(
+    sc_dictionary_fs_memory * memory,
+    sc_addr_hash link_hash,
+    sc_addr_hash new_link_hash);
+
 /*! Gets sc-link content string with its size by sc-link hash.
  * @param memory A pointer to file memory
  * @param link_hash A sc-link hash
@@ -95,6 +106,20 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_string_by_link_hash(
     sc_char ** string,
     sc_uint64 * string_size);
 
+/*! Gets stream of sc-link content by sc-link hash. The stream reads content directly from mapping of strings channel
+ * without copying of it, if the content isn't path to file and it fits in mapping of strings channel. Otherwise, the
+ * stream owns content got by `sc_dictionary_fs_memory_get_string_by_link_hash`.
+ * @param memory A pointer to file memory
+ * @param link_hash A sc-link hash
+ * @param[out] stream A stream of sc-link content, or null_ptr if there is no content
+ * @returns SC_FS_MEMORY_OK, if are no reading errors, or SC_FS_MEMORY_NO_STRING if sc-link has no content.
+ * @note The stream is valid until file memory is shutdown.
+ */
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_get_stream_by_link_hash(
+    sc_dictionary_fs_memory * memory,
+    sc_addr_hash link_hash,
+    sc_stream ** stream);
+
 /*! Function that retrieves sc-link hashes by a full string term from the file memory.
  * @param memory Pointer to the file memory.
  * @param string Pointer to the full string term.
@@ -223,6 +248,15 @@ sc_dictionary_fs_memory_status sc_dictionary_fs_memory_load(sc_dictionary_fs_mem
  * @param memory A pointer to file memory
  * @returns SC_FS_MEMORY_OK, if are no reading and writing errors.
  */
-sc_dictionary_fs_memory_status sc_dictionary_fs_memory_save(sc_dictionary_fs_memory const * memory);
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_save(sc_dictionary_fs_memory * memory);
+
+/*! Verify checksums of strings channels saved in file system without loading of dictionaries
+ * @param memory A pointer to file memory
+ * @param[out] corrupted_count Count of corrupted strings channels
+ * @returns SC_FS_MEMORY_OK, if checksums of strings channels are read or if they aren't saved yet.
+ */
+sc_dictionary_fs_memory_status sc_dictionary_fs_memory_verify(
+    sc_dictionary_fs_memory * memory,
+    sc_uint32 * corrupted_count);
 
 #endif  //_sc_dictionary_fs_memory_h_
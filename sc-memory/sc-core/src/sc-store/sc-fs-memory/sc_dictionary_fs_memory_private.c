@@ -26,8 +26,13 @@ void _sc_uchar_dictionary_sc_char_to_sc_int(sc_char ch, sc_uint8 * ch_num, sc_ui
   *ch_num = 128 + (sc_uint8)ch;
 }
 
-sc_bool _sc_uchar_dictionary_initialize(sc_dictionary ** dictionary)
+sc_bool _sc_uchar_dictionary_initialize(sc_dictionary ** dictionary, sc_char const * index)
 {
+  if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_HASH))
+    return sc_dictionary_initialize_hashed(dictionary);
+  if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_ART))
+    return sc_dictionary_initialize_art(dictionary);
+
   return sc_dictionary_initialize(
       dictionary, _sc_uchar_dictionary_children_size(), _sc_uchar_dictionary_sc_char_to_sc_int);
 }
@@ -45,8 +50,13 @@ void _sc_number_dictionary_sc_char_to_sc_int(sc_char ch, sc_uint8 * ch_num, sc_u
   *ch_num = (sc_uint8)ch - '0';
 }
 
-sc_bool _sc_number_dictionary_initialize(sc_dictionary ** dictionary)
+sc_bool _sc_number_dictionary_initialize(sc_dictionary ** dictionary, sc_char const * index)
 {
+  if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_HASH))
+    return sc_dictionary_initialize_hashed(dictionary);
+  if (sc_str_cmp(index, SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_ART))
+    return sc_dictionary_initialize_art(dictionary);
+
   return sc_dictionary_initialize(
       dictionary, _sc_number_dictionary_children_size(), _sc_number_dictionary_sc_char_to_sc_int);
 }
@@ -88,6 +98,7 @@ sc_memory_params * _sc_dictionary_fs_memory_get_default_params(sc_char const * p
   params->max_searchable_string_size = DEFAULT_MAX_SEARCHABLE_STRING_SIZE;
   params->term_separators = DEFAULT_TERM_SEPARATORS;
   params->search_by_substring = DEFAULT_SEARCH_BY_SUBSTRING;
+  params->link_contents_index = DEFAULT_LINK_CONTENTS_INDEX;
 
   return params;
 }
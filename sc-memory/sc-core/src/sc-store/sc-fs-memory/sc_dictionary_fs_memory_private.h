@@ -18,14 +18,27 @@
 #include "sc-store/sc-base/sc_monitor_table_private.h"
 #include "sc-store/sc-base/sc_message.h"
 
+#include "sc_fs_memory_trigrams.h"
+
 #define SC_FS_EXT ".scdb"
 #define INVALID_STRING_OFFSET LONG_MAX
 
+#define SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_DICTIONARY "Dictionary"
+#define SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_HASH "Hash"
+#define SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_ART "ART"
+
 #define SC_FS_MEMORY_PREFIX "[sc-fs-memory] "
 #define sc_fs_memory_info(...) sc_message(SC_FS_MEMORY_PREFIX __VA_ARGS__)
 #define sc_fs_memory_warning(...) sc_warning(SC_FS_MEMORY_PREFIX __VA_ARGS__)
 #define sc_fs_memory_error(...) sc_critical(SC_FS_MEMORY_PREFIX __VA_ARGS__)
 
+//! Checksum of bytes of strings channel saved by the last dump
+typedef struct
+{
+  sc_uint64 size;  // count of bytes from the beginning of strings channel
+  sc_uint32 checksum;
+} sc_dictionary_fs_memory_strings_checksum;
+
 struct _sc_dictionary_fs_memory
 {
   sc_char * path;  // path to all dictionary files
@@ -36,26 +49,35 @@ struct _sc_dictionary_fs_memory
   sc_uint32 max_searchable_string_size;  // maximal size of strings that can be found by string/substring
   sc_char const * term_separators;
   sc_bool search_by_substring;
+  sc_char const * link_contents_index;  // kind of indexes of strings, terms and link hashes, it is one of
+                                        // SC_DICTIONARY_FS_MEMORY_LINK_CONTENTS_INDEX_*
 
   void ** strings_channels;
+  sc_char ** strings_regions;  // read-only mappings of strings channels, strings are read from them without copying
   sc_monitor_table strings_channels_monitors_table;
   sc_uint64 last_string_offset;  // last offset of string in 'string_path`
   sc_monitor monitor;
   sc_monitor resolve_string_offset_monitor;
 
+  sc_char * strings_checksums_path;                              // path to file with checksums of strings channels
+  sc_dictionary_fs_memory_strings_checksum * strings_checksums;  // checksums of strings channels saved by last dump
+  sc_uint32 strings_threads_count;                               // count of threads to verify strings channels
+
   sc_char * terms_string_offsets_path;              // path to dictionary file with terms and its strings offsets
   sc_dictionary * terms_string_offsets_dictionary;  // dictionary instance with terms and its strings offsets
+  sc_fs_memory_trigrams * string_trigrams;  // index of searchable strings by trigrams, if search by substring is on
 
   sc_char * string_offsets_link_hashes_path;  // path to dictionary file with strings offsets and its link hashes
   sc_dictionary *
       string_offsets_link_hashes_dictionary;  // dictionary instance with strings offsets and its link hashes
   sc_dictionary *
       link_hashes_string_offsets_dictionary;  // dictionary instance with link hashes and its strings offsets
+  sc_pointer ** link_string_offsets;  // pages of string offsets of link hashes by their segments, read without locks
 };
 
-sc_bool _sc_uchar_dictionary_initialize(sc_dictionary ** dictionary);
+sc_bool _sc_uchar_dictionary_initialize(sc_dictionary ** dictionary, sc_char const * index);
 
-sc_bool _sc_number_dictionary_initialize(sc_dictionary ** dictionary);
+sc_bool _sc_number_dictionary_initialize(sc_dictionary ** dictionary, sc_char const * index);
 
 void _sc_dictionary_fs_memory_node_clear(sc_dictionary_node * node);
 
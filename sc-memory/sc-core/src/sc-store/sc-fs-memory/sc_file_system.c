@@ -87,6 +87,15 @@ sc_bool sc_fs_is_file(sc_char const * path)
   return g_file_test(path, G_FILE_TEST_IS_REGULAR);
 }
 
+sc_uint64 sc_fs_get_file_size(sc_char const * path)
+{
+  GStatBuf stat_buf;
+  if (g_stat(path, &stat_buf) != 0)
+    return 0;
+
+  return stat_buf.st_size;
+}
+
 sc_bool sc_fs_is_binary_file(sc_char const * file_path)
 {
   sc_char command_prefix[] = SC_FS_FILE_COMMAND;
@@ -19,6 +19,8 @@ sc_bool sc_fs_rename_file(sc_char const * old_path, sc_char const * new_path);
 
 sc_bool sc_fs_is_file(sc_char const * path);
 
+sc_uint64 sc_fs_get_file_size(sc_char const * path);
+
 sc_bool sc_fs_is_binary_file(sc_char const * file_path);
 
 void sc_fs_get_file_content(sc_char const * file_path, sc_char ** content, sc_uint32 * content_size);
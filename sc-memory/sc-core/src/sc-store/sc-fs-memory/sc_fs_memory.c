@@ -8,15 +8,41 @@
 #include "sc_fs_memory_builder.h"
 
 #include "sc_file_system.h"
+#include "sc_fs_memory_checksum.h"
 #include "sc_dictionary_fs_memory_private.h"
 
 #include "sc-store/sc_segment.h"
+#include "sc-store/sc_segment_allocator.h"
+#include "sc-store/sc_segment_pager.h"
 #include "sc-store/sc_storage_private.h"
 
 #include "sc_io.h"
 
+#include "sc-core/sc-container/sc_string.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "sc-store/sc-base/sc_mutex_private.h"
+#include "sc-store/sc-base/sc_condition_private.h"
+
+#ifdef SC_FS_MEMORY_LZ4
+#  include <lz4.h>
+#endif
+
 sc_fs_memory_manager * manager;
 
+void _sc_fs_memory_log_segments_progress(
+    sc_char const * action,
+    sc_addr_seg processed_count,
+    sc_addr_seg segments_count)
+{
+  // progress is logged every 25 percent
+  if (processed_count * 4 / segments_count != (processed_count - 1) * 4 / segments_count)
+    sc_message("\t%s sc-segments: %d of %d", action, processed_count, segments_count);
+}
+
 sc_fs_memory_status sc_fs_memory_initialize_ext(sc_memory_params const * params)
 {
   manager = sc_fs_memory_build();
@@ -31,6 +57,35 @@ sc_fs_memory_status sc_fs_memory_initialize_ext(sc_memory_params const * params)
 
   static sc_char const * segments_postfix = "segments" SC_FS_EXT;
   sc_fs_concat_path(manager->path, segments_postfix, &manager->segments_path);
+  static sc_char const * deltas_postfix = "segments_deltas" SC_FS_EXT;
+  sc_fs_concat_path(manager->path, deltas_postfix, &manager->deltas_path);
+
+  manager->max_deltas_count = params->dump_memory_deltas_count;
+  manager->deltas_count = 0;
+  manager->is_strings_dirty = SC_FALSE;
+  sc_monitor_init(&manager->dump_monitor);
+
+  // sc-segments are loaded and saved by the same count of threads as sc-events are processed
+  manager->segments_threads_count = params->limit_max_threads_by_max_physical_cores
+                                        ? sc_boundary(params->max_events_and_agents_threads, 1, g_get_num_processors())
+                                        : sc_max(1, params->max_events_and_agents_threads);
+  manager->segments_progress = _sc_fs_memory_log_segments_progress;
+
+  sc_char const * compression = params->dump_memory_compression;
+  manager->segments_compression = SC_FS_MEMORY_SEGMENTS_COMPRESSION_NONE;
+  if (compression != null_ptr && sc_str_cmp(compression, SC_FS_MEMORY_COMPRESSION_LZ4))
+  {
+#ifdef SC_FS_MEMORY_LZ4
+    manager->segments_compression = SC_FS_MEMORY_SEGMENTS_COMPRESSION_LZ4;
+#else
+    sc_fs_memory_warning("Sc-machine is built without LZ4, so sc-memory segments aren't compressed");
+#endif
+  }
+  else if (compression != null_ptr && sc_str_cmp(compression, SC_FS_MEMORY_COMPRESSION_NONE) == SC_FALSE)
+    sc_fs_memory_warning("Unknown compression of sc-memory segments `%s`, they aren't compressed", compression);
+
+  manager->skip_corrupted_segments = params->skip_corrupted_segments;
+  manager->skipped_segments_count = 0;
 
   if (manager->initialize(&manager->fs_memory, params) != SC_FS_MEMORY_OK)
     return SC_FS_MEMORY_NO;
@@ -41,6 +96,8 @@ sc_fs_memory_status sc_fs_memory_initialize_ext(sc_memory_params const * params)
     sc_fs_memory_info("Clear sc-memory segments");
     if (sc_fs_remove_file(manager->segments_path) == SC_FALSE)
       sc_fs_memory_info("Can't remove segments file: %s", manager->segments_path);
+    if (sc_fs_is_file(manager->deltas_path) && sc_fs_remove_file(manager->deltas_path) == SC_FALSE)
+      sc_fs_memory_info("Can't remove segments deltas file: %s", manager->deltas_path);
   }
 
   return SC_FS_MEMORY_OK;
@@ -58,16 +115,23 @@ sc_fs_memory_status sc_fs_memory_shutdown()
 {
   sc_fs_memory_status const result = manager->shutdown(manager->fs_memory);
   sc_mem_free(manager->segments_path);
+  sc_mem_free(manager->deltas_path);
+  sc_monitor_destroy(&manager->dump_monitor);
   sc_mem_free(manager);
   return result;
 }
 
+void sc_fs_memory_set_segments_progress_callback(sc_fs_memory_segments_progress_callback callback)
+{
+  manager->segments_progress = callback;
+}
+
 sc_fs_memory_status sc_fs_memory_link_string(
     sc_addr_hash const link_hash,
     sc_char const * string,
     sc_uint32 const string_size)
 {
-  return manager->link_string(manager->fs_memory, link_hash, string, string_size, SC_TRUE);
+  return sc_fs_memory_link_string_ext(link_hash, string, string_size, SC_TRUE);
 }
 
 sc_fs_memory_status sc_fs_memory_link_string_ext(
@@ -76,7 +140,10 @@ sc_fs_memory_status sc_fs_memory_link_string_ext(
     sc_uint32 const string_size,
     sc_bool is_searchable_string)
 {
-  return manager->link_string(manager->fs_memory, link_hash, string, string_size, is_searchable_string);
+  sc_fs_memory_status const status =
+      manager->link_string(manager->fs_memory, link_hash, string, string_size, is_searchable_string);
+  g_atomic_int_set(&manager->is_strings_dirty, SC_TRUE);
+  return status;
 }
 
 sc_fs_memory_status sc_fs_memory_get_string_by_link_hash(
@@ -90,6 +157,11 @@ sc_fs_memory_status sc_fs_memory_get_string_by_link_hash(
   return result;
 }
 
+sc_fs_memory_status sc_fs_memory_get_stream_by_link_hash(sc_addr_hash const link_hash, sc_stream ** stream)
+{
+  return manager->get_stream_by_link_hash(manager->fs_memory, link_hash, stream);
+}
+
 sc_fs_memory_status sc_fs_memory_get_link_hashes_by_string(
     sc_char const * string,
     sc_uint32 const string_size,
@@ -123,309 +195,1680 @@ sc_fs_memory_status sc_fs_memory_get_strings_by_substring(
 
 sc_fs_memory_status sc_fs_memory_unlink_string(sc_addr_hash link_hash)
 {
-  return manager->unlink_string(manager->fs_memory, link_hash);
+  sc_fs_memory_status const status = manager->unlink_string(manager->fs_memory, link_hash);
+  g_atomic_int_set(&manager->is_strings_dirty, SC_TRUE);
+  return status;
 }
 
-// read, write and save methods
-sc_fs_memory_status _sc_fs_memory_load_sc_memory_segments(sc_storage * storage)
+sc_fs_memory_status sc_fs_memory_move_link_string(sc_addr_hash link_hash, sc_addr_hash new_link_hash)
 {
-  if (sc_fs_is_file(manager->segments_path) == SC_FALSE)
-  {
-    storage->segments_count = 0;
-    sc_fs_memory_info("There are no sc-memory segments in %s", manager->segments_path);
-    return SC_FS_MEMORY_OK;
-  }
+  sc_fs_memory_status const status = manager->move_link_string(manager->fs_memory, link_hash, new_link_hash);
+  g_atomic_int_set(&manager->is_strings_dirty, SC_TRUE);
+  return status;
+}
 
-  // open segments
-  sc_io_channel * segments_channel = sc_io_new_read_channel(manager->segments_path, null_ptr);
-  sc_io_channel_set_encoding(segments_channel, null_ptr, null_ptr);
+// read, write and save methods
+// Alignment of segments in segments file, it is multiple of page sizes of common platforms
+#define SC_FS_MEMORY_SEGMENTS_ALIGNMENT (64 * 1024)
 
-  if (sc_fs_memory_header_read(segments_channel, &manager->header) != SC_FS_MEMORY_OK)
-    goto error;
-  storage->segments_count = manager->header.size;
+sc_uint64 _sc_fs_memory_align(sc_uint64 size, sc_uint64 alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
 
-  // backward compatibility with version 0.7.0
+sc_bool _sc_fs_memory_read(sc_io_channel * channel, void * data, sc_uint64 size, sc_uint64 * offset)
+{
   sc_uint64 read_bytes = 0;
-  sc_bool is_no_deprecated_segments = storage->segments_count == 0;
-  if (is_no_deprecated_segments)
-    sc_fs_memory_info("Load sc-memory segments from %s", manager->segments_path);
-  else
-    sc_fs_memory_warning("Load deprecated sc-memory segments from %s", manager->segments_path);
+  if (sc_io_channel_read_chars(channel, (sc_char *)data, size, &read_bytes, null_ptr) != SC_FS_IO_STATUS_NORMAL
+      || read_bytes != size)
+    return SC_FALSE;
 
-  static sc_uint32 const OLD_SC_ELEMENT_SIZE = 36;
-  sc_uint32 element_size = is_no_deprecated_segments ? sizeof(sc_element) : OLD_SC_ELEMENT_SIZE;
-  if (is_no_deprecated_segments)
-  {
-    if (sc_io_channel_read_chars(
-            segments_channel, (sc_char *)&storage->segments_count, sizeof(sc_addr_seg), &read_bytes, null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || read_bytes != sizeof(sc_addr_seg))
-    {
-      storage->segments_count = 0;
-      sc_fs_memory_error("Error while attribute `storage->segments_count` reading");
-      goto error;
-    }
+  *offset += size;
+  return SC_TRUE;
+}
 
-    if (sc_io_channel_read_chars(
-            segments_channel,
-            (sc_char *)&storage->last_not_engaged_segment_num,
-            sizeof(sc_addr_seg),
-            &read_bytes,
-            null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || read_bytes != sizeof(sc_addr_seg))
-    {
-      storage->last_not_engaged_segment_num = 0;
-      sc_fs_memory_error("Error while attribute `storage->last_not_engaged_segment_num` reading");
-      goto error;
-    }
+sc_bool _sc_fs_memory_write(sc_io_channel * channel, void const * data, sc_uint64 size, sc_uint64 * offset)
+{
+  sc_uint64 written_bytes = 0;
+  if (sc_io_channel_write_chars(channel, data, size, &written_bytes, null_ptr) != SC_FS_IO_STATUS_NORMAL
+      || written_bytes != size)
+    return SC_FALSE;
 
-    if (sc_io_channel_read_chars(
-            segments_channel,
-            (sc_char *)&storage->last_released_segment_num,
-            sizeof(sc_addr_seg),
-            &read_bytes,
-            null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || read_bytes != sizeof(sc_addr_seg))
-    {
-      storage->last_released_segment_num = 0;
-      sc_fs_memory_error("Error while attribute `storage->last_released_segment_num` reading");
-      goto error;
-    }
-  }
+  *offset += size;
+  return SC_TRUE;
+}
 
-  sc_version read_version;
-  sc_version_from_int(manager->header.version, &read_version);
-  if (sc_version_compare(&manager->version, &read_version) == -1)
+sc_bool _sc_fs_memory_read_at(sc_int32 fd, void * data, sc_uint64 size, sc_uint64 offset)
+{
+  sc_char * bytes = data;
+  while (size > 0)
   {
-    sc_char * version = sc_version_string_new(&read_version);
-    sc_fs_memory_error("Read sc-memory segments has incompatible version %s", version);
-    sc_version_string_free(version);
-    goto error;
+    ssize_t const read_bytes = pread(fd, bytes, size, (off_t)offset);
+    if (read_bytes < 0 && errno == EINTR)
+      continue;
+    if (read_bytes <= 0)
+      return SC_FALSE;
+
+    bytes += read_bytes;
+    offset += read_bytes;
+    size -= read_bytes;
   }
 
-  for (sc_addr_seg i = 0; i < storage->segments_count; ++i)
+  return SC_TRUE;
+}
+
+sc_bool _sc_fs_memory_write_at(sc_int32 fd, void const * data, sc_uint64 size, sc_uint64 offset)
+{
+  sc_char const * bytes = data;
+  while (size > 0)
   {
-    sc_addr_seg const num = i;
-    sc_segment * seg = sc_segment_new(i + 1);
-    storage->segments[i] = seg;
+    ssize_t const written_bytes = pwrite(fd, bytes, size, (off_t)offset);
+    if (written_bytes < 0 && errno == EINTR)
+      continue;
+    if (written_bytes <= 0)
+      return SC_FALSE;
 
-    for (sc_addr_seg j = 0; j < SC_SEGMENT_ELEMENTS_COUNT; ++j)
-    {
-      if (sc_io_channel_read_chars(segments_channel, (sc_char *)&seg->elements[j], element_size, &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || read_bytes != element_size)
-      {
-        storage->segments_count = num;
-        sc_fs_memory_error("Error while sc-element %d in sc-segment %d reading", j, i);
-        goto error;
-      }
+    bytes += written_bytes;
+    offset += written_bytes;
+    size -= written_bytes;
+  }
 
-      // needed for sc-template search
-      if (!is_no_deprecated_segments)
-      {
-        seg->elements[j].incoming_arcs_count = 1;
-        seg->elements[j].outgoing_arcs_count = 1;
-      }
-    }
+  return SC_TRUE;
+}
 
-    if (is_no_deprecated_segments)
-    {
-      if (sc_io_channel_read_chars(
-              segments_channel, (sc_char *)&seg->last_engaged_offset, sizeof(sc_addr_offset), &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || read_bytes != sizeof(sc_addr_offset))
-      {
-        sc_fs_memory_error("Error while sc-segment %d reading", i);
-        goto error;
-      }
+// Count of staging buffers of sc-segments, one of them is copied while others are written
+#define SC_FS_MEMORY_STAGING_BUFFERS_COUNT 2
+// Size of buffer of channel to write sc-segments, so copies of sc-segments are written by large chunks
+#define SC_FS_MEMORY_SEGMENTS_WRITE_BUFFER_SIZE (1024 * 1024)
 
-      if (sc_io_channel_read_chars(
-              segments_channel, (sc_char *)&seg->last_released_offset, sizeof(sc_addr_offset), &read_bytes, null_ptr)
-              != SC_FS_IO_STATUS_NORMAL
-          || read_bytes != sizeof(sc_addr_offset))
-      {
-        sc_fs_memory_error("Error while sc-segment %d reading", i);
-        goto error;
-      }
-    }
+//! Copy of sc-segment with its attributes
+typedef struct
+{
+  sc_char * data;
+  sc_uint64 size;
+} sc_fs_memory_staging_buffer;
 
-    i = num;
-  }
+/*! Writer of sc-segments copied to staging buffers. Sc-segments are copied under short locks of their monitors and
+ * written by thread of writer, so neither sc-memory changes nor copying of the next sc-segments wait for file I/O.
+ */
+typedef struct
+{
+  sc_io_channel * channel;
+  sc_uint64 offset;
+  sc_fs_memory_staging_buffer buffers[SC_FS_MEMORY_STAGING_BUFFERS_COUNT];
+  sc_uint32 filled_count;   // count of staging buffers passed to thread of writer
+  sc_uint32 written_count;  // count of staging buffers written by thread of writer
+  sc_bool is_finished;
+  sc_bool is_failed;
+  sc_mutex mutex;
+  sc_condition condition;
+  pthread_t thread;
+} sc_fs_memory_segments_writer;
 
-  sc_io_channel_shutdown(segments_channel, SC_FALSE, null_ptr);
+void * _sc_fs_memory_segments_writer_write(void * arg)
+{
+  sc_fs_memory_segments_writer * writer = arg;
 
-  sc_message("\tLoaded segments count: %d", storage->segments_count);
-  sc_message("\tSc-segments size: %ld", storage->segments_count * sizeof(sc_segment));
-  sc_message("\tLast not engaged segment num: %d", storage->last_not_engaged_segment_num);
-  sc_message("\tLast released segment num: %d", storage->last_released_segment_num);
+  sc_mutex_lock(&writer->mutex);
+  while (SC_TRUE)
+  {
+    while (writer->written_count == writer->filled_count && writer->is_finished == SC_FALSE)
+      sc_cond_wait(&writer->condition, &writer->mutex);
+    if (writer->written_count == writer->filled_count)
+      break;
 
-  if (is_no_deprecated_segments)
-    sc_fs_memory_info("Sc-memory segments loaded");
-  else
-    sc_fs_memory_warning("Deprecated sc-memory segments loaded");
+    sc_fs_memory_staging_buffer const * buffer =
+        &writer->buffers[writer->written_count % SC_FS_MEMORY_STAGING_BUFFERS_COUNT];
+    sc_bool const is_failed = writer->is_failed;
+    sc_mutex_unlock(&writer->mutex);
 
-  return SC_FS_MEMORY_OK;
+    sc_bool const is_written =
+        is_failed == SC_FALSE && _sc_fs_memory_write(writer->channel, buffer->data, buffer->size, &writer->offset);
 
-error:
-{
-  sc_io_channel_shutdown(segments_channel, SC_FALSE, null_ptr);
-  return SC_FS_MEMORY_READ_ERROR;
+    sc_mutex_lock(&writer->mutex);
+    if (is_written == SC_FALSE)
+      writer->is_failed = SC_TRUE;
+    ++writer->written_count;
+    sc_cond_broadcast(&writer->condition);
+  }
+  sc_mutex_unlock(&writer->mutex);
+
+  pthread_exit(null_ptr);
 }
+
+/*! Starts thread of writer of sc-segments.
+ * @param writer Pointer to writer
+ * @param channel Channel to write sc-segments
+ * @param offset Offset of channel
+ */
+void _sc_fs_memory_segments_writer_start(
+    sc_fs_memory_segments_writer * writer,
+    sc_io_channel * channel,
+    sc_uint64 offset)
+{
+  sc_uint64 capacity = 0;
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    capacity = sc_max(capacity, SC_SEG_ELEMENTS_SIZE_BYTE(pool));
+  // sc-addr, pool and offsets of lists of sc-segment precede its sc-elements in file of deltas
+  capacity += sizeof(sc_addr_seg) + sizeof(sc_uint8) + 2 * sizeof(sc_addr_offset);
+
+  *writer = (sc_fs_memory_segments_writer){0};
+  writer->channel = channel;
+  writer->offset = offset;
+  for (sc_uint32 idx = 0; idx < SC_FS_MEMORY_STAGING_BUFFERS_COUNT; ++idx)
+    writer->buffers[idx].data = sc_mem_new(sc_char, capacity);
+  sc_mutex_init(&writer->mutex);
+  sc_cond_init(&writer->condition);
+  pthread_create(&writer->thread, null_ptr, _sc_fs_memory_segments_writer_write, writer);
 }
 
-sc_fs_memory_status sc_fs_memory_load(sc_storage * storage)
+/*! Waits until one of staging buffers is written and returns it to copy the next sc-segment.
+ * @param writer Pointer to writer
+ * @returns Staging buffer with zero size, or null_ptr, if writing of sc-segments failed.
+ */
+sc_fs_memory_staging_buffer * _sc_fs_memory_segments_writer_get_buffer(sc_fs_memory_segments_writer * writer)
 {
-  if (_sc_fs_memory_load_sc_memory_segments(storage) != SC_FS_MEMORY_OK)
-    return SC_FS_MEMORY_READ_ERROR;
-  if (manager->load(manager->fs_memory) != SC_FS_MEMORY_OK)
-    return SC_FS_MEMORY_READ_ERROR;
+  sc_mutex_lock(&writer->mutex);
+  while (writer->filled_count - writer->written_count == SC_FS_MEMORY_STAGING_BUFFERS_COUNT
+         && writer->is_failed == SC_FALSE)
+    sc_cond_wait(&writer->condition, &writer->mutex);
+  sc_bool const is_failed = writer->is_failed;
+  sc_mutex_unlock(&writer->mutex);
 
-  return SC_FS_MEMORY_OK;
+  if (is_failed)
+    return null_ptr;
+
+  sc_fs_memory_staging_buffer * buffer = &writer->buffers[writer->filled_count % SC_FS_MEMORY_STAGING_BUFFERS_COUNT];
+  buffer->size = 0;
+  return buffer;
 }
 
-sc_fs_memory_status _sc_fs_memory_save_sc_memory_segments(sc_storage * storage)
+//! Passes the last staging buffer returned by `_sc_fs_memory_segments_writer_get_buffer` to thread of writer.
+void _sc_fs_memory_segments_writer_push_buffer(sc_fs_memory_segments_writer * writer)
 {
-  sc_fs_memory_info("Save sc-memory segments");
+  sc_mutex_lock(&writer->mutex);
+  ++writer->filled_count;
+  sc_cond_broadcast(&writer->condition);
+  sc_mutex_unlock(&writer->mutex);
+}
 
-  // create temporary file
-  sc_char * tmp_filename;
-  sc_io_channel * segments_channel = sc_fs_new_tmp_write_channel(manager->fs_memory->path, &tmp_filename, "segments");
-  sc_io_channel_set_encoding(segments_channel, null_ptr, null_ptr);
+/*! Waits until all staging buffers are written and stops thread of writer.
+ * @param writer Pointer to writer
+ * @param[out] offset Offset of channel after written sc-segments
+ * @returns SC_FALSE, if writing of sc-segments failed.
+ */
+sc_bool _sc_fs_memory_segments_writer_finish(sc_fs_memory_segments_writer * writer, sc_uint64 * offset)
+{
+  sc_mutex_lock(&writer->mutex);
+  writer->is_finished = SC_TRUE;
+  sc_cond_broadcast(&writer->condition);
+  sc_mutex_unlock(&writer->mutex);
+  pthread_join(writer->thread, null_ptr);
 
-  manager->header.size = 0;
-  manager->header.version = sc_version_to_int(&manager->version);
-  manager->header.timestamp = g_get_real_time();
-  if (sc_fs_memory_header_write(segments_channel, manager->header) != SC_FS_MEMORY_OK)
-    goto error;
+  for (sc_uint32 idx = 0; idx < SC_FS_MEMORY_STAGING_BUFFERS_COUNT; ++idx)
+    sc_mem_free(writer->buffers[idx].data);
+  sc_mutex_destroy(&writer->mutex);
+  sc_cond_destroy(&writer->condition);
 
-  sc_uint64 written_bytes;
-  if (sc_io_channel_write_chars(
-          segments_channel, (sc_char *)&storage->segments_count, sizeof(sc_addr_seg), &written_bytes, null_ptr)
-          != SC_FS_IO_STATUS_NORMAL
-      || written_bytes != sizeof(sc_addr_seg))
-  {
-    sc_fs_memory_error("Error while attribute `storage->segments_count` writing");
-    goto error;
-  }
+  *offset = writer->offset;
+  return writer->is_failed == SC_FALSE;
+}
 
-  if (sc_io_channel_write_chars(
-          segments_channel,
-          (sc_char *)&storage->last_not_engaged_segment_num,
-          sizeof(sc_addr_seg),
-          &written_bytes,
-          null_ptr)
-          != SC_FS_IO_STATUS_NORMAL
-      || written_bytes != sizeof(sc_addr_seg))
-  {
-    sc_fs_memory_error("Error while attribute `storage->last_not_engaged_segment_num` writing");
-    goto error;
-  }
+//! Appends data to staging buffer.
+void _sc_fs_memory_staging_buffer_append(sc_fs_memory_staging_buffer * buffer, void const * data, sc_uint64 size)
+{
+  sc_mem_cpy(buffer->data + buffer->size, data, size);
+  buffer->size += size;
+}
 
-  if (sc_io_channel_write_chars(
-          segments_channel,
-          (sc_char *)&storage->last_released_segment_num,
-          sizeof(sc_addr_seg),
-          &written_bytes,
-          null_ptr)
-          != SC_FS_IO_STATUS_NORMAL
-      || written_bytes != sizeof(sc_addr_seg))
+/*! Copies sc-elements of sc-segment to staging buffer under its monitor. The monitor is held only while sc-elements are
+ * copied, so sc-memory changes of sc-segment aren't blocked by writing of the copy.
+ * @param segment Pointer to sc-segment
+ * @param buffer Staging buffer
+ * @param[out] offsets Offsets of the last engaged and the last released sc-elements of sc-segment
+ */
+void _sc_fs_memory_capture_segment(
+    sc_segment * segment,
+    sc_fs_memory_staging_buffer * buffer,
+    sc_addr_offset * offsets)
+{
+  // the flag is reset before segment is copied, so its changes made during copying are written by the next dump
+  if (g_atomic_int_compare_and_exchange(&segment->is_dirty, SC_TRUE, SC_FALSE))
   {
-    sc_fs_memory_error("Error while attribute `storage->last_released_segment_num` writing");
-    goto error;
+    // changes of segment mapped from segments file stay in its memory only, so it isn't paged out anymore
+    if (segment->is_file_mapped)
+      g_atomic_int_set(&segment->is_changed, SC_TRUE);
   }
 
-  for (sc_addr_seg idx = 0; idx < storage->segments_count; ++idx)
-  {
-    sc_segment * segment = storage->segments[idx];
-    if (segment == null_ptr)
-    {
-      sc_fs_memory_error("Error while attribute `segment` writing");
-      goto error;
-    }
+  sc_monitor_acquire_read(&segment->monitor);
+  offsets[0] = segment->last_engaged_offset;
+  offsets[1] = segment->last_released_offset;
+  _sc_fs_memory_staging_buffer_append(
+      buffer, sc_segment_get_element(segment, 0), SC_SEG_ELEMENTS_SIZE_BYTE(segment->pool));
+  sc_monitor_release_read(&segment->monitor);
+  sc_segment_pager_release(segment);
+}
 
-    sc_monitor_acquire_read(&segment->monitor);
+/*! Processes sc-segment with specified index.
+ * @param data Data of processing
+ * @param staging Staging buffer of worker to copy sc-segment to, or null_ptr, if it isn't requested
+ * @param idx Index of sc-segment
+ * @returns SC_FALSE, if sc-segment can't be processed.
+ */
+typedef sc_bool (*sc_fs_memory_segment_processor)(void * data, sc_char * staging, sc_addr_seg idx);
 
-    if (sc_io_channel_write_chars(
-            segments_channel, (sc_char *)segment->elements, SC_SEG_ELEMENTS_SIZE_BYTE, &written_bytes, null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || written_bytes != SC_SEG_ELEMENTS_SIZE_BYTE)
-    {
-      sc_fs_memory_error("Error while attribute `segment->elements` writing");
-      goto segment_save_error;
-    }
+//! Processing of sc-segments by several workers. Workers take indices of the next sc-segments one by one.
+typedef struct
+{
+  sc_char const * action;
+  sc_addr_seg segments_count;
+  sc_uint64 staging_size;
+  sc_fs_memory_segment_processor process;
+  void * data;
+  sc_uint32 next_idx;            // index of the next sc-segment to process, it is accessed atomically
+  sc_uint32 is_failed;           // it is accessed atomically
+  sc_addr_seg processed_count;   // it is accessed under progress mutex
+  sc_mutex progress_mutex;       // progress is reported by one worker at once
+} sc_fs_memory_segments_processing;
 
-    if (sc_io_channel_write_chars(
-            segments_channel,
-            (sc_char *)&segment->last_engaged_offset,
-            sizeof(sc_addr_offset),
-            &written_bytes,
-            null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || written_bytes != sizeof(sc_addr_offset))
-    {
-      sc_fs_memory_error("Error while attribute `segment->last_engaged_offset` writing");
-      goto segment_save_error;
-    }
+void * _sc_fs_memory_process_segments_by_worker(void * arg)
+{
+  sc_fs_memory_segments_processing * processing = arg;
+  sc_char * staging = processing->staging_size == 0 ? null_ptr : sc_mem_new(sc_char, processing->staging_size);
 
-    if (sc_io_channel_write_chars(
-            segments_channel,
-            (sc_char *)&segment->last_released_offset,
-            sizeof(sc_addr_offset),
-            &written_bytes,
-            null_ptr)
-            != SC_FS_IO_STATUS_NORMAL
-        || written_bytes != sizeof(sc_addr_offset))
+  while (g_atomic_int_get(&processing->is_failed) == SC_FALSE)
+  {
+    sc_uint32 const idx = g_atomic_int_add(&processing->next_idx, 1);
+    if (idx >= processing->segments_count)
+      break;
+
+    if (processing->process(processing->data, staging, idx) == SC_FALSE)
     {
-      sc_fs_memory_error("Error while attribute `segment->last_released_offset` writing");
-      goto segment_save_error;
+      g_atomic_int_set(&processing->is_failed, SC_TRUE);
+      break;
     }
 
-  segment_save_error:
-    sc_monitor_release_read(&segment->monitor);
+    sc_mutex_lock(&processing->progress_mutex);
+    ++processing->processed_count;
+    if (manager->segments_progress != null_ptr)
+      manager->segments_progress(processing->action, processing->processed_count, processing->segments_count);
+    sc_mutex_unlock(&processing->progress_mutex);
   }
 
-  // rename main file
-  if (sc_fs_is_file(tmp_filename))
+  sc_mem_free(staging);
+  // it is called by the processing thread too, so it doesn't exit thread
+  return null_ptr;
+}
+
+/*! Processes sc-segments in parallel by `segments_threads_count` workers. Sc-segments are independent blocks of file of
+ * sc-segments, so workers read or write them at disjoint offsets. The calling thread is one of workers.
+ * @param action Name of action reported to progress callback
+ * @param segments_count Count of sc-segments
+ * @param staging_size Size of staging buffer of every worker, it is 0, if staging buffers aren't needed
+ * @param process Function to process sc-segment
+ * @param data Data passed to `process`
+ * @returns SC_FALSE, if any sc-segment isn't processed.
+ */
+sc_bool _sc_fs_memory_process_segments(
+    sc_char const * action,
+    sc_addr_seg segments_count,
+    sc_uint64 staging_size,
+    sc_fs_memory_segment_processor process,
+    void * data)
+{
+  sc_fs_memory_segments_processing processing = {
+      .action = action,
+      .segments_count = segments_count,
+      .staging_size = staging_size,
+      .process = process,
+      .data = data,
+  };
+  sc_mutex_init(&processing.progress_mutex);
+
+  sc_uint32 const threads_count = sc_max(1, sc_min(manager->segments_threads_count, segments_count));
+  pthread_t * threads = sc_mem_new(pthread_t, threads_count);
+  sc_uint32 started_threads_count = 1;
+  for (; started_threads_count < threads_count; ++started_threads_count)
   {
-    if (sc_fs_rename_file(tmp_filename, manager->segments_path) == SC_FALSE)
-    {
-      sc_fs_memory_error("Can't rename %s -> %s", tmp_filename, manager->segments_path);
-      goto error;
-    }
+    if (pthread_create(
+            &threads[started_threads_count], null_ptr, _sc_fs_memory_process_segments_by_worker, &processing)
+        != 0)
+      break;
   }
 
-  sc_message("\tLoaded segments count: %d", storage->segments_count);
-  sc_message("\tSc-segments size: %ld", storage->segments_count * sizeof(sc_segment));
-  sc_message("\tLast not engaged segment num: %d", storage->last_not_engaged_segment_num);
-  sc_message("\tLast released segment num: %d", storage->last_released_segment_num);
-
-  sc_mem_free(tmp_filename);
-  sc_io_channel_shutdown(segments_channel, SC_TRUE, null_ptr);
-  sc_fs_memory_info("Sc-memory segments saved");
-  return SC_FS_MEMORY_OK;
+  _sc_fs_memory_process_segments_by_worker(&processing);
+  for (sc_uint32 i = 1; i < started_threads_count; ++i)
+    pthread_join(threads[i], null_ptr);
 
-error:
-{
-  sc_mem_free(tmp_filename);
-  sc_io_channel_shutdown(segments_channel, SC_TRUE, null_ptr);
-  return SC_FS_MEMORY_WRITE_ERROR;
-}
+  sc_mem_free(threads);
+  sc_mutex_destroy(&processing.progress_mutex);
+  return processing.is_failed == SC_FALSE;
 }
 
-sc_fs_memory_status sc_fs_memory_save(sc_storage * storage)
+sc_bool _sc_fs_memory_is_compatible_version()
 {
-  if (manager->path == null_ptr)
+  sc_version read_version;
+  sc_version_from_int(manager->header.version, &read_version);
+  if (sc_version_compare(&manager->version, &read_version) == -1)
   {
-    sc_fs_memory_error("Repo path is empty to save memory");
-    return SC_FS_MEMORY_NO;
+    sc_char * version = sc_version_string_new(&read_version);
+    sc_fs_memory_error("Read sc-memory segments has incompatible version %s", version);
+    sc_version_string_free(version);
+    return SC_FALSE;
   }
 
-  if (_sc_fs_memory_save_sc_memory_segments(storage) != SC_FS_MEMORY_OK)
-    return SC_FS_MEMORY_WRITE_ERROR;
+  return SC_TRUE;
+}
+
+/*! Index of segments saved in aligned or compressed format. It precedes sc-elements of segments in file, so segments
+ * are loaded or verified in any order after it is read.
+ */
+typedef struct
+{
+  sc_addr_seg segments_count;
+  sc_addr_seg last_not_engaged_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_addr_seg last_released_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_uint8 * pools;
+  sc_uint64 * segment_offsets;  // offsets of sc-elements or compressed blocks of segments in file
+  sc_uint32 * block_sizes;      // sizes of compressed blocks of segments, if segments are compressed
+  sc_addr_offset * offsets;     // last engaged and last released offsets of segments
+  sc_uint32 * checksums;        // checksums of sc-elements or compressed blocks of segments, if they are saved
+  sc_uint64 max_block_size;     // maximum size of compressed blocks of segments
+} sc_fs_memory_segments_index;
+
+void _sc_fs_memory_segments_index_destroy(sc_fs_memory_segments_index * index)
+{
+  sc_mem_free(index->checksums);
+  sc_mem_free(index->block_sizes);
+  sc_mem_free(index->segment_offsets);
+  sc_mem_free(index->offsets);
+  sc_mem_free(index->pools);
+}
+
+/*! Returns checksum of index of segments. Offsets of aligned segments aren't saved, so they aren't checksummed.
+ * @param index Index of segments with checksums of segments
+ * @returns Checksum saved after checksums of segments.
+ */
+sc_uint32 _sc_fs_memory_get_segments_index_checksum(sc_fs_memory_segments_index const * index)
+{
+  sc_addr_seg const segments_count = index->segments_count;
+  sc_uint32 checksum = sc_fs_memory_checksum(0, &index->segments_count, sizeof(index->segments_count));
+  checksum = sc_fs_memory_checksum(
+      checksum, index->last_not_engaged_segment_num, sizeof(index->last_not_engaged_segment_num));
+  checksum =
+      sc_fs_memory_checksum(checksum, index->last_released_segment_num, sizeof(index->last_released_segment_num));
+  checksum = sc_fs_memory_checksum(checksum, index->pools, sizeof(sc_uint8) * segments_count);
+  if (index->block_sizes != null_ptr)
+  {
+    checksum = sc_fs_memory_checksum(checksum, index->segment_offsets, sizeof(sc_uint64) * segments_count);
+    checksum = sc_fs_memory_checksum(checksum, index->block_sizes, sizeof(sc_uint32) * segments_count);
+  }
+  checksum = sc_fs_memory_checksum(checksum, index->offsets, 2 * sizeof(sc_addr_offset) * segments_count);
+  return sc_fs_memory_checksum(checksum, index->checksums, sizeof(sc_uint32) * segments_count);
+}
+
+/*! Checks saved sc-elements or compressed block of segment by its checksum.
+ * @param index Index of segments
+ * @param idx Index of segment
+ * @param data Sc-elements or compressed block of segment
+ * @param size Size of data
+ * @returns SC_TRUE, if checksum of data is equal to the saved one or if checksums aren't saved.
+ */
+sc_bool _sc_fs_memory_is_segment_checksum_valid(
+    sc_fs_memory_segments_index const * index,
+    sc_addr_seg idx,
+    void const * data,
+    sc_uint64 size)
+{
+  return index->checksums == null_ptr || sc_fs_memory_checksum(0, data, size) == index->checksums[idx];
+}
+
+/*! Reads index of segments saved in aligned or compressed format. Index is checked by its checksum, if it is saved.
+ *
+ * Layout of file after header:
+ *  - segments count, last not engaged and last released segments numbers of pools;
+ *  - pools count and sizes of sc-elements of every pool;
+ *  - pool of every segment;
+ *  - in aligned format:
+ *    - sc-elements of every segment, every segment starts at aligned offset and takes aligned size;
+ *    - last engaged and last released offsets of every segment;
+ *    - checksum of sc-elements of every segment and checksum of index, if checksums are saved;
+ *  - in compressed format:
+ *    - offset and size of compressed block of every segment;
+ *    - last engaged and last released offsets of every segment;
+ *    - checksum of compressed block of every segment and checksum of index, if checksums are saved;
+ *    - compressed blocks of segments.
+ *
+ * @param channel Channel of file of segments, it is positioned after header
+ * @param[out] index Index of segments, it is destroyed by caller even if it isn't read
+ * @returns SC_FALSE, if index can't be read or it is corrupted.
+ */
+sc_bool _sc_fs_memory_read_sc_memory_segments_index(sc_io_channel * channel, sc_fs_memory_segments_index * index)
+{
+  *index = (sc_fs_memory_segments_index){0};
+  sc_uint64 offset = sizeof(sc_uint32) + sizeof(sc_fs_memory_header);
+  sc_uint64 const alignment = manager->header.alignment;
+  sc_bool const is_compressed = manager->header.format == SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED;
+  sc_bool const is_checksummed = manager->header.checksums == SC_FS_MEMORY_SEGMENTS_CHECKSUMS_CRC32C;
+
+  if (is_checksummed == SC_FALSE && manager->header.checksums != SC_FS_MEMORY_SEGMENTS_CHECKSUMS_NONE)
+  {
+    sc_fs_memory_error("Checksums %d of sc-memory segments aren't supported", manager->header.checksums);
+    return SC_FALSE;
+  }
+
+  if ((is_compressed == SC_FALSE && alignment == 0)
+      || _sc_fs_memory_read(channel, &index->segments_count, sizeof(sc_addr_seg), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->segments_count` reading");
+    return SC_FALSE;
+  }
+
+  if (_sc_fs_memory_read(
+          channel, index->last_not_engaged_segment_num, sizeof(index->last_not_engaged_segment_num), &offset)
+      == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->last_not_engaged_segment_num` reading");
+    return SC_FALSE;
+  }
+
+  if (_sc_fs_memory_read(channel, index->last_released_segment_num, sizeof(index->last_released_segment_num), &offset)
+      == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->last_released_segment_num` reading");
+    return SC_FALSE;
+  }
+
+  // layout of sc-elements depends on build options, so segments of other layout can't be loaded
+  sc_uint8 pools_count = 0;
+  sc_uint32 element_sizes[SC_SEGMENT_POOLS_COUNT];
+  if (_sc_fs_memory_read(channel, &pools_count, sizeof(pools_count), &offset) == SC_FALSE
+      || pools_count != SC_SEGMENT_POOLS_COUNT
+      || _sc_fs_memory_read(channel, element_sizes, sizeof(element_sizes), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Read sc-memory segments have incompatible layout of sc-elements");
+    return SC_FALSE;
+  }
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    if (element_sizes[pool] != SC_SEGMENT_ELEMENT_SIZE(pool))
+    {
+      sc_fs_memory_error(
+          "Read sc-memory segments have incompatible size of sc-elements %d != %lu",
+          element_sizes[pool],
+          SC_SEGMENT_ELEMENT_SIZE(pool));
+      return SC_FALSE;
+    }
+  }
+
+  sc_addr_seg const segments_count = index->segments_count;
+  index->pools = sc_mem_new(sc_uint8, segments_count + 1);
+  if (_sc_fs_memory_read(channel, index->pools, sizeof(sc_uint8) * segments_count, &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while pools of sc-segments reading");
+    return SC_FALSE;
+  }
+
+  index->segment_offsets = sc_mem_new(sc_uint64, segments_count + 1);
+  sc_uint64 offsets_offset = is_compressed ? offset : _sc_fs_memory_align(offset, alignment);
+  for (sc_addr_seg i = 0; i < segments_count; ++i)
+  {
+    if (index->pools[i] >= SC_SEGMENT_POOLS_COUNT)
+    {
+      sc_fs_memory_error("Error while sc-segment %d pool reading", i);
+      return SC_FALSE;
+    }
+    if (is_compressed == SC_FALSE)
+    {
+      index->segment_offsets[i] = offsets_offset;
+      offsets_offset += _sc_fs_memory_align(SC_SEGMENT_FILE_MAPPED_SIZE(index->pools[i]), alignment);
+    }
+  }
+
+  if (is_compressed)
+  {
+    index->block_sizes = sc_mem_new(sc_uint32, segments_count + 1);
+    if (_sc_fs_memory_read(channel, index->segment_offsets, sizeof(sc_uint64) * segments_count, &offset) == SC_FALSE
+        || _sc_fs_memory_read(channel, index->block_sizes, sizeof(sc_uint32) * segments_count, &offset) == SC_FALSE)
+    {
+      sc_fs_memory_error("Error while compressed blocks of sc-segments reading");
+      return SC_FALSE;
+    }
+    for (sc_addr_seg i = 0; i < segments_count; ++i)
+      index->max_block_size = sc_max(index->max_block_size, index->block_sizes[i]);
+    offsets_offset = offset;
+  }
+
+  // last engaged and last released offsets of aligned segments are saved after their sc-elements, so they are read
+  // before them
+  index->offsets = sc_mem_new(sc_addr_offset, 2 * segments_count + 1);
+  offset = offsets_offset;
+  if (sc_io_channel_seek(channel, offsets_offset, SC_FS_IO_SEEK_SET, null_ptr) != SC_FS_IO_STATUS_NORMAL
+      || _sc_fs_memory_read(channel, index->offsets, 2 * sizeof(sc_addr_offset) * segments_count, &offset)
+             == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while offsets of sc-segments reading");
+    return SC_FALSE;
+  }
+
+  if (is_checksummed == SC_FALSE)
+    return SC_TRUE;
+
+  index->checksums = sc_mem_new(sc_uint32, segments_count + 1);
+  sc_uint32 index_checksum = 0;
+  if (_sc_fs_memory_read(channel, index->checksums, sizeof(sc_uint32) * segments_count, &offset) == SC_FALSE
+      || _sc_fs_memory_read(channel, &index_checksum, sizeof(index_checksum), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while checksums of sc-segments reading");
+    return SC_FALSE;
+  }
+
+  if (index_checksum != _sc_fs_memory_get_segments_index_checksum(index))
+  {
+    sc_fs_memory_error("Index of sc-memory segments is corrupted");
+    return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+typedef struct
+{
+  sc_storage * storage;
+  sc_int32 fd;
+  sc_fs_memory_segments_index const * index;
+  sc_bool is_corrupted_skipped;       // corrupted segments are loaded empty instead of failing of loading
+  sc_uint32 mapped_segments_count;   // it is accessed atomically
+  sc_uint32 skipped_segments_count;  // it is accessed atomically
+} sc_fs_memory_segments_loading;
+
+/*! Reads compressed block of sc-segment, checks its checksum and decompresses its sc-elements.
+ * @param loading Data of loading of sc-segments
+ * @param staging Staging buffer to read compressed block to
+ * @param seg Sc-segment to decompress sc-elements to
+ * @param idx Index of sc-segment
+ * @returns SC_FALSE, if block can't be read or it is corrupted.
+ */
+sc_bool _sc_fs_memory_read_compressed_sc_memory_segment(
+    sc_fs_memory_segments_loading const * loading,
+    sc_char * staging,
+    sc_segment * seg,
+    sc_addr_seg idx)
+{
+#ifdef SC_FS_MEMORY_LZ4
+  sc_fs_memory_segments_index const * index = loading->index;
+  sc_uint32 const block_size = index->block_sizes[idx];
+  sc_int32 const elements_size = SC_SEG_ELEMENTS_SIZE_BYTE(seg->pool);
+  return _sc_fs_memory_read_at(loading->fd, staging, block_size, index->segment_offsets[idx])
+         && _sc_fs_memory_is_segment_checksum_valid(index, idx, staging, block_size)
+         && LZ4_decompress_safe(staging, (sc_char *)sc_segment_get_element(seg, 0), block_size, elements_size)
+                == elements_size;
+#else
+  (void)loading;
+  (void)staging;
+  (void)seg;
+  (void)idx;
+  return SC_FALSE;
+#endif
+}
+
+sc_bool _sc_fs_memory_load_indexed_sc_memory_segment(void * data, sc_char * staging, sc_addr_seg idx)
+{
+  sc_fs_memory_segments_loading * loading = data;
+  sc_fs_memory_segments_index const * index = loading->index;
+
+  sc_uint8 const pool = index->pools[idx];
+  sc_uint64 const offset = index->segment_offsets[idx];
+  sc_uint64 const elements_size = SC_SEG_ELEMENTS_SIZE_BYTE(pool);
+  sc_segment * seg = null_ptr;
+  if (index->block_sizes == null_ptr && sc_segment_allocator_is_file_offset_mappable(offset))
+    seg = sc_segment_new_from_file(idx + 1, pool, loading->fd, offset);
+
+  sc_bool is_read;
+  if (seg != null_ptr)
+  {
+    // checksum of mapped sc-elements reads their pages, but they stay backed by file and they are paged out again
+    is_read = _sc_fs_memory_is_segment_checksum_valid(index, idx, sc_segment_get_element(seg, 0), elements_size);
+    sc_segment_pager_release(seg);
+    if (is_read)
+      g_atomic_int_inc(&loading->mapped_segments_count);
+  }
+  else
+  {
+    seg = sc_segment_new(idx + 1, pool);
+    sc_char * elements = (sc_char *)sc_segment_get_element(seg, 0);
+    is_read = index->block_sizes == null_ptr
+                  ? _sc_fs_memory_read_at(loading->fd, elements, elements_size, offset)
+                        && _sc_fs_memory_is_segment_checksum_valid(index, idx, elements, elements_size)
+                  : _sc_fs_memory_read_compressed_sc_memory_segment(loading, staging, seg, idx);
+  }
+
+  if (is_read == SC_FALSE)
+  {
+    sc_segment_free(seg);
+    if (loading->is_corrupted_skipped == SC_FALSE)
+    {
+      sc_fs_memory_error("Sc-elements of sc-segment %d can't be read or they are corrupted", idx);
+      return SC_FALSE;
+    }
+
+    // sc-elements of skipped segment referred by sc-elements of other segments don't exist after loading
+    sc_fs_memory_error("Sc-elements of sc-segment %d can't be read or they are corrupted, it is skipped", idx);
+    g_atomic_int_inc(&loading->skipped_segments_count);
+    loading->storage->segments[idx] = sc_segment_new(idx + 1, pool);
+    return SC_TRUE;
+  }
+
+  seg->last_engaged_offset = index->offsets[2 * idx];
+  seg->last_released_offset = index->offsets[2 * idx + 1];
+  loading->storage->segments[idx] = seg;
+  return SC_TRUE;
+}
+
+/*! Loads segments saved in aligned or compressed format. Sc-elements of aligned segments are mapped from file, if it is
+ * possible, so their pages are read on first access or by checking of their checksums. Otherwise, sc-elements of every
+ * segment are read by one call. Compressed segments are read and decompressed by one call. Segments which can't be
+ * read or which checksums are invalid are loaded empty, if `skip_corrupted_segments` is set.
+ */
+sc_fs_memory_status _sc_fs_memory_load_indexed_sc_memory_segments(sc_storage * storage, sc_io_channel * channel)
+{
+  sc_fs_memory_segments_index index;
+  if (_sc_fs_memory_read_sc_memory_segments_index(channel, &index) == SC_FALSE)
+    goto error;
+
+#ifdef SC_FS_MEMORY_LZ4
+  if (index.block_sizes != null_ptr && manager->header.compression != SC_FS_MEMORY_SEGMENTS_COMPRESSION_LZ4)
+#else
+  if (index.block_sizes != null_ptr)
+#endif
+  {
+    sc_fs_memory_error("Compression %d of sc-memory segments isn't supported", manager->header.compression);
+    goto error;
+  }
+
+  sc_addr_seg const segments_count = index.segments_count;
+  if (sc_storage_reserve_segments(storage, segments_count) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while table of %d sc-segments reserving", segments_count);
+    goto error;
+  }
+
+  // segments are loaded in any order, so table of segments is cleared to free loaded ones on error
+  for (sc_addr_seg i = 0; i < segments_count; ++i)
+    storage->segments[i] = null_ptr;
+  sc_mem_cpy(
+      storage->last_not_engaged_segment_num,
+      index.last_not_engaged_segment_num,
+      sizeof(storage->last_not_engaged_segment_num));
+  sc_mem_cpy(
+      storage->last_released_segment_num, index.last_released_segment_num, sizeof(storage->last_released_segment_num));
+
+  sc_fs_memory_segments_loading loading = {
+      .storage = storage,
+      .fd = sc_io_channel_get_fd(channel),
+      .index = &index,
+      .is_corrupted_skipped = manager->skip_corrupted_segments,
+  };
+  if (_sc_fs_memory_process_segments(
+          "Loaded", segments_count, index.max_block_size, _sc_fs_memory_load_indexed_sc_memory_segment, &loading)
+      == SC_FALSE)
+  {
+    for (sc_addr_seg i = 0; i < segments_count; ++i)
+    {
+      if (storage->segments[i] != null_ptr)
+        sc_segment_free(storage->segments[i]);
+      storage->segments[i] = null_ptr;
+    }
+    goto error;
+  }
+  storage->segments_count = segments_count;
+  manager->skipped_segments_count = loading.skipped_segments_count;
+
+  _sc_fs_memory_segments_index_destroy(&index);
+
+  sc_message("\tMapped segments count: %d", loading.mapped_segments_count);
+  if (loading.skipped_segments_count != 0)
+    sc_fs_memory_warning("Corrupted sc-memory segments skipped: %d", loading.skipped_segments_count);
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  _sc_fs_memory_segments_index_destroy(&index);
+  return SC_FS_MEMORY_READ_ERROR;
+}
+}
+
+sc_fs_memory_status _sc_fs_memory_load_sc_memory_segments(sc_storage * storage)
+{
+  if (sc_fs_is_file(manager->segments_path) == SC_FALSE)
+  {
+    storage->segments_count = 0;
+    sc_fs_memory_info("There are no sc-memory segments in %s", manager->segments_path);
+    return SC_FS_MEMORY_OK;
+  }
+
+  // open segments
+  sc_io_channel * segments_channel = sc_io_new_read_channel(manager->segments_path, null_ptr);
+  sc_io_channel_set_encoding(segments_channel, null_ptr, null_ptr);
+
+  if (sc_fs_memory_header_read(segments_channel, &manager->header) != SC_FS_MEMORY_OK)
+    goto error;
+  storage->segments_count = manager->header.size;
+
+  // backward compatibility with version 0.7.0
+  sc_uint64 read_bytes = 0;
+  sc_bool is_no_deprecated_segments = storage->segments_count == 0;
+  if (is_no_deprecated_segments)
+    sc_fs_memory_info("Load sc-memory segments from %s", manager->segments_path);
+  else
+    sc_fs_memory_warning("Load deprecated sc-memory segments from %s", manager->segments_path);
+
+  static sc_uint32 const OLD_SC_ELEMENT_SIZE = 36;
+  sc_uint32 element_size = OLD_SC_ELEMENT_SIZE;
+#ifdef SC_COMPACT_ELEMENTS
+  if (!is_no_deprecated_segments)
+  {
+    storage->segments_count = 0;
+    sc_fs_memory_error("Deprecated sc-memory segments can't be loaded if sc-elements are compact");
+    goto error;
+  }
+#endif
+
+  if (manager->header.format == SC_FS_MEMORY_SEGMENTS_FORMAT_ALIGNED
+      || manager->header.format == SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED)
+  {
+    storage->segments_count = 0;
+    if (_sc_fs_memory_is_compatible_version() == SC_FALSE
+        || _sc_fs_memory_load_indexed_sc_memory_segments(storage, segments_channel) != SC_FS_MEMORY_OK)
+      goto error;
+    goto loaded;
+  }
+  else if (manager->header.format != SC_FS_MEMORY_SEGMENTS_FORMAT_STREAM)
+  {
+    storage->segments_count = 0;
+    sc_fs_memory_error("Unknown format %d of sc-memory segments", manager->header.format);
+    goto error;
+  }
+
+  if (is_no_deprecated_segments)
+  {
+    if (sc_io_channel_read_chars(
+            segments_channel, (sc_char *)&storage->segments_count, sizeof(sc_addr_seg), &read_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || read_bytes != sizeof(sc_addr_seg))
+    {
+      storage->segments_count = 0;
+      sc_fs_memory_error("Error while attribute `storage->segments_count` reading");
+      goto error;
+    }
+
+    if (sc_io_channel_read_chars(
+            segments_channel,
+            (sc_char *)storage->last_not_engaged_segment_num,
+            sizeof(storage->last_not_engaged_segment_num),
+            &read_bytes,
+            null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || read_bytes != sizeof(storage->last_not_engaged_segment_num))
+    {
+      sc_mem_set(storage->last_not_engaged_segment_num, 0, sizeof(storage->last_not_engaged_segment_num));
+      sc_fs_memory_error("Error while attribute `storage->last_not_engaged_segment_num` reading");
+      goto error;
+    }
+
+    if (sc_io_channel_read_chars(
+            segments_channel,
+            (sc_char *)storage->last_released_segment_num,
+            sizeof(storage->last_released_segment_num),
+            &read_bytes,
+            null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || read_bytes != sizeof(storage->last_released_segment_num))
+    {
+      sc_mem_set(storage->last_released_segment_num, 0, sizeof(storage->last_released_segment_num));
+      sc_fs_memory_error("Error while attribute `storage->last_released_segment_num` reading");
+      goto error;
+    }
+  }
+
+  if (_sc_fs_memory_is_compatible_version() == SC_FALSE)
+    goto error;
+
+  if (sc_storage_reserve_segments(storage, storage->segments_count) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while table of %d sc-segments reserving", storage->segments_count);
+    storage->segments_count = 0;
+    goto error;
+  }
+
+  for (sc_addr_seg i = 0; i < storage->segments_count; ++i)
+  {
+    sc_addr_seg const num = i;
+
+    sc_uint8 pool = SC_SEGMENT_POOL_NODES;
+#ifdef SC_COMPACT_ELEMENTS
+    if (sc_io_channel_read_chars(segments_channel, (sc_char *)&pool, sizeof(pool), &read_bytes, null_ptr)
+            != SC_FS_IO_STATUS_NORMAL
+        || read_bytes != sizeof(pool) || pool >= SC_SEGMENT_POOLS_COUNT)
+    {
+      storage->segments_count = num;
+      sc_fs_memory_error("Error while sc-segment %d pool reading", i);
+      goto error;
+    }
+#endif
+
+    sc_segment * seg = sc_segment_new(i + 1, pool);
+    storage->segments[i] = seg;
+    if (is_no_deprecated_segments)
+      element_size = SC_SEGMENT_ELEMENT_SIZE(pool);
+
+    // sc-elements of the current version are read at once
+    if (is_no_deprecated_segments)
+    {
+      sc_uint64 const elements_size = SC_SEG_ELEMENTS_SIZE_BYTE(pool);
+      if (sc_io_channel_read_chars(
+              segments_channel, (sc_char *)sc_segment_get_element(seg, 0), elements_size, &read_bytes, null_ptr)
+              != SC_FS_IO_STATUS_NORMAL
+          || read_bytes != elements_size)
+      {
+        storage->segments_count = num;
+        sc_fs_memory_error("Error while sc-elements in sc-segment %d reading", i);
+        goto error;
+      }
+    }
+
+    for (sc_addr_seg j = 0; !is_no_deprecated_segments && j < SC_SEGMENT_ELEMENTS_COUNT; ++j)
+    {
+      sc_element * element = sc_segment_get_element(seg, j);
+      if (sc_io_channel_read_chars(segments_channel, (sc_char *)element, element_size, &read_bytes, null_ptr)
+              != SC_FS_IO_STATUS_NORMAL
+          || read_bytes != element_size)
+      {
+        storage->segments_count = num;
+        sc_fs_memory_error("Error while sc-element %d in sc-segment %d reading", j, i);
+        goto error;
+      }
+
+      // needed for sc-template search
+      if (!is_no_deprecated_segments)
+      {
+        element->incoming_arcs_count = 1;
+        element->outgoing_arcs_count = 1;
+      }
+    }
+
+    if (is_no_deprecated_segments)
+    {
+      if (sc_io_channel_read_chars(
+              segments_channel, (sc_char *)&seg->last_engaged_offset, sizeof(sc_addr_offset), &read_bytes, null_ptr)
+              != SC_FS_IO_STATUS_NORMAL
+          || read_bytes != sizeof(sc_addr_offset))
+      {
+        sc_fs_memory_error("Error while sc-segment %d reading", i);
+        goto error;
+      }
+
+      if (sc_io_channel_read_chars(
+              segments_channel, (sc_char *)&seg->last_released_offset, sizeof(sc_addr_offset), &read_bytes, null_ptr)
+              != SC_FS_IO_STATUS_NORMAL
+          || read_bytes != sizeof(sc_addr_offset))
+      {
+        sc_fs_memory_error("Error while sc-segment %d reading", i);
+        goto error;
+      }
+    }
+
+    i = num;
+  }
+
+loaded:
+  sc_io_channel_shutdown(segments_channel, SC_FALSE, null_ptr);
+
+  sc_message("\tLoaded segments count: %d", storage->segments_count);
+  sc_message("\tSc-segments size: %ld", storage->segments_count * sizeof(sc_segment));
+  sc_message("\tLast not engaged segment num: %d", storage->last_not_engaged_segment_num[SC_SEGMENT_POOL_NODES]);
+  sc_message("\tLast released segment num: %d", storage->last_released_segment_num[SC_SEGMENT_POOL_NODES]);
+
+  if (is_no_deprecated_segments)
+    sc_fs_memory_info("Sc-memory segments loaded");
+  else
+    sc_fs_memory_warning("Deprecated sc-memory segments loaded");
+
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  sc_io_channel_shutdown(segments_channel, SC_FALSE, null_ptr);
+  return SC_FS_MEMORY_READ_ERROR;
+}
+}
+
+/*! Reads changes of segments saved by one dump of changes. Changes start with segments count, last not engaged and last
+ * released segments numbers of pools. Then every changed segment is saved with its number, pool, last engaged and last
+ * released offsets and sc-elements. Changes end with zero segment number.
+ * @param storage Sc-storage to apply changes to, if `is_applied` is SC_TRUE
+ * @param channel Channel of file of changes
+ * @param offset Offset of changes in file, it is moved to their end
+ * @param is_applied Flag to apply changes, otherwise they are only skipped
+ * @returns SC_TRUE, if changes are read completely.
+ */
+sc_bool _sc_fs_memory_read_sc_memory_segments_delta(
+    sc_storage * storage,
+    sc_io_channel * channel,
+    sc_uint64 * offset,
+    sc_bool is_applied)
+{
+  sc_addr_seg segments_count = 0;
+  sc_addr_seg last_not_engaged_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_addr_seg last_released_segment_num[SC_SEGMENT_POOLS_COUNT];
+  if (_sc_fs_memory_read(channel, &segments_count, sizeof(segments_count), offset) == SC_FALSE
+      || _sc_fs_memory_read(channel, last_not_engaged_segment_num, sizeof(last_not_engaged_segment_num), offset)
+             == SC_FALSE
+      || _sc_fs_memory_read(channel, last_released_segment_num, sizeof(last_released_segment_num), offset)
+             == SC_FALSE)
+    return SC_FALSE;
+
+  while (SC_TRUE)
+  {
+    sc_addr_seg num = 0;
+    if (_sc_fs_memory_read(channel, &num, sizeof(num), offset) == SC_FALSE)
+      return SC_FALSE;
+    if (num == 0)
+      break;
+
+    sc_uint8 pool = 0;
+    sc_addr_offset offsets[2];
+    if (num > segments_count || _sc_fs_memory_read(channel, &pool, sizeof(pool), offset) == SC_FALSE
+        || pool >= SC_SEGMENT_POOLS_COUNT || _sc_fs_memory_read(channel, offsets, sizeof(offsets), offset) == SC_FALSE)
+      return SC_FALSE;
+
+    if (is_applied == SC_FALSE)
+    {
+      *offset += SC_SEG_ELEMENTS_SIZE_BYTE(pool);
+      if (sc_io_channel_seek(channel, *offset, SC_FS_IO_SEEK_SET, null_ptr) != SC_FS_IO_STATUS_NORMAL)
+        return SC_FALSE;
+      continue;
+    }
+
+    sc_segment * segment = num <= storage->segments_count ? storage->segments[num - 1] : null_ptr;
+    if (segment == null_ptr)
+    {
+      // new segments are changed since they are generated, so they are saved in order of their numbers
+      if (num != storage->segments_count + 1 || sc_storage_reserve_segments(storage, num) == SC_FALSE)
+        return SC_FALSE;
+
+      segment = sc_segment_new(num, pool);
+      storage->segments[num - 1] = segment;
+      storage->segments_count = num;
+    }
+    else if (segment->pool != pool)
+      return SC_FALSE;
+
+    if (_sc_fs_memory_read(channel, sc_segment_get_element(segment, 0), SC_SEG_ELEMENTS_SIZE_BYTE(pool), offset)
+        == SC_FALSE)
+      return SC_FALSE;
+
+    segment->last_engaged_offset = offsets[0];
+    segment->last_released_offset = offsets[1];
+    // applied changes aren't saved in the last dump of all segments, so they are saved again by the next dump
+    segment->is_dirty = SC_TRUE;
+  }
+
+  if (is_applied == SC_TRUE)
+  {
+    if (storage->segments_count != segments_count)
+      return SC_FALSE;
+
+    sc_mem_cpy(
+        storage->last_not_engaged_segment_num, last_not_engaged_segment_num, sizeof(last_not_engaged_segment_num));
+    sc_mem_cpy(storage->last_released_segment_num, last_released_segment_num, sizeof(last_released_segment_num));
+  }
+
+  return SC_TRUE;
+}
+
+/*! Applies changes of segments saved after the last dump of all segments. Changes of other dump and incomplete changes
+ * at the end of file, if saving was interrupted, are ignored.
+ */
+sc_fs_memory_status _sc_fs_memory_load_sc_memory_segments_deltas(sc_storage * storage)
+{
+  // applied deltas are saved to new file of deltas by the next dump
+  manager->deltas_count = 0;
+  if (sc_fs_is_file(manager->deltas_path) == SC_FALSE)
+    return SC_FS_MEMORY_OK;
+
+  sc_io_channel * deltas_channel = sc_io_new_read_channel(manager->deltas_path, null_ptr);
+  if (deltas_channel == null_ptr)
+  {
+    sc_fs_memory_error("Can't open sc-memory segments deltas from %s", manager->deltas_path);
+    return SC_FS_MEMORY_READ_ERROR;
+  }
+  sc_io_channel_set_encoding(deltas_channel, null_ptr, null_ptr);
+  sc_io_channel_set_buffer_size(deltas_channel, SC_FS_MEMORY_SEGMENTS_WRITE_BUFFER_SIZE);
+
+  sc_uint64 offset = 0;
+  sc_uint64 timestamp = 0;
+  if (_sc_fs_memory_read(deltas_channel, &timestamp, sizeof(timestamp), &offset) == SC_FALSE
+      || manager->header.timestamp == 0 || timestamp != manager->header.timestamp)
+  {
+    sc_fs_memory_warning("Sc-memory segments deltas from %s are saved for other segments", manager->deltas_path);
+    goto end;
+  }
+
+  // complete deltas are found at first, so incomplete ones aren't applied partially
+  sc_uint64 const deltas_offset = offset;
+  sc_uint64 deltas_end_offset = offset;
+  sc_uint32 deltas_count = 0;
+  while (_sc_fs_memory_read_sc_memory_segments_delta(storage, deltas_channel, &offset, SC_FALSE))
+  {
+    deltas_end_offset = offset;
+    ++deltas_count;
+  }
+
+  offset = deltas_offset;
+  if (sc_io_channel_seek(deltas_channel, offset, SC_FS_IO_SEEK_SET, null_ptr) != SC_FS_IO_STATUS_NORMAL)
+    goto error;
+  while (offset < deltas_end_offset)
+  {
+    if (_sc_fs_memory_read_sc_memory_segments_delta(storage, deltas_channel, &offset, SC_TRUE) == SC_FALSE)
+    {
+      sc_fs_memory_error("Error while sc-memory segments deltas applying");
+      goto error;
+    }
+  }
+
+  sc_message("\tApplied segments deltas count: %d", deltas_count);
+  sc_message("\tLoaded segments count: %d", storage->segments_count);
+
+end:
+  sc_io_channel_shutdown(deltas_channel, SC_FALSE, null_ptr);
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  sc_io_channel_shutdown(deltas_channel, SC_FALSE, null_ptr);
+  return SC_FS_MEMORY_READ_ERROR;
+}
+}
+
+sc_fs_memory_status sc_fs_memory_load(sc_storage * storage)
+{
+  if (_sc_fs_memory_load_sc_memory_segments(storage) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_READ_ERROR;
+  if (_sc_fs_memory_load_sc_memory_segments_deltas(storage) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_READ_ERROR;
+  // lists of free sc-elements pass through skipped segments, so they are restored from loaded sc-elements
+  if (manager->skipped_segments_count != 0)
+    sc_storage_restore_free_elements(storage);
+  if (manager->load(manager->fs_memory) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_READ_ERROR;
+
+  return SC_FS_MEMORY_OK;
+}
+
+typedef struct
+{
+  sc_int32 fd;
+  sc_fs_memory_segments_index const * index;
+  sc_uint32 corrupted_count;  // it is accessed atomically
+} sc_fs_memory_segments_verifying;
+
+sc_bool _sc_fs_memory_verify_indexed_sc_memory_segment(void * data, sc_char * staging, sc_addr_seg idx)
+{
+  sc_fs_memory_segments_verifying * verifying = data;
+  sc_fs_memory_segments_index const * index = verifying->index;
+
+  // compressed blocks are checksummed before decompression, so they are verified without decompression
+  sc_uint64 const size =
+      index->block_sizes == null_ptr ? SC_SEG_ELEMENTS_SIZE_BYTE(index->pools[idx]) : index->block_sizes[idx];
+  if (_sc_fs_memory_read_at(verifying->fd, staging, size, index->segment_offsets[idx]) == SC_FALSE
+      || _sc_fs_memory_is_segment_checksum_valid(index, idx, staging, size) == SC_FALSE)
+  {
+    sc_fs_memory_error("Sc-elements of sc-segment %d can't be read or they are corrupted", idx);
+    g_atomic_int_inc(&verifying->corrupted_count);
+  }
+
+  return SC_TRUE;
+}
+
+/*! Verifies checksums of segments saved in aligned or compressed format without loading of them. Segments saved without
+ * checksums are only read.
+ * @param[in, out] corrupted_count Count of corrupted segments, it is increased by count of found ones
+ * @returns SC_FS_MEMORY_OK, if segments are verified.
+ */
+sc_fs_memory_status _sc_fs_memory_verify_sc_memory_segments(sc_uint32 * corrupted_count)
+{
+  if (sc_fs_is_file(manager->segments_path) == SC_FALSE)
+  {
+    sc_fs_memory_info("There are no sc-memory segments in %s", manager->segments_path);
+    return SC_FS_MEMORY_OK;
+  }
+
+  sc_fs_memory_info("Verify sc-memory segments from %s", manager->segments_path);
+  sc_io_channel * segments_channel = sc_io_new_read_channel(manager->segments_path, null_ptr);
+  sc_io_channel_set_encoding(segments_channel, null_ptr, null_ptr);
+
+  sc_fs_memory_segments_index index = {0};
+  sc_fs_memory_status status = SC_FS_MEMORY_OK;
+  if (sc_fs_memory_header_read(segments_channel, &manager->header) != SC_FS_MEMORY_OK)
+  {
+    ++*corrupted_count;
+    goto finish;
+  }
+
+  if (manager->header.format != SC_FS_MEMORY_SEGMENTS_FORMAT_ALIGNED
+      && manager->header.format != SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED)
+  {
+    sc_fs_memory_warning("Sc-memory segments of format %d can't be verified", manager->header.format);
+    goto finish;
+  }
+
+  if (manager->header.checksums == SC_FS_MEMORY_SEGMENTS_CHECKSUMS_NONE)
+    sc_fs_memory_warning("Sc-memory segments are saved without checksums, so only their reading is verified");
+
+  if (_sc_fs_memory_read_sc_memory_segments_index(segments_channel, &index) == SC_FALSE)
+  {
+    ++*corrupted_count;
+    goto finish;
+  }
+
+  sc_uint64 staging_size = index.max_block_size;
+  for (sc_uint8 pool = 0; index.block_sizes == null_ptr && pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    staging_size = sc_max(staging_size, SC_SEG_ELEMENTS_SIZE_BYTE(pool));
+
+  sc_fs_memory_segments_verifying verifying = {
+      .fd = sc_io_channel_get_fd(segments_channel),
+      .index = &index,
+  };
+  if (_sc_fs_memory_process_segments(
+          "Verified",
+          index.segments_count,
+          staging_size,
+          _sc_fs_memory_verify_indexed_sc_memory_segment,
+          &verifying)
+      == SC_FALSE)
+    status = SC_FS_MEMORY_READ_ERROR;
+  *corrupted_count += verifying.corrupted_count;
+
+finish:
+  _sc_fs_memory_segments_index_destroy(&index);
+  sc_io_channel_shutdown(segments_channel, SC_FALSE, null_ptr);
+  return status;
+}
+
+sc_fs_memory_status sc_fs_memory_verify(sc_uint32 * corrupted_count)
+{
+  *corrupted_count = 0;
+  if (_sc_fs_memory_verify_sc_memory_segments(corrupted_count) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_READ_ERROR;
+
+  sc_uint32 corrupted_channels_count = 0;
+  if (manager->verify(manager->fs_memory, &corrupted_channels_count) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_READ_ERROR;
+  *corrupted_count += corrupted_channels_count;
+
+  if (*corrupted_count == 0)
+    sc_fs_memory_info("Sc-memory segments and strings aren't corrupted");
+  else
+    sc_fs_memory_error("Corrupted sc-memory segments and strings channels: %d", *corrupted_count);
+  return SC_FS_MEMORY_OK;
+}
+
+typedef struct
+{
+  sc_storage * storage;
+  sc_int32 fd;
+  sc_fs_memory_segments_index * index;
+  sc_uint64 segments_size;      // maximum size of sc-elements of segments
+  sc_uint64 blocks_end_offset;  // offset after the last compressed block in file
+  sc_mutex blocks_mutex;        // compressed blocks are placed in file one by one
+} sc_fs_memory_segments_saving;
+
+//! Returns maximum size of compressed block of sc-elements of specified size.
+sc_uint64 _sc_fs_memory_get_compressed_size_bound(sc_uint64 size)
+{
+#ifdef SC_FS_MEMORY_LZ4
+  return LZ4_compressBound(size);
+#else
+  (void)size;
+  return 0;
+#endif
+}
+
+/*! Compresses sc-elements of sc-segment copied to staging buffer. Compressed block is placed in staging buffer after
+ * copied sc-elements.
+ * @param saving Data of saving of sc-segments
+ * @param staging Staging buffer with copied sc-elements
+ * @param size Size of copied sc-elements
+ * @returns Size of compressed block, or 0, if sc-elements can't be compressed.
+ */
+sc_uint32 _sc_fs_memory_compress_sc_memory_segment(
+    sc_fs_memory_segments_saving const * saving,
+    sc_char * staging,
+    sc_uint64 size)
+{
+#ifdef SC_FS_MEMORY_LZ4
+  return LZ4_compress_default(
+      staging,
+      staging + saving->segments_size,
+      size,
+      _sc_fs_memory_get_compressed_size_bound(saving->segments_size));
+#else
+  (void)saving;
+  (void)staging;
+  (void)size;
+  return 0;
+#endif
+}
+
+sc_bool _sc_fs_memory_save_sc_memory_segment(void * data, sc_char * staging, sc_addr_seg idx)
+{
+  sc_fs_memory_segments_saving * saving = data;
+  sc_fs_memory_segments_index * index = saving->index;
+
+  sc_fs_memory_staging_buffer buffer = {.data = staging, .size = 0};
+  _sc_fs_memory_capture_segment(saving->storage->segments[idx], &buffer, &index->offsets[2 * idx]);
+
+  if (index->block_sizes != null_ptr)
+  {
+    sc_uint32 const block_size = _sc_fs_memory_compress_sc_memory_segment(saving, buffer.data, buffer.size);
+    if (block_size == 0)
+    {
+      sc_fs_memory_error("Error while sc-elements of sc-segment %d compressing", idx);
+      return SC_FALSE;
+    }
+
+    // compressed blocks have different sizes, so they are placed in file in order of their compression
+    sc_mutex_lock(&saving->blocks_mutex);
+    index->segment_offsets[idx] = saving->blocks_end_offset;
+    saving->blocks_end_offset += block_size;
+    sc_mutex_unlock(&saving->blocks_mutex);
+
+    index->block_sizes[idx] = block_size;
+    buffer.data += saving->segments_size;
+    buffer.size = block_size;
+  }
+
+  index->checksums[idx] = sc_fs_memory_checksum(0, buffer.data, buffer.size);
+  if (_sc_fs_memory_write_at(saving->fd, buffer.data, buffer.size, index->segment_offsets[idx]) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while sc-elements of sc-segment %d writing", idx);
+    return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+sc_fs_memory_status _sc_fs_memory_save_sc_memory_segments(sc_storage * storage)
+{
+  sc_fs_memory_info("Save sc-memory segments");
+
+  // create temporary file
+  sc_char * tmp_filename;
+  sc_io_channel * segments_channel = sc_fs_new_tmp_write_channel(manager->fs_memory->path, &tmp_filename, "segments");
+  sc_io_channel_set_encoding(segments_channel, null_ptr, null_ptr);
+  sc_io_channel_set_buffer_size(segments_channel, SC_FS_MEMORY_SEGMENTS_WRITE_BUFFER_SIZE);
+
+  sc_addr_seg const segments_count = storage->segments_count;
+  sc_bool const is_compressed = manager->segments_compression != SC_FS_MEMORY_SEGMENTS_COMPRESSION_NONE;
+  sc_fs_memory_segments_index index = {
+      .segments_count = segments_count,
+      .pools = sc_mem_new(sc_uint8, segments_count + 1),
+      .segment_offsets = sc_mem_new(sc_uint64, segments_count + 1),
+      .block_sizes = is_compressed ? sc_mem_new(sc_uint32, segments_count + 1) : null_ptr,
+      .offsets = sc_mem_new(sc_addr_offset, 2 * segments_count + 1),
+      .checksums = sc_mem_new(sc_uint32, segments_count + 1),
+  };
+  sc_mem_cpy(
+      index.last_not_engaged_segment_num,
+      storage->last_not_engaged_segment_num,
+      sizeof(index.last_not_engaged_segment_num));
+  sc_mem_cpy(
+      index.last_released_segment_num, storage->last_released_segment_num, sizeof(index.last_released_segment_num));
+
+  manager->header.size = 0;
+  manager->header.version = sc_version_to_int(&manager->version);
+  manager->header.timestamp = g_get_real_time();
+  manager->header.format =
+      is_compressed ? SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED : SC_FS_MEMORY_SEGMENTS_FORMAT_ALIGNED;
+  manager->header.alignment = is_compressed ? 0 : SC_FS_MEMORY_SEGMENTS_ALIGNMENT;
+  manager->header.compression = manager->segments_compression;
+  manager->header.checksums = SC_FS_MEMORY_SEGMENTS_CHECKSUMS_CRC32C;
+  if (sc_fs_memory_header_write(segments_channel, manager->header) != SC_FS_MEMORY_OK)
+    goto error;
+
+  sc_uint64 offset = sizeof(sc_uint32) + sizeof(sc_fs_memory_header);
+  if (_sc_fs_memory_write(segments_channel, &segments_count, sizeof(sc_addr_seg), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->segments_count` writing");
+    goto error;
+  }
+
+  if (_sc_fs_memory_write(
+          segments_channel, index.last_not_engaged_segment_num, sizeof(index.last_not_engaged_segment_num), &offset)
+      == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->last_not_engaged_segment_num` writing");
+    goto error;
+  }
+
+  if (_sc_fs_memory_write(
+          segments_channel, index.last_released_segment_num, sizeof(index.last_released_segment_num), &offset)
+      == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `storage->last_released_segment_num` writing");
+    goto error;
+  }
+
+  sc_uint8 const pools_count = SC_SEGMENT_POOLS_COUNT;
+  sc_uint32 element_sizes[SC_SEGMENT_POOLS_COUNT];
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    element_sizes[pool] = SC_SEGMENT_ELEMENT_SIZE(pool);
+  if (_sc_fs_memory_write(segments_channel, &pools_count, sizeof(pools_count), &offset) == SC_FALSE
+      || _sc_fs_memory_write(segments_channel, element_sizes, sizeof(element_sizes), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while sizes of sc-elements writing");
+    goto error;
+  }
+
+  // pools of segments aren't changed, so they are written before sc-elements of segments
+  sc_uint64 segments_size = 0;
+  for (sc_addr_seg idx = 0; idx < segments_count; ++idx)
+  {
+    sc_segment * segment = storage->segments[idx];
+    if (segment == null_ptr)
+    {
+      sc_fs_memory_error("Error while attribute `segment` writing");
+      goto error;
+    }
+
+    index.pools[idx] = segment->pool;
+    segments_size = sc_max(segments_size, SC_SEG_ELEMENTS_SIZE_BYTE(segment->pool));
+  }
+  if (_sc_fs_memory_write(segments_channel, index.pools, sizeof(sc_uint8) * segments_count, &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while attribute `segment->pool` writing");
+    goto error;
+  }
+
+  // offsets and sizes of compressed blocks are known after compression, so they are written after blocks
+  sc_uint64 const blocks_table_offset = offset;
+  sc_uint64 offsets_offset = blocks_table_offset + (sizeof(sc_uint64) + sizeof(sc_uint32)) * segments_count;
+  if (is_compressed == SC_FALSE)
+  {
+    offsets_offset = _sc_fs_memory_align(offset, SC_FS_MEMORY_SEGMENTS_ALIGNMENT);
+    for (sc_addr_seg idx = 0; idx < segments_count; ++idx)
+    {
+      index.segment_offsets[idx] = offsets_offset;
+      // the rest of mapped memory of segment isn't written, so the next segment is aligned and the rest is read as
+      // zeros
+      offsets_offset += _sc_fs_memory_align(
+          SC_SEGMENT_FILE_MAPPED_SIZE(storage->segments[idx]->pool), SC_FS_MEMORY_SEGMENTS_ALIGNMENT);
+    }
+  }
+
+  // sc-elements of segments are written at their offsets, so header is written before them
+  if (sc_io_channel_flush(segments_channel, null_ptr) != SC_FS_IO_STATUS_NORMAL)
+  {
+    sc_fs_memory_error("Error while header of sc-segments writing");
+    goto error;
+  }
+
+  sc_fs_memory_segments_saving saving = {
+      .storage = storage,
+      .fd = sc_io_channel_get_fd(segments_channel),
+      .index = &index,
+      .segments_size = segments_size,
+      .blocks_end_offset = offsets_offset + (2 * sizeof(sc_addr_offset) + sizeof(sc_uint32)) * segments_count
+                           + sizeof(sc_uint32),
+  };
+  sc_uint64 const staging_size =
+      is_compressed ? segments_size + _sc_fs_memory_get_compressed_size_bound(segments_size) : segments_size;
+  sc_mutex_init(&saving.blocks_mutex);
+  sc_bool const is_saved = _sc_fs_memory_process_segments(
+      "Saved", segments_count, staging_size, _sc_fs_memory_save_sc_memory_segment, &saving);
+  sc_mutex_destroy(&saving.blocks_mutex);
+  if (is_saved == SC_FALSE)
+    goto error;
+
+  sc_uint32 const index_checksum = _sc_fs_memory_get_segments_index_checksum(&index);
+  offset = is_compressed ? blocks_table_offset : offsets_offset;
+  if (sc_io_channel_seek(segments_channel, offset, SC_FS_IO_SEEK_SET, null_ptr) != SC_FS_IO_STATUS_NORMAL
+      || (is_compressed
+          && (_sc_fs_memory_write(segments_channel, index.segment_offsets, sizeof(sc_uint64) * segments_count, &offset)
+                  == SC_FALSE
+              || _sc_fs_memory_write(segments_channel, index.block_sizes, sizeof(sc_uint32) * segments_count, &offset)
+                     == SC_FALSE))
+      || _sc_fs_memory_write(segments_channel, index.offsets, 2 * sizeof(sc_addr_offset) * segments_count, &offset)
+             == SC_FALSE
+      || _sc_fs_memory_write(segments_channel, index.checksums, sizeof(sc_uint32) * segments_count, &offset)
+             == SC_FALSE
+      || _sc_fs_memory_write(segments_channel, &index_checksum, sizeof(index_checksum), &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while offsets of segments writing");
+    goto error;
+  }
+
+  // rename main file
+  if (sc_fs_is_file(tmp_filename))
+  {
+    if (sc_fs_rename_file(tmp_filename, manager->segments_path) == SC_FALSE)
+    {
+      sc_fs_memory_error("Can't rename %s -> %s", tmp_filename, manager->segments_path);
+      goto error;
+    }
+  }
+
+  sc_message("\tLoaded segments count: %d", segments_count);
+  sc_message("\tSc-segments size: %ld", segments_count * sizeof(sc_segment));
+  sc_message("\tLast not engaged segment num: %d", storage->last_not_engaged_segment_num[SC_SEGMENT_POOL_NODES]);
+  sc_message("\tLast released segment num: %d", storage->last_released_segment_num[SC_SEGMENT_POOL_NODES]);
+
+  _sc_fs_memory_segments_index_destroy(&index);
+  sc_mem_free(tmp_filename);
+  sc_io_channel_shutdown(segments_channel, SC_TRUE, null_ptr);
+  sc_fs_memory_info("Sc-memory segments saved");
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  _sc_fs_memory_segments_index_destroy(&index);
+  sc_mem_free(tmp_filename);
+  sc_io_channel_shutdown(segments_channel, SC_TRUE, null_ptr);
+  return SC_FS_MEMORY_WRITE_ERROR;
+}
+}
+
+/*! Appends segments changed after the previous dump to file of deltas. The first deltas after the dump of all segments
+ * replace file of deltas of the previous dump.
+ */
+sc_fs_memory_status _sc_fs_memory_save_sc_memory_segments_delta(sc_storage * storage)
+{
+  sc_fs_memory_info("Save changed sc-memory segments");
+
+  sc_char * tmp_filename = null_ptr;
+  sc_io_channel * deltas_channel =
+      manager->deltas_count == 0
+          ? sc_fs_new_tmp_write_channel(manager->fs_memory->path, &tmp_filename, "segments_deltas")
+          : sc_io_new_channel(manager->deltas_path, "a", null_ptr);
+  if (deltas_channel == null_ptr)
+  {
+    sc_fs_memory_error("Can't open sc-memory segments deltas in %s", manager->deltas_path);
+    sc_mem_free(tmp_filename);
+    return SC_FS_MEMORY_WRITE_ERROR;
+  }
+  sc_io_channel_set_encoding(deltas_channel, null_ptr, null_ptr);
+  sc_io_channel_set_buffer_size(deltas_channel, SC_FS_MEMORY_SEGMENTS_WRITE_BUFFER_SIZE);
+
+  sc_uint64 offset = 0;
+  if (tmp_filename != null_ptr
+      && _sc_fs_memory_write(deltas_channel, &manager->header.timestamp, sizeof(manager->header.timestamp), &offset)
+             == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while timestamp of sc-memory segments writing");
+    goto error;
+  }
+
+  // segments are generated together with changes of their lists, so they are copied under the same lock
+  sc_monitor_acquire_read(&storage->segments_monitor);
+  sc_addr_seg const segments_count = storage->segments_count;
+  sc_addr_seg last_not_engaged_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_addr_seg last_released_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_mem_cpy(last_not_engaged_segment_num, storage->last_not_engaged_segment_num, sizeof(last_not_engaged_segment_num));
+  sc_mem_cpy(last_released_segment_num, storage->last_released_segment_num, sizeof(last_released_segment_num));
+  sc_monitor_release_read(&storage->segments_monitor);
+
+  if (_sc_fs_memory_write(deltas_channel, &segments_count, sizeof(segments_count), &offset) == SC_FALSE
+      || _sc_fs_memory_write(
+             deltas_channel, last_not_engaged_segment_num, sizeof(last_not_engaged_segment_num), &offset)
+             == SC_FALSE
+      || _sc_fs_memory_write(deltas_channel, last_released_segment_num, sizeof(last_released_segment_num), &offset)
+             == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while lists of sc-memory segments writing");
+    goto error;
+  }
+
+  sc_fs_memory_segments_writer writer;
+  _sc_fs_memory_segments_writer_start(&writer, deltas_channel, offset);
+
+  sc_addr_seg changed_segments_count = 0;
+  for (sc_addr_seg idx = 0; idx < segments_count; ++idx)
+  {
+    sc_segment * segment = storage->segments[idx];
+    if (g_atomic_int_get(&segment->is_dirty) == SC_FALSE)
+      continue;
+
+    sc_fs_memory_staging_buffer * buffer = _sc_fs_memory_segments_writer_get_buffer(&writer);
+    if (buffer == null_ptr)
+      break;
+
+    _sc_fs_memory_staging_buffer_append(buffer, &segment->num, sizeof(segment->num));
+    _sc_fs_memory_staging_buffer_append(buffer, &segment->pool, sizeof(segment->pool));
+    // offsets of lists of segment are copied together with its sc-elements, so they are filled after copying
+    sc_addr_offset offsets[2];
+    sc_uint64 const offsets_position = buffer->size;
+    buffer->size += sizeof(offsets);
+    _sc_fs_memory_capture_segment(segment, buffer, offsets);
+    sc_mem_cpy(buffer->data + offsets_position, offsets, sizeof(offsets));
+    _sc_fs_memory_segments_writer_push_buffer(&writer);
+
+    ++changed_segments_count;
+  }
+
+  if (_sc_fs_memory_segments_writer_finish(&writer, &offset) == SC_FALSE)
+  {
+    sc_fs_memory_error("Error while changed sc-segments writing");
+    goto error;
+  }
+
+  sc_addr_seg const end_num = 0;
+  if (_sc_fs_memory_write(deltas_channel, &end_num, sizeof(end_num), &offset) == SC_FALSE
+      || sc_io_channel_flush(deltas_channel, null_ptr) != SC_FS_IO_STATUS_NORMAL)
+  {
+    sc_fs_memory_error("Error while end of sc-memory segments deltas writing");
+    goto error;
+  }
+
+  if (tmp_filename != null_ptr && sc_fs_rename_file(tmp_filename, manager->deltas_path) == SC_FALSE)
+  {
+    sc_fs_memory_error("Can't rename %s -> %s", tmp_filename, manager->deltas_path);
+    goto error;
+  }
+
+  ++manager->deltas_count;
+  sc_message("\tChanged segments count: %d", changed_segments_count);
+  sc_message("\tSegments deltas count: %d", manager->deltas_count);
+
+  sc_mem_free(tmp_filename);
+  sc_io_channel_shutdown(deltas_channel, SC_TRUE, null_ptr);
+  sc_fs_memory_info("Changed sc-memory segments saved");
+  return SC_FS_MEMORY_OK;
+
+error:
+{
+  sc_mem_free(tmp_filename);
+  sc_io_channel_shutdown(deltas_channel, SC_TRUE, null_ptr);
+  return SC_FS_MEMORY_WRITE_ERROR;
+}
+}
+
+sc_fs_memory_status _sc_fs_memory_save(sc_storage * storage)
+{
+  if (_sc_fs_memory_save_sc_memory_segments(storage) != SC_FS_MEMORY_OK)
+    return SC_FS_MEMORY_WRITE_ERROR;
+
+  // deltas of the previous dump can't be applied to the saved one
+  manager->deltas_count = 0;
+  if (sc_fs_is_file(manager->deltas_path) && sc_fs_remove_file(manager->deltas_path) == SC_FALSE)
+  {
+    sc_fs_memory_error("Can't remove sc-memory segments deltas %s", manager->deltas_path);
+    return SC_FS_MEMORY_WRITE_ERROR;
+  }
+
+  g_atomic_int_set(&manager->is_strings_dirty, SC_FALSE);
   if (manager->save(manager->fs_memory) != SC_FS_MEMORY_OK)
+  {
+    g_atomic_int_set(&manager->is_strings_dirty, SC_TRUE);
     return SC_FS_MEMORY_WRITE_ERROR;
+  }
 
   return SC_FS_MEMORY_OK;
 }
+
+sc_fs_memory_status sc_fs_memory_save(sc_storage * storage)
+{
+  if (manager->path == null_ptr)
+  {
+    sc_fs_memory_error("Repo path is empty to save memory");
+    return SC_FS_MEMORY_NO;
+  }
+
+  sc_monitor_acquire_write(&manager->dump_monitor);
+  sc_fs_memory_status status = _sc_fs_memory_save(storage);
+  // changes of segments could be reset without saving, so the next dump saves all segments
+  if (status != SC_FS_MEMORY_OK)
+    manager->deltas_count = manager->max_deltas_count;
+  sc_monitor_release_write(&manager->dump_monitor);
+
+  return status;
+}
+
+sc_fs_memory_status sc_fs_memory_save_changes(sc_storage * storage)
+{
+  if (manager->path == null_ptr)
+  {
+    sc_fs_memory_error("Repo path is empty to save memory");
+    return SC_FS_MEMORY_NO;
+  }
+
+  sc_monitor_acquire_write(&manager->dump_monitor);
+
+  sc_fs_memory_status status;
+  // deltas are applied to the last dump of all segments on load, so it must exist
+  if (manager->deltas_count >= manager->max_deltas_count || manager->header.timestamp == 0
+      || sc_fs_is_file(manager->segments_path) == SC_FALSE)
+    status = _sc_fs_memory_save(storage);
+  else
+  {
+    status = _sc_fs_memory_save_sc_memory_segments_delta(storage);
+    if (status == SC_FS_MEMORY_OK && g_atomic_int_get(&manager->is_strings_dirty) == SC_TRUE)
+    {
+      g_atomic_int_set(&manager->is_strings_dirty, SC_FALSE);
+      if (manager->save(manager->fs_memory) != SC_FS_MEMORY_OK)
+      {
+        g_atomic_int_set(&manager->is_strings_dirty, SC_TRUE);
+        status = SC_FS_MEMORY_WRITE_ERROR;
+      }
+    }
+  }
+
+  // file of deltas could be incomplete or changes of segments could be reset without saving, so the next dump saves
+  // all segments
+  if (status != SC_FS_MEMORY_OK)
+    manager->deltas_count = manager->max_deltas_count;
+
+  sc_monitor_release_write(&manager->dump_monitor);
+
+  return status;
+}
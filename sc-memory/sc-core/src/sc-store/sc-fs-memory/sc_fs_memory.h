@@ -16,16 +16,44 @@
 #include "sc-core/sc-container/sc_list.h"
 #include "sc-core/sc_memory_params.h"
 #include "sc-store/sc_storage.h"
+#include "sc-store/sc-base/sc_monitor_private.h"
 
 #ifdef SC_DICTIONARY_FS_MEMORY
 typedef struct _sc_dictionary_fs_memory sc_fs_memory;
 #endif
 
+#define SC_FS_MEMORY_COMPRESSION_NONE "None"
+#define SC_FS_MEMORY_COMPRESSION_LZ4 "LZ4"
+
+/*! Reports progress of loading or saving of sc-segments. It is called after every processed sc-segment by one thread at
+ * once.
+ * @param action Action with sc-segments, "Loaded" or "Saved"
+ * @param processed_count Count of processed sc-segments
+ * @param segments_count Count of all sc-segments
+ */
+typedef void (*sc_fs_memory_segments_progress_callback)(
+    sc_char const * action,
+    sc_addr_seg processed_count,
+    sc_addr_seg segments_count);
+
 typedef struct _sc_fs_memory_manager
 {
   sc_fs_memory * fs_memory;  // file system memory instance
   sc_char const * path;      // repo path
   sc_char * segments_path;   // file path to sc-memory segments
+  sc_char * deltas_path;     // file path to changes of sc-memory segments after the last dump of all segments
+
+  sc_uint32 max_deltas_count;  // count of dumps of changes between dumps of all segments
+  sc_uint32 deltas_count;      // count of dumps of changes after the last dump of all segments
+  sc_uint32 is_strings_dirty;  // sc-link contents are changed after the last dump, it is accessed atomically
+  sc_monitor dump_monitor;     // dumps are made one by one
+
+  sc_uint32 segments_threads_count;                           // count of threads to load and save sc-segments
+  sc_fs_memory_segments_progress_callback segments_progress;  // callback to report progress of sc-segments
+  sc_uint32 segments_compression;                             // compression of sc-segments in dumps of all segments
+
+  sc_bool skip_corrupted_segments;     // corrupted sc-segments are loaded empty instead of failing of loading
+  sc_addr_seg skipped_segments_count;  // count of corrupted sc-segments loaded empty
 
   sc_version version;
   sc_fs_memory_header header;
@@ -33,7 +61,8 @@ typedef struct _sc_fs_memory_manager
   sc_fs_memory_status (*initialize)(sc_fs_memory ** memory, sc_memory_params const * params);
   sc_fs_memory_status (*shutdown)(sc_fs_memory * memory);
   sc_fs_memory_status (*load)(sc_fs_memory * memory);
-  sc_fs_memory_status (*save)(sc_fs_memory const * memory);
+  sc_fs_memory_status (*save)(sc_fs_memory * memory);
+  sc_fs_memory_status (*verify)(sc_fs_memory * memory, sc_uint32 * corrupted_count);
   sc_fs_memory_status (*link_string)(
       sc_fs_memory * memory,
       sc_addr_hash const link_hash,
@@ -45,6 +74,10 @@ typedef struct _sc_fs_memory_manager
       sc_addr_hash const link_hash,
       sc_char ** string,
       sc_uint64 * string_size);
+  sc_fs_memory_status (*get_stream_by_link_hash)(
+      sc_fs_memory * memory,
+      sc_addr_hash const link_hash,
+      sc_stream ** stream);
   sc_fs_memory_status (*get_link_hashes_by_string)(
       sc_fs_memory * memory,
       sc_char const * string,
@@ -66,6 +99,10 @@ typedef struct _sc_fs_memory_manager
       void * data,
       void (*callback)(void * data, sc_addr const link_addr, sc_char const * link_content));
   sc_fs_memory_status (*unlink_string)(sc_fs_memory * memory, sc_addr_hash const link_hash);
+  sc_fs_memory_status (*move_link_string)(
+      sc_fs_memory * memory,
+      sc_addr_hash const link_hash,
+      sc_addr_hash const new_link_hash);
 } sc_fs_memory_manager;
 
 /*! Initialize file system memory in specified path.
@@ -113,6 +150,13 @@ sc_fs_memory_status sc_fs_memory_link_string_ext(
  */
 sc_fs_memory_status sc_fs_memory_unlink_string(sc_addr_hash link_hash);
 
+/*! Moves sc-link content string from file system memory to another sc-link hash.
+ * @param link_hash A sc-link hash with content string
+ * @param new_link_hash A sc-link hash without content string
+ * @returns SC_TRUE, if are no writing errors.
+ */
+sc_fs_memory_status sc_fs_memory_move_link_string(sc_addr_hash link_hash, sc_addr_hash new_link_hash);
+
 /*! Gets sc-link content string with its size by sc-link hash.
  * @param link_hash A sc-link hash
  * @param[out] string A sc-link content string
@@ -124,6 +168,15 @@ sc_fs_memory_status sc_fs_memory_get_string_by_link_hash(
     sc_char ** string,
     sc_uint32 * string_size);
 
+/*! Gets stream of sc-link content by sc-link hash. Content isn't copied to the stream, if file system memory can read
+ * it in place.
+ * @param link_hash A sc-link hash
+ * @param[out] stream A stream of sc-link content, or null_ptr if there is no content
+ * @returns SC_FS_MEMORY_OK, if sc-link content exists.
+ * @note The stream is valid until file system memory is shutdown.
+ */
+sc_fs_memory_status sc_fs_memory_get_stream_by_link_hash(sc_addr_hash link_hash, sc_stream ** stream);
+
 /*! Gets sc-link hashes from file system memory by its string content.
  * @param string A sc-links content string
  * @param string_size A sc-links content string size
@@ -164,6 +217,12 @@ sc_fs_memory_status sc_fs_memory_get_strings_by_substring(
     void * data,
     void (*callback)(void * data, sc_addr const link_addr, sc_char const * link_content));
 
+/*! Sets callback to report progress of loading and saving of sc-segments. Progress is logged every 25 percent by
+ * default.
+ * @param callback Callback to report progress, or null_ptr to not report it
+ */
+void sc_fs_memory_set_segments_progress_callback(sc_fs_memory_segments_progress_callback callback);
+
 /*! Load file system memory from file system
  * @returns SC_TRUE, if file system loaded.
  */
@@ -174,4 +233,18 @@ sc_fs_memory_status sc_fs_memory_load(sc_storage * storage);
  */
 sc_fs_memory_status sc_fs_memory_save(sc_storage * storage);
 
+/*! Verifies checksums of sc-memory segments and strings saved in file system memory without loading them. Every
+ * corrupted sc-segment or strings channel is reported.
+ * @param[out] corrupted_count Count of corrupted sc-segments and strings channels
+ * @returns SC_FS_MEMORY_OK, if saved sc-memory is verified, even if it is corrupted, or if it isn't saved yet.
+ */
+sc_fs_memory_status sc_fs_memory_verify(sc_uint32 * corrupted_count);
+
+/*! Save changes of file system memory made after the last dump. Changed segments are appended to file of changes of
+ * the last dump of all segments, and they are applied to it on load. All segments are saved instead, if they aren't
+ * saved yet or if `max_deltas_count` changes are already appended.
+ * @returns SC_FS_MEMORY_OK, if changes are saved.
+ */
+sc_fs_memory_status sc_fs_memory_save_changes(sc_storage * storage);
+
 #endif
@@ -20,12 +20,15 @@ sc_fs_memory_manager * sc_fs_memory_build()
   manager->shutdown = sc_dictionary_fs_memory_shutdown;
   manager->load = sc_dictionary_fs_memory_load;
   manager->save = sc_dictionary_fs_memory_save;
+  manager->verify = sc_dictionary_fs_memory_verify;
   manager->link_string = sc_dictionary_fs_memory_link_string_ext;
   manager->get_link_hashes_by_string = sc_dictionary_fs_memory_get_link_hashes_by_string;
   manager->get_link_hashes_by_substring = sc_dictionary_fs_memory_get_link_hashes_by_substring_ext;
   manager->get_strings_by_substring = sc_dictionary_fs_memory_get_strings_by_substring_ext;
   manager->get_string_by_link_hash = sc_dictionary_fs_memory_get_string_by_link_hash;
+  manager->get_stream_by_link_hash = sc_dictionary_fs_memory_get_stream_by_link_hash;
   manager->unlink_string = sc_dictionary_fs_memory_unlink_string;
+  manager->move_link_string = sc_dictionary_fs_memory_move_link_string;
 #endif
 
   return manager;
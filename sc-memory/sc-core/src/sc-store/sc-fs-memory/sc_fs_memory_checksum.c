@@ -0,0 +1,150 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_fs_memory_checksum.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  include <nmmintrin.h>
+#  define SC_FS_MEMORY_CHECKSUM_SSE42
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#  include <arm_acle.h>
+#  define SC_FS_MEMORY_CHECKSUM_ARM_CRC32
+#endif
+
+// Reflected polynomial of CRC32C (Castagnoli)
+#define SC_FS_MEMORY_CHECKSUM_POLYNOMIAL 0x82F63B78
+// Size of buffer to read files by
+#define SC_FS_MEMORY_CHECKSUM_FILE_BUFFER_SIZE (1024 * 1024)
+
+typedef sc_uint32 (*sc_fs_memory_checksum_function)(sc_uint32 crc, sc_uint8 const * bytes, sc_uint64 size);
+
+// tables of software implementation process 8 bytes at once (slicing-by-8)
+sc_uint32 sc_fs_memory_checksum_tables[8][256];
+sc_fs_memory_checksum_function sc_fs_memory_checksum_implementation;
+pthread_once_t sc_fs_memory_checksum_once = PTHREAD_ONCE_INIT;
+
+sc_uint32 _sc_fs_memory_checksum_software(sc_uint32 crc, sc_uint8 const * bytes, sc_uint64 size)
+{
+  sc_uint32 const(*tables)[256] = sc_fs_memory_checksum_tables;
+  for (; size >= 8; size -= 8, bytes += 8)
+  {
+    sc_uint32 const low =
+        crc ^ (bytes[0] | (sc_uint32)bytes[1] << 8 | (sc_uint32)bytes[2] << 16 | (sc_uint32)bytes[3] << 24);
+    sc_uint32 const high = bytes[4] | (sc_uint32)bytes[5] << 8 | (sc_uint32)bytes[6] << 16 | (sc_uint32)bytes[7] << 24;
+    crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+          ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF]
+          ^ tables[0][high >> 24];
+  }
+
+  for (; size > 0; --size, ++bytes)
+    crc = (crc >> 8) ^ tables[0][(crc ^ *bytes) & 0xFF];
+  return crc;
+}
+
+#if defined(SC_FS_MEMORY_CHECKSUM_SSE42)
+__attribute__((target("sse4.2"))) sc_uint32 _sc_fs_memory_checksum_hardware(
+    sc_uint32 crc,
+    sc_uint8 const * bytes,
+    sc_uint64 size)
+{
+  sc_uint64 crc64 = crc;
+  for (; size >= 8; size -= 8, bytes += 8)
+  {
+    sc_uint64 word;
+    sc_mem_cpy(&word, bytes, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+
+  crc = (sc_uint32)crc64;
+  for (; size > 0; --size, ++bytes)
+    crc = _mm_crc32_u8(crc, *bytes);
+  return crc;
+}
+#elif defined(SC_FS_MEMORY_CHECKSUM_ARM_CRC32)
+sc_uint32 _sc_fs_memory_checksum_hardware(sc_uint32 crc, sc_uint8 const * bytes, sc_uint64 size)
+{
+  for (; size >= 8; size -= 8, bytes += 8)
+  {
+    sc_uint64 word;
+    sc_mem_cpy(&word, bytes, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+
+  for (; size > 0; --size, ++bytes)
+    crc = __crc32cb(crc, *bytes);
+  return crc;
+}
+#endif
+
+void _sc_fs_memory_checksum_initialize()
+{
+  for (sc_uint32 i = 0; i < 256; ++i)
+  {
+    sc_uint32 crc = i;
+    for (sc_uint8 bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ ((crc & 1) * SC_FS_MEMORY_CHECKSUM_POLYNOMIAL);
+    sc_fs_memory_checksum_tables[0][i] = crc;
+  }
+  for (sc_uint32 i = 0; i < 256; ++i)
+  {
+    for (sc_uint8 table = 1; table < 8; ++table)
+    {
+      sc_uint32 const crc = sc_fs_memory_checksum_tables[table - 1][i];
+      sc_fs_memory_checksum_tables[table][i] = (crc >> 8) ^ sc_fs_memory_checksum_tables[0][crc & 0xFF];
+    }
+  }
+
+  sc_fs_memory_checksum_implementation = _sc_fs_memory_checksum_software;
+#if defined(SC_FS_MEMORY_CHECKSUM_SSE42)
+  if (__builtin_cpu_supports("sse4.2"))
+    sc_fs_memory_checksum_implementation = _sc_fs_memory_checksum_hardware;
+#elif defined(SC_FS_MEMORY_CHECKSUM_ARM_CRC32)
+  sc_fs_memory_checksum_implementation = _sc_fs_memory_checksum_hardware;
+#endif
+}
+
+sc_uint32 sc_fs_memory_checksum(sc_uint32 checksum, void const * data, sc_uint64 size)
+{
+  pthread_once(&sc_fs_memory_checksum_once, _sc_fs_memory_checksum_initialize);
+  return ~sc_fs_memory_checksum_implementation(~checksum, data, size);
+}
+
+sc_bool sc_fs_memory_checksum_file(sc_char const * path, sc_uint64 begin, sc_uint64 end, sc_uint32 * checksum)
+{
+  sc_int32 const fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return SC_FALSE;
+
+  sc_uint64 const buffer_size = sc_min(SC_FS_MEMORY_CHECKSUM_FILE_BUFFER_SIZE, end - begin);
+  sc_uint8 * buffer = buffer_size == 0 ? null_ptr : sc_mem_new(sc_uint8, buffer_size);
+  sc_bool result = SC_TRUE;
+  while (begin < end)
+  {
+    ssize_t const read_size = pread(fd, buffer, sc_min(buffer_size, end - begin), begin);
+    if (read_size == -1 && errno == EINTR)
+      continue;
+    // file is shorter than checksummed range
+    if (read_size <= 0)
+    {
+      result = SC_FALSE;
+      break;
+    }
+
+    *checksum = sc_fs_memory_checksum(*checksum, buffer, read_size);
+    begin += read_size;
+  }
+
+  sc_mem_free(buffer);
+  close(fd);
+  return result;
+}
@@ -0,0 +1,31 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_fs_memory_checksum_h_
+#define _sc_fs_memory_checksum_h_
+
+#include "sc-core/sc_types.h"
+
+/*! Continues CRC32C checksum of data. Checksum of concatenated data is equal to checksum of its parts calculated one by
+ * one, so checksums of growing files are continued from their previous sizes. CRC32C instructions of processor are used
+ * if they are available.
+ * @param checksum Checksum of previous data, or 0 for the first data
+ * @param data Data to calculate checksum of
+ * @param size Size of data
+ * @returns Checksum of previous data and specified data.
+ */
+sc_uint32 sc_fs_memory_checksum(sc_uint32 checksum, void const * data, sc_uint64 size);
+
+/*! Continues CRC32C checksum of data by bytes of file in specified range.
+ * @param path Path to file
+ * @param begin Offset of the first byte in file
+ * @param end Offset after the last byte in file
+ * @param[in, out] checksum Checksum of previous data, it is continued by bytes of file
+ * @returns SC_FALSE, if file can't be opened or it is shorter than `end`.
+ */
+sc_bool sc_fs_memory_checksum_file(sc_char const * path, sc_uint64 begin, sc_uint64 end, sc_uint32 * checksum);
+
+#endif
@@ -6,6 +6,8 @@
 
 #include "sc_fs_memory_header.h"
 
+#include "sc-core/sc-base/sc_allocator.h"
+
 #include "sc_dictionary_fs_memory_private.h"
 
 sc_fs_memory_status sc_fs_memory_header_read(sc_io_channel * channel, sc_fs_memory_header * header)
@@ -20,15 +22,18 @@ sc_fs_memory_status sc_fs_memory_header_read(sc_io_channel * channel, sc_fs_memo
     return SC_FS_MEMORY_READ_ERROR;
   }
 
-  if (header_size != sizeof(sc_fs_memory_header))
+  // headers of previous versions don't have segments format, compression or checksums, their segments aren't
+  // compressed and checksummed
+  if (header_size != sizeof(sc_fs_memory_header) && header_size != SC_FS_MEMORY_COMPRESSED_HEADER_SIZE
+      && header_size != SC_FS_MEMORY_ALIGNED_HEADER_SIZE && header_size != SC_FS_MEMORY_STREAM_HEADER_SIZE)
   {
     sc_fs_memory_error("Invalid header size %d != %lu", header_size, sizeof(sc_fs_memory_header));
     return SC_FS_MEMORY_READ_ERROR;
   }
 
-  if (sc_io_channel_read_chars(channel, (sc_char *)header, sizeof(sc_fs_memory_header), &read_bytes, null_ptr)
-          != SC_FS_IO_STATUS_NORMAL
-      || read_bytes != sizeof(sc_fs_memory_header))
+  sc_mem_set(header, 0, sizeof(sc_fs_memory_header));
+  if (sc_io_channel_read_chars(channel, (sc_char *)header, header_size, &read_bytes, null_ptr) != SC_FS_IO_STATUS_NORMAL
+      || read_bytes != header_size)
   {
     sc_fs_memory_error("Error while attribute `header` reading");
     return SC_FS_MEMORY_READ_ERROR;
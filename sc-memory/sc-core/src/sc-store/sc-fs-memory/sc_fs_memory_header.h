@@ -11,16 +11,46 @@
 #include "sc_fs_memory_status.h"
 #include "sc_io.h"
 
+#include <stddef.h>
+
 #define DEFAULT_CHECKSUM_SIZE 64
 
+//! Sc-elements of segments follow each other
+#define SC_FS_MEMORY_SEGMENTS_FORMAT_STREAM 0
+//! Sc-elements of every segment start at offset aligned to `alignment`, so they can be mapped into memory
+#define SC_FS_MEMORY_SEGMENTS_FORMAT_ALIGNED 1
+//! Sc-elements of every segment are compressed by `compression` as one block, blocks follow each other
+#define SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED 2
+
+//! Sc-elements of segments aren't compressed
+#define SC_FS_MEMORY_SEGMENTS_COMPRESSION_NONE 0
+//! Sc-elements of every segment are compressed by LZ4
+#define SC_FS_MEMORY_SEGMENTS_COMPRESSION_LZ4 1
+
+//! Sc-segments are saved without checksums
+#define SC_FS_MEMORY_SEGMENTS_CHECKSUMS_NONE 0
+//! Sc-elements or compressed block of every segment and index of segments are saved with CRC32C checksums
+#define SC_FS_MEMORY_SEGMENTS_CHECKSUMS_CRC32C 1
+
 typedef struct _sc_fs_memory_header
 {
   sc_uint32 version;
   sc_uint16 size;  // deprecated in 0.8.0
   sc_uint64 timestamp;
   sc_uint8 checksum[DEFAULT_CHECKSUM_SIZE];
+  sc_uint32 format;       // format of segments, added in 0.10.0
+  sc_uint32 alignment;    // alignment of segments in file, if they are aligned
+  sc_uint32 compression;  // compression of segments, if they are compressed, added in 0.10.0
+  sc_uint32 checksums;    // checksums of segments, added in 0.10.0
 } sc_fs_memory_header;
 
+//! Size of header written before segments format was added
+#define SC_FS_MEMORY_STREAM_HEADER_SIZE offsetof(sc_fs_memory_header, format)
+//! Size of header written before compression of segments was added
+#define SC_FS_MEMORY_ALIGNED_HEADER_SIZE offsetof(sc_fs_memory_header, compression)
+//! Size of header written before checksums of segments were added
+#define SC_FS_MEMORY_COMPRESSED_HEADER_SIZE offsetof(sc_fs_memory_header, checksums)
+
 sc_fs_memory_status sc_fs_memory_header_read(sc_io_channel * channel, sc_fs_memory_header * header);
 
 sc_fs_memory_status sc_fs_memory_header_write(sc_io_channel * channel, sc_fs_memory_header header);
@@ -0,0 +1,388 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_fs_memory_trigrams.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+#include "sc-core/sc-base/sc_monitor.h"
+
+#include "sc-store/sc-base/sc_monitor_private.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#define SC_FS_MEMORY_TRIGRAMS_INITIAL_CAPACITY 1024
+#define SC_FS_MEMORY_TRIGRAMS_INITIAL_STRINGS_CAPACITY 1024
+#define SC_FS_MEMORY_TRIGRAMS_INITIAL_POSTINGS_CAPACITY 4
+// lists of strings are intersected by search of elements of smaller list in bigger one, if bigger list is longer
+#define SC_FS_MEMORY_TRIGRAMS_GALLOPING_RATIO 32
+
+//! Slot of hash table of trigrams with sorted identifiers of strings containing trigram
+typedef struct
+{
+  sc_uint32 key;  // trigram incremented by one, or zero if slot is empty
+  sc_uint32 size;
+  sc_uint32 capacity;
+  sc_uint32 * ids;
+} sc_fs_memory_trigram_postings;
+
+struct _sc_fs_memory_trigrams
+{
+  sc_fs_memory_trigram_postings * slots;  // slots with linear probing, count of them is power of two
+  sc_uint32 capacity;
+  sc_uint32 size;
+  sc_uint64 * string_offsets;  // offsets of strings by their identifiers, identifiers are given in order of appending
+  sc_uint32 strings_count;
+  sc_uint32 strings_capacity;
+  sc_uint64 postings_size;  // count of identifiers that can be stored in all lists without their growing
+  sc_monitor monitor;
+};
+
+sc_uint32 _sc_fs_memory_trigrams_get_key(sc_char const * bytes)
+{
+  return (((sc_uint32)(sc_uchar)bytes[0] << 16) | ((sc_uint32)(sc_uchar)bytes[1] << 8) | (sc_uchar)bytes[2]) + 1;
+}
+
+sc_uint32 _sc_fs_memory_trigrams_hash(sc_uint32 key)
+{
+  // finalizer of MurmurHash3, neighbouring trigrams get distant slots
+  key ^= key >> 16;
+  key *= 0x85ebca6bu;
+  key ^= key >> 13;
+  key *= 0xc2b2ae35u;
+  key ^= key >> 16;
+  return key;
+}
+
+sc_fs_memory_trigram_postings * _sc_fs_memory_trigrams_find_slot(
+    sc_fs_memory_trigram_postings * slots,
+    sc_uint32 capacity,
+    sc_uint32 key)
+{
+  sc_uint32 const mask = capacity - 1;
+  for (sc_uint32 idx = _sc_fs_memory_trigrams_hash(key) & mask;; idx = (idx + 1) & mask)
+  {
+    if (slots[idx].key == key || slots[idx].key == 0)
+      return &slots[idx];
+  }
+}
+
+void _sc_fs_memory_trigrams_grow(sc_fs_memory_trigrams * trigrams)
+{
+  sc_uint32 const capacity = trigrams->capacity * 2;
+  sc_fs_memory_trigram_postings * slots = sc_mem_new(sc_fs_memory_trigram_postings, capacity);
+
+  for (sc_uint32 i = 0; i < trigrams->capacity; ++i)
+  {
+    sc_fs_memory_trigram_postings const * slot = &trigrams->slots[i];
+    if (slot->key != 0)
+      *_sc_fs_memory_trigrams_find_slot(slots, capacity, slot->key) = *slot;
+  }
+
+  sc_mem_free(trigrams->slots);
+  trigrams->slots = slots;
+  trigrams->capacity = capacity;
+}
+
+void _sc_fs_memory_trigrams_push_id(
+    sc_fs_memory_trigrams * trigrams,
+    sc_fs_memory_trigram_postings * postings,
+    sc_uint32 id)
+{
+  // identifiers of one string are pushed one after another, so repeated trigrams of string are skipped here
+  if (postings->size != 0 && postings->ids[postings->size - 1] == id)
+    return;
+
+  if (postings->size == postings->capacity)
+  {
+    sc_uint32 const capacity = sc_max(postings->capacity * 2, SC_FS_MEMORY_TRIGRAMS_INITIAL_POSTINGS_CAPACITY);
+    sc_uint32 * ids = sc_mem_new(sc_uint32, capacity);
+    if (postings->ids != null_ptr)
+      memcpy(ids, postings->ids, postings->size * sizeof(sc_uint32));
+    sc_mem_free(postings->ids);
+    trigrams->postings_size += capacity - postings->capacity;
+    postings->ids = ids;
+    postings->capacity = capacity;
+  }
+
+  postings->ids[postings->size++] = id;
+}
+
+sc_fs_memory_trigrams * sc_fs_memory_trigrams_new(void)
+{
+  sc_fs_memory_trigrams * trigrams = sc_mem_new(sc_fs_memory_trigrams, 1);
+  trigrams->capacity = SC_FS_MEMORY_TRIGRAMS_INITIAL_CAPACITY;
+  trigrams->slots = sc_mem_new(sc_fs_memory_trigram_postings, trigrams->capacity);
+  trigrams->strings_capacity = SC_FS_MEMORY_TRIGRAMS_INITIAL_STRINGS_CAPACITY;
+  trigrams->string_offsets = sc_mem_new(sc_uint64, trigrams->strings_capacity);
+  sc_monitor_init(&trigrams->monitor);
+  return trigrams;
+}
+
+void sc_fs_memory_trigrams_free(sc_fs_memory_trigrams * trigrams)
+{
+  if (trigrams == null_ptr)
+    return;
+
+  for (sc_uint32 i = 0; i < trigrams->capacity; ++i)
+    sc_mem_free(trigrams->slots[i].ids);
+  sc_mem_free(trigrams->slots);
+  sc_mem_free(trigrams->string_offsets);
+  sc_monitor_destroy(&trigrams->monitor);
+  sc_mem_free(trigrams);
+}
+
+void sc_fs_memory_trigrams_append(
+    sc_fs_memory_trigrams * trigrams,
+    sc_char const * string,
+    sc_uint64 string_size,
+    sc_uint64 string_offset)
+{
+  sc_monitor_acquire_write(&trigrams->monitor);
+
+  if (trigrams->strings_count == trigrams->strings_capacity)
+  {
+    sc_uint32 const capacity = trigrams->strings_capacity * 2;
+    sc_uint64 * string_offsets = sc_mem_new(sc_uint64, capacity);
+    memcpy(string_offsets, trigrams->string_offsets, trigrams->strings_count * sizeof(sc_uint64));
+    sc_mem_free(trigrams->string_offsets);
+    trigrams->string_offsets = string_offsets;
+    trigrams->strings_capacity = capacity;
+  }
+
+  sc_uint32 const id = trigrams->strings_count++;
+  trigrams->string_offsets[id] = string_offset;
+
+  for (sc_uint64 i = 0; i + SC_FS_MEMORY_TRIGRAM_SIZE <= string_size; ++i)
+  {
+    sc_uint32 const key = _sc_fs_memory_trigrams_get_key(string + i);
+    sc_fs_memory_trigram_postings * postings =
+        _sc_fs_memory_trigrams_find_slot(trigrams->slots, trigrams->capacity, key);
+    if (postings->key == 0)
+    {
+      // load factor of hash table is kept below 3/4, so probing sequences are short
+      if ((trigrams->size + 1) * 4 > trigrams->capacity * 3)
+      {
+        _sc_fs_memory_trigrams_grow(trigrams);
+        postings = _sc_fs_memory_trigrams_find_slot(trigrams->slots, trigrams->capacity, key);
+      }
+
+      postings->key = key;
+      ++trigrams->size;
+    }
+
+    _sc_fs_memory_trigrams_push_id(trigrams, postings, id);
+  }
+
+  sc_monitor_release_write(&trigrams->monitor);
+}
+
+/*! Intersects sorted list of identifiers with bigger one by search of every identifier in bigger list. Search begins
+ * from position of the previous found identifier with growing steps, so it takes logarithmic time from distance
+ * between identifiers.
+ */
+sc_uint32 _sc_fs_memory_trigrams_intersect_galloping(
+    sc_uint32 * ids,
+    sc_uint32 size,
+    sc_uint32 const * other_ids,
+    sc_uint32 other_size)
+{
+  sc_uint32 count = 0;
+  sc_uint32 j = 0;
+  for (sc_uint32 i = 0; i < size && j < other_size; ++i)
+  {
+    sc_uint32 const id = ids[i];
+    sc_uint32 step = 1;
+    sc_uint32 low = j;
+    sc_uint32 high = j;
+    while (high < other_size && other_ids[high] < id)
+    {
+      low = high + 1;
+      high += step;
+      step *= 2;
+    }
+    high = sc_min(high, other_size);
+
+    while (low < high)
+    {
+      sc_uint32 const middle = low + (high - low) / 2;
+      if (other_ids[middle] < id)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+
+    j = low;
+    if (j < other_size && other_ids[j] == id)
+      ids[count++] = id;
+  }
+
+  return count;
+}
+
+/*! Intersects two sorted lists of identifiers by merging of them. Blocks of four identifiers of both lists are compared
+ * all with all by SSE2 instructions, if they are available.
+ */
+sc_uint32 _sc_fs_memory_trigrams_intersect_merging(
+    sc_uint32 * ids,
+    sc_uint32 size,
+    sc_uint32 const * other_ids,
+    sc_uint32 other_size)
+{
+  sc_uint32 count = 0;
+  sc_uint32 i = 0;
+  sc_uint32 j = 0;
+
+#if defined(__SSE2__)
+  while (i + 4 <= size && j + 4 <= other_size)
+  {
+    __m128i const block = _mm_loadu_si128((__m128i const *)(ids + i));
+    __m128i const other_block = _mm_loadu_si128((__m128i const *)(other_ids + j));
+
+    // block is compared with all rotations of other block
+    __m128i equal = _mm_cmpeq_epi32(block, other_block);
+    equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(other_block, _MM_SHUFFLE(0, 3, 2, 1))));
+    equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(other_block, _MM_SHUFFLE(1, 0, 3, 2))));
+    equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block, _mm_shuffle_epi32(other_block, _MM_SHUFFLE(2, 1, 0, 3))));
+    sc_uint32 mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+
+    sc_uint32 block_ids[4];
+    _mm_storeu_si128((__m128i *)block_ids, block);
+    while (mask != 0)
+    {
+      ids[count++] = block_ids[__builtin_ctz(mask)];
+      mask &= mask - 1;
+    }
+
+    sc_uint32 const max_id = block_ids[3];
+    sc_uint32 const other_max_id = other_ids[j + 3];
+    if (max_id <= other_max_id)
+      i += 4;
+    if (other_max_id <= max_id)
+      j += 4;
+  }
+#endif
+
+  while (i < size && j < other_size)
+  {
+    if (ids[i] < other_ids[j])
+      ++i;
+    else if (other_ids[j] < ids[i])
+      ++j;
+    else
+    {
+      ids[count++] = ids[i];
+      ++i;
+      ++j;
+    }
+  }
+
+  return count;
+}
+
+int _sc_fs_memory_trigrams_compare_keys(void const * key, void const * other_key)
+{
+  sc_uint32 const a = *(sc_uint32 const *)key;
+  sc_uint32 const b = *(sc_uint32 const *)other_key;
+  return (a > b) - (a < b);
+}
+
+int _sc_fs_memory_trigrams_compare_postings_sizes(void const * postings, void const * other_postings)
+{
+  sc_uint32 const a = (*(sc_fs_memory_trigram_postings const * const *)postings)->size;
+  sc_uint32 const b = (*(sc_fs_memory_trigram_postings const * const *)other_postings)->size;
+  return (a > b) - (a < b);
+}
+
+sc_bool sc_fs_memory_trigrams_find(
+    sc_fs_memory_trigrams * trigrams,
+    sc_char const * substring,
+    sc_uint64 substring_size,
+    sc_uint64 ** string_offsets,
+    sc_uint32 * string_offsets_count)
+{
+  *string_offsets = null_ptr;
+  *string_offsets_count = 0;
+  if (substring_size < SC_FS_MEMORY_TRIGRAM_SIZE)
+    return SC_FALSE;
+
+  sc_uint32 keys_count = substring_size - SC_FS_MEMORY_TRIGRAM_SIZE + 1;
+  sc_uint32 * keys = sc_mem_new(sc_uint32, keys_count);
+  for (sc_uint32 i = 0; i < keys_count; ++i)
+    keys[i] = _sc_fs_memory_trigrams_get_key(substring + i);
+
+  // repeated trigrams of substring are intersected once
+  qsort(keys, keys_count, sizeof(sc_uint32), _sc_fs_memory_trigrams_compare_keys);
+  sc_uint32 unique_keys_count = 0;
+  for (sc_uint32 i = 0; i < keys_count; ++i)
+  {
+    if (unique_keys_count == 0 || keys[unique_keys_count - 1] != keys[i])
+      keys[unique_keys_count++] = keys[i];
+  }
+  keys_count = unique_keys_count;
+
+  sc_fs_memory_trigram_postings ** postings = sc_mem_new(sc_fs_memory_trigram_postings *, keys_count);
+  sc_uint32 * ids = null_ptr;
+  sc_uint32 ids_count = 0;
+
+  sc_monitor_acquire_read(&trigrams->monitor);
+
+  for (sc_uint32 i = 0; i < keys_count; ++i)
+  {
+    postings[i] = _sc_fs_memory_trigrams_find_slot(trigrams->slots, trigrams->capacity, keys[i]);
+    if (postings[i]->key == 0)
+      goto result;
+  }
+
+  // the shortest lists are intersected first, so intermediate lists are short
+  qsort(postings, keys_count, sizeof(sc_fs_memory_trigram_postings *), _sc_fs_memory_trigrams_compare_postings_sizes);
+
+  ids_count = postings[0]->size;
+  ids = sc_mem_new(sc_uint32, ids_count);
+  memcpy(ids, postings[0]->ids, ids_count * sizeof(sc_uint32));
+  for (sc_uint32 i = 1; i < keys_count && ids_count != 0; ++i)
+  {
+    sc_fs_memory_trigram_postings const * other_postings = postings[i];
+    if (other_postings->size / ids_count >= SC_FS_MEMORY_TRIGRAMS_GALLOPING_RATIO)
+      ids_count = _sc_fs_memory_trigrams_intersect_galloping(ids, ids_count, other_postings->ids, other_postings->size);
+    else
+      ids_count = _sc_fs_memory_trigrams_intersect_merging(ids, ids_count, other_postings->ids, other_postings->size);
+  }
+
+  if (ids_count != 0)
+  {
+    *string_offsets = sc_mem_new(sc_uint64, ids_count);
+    for (sc_uint32 i = 0; i < ids_count; ++i)
+      (*string_offsets)[i] = trigrams->string_offsets[ids[i]];
+    *string_offsets_count = ids_count;
+  }
+
+result:
+  sc_monitor_release_read(&trigrams->monitor);
+
+  sc_mem_free(ids);
+  sc_mem_free(postings);
+  sc_mem_free(keys);
+  return SC_TRUE;
+}
+
+void sc_fs_memory_trigrams_get_memory_size(
+    sc_fs_memory_trigrams * trigrams,
+    sc_uint64 * strings_count,
+    sc_uint64 * trigrams_count,
+    sc_uint64 * memory_size)
+{
+  sc_monitor_acquire_read(&trigrams->monitor);
+  *strings_count = trigrams->strings_count;
+  *trigrams_count = trigrams->size;
+  *memory_size = sizeof(sc_fs_memory_trigrams) + trigrams->capacity * sizeof(sc_fs_memory_trigram_postings)
+                 + trigrams->postings_size * sizeof(sc_uint32) + trigrams->strings_capacity * sizeof(sc_uint64);
+  sc_monitor_release_read(&trigrams->monitor);
+}
@@ -0,0 +1,72 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_fs_memory_trigrams_h_
+#define _sc_fs_memory_trigrams_h_
+
+#include "sc-core/sc_types.h"
+
+//! Size of n-grams of strings indexed by trigrams index
+#define SC_FS_MEMORY_TRIGRAM_SIZE 3
+
+/*! Index of strings by their trigrams. Every trigram of indexed strings has sorted list of identifiers of strings
+ * containing it, strings containing substring are candidates from intersection of lists of all trigrams of substring.
+ * Strings are identified by their offsets, they are appended once and aren't removed, since strings are never
+ * rewritten in strings channels.
+ */
+typedef struct _sc_fs_memory_trigrams sc_fs_memory_trigrams;
+
+/*! Creates empty trigrams index.
+ * @returns Pointer to created trigrams index.
+ */
+sc_fs_memory_trigrams * sc_fs_memory_trigrams_new(void);
+
+/*! Frees trigrams index and all its lists of strings.
+ * @param trigrams Pointer to trigrams index
+ */
+void sc_fs_memory_trigrams_free(sc_fs_memory_trigrams * trigrams);
+
+/*! Appends string to trigrams index. Every string offset must be appended only once.
+ * @param trigrams Pointer to trigrams index
+ * @param string Bytes of string
+ * @param string_size Size of string
+ * @param string_offset Offset of string
+ */
+void sc_fs_memory_trigrams_append(
+    sc_fs_memory_trigrams * trigrams,
+    sc_char const * string,
+    sc_uint64 string_size,
+    sc_uint64 string_offset);
+
+/*! Finds offsets of strings that contain all trigrams of substring. Found strings are candidates, they must be checked
+ * if they contain substring.
+ * @param trigrams Pointer to trigrams index
+ * @param substring Bytes of substring
+ * @param substring_size Size of substring
+ * @param[out] string_offsets Offsets of found strings in order of their appending, they must be freed
+ * @param[out] string_offsets_count Count of found strings
+ * @returns SC_FALSE, if substring is shorter than trigram, so strings can't be found by trigrams index.
+ */
+sc_bool sc_fs_memory_trigrams_find(
+    sc_fs_memory_trigrams * trigrams,
+    sc_char const * substring,
+    sc_uint64 substring_size,
+    sc_uint64 ** string_offsets,
+    sc_uint32 * string_offsets_count);
+
+/*! Gets count of strings, count of trigrams and size of memory of trigrams index.
+ * @param trigrams Pointer to trigrams index
+ * @param[out] strings_count Count of appended strings
+ * @param[out] trigrams_count Count of distinct trigrams of appended strings
+ * @param[out] memory_size Size of memory of trigrams index in bytes
+ */
+void sc_fs_memory_trigrams_get_memory_size(
+    sc_fs_memory_trigrams * trigrams,
+    sc_uint64 * strings_count,
+    sc_uint64 * trigrams_count,
+    sc_uint64 * memory_size);
+
+#endif
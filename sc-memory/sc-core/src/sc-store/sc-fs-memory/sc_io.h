@@ -29,6 +29,8 @@ typedef GIOChannel sc_io_channel;
 
 #define sc_io_channel_set_encoding(channel, encoding, errors) g_io_channel_set_encoding(channel, encoding, errors)
 
+#define sc_io_channel_set_buffer_size(channel, size) g_io_channel_set_buffer_size(channel, size)
+
 #define sc_io_channel_flush(channel, errors) g_io_channel_flush(channel, errors)
 
 #define sc_io_channel_shutdown(channel, flush, errors) \
@@ -43,4 +45,6 @@ typedef GIOChannel sc_io_channel;
 
 #define sc_io_channel_seek(channel, offset, type, errors) g_io_channel_seek_position(channel, offset, type, errors)
 
+#define sc_io_channel_get_fd(channel) g_io_channel_unix_get_fd(channel)
+
 #endif
@@ -0,0 +1,347 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+
+#  include "sc_arcs_index.h"
+
+#  include "sc-core/sc-base/sc_allocator.h"
+#  include "sc-store/sc-base/sc_monitor_private.h"
+#  include "sc-store/sc-container/sc_hash_table.h"
+
+#  include "sc_element.h"
+#  include "sc_storage.h"
+#  include "sc_storage_private.h"
+#  include "sc_memory_private.h"
+
+#  define SC_ARCS_INDEX_INITIAL_BUCKETS_CAPACITY 4
+
+#  define _sc_arcs_index_have_different_subtypes(type, other_type, mask) \
+    ({ \
+      sc_type const subtype = (type) & (mask); \
+      sc_type const other_subtype = (other_type) & (mask); \
+      subtype != sc_type_unknown && other_subtype != sc_type_unknown && subtype != other_subtype; \
+    })
+
+typedef struct
+{
+  sc_type type;
+  sc_addr first_arc;
+  sc_addr last_arc;
+} sc_arcs_index_bucket;
+
+typedef struct
+{
+  sc_arcs_index_bucket * buckets;
+  sc_uint32 size;
+  sc_uint32 capacity;
+} sc_arcs_index;
+
+sc_uint32 arcs_index_threshold = 0;
+sc_hash_table * outgoing_arcs_indexes = null_ptr;
+sc_hash_table * incoming_arcs_indexes = null_ptr;
+sc_monitor arcs_indexes_monitor;
+
+void _sc_arcs_index_free(sc_pointer data)
+{
+  sc_arcs_index * index = data;
+  sc_mem_free(index->buckets);
+  sc_mem_free(index);
+}
+
+void sc_arcs_index_initialize(sc_memory_params const * params)
+{
+  arcs_index_threshold = params->arcs_index_threshold;
+  outgoing_arcs_indexes = sc_hash_table_init(g_direct_hash, g_direct_equal, null_ptr, _sc_arcs_index_free);
+  incoming_arcs_indexes = sc_hash_table_init(g_direct_hash, g_direct_equal, null_ptr, _sc_arcs_index_free);
+  sc_monitor_init(&arcs_indexes_monitor);
+
+  sc_message("\tArcs index threshold: %u", arcs_index_threshold);
+}
+
+void sc_arcs_index_shutdown()
+{
+  sc_hash_table_destroy(outgoing_arcs_indexes);
+  outgoing_arcs_indexes = null_ptr;
+  sc_hash_table_destroy(incoming_arcs_indexes);
+  incoming_arcs_indexes = null_ptr;
+  sc_monitor_destroy(&arcs_indexes_monitor);
+  arcs_index_threshold = 0;
+}
+
+sc_addr * _sc_arcs_index_get_prev_arc(sc_element * arc, sc_bool is_outgoing)
+{
+  sc_arc_info * info = sc_element_get_arc(arc);
+  return is_outgoing ? &info->prev_out_arc_of_type : &info->prev_in_arc_of_type;
+}
+
+sc_addr * _sc_arcs_index_get_next_arc(sc_element * arc, sc_bool is_outgoing)
+{
+  sc_arc_info * info = sc_element_get_arc(arc);
+  return is_outgoing ? &info->next_out_arc_of_type : &info->next_in_arc_of_type;
+}
+
+sc_arcs_index * _sc_arcs_index_get(sc_addr element_addr, sc_bool is_outgoing)
+{
+  sc_monitor_acquire_read(&arcs_indexes_monitor);
+  sc_arcs_index * index = sc_hash_table_get(
+      is_outgoing ? outgoing_arcs_indexes : incoming_arcs_indexes,
+      GUINT_TO_POINTER(SC_ADDR_LOCAL_TO_INT(element_addr)));
+  sc_monitor_release_read(&arcs_indexes_monitor);
+  return index;
+}
+
+sc_arcs_index * _sc_arcs_index_get_by_element(sc_addr element_addr, sc_element * element, sc_bool is_outgoing)
+{
+  // indexes of sc-elements, loaded from saved state, aren't restored, so the state is only a hint
+  sc_states const state = is_outgoing ? SC_STATE_HAS_OUTGOING_ARCS_INDEX : SC_STATE_HAS_INCOMING_ARCS_INDEX;
+  if ((element->flags.states & state) != state)
+    return null_ptr;
+
+  return _sc_arcs_index_get(element_addr, is_outgoing);
+}
+
+sc_arcs_index_bucket * _sc_arcs_index_get_bucket(sc_arcs_index * index, sc_type type)
+{
+  for (sc_uint32 i = 0; i < index->size; ++i)
+  {
+    if (index->buckets[i].type == type)
+      return &index->buckets[i];
+  }
+
+  if (index->size == index->capacity)
+  {
+    sc_uint32 const new_capacity =
+        index->capacity == 0 ? SC_ARCS_INDEX_INITIAL_BUCKETS_CAPACITY : index->capacity * 2;
+    sc_arcs_index_bucket * new_buckets = sc_mem_new(sc_arcs_index_bucket, new_capacity);
+    sc_mem_cpy(new_buckets, index->buckets, sizeof(sc_arcs_index_bucket) * index->size);
+    sc_mem_free(index->buckets);
+    index->buckets = new_buckets;
+    index->capacity = new_capacity;
+  }
+
+  sc_arcs_index_bucket * bucket = &index->buckets[index->size++];
+  *bucket = (sc_arcs_index_bucket){type, SC_ADDR_EMPTY, SC_ADDR_EMPTY};
+  return bucket;
+}
+
+void _sc_arcs_index_append_arc(sc_arcs_index * index, sc_addr arc_addr, sc_element * arc, sc_bool is_outgoing)
+{
+  sc_arcs_index_bucket * bucket = _sc_arcs_index_get_bucket(index, arc->flags.type);
+
+  *_sc_arcs_index_get_prev_arc(arc, is_outgoing) = bucket->last_arc;
+  *_sc_arcs_index_get_next_arc(arc, is_outgoing) = SC_ADDR_EMPTY;
+
+  sc_element * last_arc;
+  if (sc_storage_get_element_by_addr(bucket->last_arc, &last_arc) == SC_RESULT_OK)
+    *_sc_arcs_index_get_next_arc(last_arc, is_outgoing) = arc_addr;
+  else
+    bucket->first_arc = arc_addr;
+
+  bucket->last_arc = arc_addr;
+}
+
+void _sc_arcs_index_prepend_arc(sc_arcs_index * index, sc_addr arc_addr, sc_element * arc, sc_bool is_outgoing)
+{
+  sc_arcs_index_bucket * bucket = _sc_arcs_index_get_bucket(index, arc->flags.type);
+
+  *_sc_arcs_index_get_prev_arc(arc, is_outgoing) = SC_ADDR_EMPTY;
+  *_sc_arcs_index_get_next_arc(arc, is_outgoing) = bucket->first_arc;
+
+  sc_element * first_arc;
+  if (sc_storage_get_element_by_addr(bucket->first_arc, &first_arc) == SC_RESULT_OK)
+    *_sc_arcs_index_get_prev_arc(first_arc, is_outgoing) = arc_addr;
+  else
+    bucket->last_arc = arc_addr;
+
+  bucket->first_arc = arc_addr;
+}
+
+sc_addr _sc_arcs_index_get_next_connector(sc_addr element_addr, sc_element * connector, sc_bool is_outgoing)
+{
+  sc_arc_info const * info = sc_element_get_arc(connector);
+  if (sc_type_has_subtype(connector->flags.type, sc_type_common_edge) && SC_ADDR_IS_EQUAL(element_addr, info->end))
+    return is_outgoing ? info->next_end_out_arc : info->next_end_in_arc;
+  if (sc_type_has_subtype(connector->flags.type, sc_type_common_edge))
+    return is_outgoing ? info->next_begin_out_arc : info->next_begin_in_arc;
+
+  return is_outgoing ? info->next_begin_out_arc : info->next_end_in_arc;
+}
+
+void _sc_arcs_index_build(sc_addr element_addr, sc_element * element, sc_bool is_outgoing)
+{
+  sc_arcs_index * index = sc_mem_new(sc_arcs_index, 1);
+
+  // sc-arcs are appended to buckets in order of the list of sc-connectors, so the newest ones are first as there
+  sc_addr connector_addr = is_outgoing ? element->first_out_arc : element->first_in_arc;
+  while (SC_ADDR_IS_NOT_EMPTY(connector_addr))
+  {
+    sc_element * connector;
+    if (sc_storage_get_element_by_addr(connector_addr, &connector) != SC_RESULT_OK)
+      break;
+
+    if (sc_type_has_subtype(connector->flags.type, sc_type_arc))
+      _sc_arcs_index_append_arc(index, connector_addr, connector, is_outgoing);
+
+    connector_addr = _sc_arcs_index_get_next_connector(element_addr, connector, is_outgoing);
+  }
+
+  sc_monitor_acquire_write(&arcs_indexes_monitor);
+  sc_hash_table_insert(
+      is_outgoing ? outgoing_arcs_indexes : incoming_arcs_indexes,
+      GUINT_TO_POINTER(SC_ADDR_LOCAL_TO_INT(element_addr)),
+      index);
+  sc_monitor_release_write(&arcs_indexes_monitor);
+
+  element->flags.states |= is_outgoing ? SC_STATE_HAS_OUTGOING_ARCS_INDEX : SC_STATE_HAS_INCOMING_ARCS_INDEX;
+}
+
+void sc_arcs_index_add_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_bool is_outgoing)
+{
+  if (arcs_index_threshold == 0)
+    return;
+
+  sc_arcs_index * index = _sc_arcs_index_get_by_element(element_addr, element, is_outgoing);
+  if (index != null_ptr)
+  {
+    _sc_arcs_index_prepend_arc(index, arc_addr, arc, is_outgoing);
+    return;
+  }
+
+  sc_uint32 const arcs_count = is_outgoing ? element->outgoing_arcs_count : element->incoming_arcs_count;
+  if (arcs_count >= arcs_index_threshold)
+    _sc_arcs_index_build(element_addr, element, is_outgoing);
+}
+
+void sc_arcs_index_remove_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_bool is_outgoing)
+{
+  sc_arcs_index * index = _sc_arcs_index_get_by_element(element_addr, element, is_outgoing);
+  if (index == null_ptr)
+    return;
+
+  sc_addr const prev_arc_addr = *_sc_arcs_index_get_prev_arc(arc, is_outgoing);
+  sc_addr const next_arc_addr = *_sc_arcs_index_get_next_arc(arc, is_outgoing);
+
+  sc_element * prev_arc;
+  if (sc_storage_get_element_by_addr(prev_arc_addr, &prev_arc) == SC_RESULT_OK)
+    *_sc_arcs_index_get_next_arc(prev_arc, is_outgoing) = next_arc_addr;
+
+  sc_element * next_arc;
+  if (sc_storage_get_element_by_addr(next_arc_addr, &next_arc) == SC_RESULT_OK)
+    *_sc_arcs_index_get_prev_arc(next_arc, is_outgoing) = prev_arc_addr;
+
+  // type of sc-arc could be changed after it was indexed, so its bucket is found by its position
+  if (SC_ADDR_IS_EMPTY(prev_arc_addr) || SC_ADDR_IS_EMPTY(next_arc_addr))
+  {
+    for (sc_uint32 i = 0; i < index->size; ++i)
+    {
+      sc_arcs_index_bucket * bucket = &index->buckets[i];
+      if (SC_ADDR_IS_EQUAL(bucket->first_arc, arc_addr))
+        bucket->first_arc = next_arc_addr;
+      if (SC_ADDR_IS_EQUAL(bucket->last_arc, arc_addr))
+        bucket->last_arc = prev_arc_addr;
+    }
+  }
+}
+
+void sc_arcs_index_erase(sc_addr element_addr, sc_element * element)
+{
+  if ((element->flags.states & (SC_STATE_HAS_OUTGOING_ARCS_INDEX | SC_STATE_HAS_INCOMING_ARCS_INDEX)) == 0)
+    return;
+
+  sc_pointer const key = GUINT_TO_POINTER(SC_ADDR_LOCAL_TO_INT(element_addr));
+  sc_monitor_acquire_write(&arcs_indexes_monitor);
+  sc_hash_table_remove(outgoing_arcs_indexes, key);
+  sc_hash_table_remove(incoming_arcs_indexes, key);
+  sc_monitor_release_write(&arcs_indexes_monitor);
+}
+
+/*! Checks that sc-arcs of the bucket type can have or obtain the searched type. Sc-arcs types can be only extended,
+ * so the types mustn't have different subtypes in the same mask.
+ */
+sc_bool _sc_arcs_index_is_bucket_matched(sc_type bucket_type, sc_type arc_type)
+{
+  sc_type const masks[] = {
+      sc_type_arc_mask & ~sc_type_arc,
+      sc_type_constancy_mask,
+      sc_type_actuality_mask & ~sc_type_membership_arc,
+      sc_type_permanency_mask & ~sc_type_membership_arc,
+      sc_type_positivity_mask & ~sc_type_membership_arc,
+  };
+
+  for (sc_uint32 i = 0; i < sizeof(masks) / sizeof(masks[0]); ++i)
+  {
+    if (_sc_arcs_index_have_different_subtypes(bucket_type, arc_type, masks[i]))
+      return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+sc_addr _sc_arcs_index_get_first_matched_arc(sc_arcs_index const * index, sc_uint32 bucket_index, sc_type arc_type)
+{
+  for (sc_uint32 i = bucket_index; i < index->size; ++i)
+  {
+    sc_arcs_index_bucket const * bucket = &index->buckets[i];
+    // types of sc-arcs can be extended after they are indexed, so buckets of more general types are walked too
+    if (SC_ADDR_IS_NOT_EMPTY(bucket->first_arc) && _sc_arcs_index_is_bucket_matched(bucket->type, arc_type))
+      return bucket->first_arc;
+  }
+
+  return SC_ADDR_EMPTY;
+}
+
+sc_bool sc_arcs_index_get_first_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_type arc_type,
+    sc_bool is_outgoing,
+    sc_addr * arc_addr)
+{
+  sc_arcs_index * index = _sc_arcs_index_get_by_element(element_addr, element, is_outgoing);
+  if (index == null_ptr)
+    return SC_FALSE;
+
+  *arc_addr = _sc_arcs_index_get_first_matched_arc(index, 0, arc_type);
+  return SC_TRUE;
+}
+
+sc_addr sc_arcs_index_get_next_arc(
+    sc_addr element_addr,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_type arc_type,
+    sc_bool is_outgoing)
+{
+  sc_addr const next_arc_addr = *_sc_arcs_index_get_next_arc(arc, is_outgoing);
+  if (SC_ADDR_IS_NOT_EMPTY(next_arc_addr))
+    return next_arc_addr;
+
+  sc_arcs_index * index = _sc_arcs_index_get(element_addr, is_outgoing);
+  if (index == null_ptr)
+    return SC_ADDR_EMPTY;
+
+  // sc-arc is the last one in its bucket, so sc-arcs are searched in the next buckets
+  for (sc_uint32 i = 0; i < index->size; ++i)
+  {
+    if (SC_ADDR_IS_EQUAL(index->buckets[i].last_arc, arc_addr))
+      return _sc_arcs_index_get_first_matched_arc(index, i + 1, arc_type);
+  }
+
+  return SC_ADDR_EMPTY;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_arcs_index_h_
+#define _sc_arcs_index_h_
+
+#include "sc-core/sc_types.h"
+#include "sc-core/sc_memory_params.h"
+
+/* Index of sc-arcs of high-degree sc-elements by types of sc-arcs. Outgoing and incoming sc-arcs of such sc-element
+ * are split into buckets of sc-arcs with the same type. Sc-arcs of a bucket are linked by their fields `*_arc_of_type`,
+ * so iterators with concrete type of sc-arcs walk only buckets, which sc-arcs can have this type.
+ *
+ * Index of sc-element is built when count of its outgoing or incoming sc-arcs reaches `arcs_index_threshold`.
+ * All functions, except initialization, are called under monitor of indexed sc-element. Sc-edges are not indexed.
+ */
+
+/*! Configures index of sc-arcs.
+ * @param params Sc-memory params with `arcs_index_threshold`
+ */
+void sc_arcs_index_initialize(sc_memory_params const * params);
+
+//! Destroys indexes of all sc-elements
+void sc_arcs_index_shutdown();
+
+/*! Adds sc-arc to index of sc-element, or builds the index if count of sc-arcs of sc-element reaches threshold.
+ * @param element_addr Sc-address of begin (if `is_outgoing`) or end sc-element of sc-arc
+ * @param element Begin or end sc-element of sc-arc, sc-arc is already linked into its list of sc-connectors
+ * @param arc_addr Sc-address of sc-arc
+ * @param arc Sc-arc to add
+ * @param is_outgoing SC_TRUE, if sc-arc is added to outgoing sc-arcs of sc-element, otherwise to incoming ones
+ * @note Monitor of sc-element must be acquired for write.
+ */
+void sc_arcs_index_add_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_bool is_outgoing);
+
+/*! Removes sc-arc from index of sc-element, if sc-element is indexed.
+ * @note Monitor of sc-element must be acquired for write.
+ */
+void sc_arcs_index_remove_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_bool is_outgoing);
+
+/*! Destroys indexes of erased sc-element.
+ * @note Monitor of sc-element must be acquired for write.
+ */
+void sc_arcs_index_erase(sc_addr element_addr, sc_element * element);
+
+/*! Gets the first sc-arc of sc-element, which type can be extended to specified one.
+ * @param element_addr Sc-address of sc-element
+ * @param element Sc-element
+ * @param arc_type Searched type of sc-arcs
+ * @param is_outgoing SC_TRUE, if outgoing sc-arcs are searched, otherwise incoming ones
+ * @param[out] arc_addr Sc-address of the first sc-arc or SC_ADDR_EMPTY, it isn't changed if sc-element isn't indexed
+ * @returns SC_TRUE, if sc-element is indexed, so next sc-arcs must be got by `sc_arcs_index_get_next_arc`.
+ * @note Monitor of sc-element must be acquired for read.
+ */
+sc_bool sc_arcs_index_get_first_arc(
+    sc_addr element_addr,
+    sc_element * element,
+    sc_type arc_type,
+    sc_bool is_outgoing,
+    sc_addr * arc_addr);
+
+/*! Gets sc-arc of sc-element after specified one, which type can be extended to specified one.
+ * @returns Sc-address of the next sc-arc or SC_ADDR_EMPTY, if there are no more sc-arcs.
+ * @note Monitor of sc-element must be acquired for read.
+ */
+sc_addr sc_arcs_index_get_next_arc(
+    sc_addr element_addr,
+    sc_addr arc_addr,
+    sc_element * arc,
+    sc_type arc_type,
+    sc_bool is_outgoing);
+
+#endif
@@ -0,0 +1,295 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_connectors_index.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include "sc-store/sc-base/sc_monitor_private.h"
+#include "sc-store/sc-container/sc_hash_table.h"
+
+#include "sc_storage.h"
+#include "sc_memory_private.h"
+
+#define SC_CONNECTORS_INDEX_SHARDS_COUNT 64
+// glib hash table stores pointers to key and value and hash of key for every entry
+#define SC_CONNECTORS_INDEX_ENTRY_OVERHEAD (2 * sizeof(sc_pointer) + sizeof(sc_uint32))
+
+typedef struct
+{
+  sc_addr connector;
+  sc_uint32 number;  // number of sc-connector in order of adding to shard
+} sc_connectors_pair_entry;
+
+typedef struct
+{
+  sc_uint64 key;  // begin and end sc-elements, it is also key of hash table
+  sc_connectors_pair_entry * entries;  // removed sc-connectors are left as entries with empty sc-addrs
+  sc_uint32 size;
+  sc_uint32 capacity;
+  sc_uint32 removed_count;  // count of entries of removed sc-connectors
+  sc_uint32 generation;  // it is changed when entries are compacted, so indexes of positions of iteration are stale
+} sc_connectors_pair;
+
+typedef struct
+{
+  sc_hash_table * pairs;
+  sc_monitor monitor;
+  sc_uint64 size;
+  sc_uint32 last_number;      // the last number of added sc-connector, numbers of sc-connectors of pairs grow
+  sc_uint32 last_generation;  // the last generation of pairs, generations of pairs with the same key don't repeat
+} sc_connectors_index_shard;
+
+sc_uint32 connectors_index_enabled = SC_FALSE;  // it is accessed atomically, because statistics is read without locks
+sc_connectors_index_shard * connectors_index_shards = null_ptr;  // shards aren't freed until shutdown
+
+void _sc_connectors_pair_free(sc_pointer data)
+{
+  sc_connectors_pair * pair = data;
+  sc_mem_free(pair->entries);
+  sc_mem_free(pair);
+}
+
+// `g_int64_hash` takes only the lower half of key, so sc-connectors incoming to the same sc-element would collide
+guint _sc_connectors_index_hash(gconstpointer key)
+{
+  return (guint)((*(sc_uint64 const *)key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+sc_uint64 _sc_connectors_pair_get_size(sc_connectors_pair const * pair)
+{
+  return sizeof(sc_connectors_pair) + pair->capacity * sizeof(sc_connectors_pair_entry)
+         + SC_CONNECTORS_INDEX_ENTRY_OVERHEAD;
+}
+
+void sc_connectors_index_initialize(sc_memory_params const * params)
+{
+  sc_message("\tConnectors index: %s", params->connectors_index ? "On" : "Off");
+  if (params->connectors_index)
+    sc_connectors_index_enable();
+}
+
+void sc_connectors_index_shutdown()
+{
+  g_atomic_int_set(&connectors_index_enabled, SC_FALSE);
+  if (connectors_index_shards == null_ptr)
+    return;
+
+  for (sc_uint32 i = 0; i < SC_CONNECTORS_INDEX_SHARDS_COUNT; ++i)
+  {
+    sc_connectors_index_shard * shard = &connectors_index_shards[i];
+    sc_hash_table_destroy(shard->pairs);
+    sc_monitor_destroy(&shard->monitor);
+  }
+  sc_mem_free(connectors_index_shards);
+  connectors_index_shards = null_ptr;
+}
+
+void sc_connectors_index_enable()
+{
+  if (connectors_index_shards == null_ptr)
+  {
+    connectors_index_shards = sc_mem_new(sc_connectors_index_shard, SC_CONNECTORS_INDEX_SHARDS_COUNT);
+    for (sc_uint32 i = 0; i < SC_CONNECTORS_INDEX_SHARDS_COUNT; ++i)
+    {
+      sc_connectors_index_shard * shard = &connectors_index_shards[i];
+      shard->pairs = sc_hash_table_init(_sc_connectors_index_hash, g_int64_equal, null_ptr, _sc_connectors_pair_free);
+      sc_monitor_init(&shard->monitor);
+    }
+  }
+
+  // shards are allocated before the index is published, so they are read by statistics without other locks
+  g_atomic_int_set(&connectors_index_enabled, SC_TRUE);
+}
+
+void sc_connectors_index_disable()
+{
+  g_atomic_int_set(&connectors_index_enabled, SC_FALSE);
+  if (connectors_index_shards == null_ptr)
+    return;
+
+  for (sc_uint32 i = 0; i < SC_CONNECTORS_INDEX_SHARDS_COUNT; ++i)
+  {
+    sc_connectors_index_shard * shard = &connectors_index_shards[i];
+    sc_monitor_acquire_write(&shard->monitor);
+    sc_hash_table_clear(shard->pairs);
+    shard->size = 0;
+    sc_monitor_release_write(&shard->monitor);
+  }
+}
+
+sc_bool sc_connectors_index_is_enabled()
+{
+  return g_atomic_int_get(&connectors_index_enabled) == SC_TRUE;
+}
+
+sc_uint64 _sc_connectors_index_get_key(sc_addr begin_addr, sc_addr end_addr)
+{
+  return ((sc_uint64)SC_ADDR_LOCAL_TO_INT(begin_addr) << 32) | SC_ADDR_LOCAL_TO_INT(end_addr);
+}
+
+sc_connectors_index_shard * _sc_connectors_index_get_shard(sc_uint64 const * key)
+{
+  return &connectors_index_shards[_sc_connectors_index_hash(key) % SC_CONNECTORS_INDEX_SHARDS_COUNT];
+}
+
+void sc_connectors_index_add(sc_addr begin_addr, sc_addr end_addr, sc_addr connector_addr)
+{
+  if (sc_connectors_index_is_enabled() == SC_FALSE)
+    return;
+
+  sc_uint64 const key = _sc_connectors_index_get_key(begin_addr, end_addr);
+  sc_connectors_index_shard * shard = _sc_connectors_index_get_shard(&key);
+
+  sc_monitor_acquire_write(&shard->monitor);
+
+  sc_connectors_pair * pair = sc_hash_table_get(shard->pairs, &key);
+  if (pair == null_ptr)
+  {
+    pair = sc_mem_new(sc_connectors_pair, 1);
+    pair->key = key;
+    pair->generation = ++shard->last_generation;
+    sc_hash_table_insert(shard->pairs, &pair->key, pair);
+  }
+  else
+    shard->size -= _sc_connectors_pair_get_size(pair);
+
+  if (pair->size == pair->capacity)
+  {
+    sc_uint32 const new_capacity = pair->capacity == 0 ? 1 : pair->capacity * 2;
+    sc_connectors_pair_entry * new_entries = sc_mem_new(sc_connectors_pair_entry, new_capacity);
+    sc_mem_cpy(new_entries, pair->entries, sizeof(sc_connectors_pair_entry) * pair->size);
+    sc_mem_free(pair->entries);
+    pair->entries = new_entries;
+    pair->capacity = new_capacity;
+  }
+
+  // sc-connectors are appended, so indexes of got ones stay valid and the newest ones aren't got by started iterations
+  pair->entries[pair->size++] = (sc_connectors_pair_entry){connector_addr, ++shard->last_number};
+  shard->size += _sc_connectors_pair_get_size(pair);
+
+  sc_monitor_release_write(&shard->monitor);
+}
+
+void sc_connectors_index_remove(sc_addr begin_addr, sc_addr end_addr, sc_addr connector_addr)
+{
+  if (sc_connectors_index_is_enabled() == SC_FALSE)
+    return;
+
+  sc_uint64 const key = _sc_connectors_index_get_key(begin_addr, end_addr);
+  sc_connectors_index_shard * shard = _sc_connectors_index_get_shard(&key);
+
+  sc_monitor_acquire_write(&shard->monitor);
+
+  sc_connectors_pair * pair = sc_hash_table_get(shard->pairs, &key);
+  if (pair == null_ptr)
+    goto end;
+
+  for (sc_uint32 i = 0; i < pair->size; ++i)
+  {
+    if (SC_ADDR_IS_NOT_EQUAL(pair->entries[i].connector, connector_addr))
+      continue;
+
+    // entries aren't shifted on every removal, so erasure of all sc-connectors of a pair isn't quadratic
+    pair->entries[i].connector = SC_ADDR_EMPTY;
+    ++pair->removed_count;
+    break;
+  }
+
+  if (pair->removed_count == pair->size)
+  {
+    shard->size -= _sc_connectors_pair_get_size(pair);
+    sc_hash_table_remove(shard->pairs, &key);
+  }
+  else if (pair->removed_count > pair->size / 2)
+  {
+    // order of sc-connectors is kept, so iterations over them are continued by numbers of sc-connectors
+    sc_uint32 live_size = 0;
+    for (sc_uint32 i = 0; i < pair->size; ++i)
+    {
+      if (SC_ADDR_IS_NOT_EMPTY(pair->entries[i].connector))
+        pair->entries[live_size++] = pair->entries[i];
+    }
+    pair->size = live_size;
+    pair->removed_count = 0;
+    pair->generation = ++shard->last_generation;
+  }
+
+end:
+  sc_monitor_release_write(&shard->monitor);
+}
+
+sc_bool sc_connectors_index_get_next(
+    sc_addr begin_addr,
+    sc_addr end_addr,
+    sc_connectors_index_position * position,
+    sc_addr * connector_addr)
+{
+  if (sc_connectors_index_is_enabled() == SC_FALSE)
+    return SC_FALSE;
+
+  sc_bool is_found = SC_FALSE;
+  sc_uint64 const key = _sc_connectors_index_get_key(begin_addr, end_addr);
+  sc_connectors_index_shard * shard = _sc_connectors_index_get_shard(&key);
+
+  sc_monitor_acquire_read(&shard->monitor);
+
+  sc_connectors_pair * pair = sc_hash_table_get(shard->pairs, &key);
+  if (pair == null_ptr)
+    goto end;
+
+  // sc-connectors before `next_index` are generated before the last got one
+  sc_uint32 next_index = pair->size;
+  if (position->number != 0 && position->generation == pair->generation)
+    next_index = position->index;
+  else if (position->number != 0)
+  {
+    // sc-connectors are removed after the last got one, so it is found by its number among ordered ones
+    sc_uint32 low = 0;
+    sc_uint32 high = pair->size;
+    while (low < high)
+    {
+      sc_uint32 const middle = low + (high - low) / 2;
+      if (pair->entries[middle].number < position->number)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    next_index = low;
+  }
+
+  while (next_index > 0 && SC_ADDR_IS_EMPTY(pair->entries[next_index - 1].connector))
+    --next_index;
+
+  if (next_index > 0)
+  {
+    sc_connectors_pair_entry const * entry = &pair->entries[next_index - 1];
+    *position = (sc_connectors_index_position){next_index - 1, pair->generation, entry->number};
+    *connector_addr = entry->connector;
+    is_found = SC_TRUE;
+  }
+
+end:
+  sc_monitor_release_read(&shard->monitor);
+  return is_found;
+}
+
+sc_uint64 sc_connectors_index_get_size()
+{
+  if (sc_connectors_index_is_enabled() == SC_FALSE)
+    return 0;
+
+  sc_uint64 size = sizeof(sc_connectors_index_shard) * SC_CONNECTORS_INDEX_SHARDS_COUNT;
+  for (sc_uint32 i = 0; i < SC_CONNECTORS_INDEX_SHARDS_COUNT; ++i)
+  {
+    sc_connectors_index_shard * shard = &connectors_index_shards[i];
+    sc_monitor_acquire_read(&shard->monitor);
+    size += shard->size;
+    sc_monitor_release_read(&shard->monitor);
+  }
+
+  return size;
+}
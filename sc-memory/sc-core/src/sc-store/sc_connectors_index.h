@@ -0,0 +1,76 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_connectors_index_h_
+#define _sc_connectors_index_h_
+
+#include "sc-core/sc_types.h"
+#include "sc-core/sc_memory_params.h"
+#include "sc-core/sc_iterator3.h"
+
+/* Index of sc-connectors by pairs of their begin and end sc-elements. Every pair is mapped to sc-connectors between
+ * its sc-elements in order of their generation, so sc-connectors between two sc-elements are found without walking
+ * lists of sc-connectors of these sc-elements. Sc-edges are added for both directions.
+ *
+ * The index is split into shards with own monitors, so sc-connectors of different pairs are indexed concurrently.
+ * Monitors of shards aren't held while other monitors are acquired.
+ */
+
+/*! Enables empty index of sc-connectors if it is configured, existing sc-connectors must be added to it by caller.
+ * @param params Sc-memory params with `connectors_index`
+ */
+void sc_connectors_index_initialize(sc_memory_params const * params);
+
+/*! Destroys index of sc-connectors.
+ * @note It must be called when no other threads use index of sc-connectors.
+ */
+void sc_connectors_index_shutdown();
+
+/*! Enables empty index of sc-connectors, existing sc-connectors must be added to it by caller.
+ * @note It must be called when no other threads add, remove or get sc-connectors of the index, i.e. when all monitors
+ * of sc-addrs are acquired, since these functions are called under monitors of sc-addrs.
+ */
+void sc_connectors_index_enable();
+
+/*! Disables index of sc-connectors and clears it. Shards of the index are kept until shutdown, so its statistics is
+ * read without monitors of sc-addrs.
+ * @note It must be called when no other threads add, remove or get sc-connectors of the index, i.e. when all monitors
+ * of sc-addrs are acquired, since these functions are called under monitors of sc-addrs.
+ */
+void sc_connectors_index_disable();
+
+//! Returns SC_TRUE, if sc-connectors are indexed
+sc_bool sc_connectors_index_is_enabled();
+
+/*! Adds sc-connector to sc-connectors between its begin and end sc-elements.
+ * @param begin_addr Sc-address of begin sc-element of sc-connector (or of end one, for reverse direction of sc-edge)
+ * @param end_addr Sc-address of end sc-element of sc-connector
+ * @param connector_addr Sc-address of added sc-connector
+ */
+void sc_connectors_index_add(sc_addr begin_addr, sc_addr end_addr, sc_addr connector_addr);
+
+//! Removes sc-connector from sc-connectors between its begin and end sc-elements
+void sc_connectors_index_remove(sc_addr begin_addr, sc_addr end_addr, sc_addr connector_addr);
+
+/*! Gets sc-connector between two sc-elements, generated before the last got one. The newest sc-connectors are got
+ * first. Position of iteration keeps index of the last got sc-connector, so the next one is got without search, and
+ * its number, so iteration is continued from the same place if the last got sc-connector is removed.
+ * @param begin_addr Sc-address of begin sc-element
+ * @param end_addr Sc-address of end sc-element
+ * @param[in,out] position Position of iteration, zeroed one starts iteration from the newest sc-connector
+ * @param[out] connector_addr Sc-address of got sc-connector
+ * @returns SC_TRUE, if there is such sc-connector.
+ */
+sc_bool sc_connectors_index_get_next(
+    sc_addr begin_addr,
+    sc_addr end_addr,
+    sc_connectors_index_position * position,
+    sc_addr * connector_addr);
+
+//! Returns approximate size of memory used by index of sc-connectors in bytes
+sc_uint64 sc_connectors_index_get_size();
+
+#endif
@@ -23,6 +23,12 @@ struct _sc_arc_info
   sc_addr prev_in_arc_from_structure;
   sc_addr next_in_arc_from_structure;
 #endif
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  sc_addr prev_out_arc_of_type;
+  sc_addr next_out_arc_of_type;
+  sc_addr prev_in_arc_of_type;
+  sc_addr next_in_arc_of_type;
+#endif
 };
 
 /* Structure to store information for sc-elements.
@@ -61,10 +67,21 @@ struct _sc_element
   sc_addr first_in_arc_from_structure;
 #endif
 
+#ifndef SC_COMPACT_ELEMENTS
   sc_arc_info arc;
+#endif
 
   sc_uint32 incoming_arcs_count;
   sc_uint32 outgoing_arcs_count;
 };
 
+/* If sc-elements are compact, sc-element structure is only a header of sc-element, and information about
+ * sc-connector is stored right after the header. Segments of sc-nodes don't store it at all.
+ */
+#ifdef SC_COMPACT_ELEMENTS
+#  define sc_element_get_arc(element) ((sc_arc_info *)((element) + 1))
+#else
+#  define sc_element_get_arc(element) (&(element)->arc)
+#endif
+
 #endif
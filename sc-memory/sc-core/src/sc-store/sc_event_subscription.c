@@ -238,11 +238,46 @@ sc_result sc_event_subscription_destroy(sc_event_subscription * event_subscripti
   return SC_RESULT_OK;
 }
 
-sc_result sc_event_notify_element_deleted(sc_addr element)
+void _sc_event_notify_element_deleted(
+    sc_event_subscription_manager * subscription_manager,
+    sc_event_emission_manager * emission_manager,
+    sc_addr element)
 {
   sc_hash_table_list * element_events_list = null_ptr;
   sc_event_subscription * event_subscription = null_ptr;
 
+  // lookup for all registered to specified sc-element events
+  element_events_list = (sc_hash_table_list *)sc_hash_table_get(subscription_manager->events_table, TABLE_KEY(element));
+  if (element_events_list == null_ptr)
+    return;
+
+  sc_hash_table_remove(subscription_manager->events_table, TABLE_KEY(element));
+
+  while (element_events_list != null_ptr)
+  {
+    event_subscription = (sc_event_subscription *)element_events_list->data;
+
+    // mark event_subscription for deletion
+    sc_monitor_acquire_write(&event_subscription->monitor);
+
+    sc_monitor_acquire_write(&emission_manager->pool_monitor);
+    sc_queue_push(&emission_manager->deletable_events_subscriptions, event_subscription);
+    sc_monitor_release_write(&emission_manager->pool_monitor);
+
+    sc_monitor_release_write(&event_subscription->monitor);
+
+    element_events_list = sc_hash_table_list_remove_sublist(element_events_list, element_events_list);
+  }
+  sc_hash_table_list_destroy(element_events_list);
+}
+
+sc_result sc_event_notify_element_deleted(sc_addr element)
+{
+  return sc_event_notify_elements_deleted(&element, 1);
+}
+
+sc_result sc_event_notify_elements_deleted(sc_addr const * elements, sc_uint32 count)
+{
   sc_event_subscription_manager * subscription_manager = sc_storage_get_event_subscription_manager();
   sc_event_emission_manager * emission_manager = sc_storage_get_event_emission_manager();
 
@@ -251,35 +286,9 @@ sc_result sc_event_notify_element_deleted(sc_addr element)
     goto result;
 
   // TODO(NikitaZotov): Implement monitor for `subscription_manager` to synchronize its freeing.
-  // lookup for all registered to specified sc-element events
   sc_monitor_acquire_write(&subscription_manager->events_table_monitor);
-  if (subscription_manager != null_ptr)
-  {
-    element_events_list =
-        (sc_hash_table_list *)sc_hash_table_get(subscription_manager->events_table, TABLE_KEY(element));
-    if (element_events_list != null_ptr)
-      sc_hash_table_remove(subscription_manager->events_table, TABLE_KEY(element));
-  }
-
-  if (element_events_list != null_ptr)
-  {
-    while (element_events_list != null_ptr)
-    {
-      event_subscription = (sc_event_subscription *)element_events_list->data;
-
-      // mark event_subscription for deletion
-      sc_monitor_acquire_write(&event_subscription->monitor);
-
-      sc_monitor_acquire_write(&emission_manager->pool_monitor);
-      sc_queue_push(&emission_manager->deletable_events_subscriptions, event_subscription);
-      sc_monitor_release_write(&emission_manager->pool_monitor);
-
-      sc_monitor_release_write(&event_subscription->monitor);
-
-      element_events_list = sc_hash_table_list_remove_sublist(element_events_list, element_events_list);
-    }
-    sc_hash_table_list_destroy(element_events_list);
-  }
+  for (sc_uint32 i = 0; i < count; ++i)
+    _sc_event_notify_element_deleted(subscription_manager, emission_manager, elements[i]);
   sc_monitor_release_write(&subscription_manager->events_table_monitor);
 
 result:
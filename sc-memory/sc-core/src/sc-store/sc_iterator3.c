@@ -13,6 +13,8 @@
 #include "sc-store/sc_element.h"
 #include "sc-store/sc_storage.h"
 #include "sc-store/sc_storage_private.h"
+#include "sc-store/sc_arcs_index.h"
+#include "sc-store/sc_connectors_index.h"
 
 #include "sc_memory_context_manager.h"
 #include "sc_memory_context_private.h"
@@ -208,6 +210,8 @@ sc_iterator3 * sc_iterator3_new(
   it->type = type;
   it->ctx = ctx;
   it->finished = SC_FALSE;
+  it->is_arcs_index_used = SC_FALSE;
+  it->connectors_index_position = (sc_connectors_index_position){0, 0, 0};
 
   return it;
 }
@@ -222,7 +226,53 @@ void sc_iterator3_free(sc_iterator3 * it)
 
 sc_addr _sc_iterator3_get_other_edge_incident_element(sc_element * el, sc_addr incident_element)
 {
-  return SC_ADDR_IS_EQUAL(incident_element, el->arc.end) ? el->arc.begin : el->arc.end;
+  sc_arc_info const * arc = sc_element_get_arc(el);
+  return SC_ADDR_IS_EQUAL(incident_element, arc->end) ? arc->begin : arc->end;
+}
+
+sc_addr _sc_iterator3_get_next_outgoing_arc(
+    sc_iterator3 const * it,
+    sc_addr arc_addr,
+    sc_element * el,
+    sc_addr arc_begin)
+{
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  if (it->is_arcs_index_used)
+    return sc_arcs_index_get_next_arc(arc_begin, arc_addr, el, it->params[1].type, SC_TRUE);
+#else
+  (void)it;
+  (void)arc_addr;
+#endif
+
+  sc_arc_info const * arc = sc_element_get_arc(el);
+  return sc_type_has_subtype(el->flags.type, sc_type_common_edge)
+             ? SC_ADDR_IS_EQUAL(arc_begin, arc->end) ? arc->next_end_out_arc : arc->next_begin_out_arc
+             : arc->next_begin_out_arc;
+}
+
+sc_addr _sc_iterator3_get_next_incoming_arc(
+    sc_iterator3 const * it,
+    sc_addr arc_addr,
+    sc_element * el,
+    sc_addr arc_end,
+    sc_bool search_structure)
+{
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  if (it->is_arcs_index_used)
+    return sc_arcs_index_get_next_arc(arc_end, arc_addr, el, it->params[1].type, SC_FALSE);
+#else
+  (void)it;
+  (void)arc_addr;
+#endif
+
+  sc_arc_info const * arc = sc_element_get_arc(el);
+  return sc_type_has_subtype(el->flags.type, sc_type_common_edge)
+             ? SC_ADDR_IS_EQUAL(arc_end, arc->end) ? arc->next_end_in_arc : arc->next_begin_in_arc
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+             : (search_structure ? arc->next_in_arc_from_structure : arc->next_end_in_arc);
+#else
+             : arc->next_end_in_arc;
+#endif
 }
 
 sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
@@ -252,15 +302,17 @@ sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
       goto error;
 
     arc_addr = el->first_out_arc;
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    it->is_arcs_index_used = sc_type_has_subtype(it->params[1].type, sc_type_arc)
+                             && sc_arcs_index_get_first_arc(arc_begin, el, it->params[1].type, SC_TRUE, &arc_addr);
+#endif
   }
   else
   {
-    sc_bool const is_not_same = SC_ADDR_IS_NOT_EQUAL(arc_begin, it->results[1].addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
+    sc_bool const is_not_same = arc_monitor != monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(it->results[1].addr, &el);
     if (result != SC_RESULT_OK)
@@ -270,9 +322,7 @@ sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
       goto error;
     }
 
-    arc_addr = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-                   ? SC_ADDR_IS_EQUAL(arc_begin, el->arc.end) ? el->arc.next_end_out_arc : el->arc.next_begin_out_arc
-                   : el->arc.next_begin_out_arc;
+    arc_addr = _sc_iterator3_get_next_outgoing_arc(it, it->results[1].addr, el, arc_begin);
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -281,12 +331,10 @@ sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
   // iterate through outgoing sc-arcs
   while (SC_ADDR_IS_NOT_EMPTY(arc_addr))
   {
-    sc_bool const is_not_same = SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
+    sc_bool const is_not_same = arc_monitor != monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(arc_addr, &el);
     if (result != SC_RESULT_OK)
@@ -296,10 +344,7 @@ sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
       goto error;
     }
 
-    sc_addr next_out_arc =
-        sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-            ? SC_ADDR_IS_EQUAL(arc_begin, el->arc.end) ? el->arc.next_end_out_arc : el->arc.next_begin_out_arc
-            : el->arc.next_begin_out_arc;
+    sc_addr next_out_arc = _sc_iterator3_get_next_outgoing_arc(it, arc_addr, el, arc_begin);
 
     if (_sc_memory_context_check_local_and_global_permissions(
             sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_addr)
@@ -322,7 +367,7 @@ sc_bool _sc_iterator3_f_a_a_next(sc_iterator3 * it)
     sc_type arc_type = el->flags.type;
     sc_addr arc_end = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
                           ? _sc_iterator3_get_other_edge_incident_element(el, arc_begin)
-                          : el->arc.end;
+                          : sc_element_get_arc(el)->end;
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -364,6 +409,42 @@ success:
   return SC_TRUE;
 }
 
+sc_bool _sc_iterator3_f_a_f_find_indexed_arc(sc_iterator3 * it, sc_monitor * beg_monitor, sc_monitor * end_monitor)
+{
+  sc_addr const arc_begin = it->params[0].addr;
+  sc_addr const arc_end = it->params[2].addr;
+
+  sc_addr arc_addr;
+  while (sc_connectors_index_get_next(arc_begin, arc_end, &it->connectors_index_position, &arc_addr))
+  {
+    sc_monitor * arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
+    sc_bool const is_not_same = arc_monitor != beg_monitor && arc_monitor != end_monitor;
+    if (is_not_same)
+      sc_monitor_acquire_read(arc_monitor);
+
+    sc_element * el;
+    sc_bool const is_found =
+        sc_storage_get_element_by_addr(arc_addr, &el) == SC_RESULT_OK
+        && _sc_memory_context_check_local_and_global_permissions(
+               sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_addr)
+        && _sc_memory_context_check_global_permissions_to_read_permissions(
+               sc_memory_get_context_manager(), it->ctx, el, arc_addr, SC_CONTEXT_PERMISSIONS_TO_READ_PERMISSIONS)
+        && sc_iterator_compare_type(el->flags.type, it->params[1].type);
+
+    if (is_not_same)
+      sc_monitor_release_read(arc_monitor);
+
+    if (is_found)
+    {
+      it->results[1].addr = arc_addr;
+      it->results[1].is_accessed = SC_TRUE;
+      return SC_TRUE;
+    }
+  }
+
+  return SC_FALSE;
+}
+
 sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
 {
   sc_addr const arc_begin = it->results[0].addr = it->params[0].addr;
@@ -390,6 +471,17 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
     goto error;
   it->results[2].is_accessed = SC_TRUE;
 
+  // sc-connectors between two sc-elements are got from index without walking sc-connectors of end sc-element, and
+  // iteration started by walking them isn't continued by index, if the index is enabled during it
+  sc_bool const is_iteration_started = SC_ADDR_IS_NOT_EMPTY(it->results[1].addr);
+  if (sc_connectors_index_is_enabled()
+      && (is_iteration_started == SC_FALSE || it->connectors_index_position.number != 0))
+  {
+    if (_sc_iterator3_f_a_f_find_indexed_arc(it, beg_monitor, end_monitor))
+      goto success;
+    goto error;
+  }
+
   // try to find first incoming sc-arc
   sc_element * el = null_ptr;
   if (sc_storage_get_element_by_addr(it->results[1].addr, &el) != SC_RESULT_OK)
@@ -399,16 +491,17 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
       goto error;
 
     arc_addr = el->first_in_arc;
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    it->is_arcs_index_used = sc_type_has_subtype(it->params[1].type, sc_type_arc)
+                             && sc_arcs_index_get_first_arc(arc_end, el, it->params[1].type, SC_FALSE, &arc_addr);
+#endif
   }
   else
   {
-    sc_bool const is_not_same =
-        SC_ADDR_IS_NOT_EQUAL(arc_begin, it->results[1].addr) && SC_ADDR_IS_NOT_EQUAL(arc_end, it->results[1].addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
+    sc_bool const is_not_same = arc_monitor != beg_monitor && arc_monitor != end_monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(it->results[1].addr, &el);
     if (result != SC_RESULT_OK)
@@ -418,9 +511,7 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
       goto error;
     }
 
-    arc_addr = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-                   ? SC_ADDR_IS_EQUAL(arc_end, el->arc.end) ? el->arc.next_end_in_arc : el->arc.next_begin_in_arc
-                   : el->arc.next_end_in_arc;
+    arc_addr = _sc_iterator3_get_next_incoming_arc(it, it->results[1].addr, el, arc_end, SC_FALSE);
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -429,12 +520,10 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
   // trying to find incoming sc-arc, that created before iterator, and wasn't deleted
   while (SC_ADDR_IS_NOT_EMPTY(arc_addr))
   {
-    sc_bool const is_not_same = SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_addr) && SC_ADDR_IS_NOT_EQUAL(arc_end, arc_addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
+    sc_bool const is_not_same = arc_monitor != beg_monitor && arc_monitor != end_monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(arc_addr, &el);
     if (result != SC_RESULT_OK)
@@ -444,10 +533,7 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
       goto error;
     }
 
-    sc_addr next_in_arc =
-        sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-            ? SC_ADDR_IS_EQUAL(arc_end, el->arc.end) ? el->arc.next_end_in_arc : el->arc.next_begin_in_arc
-            : el->arc.next_end_in_arc;
+    sc_addr next_in_arc = _sc_iterator3_get_next_incoming_arc(it, arc_addr, el, arc_end, SC_FALSE);
 
     if (_sc_memory_context_check_local_and_global_permissions(
             sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_addr)
@@ -469,9 +555,10 @@ sc_bool _sc_iterator3_f_a_f_next(sc_iterator3 * it)
 
     sc_type arc_type = el->flags.type;
 
+    sc_arc_info const * arc = sc_element_get_arc(el);
     sc_bool is_begin_same = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-                                ? SC_ADDR_IS_EQUAL(arc_begin, el->arc.begin) || SC_ADDR_IS_EQUAL(arc_begin, el->arc.end)
-                                : SC_ADDR_IS_EQUAL(arc_begin, el->arc.begin);
+                                ? SC_ADDR_IS_EQUAL(arc_begin, arc->begin) || SC_ADDR_IS_EQUAL(arc_begin, arc->end)
+                                : SC_ADDR_IS_EQUAL(arc_begin, arc->begin);
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -502,9 +589,7 @@ success:
 sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
 {
   sc_addr const arc_end = it->results[2].addr = it->params[2].addr;
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
   sc_bool const search_structure = sc_type_is_structure_and_arc(it->params[0].type, it->params[1].type);
-#endif
 
   sc_addr arc_addr = SC_ADDR_EMPTY;
   sc_result result;
@@ -532,16 +617,18 @@ sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
     arc_addr = search_structure ? el->first_in_arc_from_structure : el->first_in_arc;
 #else
     arc_addr = el->first_in_arc;
+#endif
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    it->is_arcs_index_used = !search_structure && sc_type_has_subtype(it->params[1].type, sc_type_arc)
+                             && sc_arcs_index_get_first_arc(arc_end, el, it->params[1].type, SC_FALSE, &arc_addr);
 #endif
   }
   else
   {
-    sc_bool const is_not_same = SC_ADDR_IS_NOT_EQUAL(arc_end, it->results[1].addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
+    sc_bool const is_not_same = arc_monitor != monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, it->results[1].addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(it->results[1].addr, &el);
     if (result != SC_RESULT_OK)
@@ -551,13 +638,7 @@ sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
       goto error;
     }
 
-    arc_addr = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-                   ? SC_ADDR_IS_EQUAL(arc_end, el->arc.end) ? el->arc.next_end_in_arc : el->arc.next_begin_in_arc
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-                   : (search_structure ? el->arc.next_in_arc_from_structure : el->arc.next_end_in_arc);
-#else
-                   : el->arc.next_end_in_arc;
-#endif
+    arc_addr = _sc_iterator3_get_next_incoming_arc(it, it->results[1].addr, el, arc_end, search_structure);
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -566,12 +647,10 @@ sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
   // trying to find incoming sc-arc, that created before iterator, and wasn't deleted
   while (SC_ADDR_IS_NOT_EMPTY(arc_addr))
   {
-    sc_bool const is_not_same = SC_ADDR_IS_NOT_EQUAL(arc_end, arc_addr);
+    arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
+    sc_bool const is_not_same = arc_monitor != monitor;
     if (is_not_same)
-    {
-      arc_monitor = sc_monitor_table_get_monitor_for_addr(&sc_storage_get()->addr_monitors_table, arc_addr);
       sc_monitor_acquire_read(arc_monitor);
-    }
 
     result = sc_storage_get_element_by_addr(arc_addr, &el);
     if (result != SC_RESULT_OK)
@@ -581,14 +660,7 @@ sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
       goto error;
     }
 
-    sc_addr next_in_arc =
-        sc_type_has_subtype(el->flags.type, sc_type_common_edge)
-            ? SC_ADDR_IS_EQUAL(arc_end, el->arc.end) ? el->arc.next_end_in_arc : el->arc.next_begin_in_arc
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-            : (search_structure ? el->arc.next_in_arc_from_structure : el->arc.next_end_in_arc);
-#else
-            : el->arc.next_end_in_arc;
-#endif
+    sc_addr next_in_arc = _sc_iterator3_get_next_incoming_arc(it, arc_addr, el, arc_end, search_structure);
 
     if (_sc_memory_context_check_local_and_global_permissions(
             sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_addr)
@@ -611,7 +683,7 @@ sc_bool _sc_iterator3_a_a_f_next(sc_iterator3 * it)
     sc_type arc_type = el->flags.type;
     sc_addr arc_begin = sc_type_has_subtype(el->flags.type, sc_type_common_edge)
                             ? _sc_iterator3_get_other_edge_incident_element(el, arc_end)
-                            : el->arc.begin;
+                            : sc_element_get_arc(el)->begin;
 
     if (is_not_same)
       sc_monitor_release_read(arc_monitor);
@@ -675,19 +747,19 @@ sc_bool _sc_iterator3_a_f_a_next(sc_iterator3 * it)
   it->results[1].is_accessed = SC_TRUE;
 
   if (_sc_memory_context_check_local_and_global_permissions(
-          sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_el->arc.begin)
+          sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, sc_element_get_arc(arc_el)->begin)
       == SC_FALSE)
     goto success;
 
-  it->results[0].addr = arc_el->arc.begin;
+  it->results[0].addr = sc_element_get_arc(arc_el)->begin;
   it->results[0].is_accessed = SC_TRUE;
 
   if (_sc_memory_context_check_local_and_global_permissions(
-          sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, arc_el->arc.end)
+          sc_memory_get_context_manager(), it->ctx, SC_CONTEXT_PERMISSIONS_READ, sc_element_get_arc(arc_el)->end)
       == SC_FALSE)
     goto success;
 
-  it->results[2].addr = arc_el->arc.end;
+  it->results[2].addr = sc_element_get_arc(arc_el)->end;
   it->results[2].is_accessed = SC_TRUE;
 
 success:
@@ -728,17 +800,18 @@ sc_bool _sc_iterator3_f_f_a_next(sc_iterator3 * it)
   sc_addr arc_end;
   if (sc_type_has_subtype(arc_el->flags.type, sc_type_common_edge))
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.begin) && SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->begin)
+        && SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->end))
       goto error;
 
     arc_end = _sc_iterator3_get_other_edge_incident_element(arc_el, arc_begin);
   }
   else
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.begin))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->begin))
       goto error;
 
-    arc_end = arc_el->arc.end;
+    arc_end = sc_element_get_arc(arc_el)->end;
   }
 
   if (_sc_memory_context_check_local_and_global_permissions(
@@ -792,17 +865,18 @@ sc_bool _sc_iterator3_a_f_f_next(sc_iterator3 * it)
   sc_addr arc_begin;
   if (sc_type_has_subtype(arc_el->flags.type, sc_type_common_edge))
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.begin) && SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->begin)
+        && SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->end))
       goto error;
 
     arc_begin = _sc_iterator3_get_other_edge_incident_element(arc_el, arc_end);
   }
   else
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->end))
       goto error;
 
-    arc_begin = arc_el->arc.begin;
+    arc_begin = sc_element_get_arc(arc_el)->begin;
   }
 
   if (_sc_memory_context_check_local_and_global_permissions(
@@ -856,18 +930,20 @@ sc_bool _sc_iterator3_f_f_f_next(sc_iterator3 * it)
 
   if (sc_type_has_subtype(arc_el->flags.type, sc_type_common_edge))
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.begin) && SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->begin)
+        && SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->end))
       goto error;
 
-    if (SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.begin) && SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->begin)
+        && SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->end))
       goto error;
   }
   else
   {
-    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, arc_el->arc.begin))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_begin, sc_element_get_arc(arc_el)->begin))
       goto error;
 
-    if (SC_ADDR_IS_NOT_EQUAL(arc_end, arc_el->arc.end))
+    if (SC_ADDR_IS_NOT_EQUAL(arc_end, sc_element_get_arc(arc_el)->end))
       goto error;
   }
 
@@ -9,13 +9,59 @@
 #include "sc-core/sc-base/sc_allocator.h"
 
 #include "sc_element.h"
+#include "sc_segment_allocator.h"
+#include "sc_segment_pager.h"
 
-sc_segment * sc_segment_new(sc_addr_seg num)
+sc_segment * sc_segment_new(sc_addr_seg num, sc_uint8 pool)
 {
+  sc_bool is_mapped;
+#ifdef SC_COMPACT_ELEMENTS
+  // only sc-elements are big enough to be placed in huge pages
   sc_segment * segment = sc_mem_new(sc_segment, 1);
+  segment->elements = sc_segment_allocator_new(num, SC_SEG_ELEMENTS_SIZE_BYTE(pool), &is_mapped);
+#else
+  sc_segment * segment = sc_segment_allocator_new(num, sizeof(sc_segment), &is_mapped);
+#endif
+  segment->is_mapped = is_mapped;
+  segment->is_file_mapped = SC_FALSE;
+  segment->pool = pool;
   segment->num = num;
   segment->last_engaged_offset = 0;
   segment->last_released_offset = 0;
+  segment->is_dirty = SC_FALSE;
+  segment->is_changed = SC_FALSE;
+  segment->access_count = 0;
+  segment->is_accessed = SC_FALSE;
+  segment->is_resident = SC_FALSE;
+  sc_monitor_init(&segment->monitor);
+
+  return segment;
+}
+
+sc_segment * sc_segment_new_from_file(sc_addr_seg num, sc_uint8 pool, sc_int32 fd, sc_uint64 offset)
+{
+  sc_pointer memory = sc_segment_allocator_map_file(num, fd, offset, SC_SEGMENT_FILE_MAPPED_SIZE(pool));
+  if (memory == null_ptr)
+    return null_ptr;
+
+#ifdef SC_COMPACT_ELEMENTS
+  sc_segment * segment = sc_mem_new(sc_segment, 1);
+  segment->elements = memory;
+#else
+  // fields after sc-elements are mapped from padding of segment in file and are overwritten here
+  sc_segment * segment = memory;
+#endif
+  segment->is_mapped = SC_FALSE;
+  segment->is_file_mapped = SC_TRUE;
+  segment->pool = pool;
+  segment->num = num;
+  segment->last_engaged_offset = 0;
+  segment->last_released_offset = 0;
+  segment->is_dirty = SC_FALSE;
+  segment->is_changed = SC_FALSE;
+  segment->access_count = 0;
+  segment->is_accessed = SC_FALSE;
+  segment->is_resident = SC_FALSE;
   sc_monitor_init(&segment->monitor);
 
   return segment;
@@ -23,19 +69,36 @@ sc_segment * sc_segment_new(sc_addr_seg num)
 
 void sc_segment_free(sc_segment * segment)
 {
+  sc_segment_pager_forget(segment);
   sc_monitor_destroy(&segment->monitor);
+  if (segment->is_file_mapped)
+  {
+#ifdef SC_COMPACT_ELEMENTS
+    sc_segment_allocator_unmap_file(segment->elements, SC_SEGMENT_FILE_MAPPED_SIZE(segment->pool));
+    sc_mem_free(segment);
+#else
+    sc_segment_allocator_unmap_file(segment, SC_SEGMENT_FILE_MAPPED_SIZE(segment->pool));
+#endif
+    return;
+  }
+
+#ifdef SC_COMPACT_ELEMENTS
+  sc_segment_allocator_free(segment->elements, SC_SEG_ELEMENTS_SIZE_BYTE(segment->pool), segment->is_mapped);
   sc_mem_free(segment);
+#else
+  sc_segment_allocator_free(segment, sizeof(sc_segment), segment->is_mapped);
+#endif
 }
 
 void sc_segment_collect_elements_stat(sc_segment * seg, sc_stat * stat)
 {
-  for (sc_addr_offset i = 0; i < seg->last_engaged_offset; ++i)
+  for (sc_addr_offset i = 1; i <= seg->last_engaged_offset; ++i)
   {
-    sc_element element = seg->elements[i];
-    if ((element.flags.states & SC_STATE_ELEMENT_EXIST) == 0)
+    sc_element * element = sc_segment_get_element(seg, i);
+    if ((element->flags.states & SC_STATE_ELEMENT_EXIST) == 0)
       continue;
 
-    sc_type type = element.flags.type;
+    sc_type type = element->flags.type;
     if (sc_type_has_subtype(type, sc_type_node))
     {
       stat->node_count++;
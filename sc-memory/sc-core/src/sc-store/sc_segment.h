@@ -17,23 +17,74 @@
 
 #include "sc-store/sc-base/sc_monitor_private.h"
 
-#define SC_SEG_ELEMENTS_SIZE_BYTE (sizeof(sc_element) * SC_SEGMENT_ELEMENTS_COUNT)
+/* Segments are grouped in pools. If sc-elements are compact, sc-connectors are stored in their own pool of segments,
+ * and segments of other sc-elements store only headers of sc-elements. Otherwise, all sc-elements are stored in the
+ * same pool.
+ */
+#define SC_SEGMENT_POOL_NODES 0
+#define SC_SEGMENT_POOL_CONNECTORS 1
+
+#ifdef SC_COMPACT_ELEMENTS
+#  define SC_SEGMENT_POOLS_COUNT 2
+#  define sc_segment_pool_of_type(type) \
+    (sc_type_is_connector(type) ? SC_SEGMENT_POOL_CONNECTORS : SC_SEGMENT_POOL_NODES)
+#  define SC_SEGMENT_ELEMENT_SIZE(pool) \
+    (sizeof(sc_element) + ((pool) == SC_SEGMENT_POOL_CONNECTORS ? sizeof(sc_arc_info) : 0))
+#  define sc_segment_get_element(segment, offset) \
+    ((sc_element *)((sc_char *)(segment)->elements + (sc_uint32)(offset) * SC_SEGMENT_ELEMENT_SIZE((segment)->pool)))
+#else
+#  define SC_SEGMENT_POOLS_COUNT 1
+#  define sc_segment_pool_of_type(type) SC_SEGMENT_POOL_NODES
+#  define SC_SEGMENT_ELEMENT_SIZE(pool) sizeof(sc_element)
+#  define sc_segment_get_element(segment, offset) (&(segment)->elements[offset])
+#endif
+
+#define SC_SEG_ELEMENTS_SIZE_BYTE(pool) (SC_SEGMENT_ELEMENT_SIZE(pool) * SC_SEGMENT_ELEMENTS_COUNT)
+
+// Size of segment memory mapped from segments file, sc-elements are placed at its beginning
+#ifdef SC_COMPACT_ELEMENTS
+#  define SC_SEGMENT_FILE_MAPPED_SIZE(pool) SC_SEG_ELEMENTS_SIZE_BYTE(pool)
+#else
+#  define SC_SEGMENT_FILE_MAPPED_SIZE(pool) sizeof(sc_segment)
+#endif
 
 /*! Structure for segment storing
  */
 struct _sc_segment
 {
+#ifdef SC_COMPACT_ELEMENTS
+  sc_element * elements;  // sc-elements of size SC_SEGMENT_ELEMENT_SIZE(pool)
+#else
   sc_element elements[SC_SEGMENT_ELEMENTS_COUNT];
+#endif
+  sc_uint8 pool;                       // pool of segments this segment belongs to
+  sc_bool is_mapped;                   // segment memory is mapped by segment allocator
+  sc_bool is_file_mapped;              // segment memory is mapped from segments file
   sc_addr_seg num;                     // number of this segment in memory
   sc_addr_offset last_engaged_offset;  // number of sc-element in the segment
   sc_addr_offset last_released_offset;
+  sc_uint32 is_dirty;      // segment is changed after the last dump, it is accessed atomically
+  sc_uint32 is_changed;    // segment mapped from segments file is changed after its loading, it is accessed atomically
+  sc_uint32 access_count;  // count of accesses to sc-elements of segment, it is accessed atomically
+  sc_uint32 is_accessed;   // segment is accessed after it is checked by segment pager, it is accessed atomically
+  sc_uint32 is_resident;   // segment is counted in memory of segment pager, it is accessed atomically
   sc_monitor monitor;
 };
 
 /*! Create new segment with specified size.
  * @param num Number of created instance in sc-memory
+ * @param pool Pool of segments the created segment belongs to
+ */
+sc_segment * sc_segment_new(sc_addr_seg num, sc_uint8 pool);
+
+/*! Create segment, which sc-elements are mapped from segments file.
+ * @param num Number of created instance in sc-memory
+ * @param pool Pool of segments the created segment belongs to
+ * @param fd Descriptor of segments file
+ * @param offset Offset of sc-elements of segment in file, it must be aligned to page size
+ * @returns Created segment or null_ptr, if file can't be mapped.
  */
-sc_segment * sc_segment_new(sc_addr_seg num);
+sc_segment * sc_segment_new_from_file(sc_addr_seg num, sc_uint8 pool, sc_int32 fd, sc_uint64 offset);
 
 void sc_segment_free(sc_segment * segment);
 
@@ -0,0 +1,237 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_segment_allocator.h"
+
+#include "sc-core/sc_platform.h"
+#include "sc-core/sc-base/sc_allocator.h"
+#include "sc-core/sc-container/sc_string.h"
+
+#include "sc_storage.h"
+#include "sc_memory_private.h"
+
+#if SC_IS_PLATFORM_LINUX
+#  include <stdio.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  define SC_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#  define SC_MPOL_BIND 2
+#  define SC_MPOL_INTERLEAVE 3
+#  define SC_MAX_NUMA_NODES_COUNT (sizeof(unsigned long) * 8)
+#endif
+
+typedef enum
+{
+  SC_SEGMENTS_NUMA_NONE,
+  SC_SEGMENTS_NUMA_INTERLEAVE,
+  SC_SEGMENTS_NUMA_BIND,
+} sc_segments_numa_policy;
+
+sc_bool segments_huge_pages = SC_FALSE;
+sc_segments_numa_policy segments_numa_policy = SC_SEGMENTS_NUMA_NONE;
+sc_uint32 numa_nodes_count = 1;
+
+#if SC_IS_PLATFORM_LINUX
+sc_uint32 _sc_segment_allocator_get_numa_nodes_count()
+{
+  sc_uint32 count = 0;
+  sc_char path[64];
+  while (count < SC_MAX_NUMA_NODES_COUNT)
+  {
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u", count);
+    if (access(path, F_OK) != 0)
+      break;
+    ++count;
+  }
+
+  return count == 0 ? 1 : count;
+}
+#endif
+
+void sc_segment_allocator_initialize(sc_memory_params const * params)
+{
+  segments_huge_pages = params->segments_huge_pages;
+
+  sc_char const * policy = params->segments_numa_policy;
+  if (policy == null_ptr || sc_str_cmp(policy, SC_SEGMENTS_NUMA_POLICY_NONE))
+    segments_numa_policy = SC_SEGMENTS_NUMA_NONE;
+  else if (sc_str_cmp(policy, SC_SEGMENTS_NUMA_POLICY_INTERLEAVE))
+    segments_numa_policy = SC_SEGMENTS_NUMA_INTERLEAVE;
+  else if (sc_str_cmp(policy, SC_SEGMENTS_NUMA_POLICY_BIND))
+    segments_numa_policy = SC_SEGMENTS_NUMA_BIND;
+  else
+  {
+    sc_memory_warning("Unknown NUMA policy of segments `%s`, segments aren't bound to NUMA nodes", policy);
+    segments_numa_policy = SC_SEGMENTS_NUMA_NONE;
+    policy = SC_SEGMENTS_NUMA_POLICY_NONE;
+  }
+
+#if SC_IS_PLATFORM_LINUX
+  numa_nodes_count = _sc_segment_allocator_get_numa_nodes_count();
+#else
+  if (segments_huge_pages || segments_numa_policy != SC_SEGMENTS_NUMA_NONE)
+    sc_memory_warning("Huge pages and NUMA policies of segments are supported on Linux only");
+  segments_huge_pages = SC_FALSE;
+  segments_numa_policy = SC_SEGMENTS_NUMA_NONE;
+#endif
+
+  sc_message("\tSegments huge pages: %s", segments_huge_pages ? "On" : "Off");
+  sc_message(
+      "\tSegments NUMA policy: %s (NUMA nodes: %u)",
+      segments_numa_policy == SC_SEGMENTS_NUMA_NONE ? SC_SEGMENTS_NUMA_POLICY_NONE : policy,
+      numa_nodes_count);
+}
+
+void sc_segment_allocator_shutdown()
+{
+  segments_huge_pages = SC_FALSE;
+  segments_numa_policy = SC_SEGMENTS_NUMA_NONE;
+  numa_nodes_count = 1;
+}
+
+#if SC_IS_PLATFORM_LINUX
+sc_uint64 _sc_segment_allocator_get_mapped_size(sc_uint64 size)
+{
+  return (size + SC_HUGE_PAGE_SIZE - 1) / SC_HUGE_PAGE_SIZE * SC_HUGE_PAGE_SIZE;
+}
+
+sc_pointer _sc_segment_allocator_map(sc_uint64 size)
+{
+  sc_pointer memory = MAP_FAILED;
+#  ifdef MAP_HUGETLB
+  // explicit huge pages are reserved by administrator, if there are no free ones then transparent huge pages are used
+  if (segments_huge_pages)
+    memory = mmap(null_ptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#  endif
+  if (memory != MAP_FAILED)
+    return memory;
+
+  memory = mmap(null_ptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED)
+    return null_ptr;
+
+#  ifdef MADV_HUGEPAGE
+  if (segments_huge_pages)
+    madvise(memory, size, MADV_HUGEPAGE);
+#  endif
+  return memory;
+}
+
+void _sc_segment_allocator_bind(sc_addr_seg num, sc_pointer memory, sc_uint64 size)
+{
+  if (segments_numa_policy == SC_SEGMENTS_NUMA_NONE || numa_nodes_count < 2)
+    return;
+
+  unsigned long nodes_mask;
+  int mode;
+  if (segments_numa_policy == SC_SEGMENTS_NUMA_INTERLEAVE)
+  {
+    mode = SC_MPOL_INTERLEAVE;
+    nodes_mask = numa_nodes_count == SC_MAX_NUMA_NODES_COUNT ? ~0UL : (1UL << numa_nodes_count) - 1;
+  }
+  else
+  {
+    mode = SC_MPOL_BIND;
+    nodes_mask = 1UL << (num % numa_nodes_count);
+  }
+
+  // pages aren't touched yet, so they are placed by the policy on first access
+  if (syscall(SYS_mbind, memory, size, mode, &nodes_mask, SC_MAX_NUMA_NODES_COUNT, 0) != 0)
+    sc_memory_warning("Segment %d can't be bound to NUMA nodes", num);
+}
+#endif
+
+sc_pointer sc_segment_allocator_new(sc_addr_seg num, sc_uint64 size, sc_bool * is_mapped)
+{
+  *is_mapped = SC_FALSE;
+
+#if SC_IS_PLATFORM_LINUX
+  if (segments_huge_pages || segments_numa_policy != SC_SEGMENTS_NUMA_NONE)
+  {
+    sc_uint64 const mapped_size = _sc_segment_allocator_get_mapped_size(size);
+    sc_pointer memory = _sc_segment_allocator_map(mapped_size);
+    if (memory != null_ptr)
+    {
+      _sc_segment_allocator_bind(num, memory, mapped_size);
+      *is_mapped = SC_TRUE;
+      return memory;
+    }
+  }
+#endif
+
+  return _sc_mem_new(size);
+}
+
+void sc_segment_allocator_free(sc_pointer memory, sc_uint64 size, sc_bool is_mapped)
+{
+#if SC_IS_PLATFORM_LINUX
+  if (is_mapped)
+  {
+    munmap(memory, _sc_segment_allocator_get_mapped_size(size));
+    return;
+  }
+#endif
+
+  sc_mem_free(memory);
+}
+
+sc_pointer sc_segment_allocator_map_file(sc_addr_seg num, sc_int32 fd, sc_uint64 offset, sc_uint64 size)
+{
+#if SC_IS_PLATFORM_LINUX
+  sc_pointer memory = mmap(null_ptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t)offset);
+  if (memory == MAP_FAILED)
+    return null_ptr;
+
+  _sc_segment_allocator_bind(num, memory, size);
+  return memory;
+#else
+  (void)num;
+  (void)fd;
+  (void)offset;
+  (void)size;
+  return null_ptr;
+#endif
+}
+
+void sc_segment_allocator_unmap_file(sc_pointer memory, sc_uint64 size)
+{
+#if SC_IS_PLATFORM_LINUX
+  munmap(memory, size);
+#else
+  (void)memory;
+  (void)size;
+#endif
+}
+
+sc_bool sc_segment_allocator_page_out(sc_pointer memory, sc_uint64 size)
+{
+#if SC_IS_PLATFORM_LINUX && defined(MADV_PAGEOUT)
+  sc_int64 const page_size = sysconf(_SC_PAGESIZE);
+  if (page_size <= 0)
+    return SC_FALSE;
+
+  // pages of private mapping aren't discarded by MADV_PAGEOUT unlike MADV_DONTNEED, so changes of them aren't lost
+  size -= size % page_size;
+  return size == 0 || madvise(memory, size, MADV_PAGEOUT) == 0;
+#else
+  (void)memory;
+  (void)size;
+  return SC_FALSE;
+#endif
+}
+
+sc_bool sc_segment_allocator_is_file_offset_mappable(sc_uint64 offset)
+{
+#if SC_IS_PLATFORM_LINUX
+  sc_int64 const page_size = sysconf(_SC_PAGESIZE);
+  return page_size > 0 && offset % page_size == 0;
+#else
+  (void)offset;
+  return SC_FALSE;
+#endif
+}
@@ -0,0 +1,62 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_segment_allocator_h_
+#define _sc_segment_allocator_h_
+
+#include "sc-core/sc_types.h"
+#include "sc-core/sc_memory_params.h"
+
+#define SC_SEGMENTS_NUMA_POLICY_NONE "None"
+#define SC_SEGMENTS_NUMA_POLICY_INTERLEAVE "Interleave"
+#define SC_SEGMENTS_NUMA_POLICY_BIND "Bind"
+
+/*! Configures memory of segments allocated after this call.
+ * @param params Sc-memory params with `segments_huge_pages` and `segments_numa_policy`
+ * @note Unknown NUMA policy is reported and replaced by `None`.
+ */
+void sc_segment_allocator_initialize(sc_memory_params const * params);
+
+//! Resets configuration of segments memory to plain heap allocations
+void sc_segment_allocator_shutdown();
+
+/*! Allocates zeroed memory of segment. The memory is mapped in huge pages and bound to NUMA nodes if it is configured
+ * and supported, otherwise it is allocated in heap.
+ * @param num Number of segment, it selects NUMA node if NUMA policy is `Bind`
+ * @param size Size of allocated memory
+ * @param[out] is_mapped SC_TRUE, if the memory is mapped and must be unmapped by `sc_segment_allocator_free`
+ * @returns Pointer to allocated memory.
+ */
+sc_pointer sc_segment_allocator_new(sc_addr_seg num, sc_uint64 size, sc_bool * is_mapped);
+
+//! Frees memory allocated by `sc_segment_allocator_new`
+void sc_segment_allocator_free(sc_pointer memory, sc_uint64 size, sc_bool is_mapped);
+
+/*! Maps part of file into memory of segment. Pages of the memory are read from file on first access and are copied on
+ * first write, so the file isn't changed.
+ * @param num Number of segment, it selects NUMA node if NUMA policy is `Bind`
+ * @param fd Descriptor of file opened for reading
+ * @param offset Offset of mapped part in file, it must be aligned to page size
+ * @param size Size of mapped part
+ * @returns Pointer to mapped memory or null_ptr, if file can't be mapped.
+ */
+sc_pointer sc_segment_allocator_map_file(sc_addr_seg num, sc_int32 fd, sc_uint64 offset, sc_uint64 size);
+
+//! Unmaps memory mapped by `sc_segment_allocator_map_file`
+void sc_segment_allocator_unmap_file(sc_pointer memory, sc_uint64 size);
+
+/*! Pages out memory mapped by `sc_segment_allocator_map_file`. Its unchanged pages are dropped and are read from file
+ * again on next access, and its changed pages are kept or swapped, so the memory stays valid.
+ * @param memory Beginning of mapped memory
+ * @param size Size of paged out memory, it is rounded down to page size
+ * @returns SC_TRUE, if the memory is paged out.
+ */
+sc_bool sc_segment_allocator_page_out(sc_pointer memory, sc_uint64 size);
+
+//! Returns SC_TRUE, if file offset can be mapped into memory of segment
+sc_bool sc_segment_allocator_is_file_offset_mappable(sc_uint64 offset);
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_segment_pager.h"
+
+#include "sc-core/sc_platform.h"
+#include "sc-core/sc-base/sc_allocator.h"
+#include "sc-store/sc-base/sc_mutex_private.h"
+#include "sc-store/sc-base/sc_thread.h"
+
+#include "sc_segment.h"
+#include "sc_segment_allocator.h"
+#include "sc_storage.h"
+#include "sc_memory_private.h"
+
+#if SC_IS_PLATFORM_LINUX
+#  include <sys/mman.h>
+#endif
+
+#define SC_SEGMENT_PAGER_INITIAL_CAPACITY 64
+// size of sc-elements of segment, segment fields after them aren't paged out
+#define SC_SEGMENT_PAGER_SEGMENT_SIZE(segment) SC_SEG_ELEMENTS_SIZE_BYTE((segment)->pool)
+
+typedef struct
+{
+  sc_bool is_enabled;         // segments memory limit is set
+  sc_uint64 memory_limit;     // limit of memory of resident segments in bytes
+  sc_uint64 resident_size;    // memory of resident segments in bytes
+  sc_uint64 paged_out_count;  // count of segments paged out after initialization
+  sc_segment ** segments;     // resident segments, they are checked by clock hand one by one
+  sc_uint32 segments_count;   // count of resident segments
+  sc_uint32 segments_capacity;
+  sc_uint32 clock_hand;  // index of the next checked resident segment
+  sc_mutex mutex;
+} sc_segment_pager;
+
+sc_segment_pager segment_pager = {.is_enabled = SC_FALSE};
+// count of accesses of thread after its last counted access, it is stored in place of pointer
+sc_thread_local segment_pager_accesses_count = SC_THREAD_LOCAL_INIT(null_ptr);
+
+void sc_segment_pager_initialize(sc_memory_params const * params)
+{
+  segment_pager.memory_limit = (sc_uint64)params->segments_memory_limit * 1024 * 1024;
+  segment_pager.resident_size = 0;
+  segment_pager.paged_out_count = 0;
+  segment_pager.segments = null_ptr;
+  segment_pager.segments_count = 0;
+  segment_pager.segments_capacity = 0;
+  segment_pager.clock_hand = 0;
+  sc_mutex_init(&segment_pager.mutex);
+
+  segment_pager.is_enabled = segment_pager.memory_limit != 0;
+#if !SC_IS_PLATFORM_LINUX || !defined(MADV_PAGEOUT)
+  if (segment_pager.is_enabled)
+    sc_memory_warning("Paging out of segments is supported on Linux 5.4 and newer only");
+#endif
+
+  if (segment_pager.is_enabled)
+    sc_message("\tSegments memory limit: %u MB", params->segments_memory_limit);
+  else
+    sc_message("\tSegments memory limit: Off");
+}
+
+void sc_segment_pager_shutdown()
+{
+  segment_pager.is_enabled = SC_FALSE;
+  sc_mem_free(segment_pager.segments);
+  segment_pager.segments = null_ptr;
+  segment_pager.segments_count = 0;
+  segment_pager.segments_capacity = 0;
+  segment_pager.resident_size = 0;
+  sc_mutex_destroy(&segment_pager.mutex);
+}
+
+sc_bool _sc_segment_pager_is_changed(sc_segment * segment)
+{
+  return g_atomic_int_get(&segment->is_dirty) == SC_TRUE || g_atomic_int_get(&segment->is_changed) == SC_TRUE;
+}
+
+void _sc_segment_pager_remove(sc_uint32 index)
+{
+  sc_segment * segment = segment_pager.segments[index];
+  segment_pager.segments[index] = segment_pager.segments[--segment_pager.segments_count];
+  segment_pager.resident_size -= SC_SEGMENT_PAGER_SEGMENT_SIZE(segment);
+  g_atomic_int_set(&segment->is_resident, SC_FALSE);
+}
+
+void _sc_segment_pager_page_out_cold_segments(sc_segment * accessed_segment)
+{
+  // every segment is passed at most twice: the first time its access flag is cleared, the second time it is paged out
+  sc_uint64 steps = 2 * (sc_uint64)segment_pager.segments_count;
+  while (segment_pager.resident_size > segment_pager.memory_limit && segment_pager.segments_count > 1 && steps-- > 0)
+  {
+    if (segment_pager.clock_hand >= segment_pager.segments_count)
+      segment_pager.clock_hand = 0;
+
+    sc_segment * segment = segment_pager.segments[segment_pager.clock_hand];
+    if (g_atomic_int_get(&segment->is_accessed) == SC_TRUE)
+    {
+      g_atomic_int_set(&segment->is_accessed, SC_FALSE);
+      ++segment_pager.clock_hand;
+      continue;
+    }
+
+    // changed pages of mapped segment aren't backed by segments file, so they aren't paged out, and the accessed
+    // segment isn't paged out before it is used
+    if (segment == accessed_segment || _sc_segment_pager_is_changed(segment))
+    {
+      ++segment_pager.clock_hand;
+      continue;
+    }
+
+    // the last resident segment takes place of the removed one and it is checked next
+    _sc_segment_pager_remove(segment_pager.clock_hand);
+    if (sc_segment_allocator_page_out(sc_segment_get_element(segment, 0), SC_SEGMENT_PAGER_SEGMENT_SIZE(segment)))
+      ++segment_pager.paged_out_count;
+  }
+}
+
+void _sc_segment_pager_add(sc_segment * segment)
+{
+  sc_mutex_lock(&segment_pager.mutex);
+  if (g_atomic_int_get(&segment->is_resident) == SC_TRUE)
+    goto end;
+
+  if (segment_pager.segments_count == segment_pager.segments_capacity)
+  {
+    sc_uint32 const capacity = segment_pager.segments_capacity == 0 ? SC_SEGMENT_PAGER_INITIAL_CAPACITY
+                                                                    : segment_pager.segments_capacity * 2;
+    sc_segment ** segments = sc_mem_new(sc_segment *, capacity);
+    if (segment_pager.segments_count != 0)
+      sc_mem_cpy(segments, segment_pager.segments, segment_pager.segments_count * sizeof(sc_segment *));
+    sc_mem_free(segment_pager.segments);
+    segment_pager.segments = segments;
+    segment_pager.segments_capacity = capacity;
+  }
+
+  segment_pager.segments[segment_pager.segments_count++] = segment;
+  segment_pager.resident_size += SC_SEGMENT_PAGER_SEGMENT_SIZE(segment);
+  g_atomic_int_set(&segment->is_resident, SC_TRUE);
+
+  _sc_segment_pager_page_out_cold_segments(segment);
+
+end:
+  sc_mutex_unlock(&segment_pager.mutex);
+}
+
+void sc_segment_pager_access(sc_segment * segment)
+{
+  if (segment_pager.is_enabled == SC_FALSE || segment->is_file_mapped == SC_FALSE)
+    return;
+
+  // only sampled accesses write access count, so lookups of threads don't contend for cache line of segment
+  sc_uint32 accesses_count = GPOINTER_TO_UINT(sc_thread_local_get(&segment_pager_accesses_count));
+  accesses_count = (accesses_count + 1) % SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD;
+  sc_thread_local_set(&segment_pager_accesses_count, GUINT_TO_POINTER(accesses_count));
+  if (accesses_count == 0)
+    g_atomic_int_add(&segment->access_count, SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD);
+  // flags are written only if they are changed, so accesses to the same segment don't invalidate its cache line
+  if (g_atomic_int_get(&segment->is_accessed) == SC_FALSE)
+    g_atomic_int_set(&segment->is_accessed, SC_TRUE);
+  if (g_atomic_int_get(&segment->is_resident) == SC_FALSE)
+    _sc_segment_pager_add(segment);
+}
+
+void sc_segment_pager_release(sc_segment * segment)
+{
+  if (segment_pager.is_enabled == SC_FALSE || segment->is_file_mapped == SC_FALSE)
+    return;
+
+  if (g_atomic_int_get(&segment->is_resident) == SC_FALSE && !_sc_segment_pager_is_changed(segment))
+    sc_segment_allocator_page_out(sc_segment_get_element(segment, 0), SC_SEGMENT_PAGER_SEGMENT_SIZE(segment));
+}
+
+void sc_segment_pager_forget(sc_segment * segment)
+{
+  if (segment_pager.is_enabled == SC_FALSE || g_atomic_int_get(&segment->is_resident) == SC_FALSE)
+    return;
+
+  sc_mutex_lock(&segment_pager.mutex);
+  for (sc_uint32 i = 0; i < segment_pager.segments_count; ++i)
+  {
+    if (segment_pager.segments[i] == segment)
+    {
+      _sc_segment_pager_remove(i);
+      break;
+    }
+  }
+  sc_mutex_unlock(&segment_pager.mutex);
+}
+
+void sc_segment_pager_get_stat(sc_stat * stat)
+{
+  if (segment_pager.is_enabled == SC_FALSE)
+    return;
+
+  sc_mutex_lock(&segment_pager.mutex);
+  stat->resident_segments_size = segment_pager.resident_size;
+  stat->paged_out_segments_count = segment_pager.paged_out_count;
+  sc_mutex_unlock(&segment_pager.mutex);
+}
@@ -0,0 +1,50 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_segment_pager_h_
+#define _sc_segment_pager_h_
+
+#include "sc-core/sc_types.h"
+#include "sc-core/sc_memory_params.h"
+
+/* Segments mapped from segments file are read by operating system on first access to their pages. Segment pager keeps
+ * memory of accessed segments within `segments_memory_limit`: it pages out segments, which aren't accessed for the
+ * longest time, if they aren't changed after loading. Paged out segments are read from segments file again on next
+ * access. Least recently used segments are approximated by clock algorithm, so an access to segment only sets its flag.
+ */
+
+//! Only every such access of a thread is counted in access count of segment, and it is counted as the whole period
+#define SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD 32
+
+/*! Configures limit of memory of segments mapped from segments file.
+ * @param params Sc-memory params with `segments_memory_limit`
+ */
+void sc_segment_pager_initialize(sc_memory_params const * params);
+
+//! Forgets resident segments and disables segment pager
+void sc_segment_pager_shutdown();
+
+/*! Counts access to sc-elements of segment, accesses are sampled by `SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD`. If
+ * segment isn't resident, it is counted in memory of segment pager, and the least recently used segments are paged out,
+ * if the memory exceeds its limit.
+ * @param segment Accessed segment
+ */
+void sc_segment_pager_access(sc_segment * segment);
+
+/*! Pages out segment read without access to its sc-elements, for example by dump or statistics, if it isn't resident.
+ * @param segment Read segment
+ */
+void sc_segment_pager_release(sc_segment * segment);
+
+//! Removes freed segment from resident segments
+void sc_segment_pager_forget(sc_segment * segment);
+
+/*! Collects statistics of segment pager.
+ * @param[out] stat Statistics, which `resident_segments_size` and `paged_out_segments_count` are set
+ */
+void sc_segment_pager_get_stat(sc_stat * stat);
+
+#endif
@@ -6,6 +6,8 @@
 
 #include "sc_storage.h"
 
+#include <string.h>
+
 #include "sc-core/sc_event_subscription.h"
 
 #include "sc-core/sc_stream_memory.h"
@@ -15,14 +17,263 @@
 #include "sc-core/sc_keynodes.h"
 
 #include "sc_segment.h"
+#include "sc_segment_allocator.h"
+#include "sc_segment_pager.h"
+#include "sc_arcs_index.h"
+#include "sc_connectors_index.h"
 #include "sc_element.h"
 
 #include "sc-fs-memory/sc_fs_memory.h"
+#include "sc-fs-memory/sc_file_system.h"
 
 #include "sc_storage_private.h"
+#include "sc_storage_compaction.h"
+#include "sc_storage_export.h"
+#include "sc_storage_wal.h"
 #include "sc_memory_private.h"
 
 sc_storage * storage = null_ptr;
+sc_uint32 storage_generation = 0;
+
+//! Adds sc-connector to index of sc-connectors, sc-edges are added for both directions, but loops are added once
+void _sc_storage_index_connector(sc_addr addr, sc_element * element)
+{
+  sc_arc_info const * arc = sc_element_get_arc(element);
+  sc_connectors_index_add(arc->begin, arc->end, addr);
+  if (sc_type_has_subtype(element->flags.type, sc_type_common_edge) && SC_ADDR_IS_NOT_EQUAL(arc->begin, arc->end))
+    sc_connectors_index_add(arc->end, arc->begin, addr);
+}
+
+void _sc_storage_unindex_connector(sc_addr addr, sc_element * element)
+{
+  sc_arc_info const * arc = sc_element_get_arc(element);
+  sc_connectors_index_remove(arc->begin, arc->end, addr);
+  if (sc_type_has_subtype(element->flags.type, sc_type_common_edge) && SC_ADDR_IS_NOT_EQUAL(arc->begin, arc->end))
+    sc_connectors_index_remove(arc->end, arc->begin, addr);
+}
+
+/*! Checks that sc-connector is in list of outgoing sc-connectors of its begin sc-element. Generated sc-connectors exist
+ * before they are linked with their begin and end sc-elements, and they are indexed when they are linked.
+ * @note Monitors of sc-connector and its begin sc-element must be acquired, if other threads can change them.
+ */
+sc_bool _sc_storage_is_connector_linked(sc_addr addr, sc_element * element)
+{
+  sc_arc_info const * arc = sc_element_get_arc(element);
+  if (SC_ADDR_IS_NOT_EMPTY(arc->prev_begin_out_arc))
+    return SC_TRUE;
+
+  sc_element * beg_el;
+  return sc_storage_get_element_by_addr(arc->begin, &beg_el) == SC_RESULT_OK
+         && SC_ADDR_IS_EQUAL(beg_el->first_out_arc, addr);
+}
+
+/*! Indexes linked sc-connectors of segments, the index isn't saved with them.
+ * @param segments_count Count of indexed segments, sc-connectors of segments generated later aren't linked yet
+ * @note All monitors of sc-addrs must be acquired, if other threads can generate or erase sc-connectors.
+ */
+void _sc_storage_index_connectors(sc_addr_seg segments_count)
+{
+  sc_segment ** segments = g_atomic_pointer_get(&storage->segments);
+  for (sc_addr_seg num = 1; num <= segments_count; ++num)
+  {
+    sc_segment * segment = segments[num - 1];
+    for (sc_addr_offset offset = 1; offset <= segment->last_engaged_offset; ++offset)
+    {
+      sc_element * element = sc_segment_get_element(segment, offset);
+      if ((element->flags.states & SC_STATE_ELEMENT_EXIST) != SC_STATE_ELEMENT_EXIST
+          || !sc_type_has_subtype_in_mask(element->flags.type, sc_type_connector_mask))
+        continue;
+
+      sc_addr const addr = {.seg = num, .offset = offset};
+      if (_sc_storage_is_connector_linked(addr, element))
+        _sc_storage_index_connector(addr, element);
+    }
+    sc_segment_pager_release(segment);
+  }
+}
+
+//! Gets loaded segment of sc-element from record of write-ahead log
+sc_segment * _sc_storage_get_redone_segment(sc_addr addr)
+{
+  if (addr.seg == 0 || addr.seg > storage->segments_count || addr.offset == 0)
+    return null_ptr;
+  return storage->segments[addr.seg - 1];
+}
+
+//! Checks that sc-link has specified content, e.g. if loaded dump contains content set by record of write-ahead log
+sc_bool _sc_storage_has_link_content(sc_addr addr, sc_char const * string, sc_uint32 string_size)
+{
+  sc_char * content = null_ptr;
+  sc_uint32 content_size = 0;
+  sc_bool const has_content =
+      sc_fs_memory_get_string_by_link_hash(SC_ADDR_LOCAL_TO_INT(addr), &content, &content_size) == SC_FS_MEMORY_OK
+      && content_size == string_size && memcmp(content, string, string_size) == 0;
+  sc_mem_free(content);
+  return has_content;
+}
+
+/*! Applies record of write-ahead log to loaded sc-memory. Records contain after-images of sc-elements, so they are
+ * applied the same way whether loaded dump contains their changes or not.
+ */
+sc_bool _sc_storage_redo_wal_record(sc_uint8 kind, sc_char const * data, sc_uint32 size)
+{
+  switch (kind)
+  {
+  case SC_STORAGE_WAL_RECORD_SEGMENT_NEW:
+  {
+    sc_addr_seg num;
+    sc_uint8 pool;
+    if (size != sizeof(num) + sizeof(pool))
+      return SC_FALSE;
+    sc_mem_cpy(&num, data, sizeof(num));
+    sc_mem_cpy(&pool, data + sizeof(num), sizeof(pool));
+    if (num == 0 || pool >= SC_SEGMENT_POOLS_COUNT)
+      return SC_FALSE;
+
+    if (num <= storage->segments_count)
+      return storage->segments[num - 1]->pool == pool;
+    if (num != storage->segments_count + 1 || !sc_storage_reserve_segments(storage, num))
+      return SC_FALSE;
+
+    sc_segment * segment = storage->segments[num - 1] = sc_segment_new(num, pool);
+    segment->is_dirty = SC_TRUE;
+    storage->segments_count = num;
+    return SC_TRUE;
+  }
+
+  case SC_STORAGE_WAL_RECORD_ELEMENTS_NEW:
+  case SC_STORAGE_WAL_RECORD_CONNECTOR_NEW:
+  case SC_STORAGE_WAL_RECORD_CONNECTOR_UNLINK:
+  case SC_STORAGE_WAL_RECORD_SUBTYPE_CHANGE:
+  {
+    sc_uint32 offset = 0;
+    while (offset < size)
+    {
+      sc_addr addr;
+      if (size - offset < sizeof(addr))
+        return SC_FALSE;
+      sc_mem_cpy(&addr, data + offset, sizeof(addr));
+      offset += sizeof(addr);
+
+      sc_segment * segment = _sc_storage_get_redone_segment(addr);
+      if (segment == null_ptr)
+        return SC_FALSE;
+
+      sc_uint32 const element_size = SC_SEGMENT_ELEMENT_SIZE(segment->pool);
+      if (size - offset < element_size)
+        return SC_FALSE;
+      sc_mem_cpy(sc_segment_get_element(segment, addr.offset), data + offset, element_size);
+      offset += element_size;
+      segment->is_dirty = SC_TRUE;
+    }
+    return SC_TRUE;
+  }
+
+  case SC_STORAGE_WAL_RECORD_ELEMENTS_ERASE:
+  {
+    if (size % sizeof(sc_addr) != 0)
+      return SC_FALSE;
+
+    for (sc_uint32 offset = 0; offset < size; offset += sizeof(sc_addr))
+    {
+      sc_addr addr;
+      sc_mem_cpy(&addr, data + offset, sizeof(addr));
+      sc_segment * segment = _sc_storage_get_redone_segment(addr);
+      if (segment == null_ptr)
+        return SC_FALSE;
+      sc_mem_set(sc_segment_get_element(segment, addr.offset), 0, SC_SEGMENT_ELEMENT_SIZE(segment->pool));
+      segment->is_dirty = SC_TRUE;
+    }
+    return SC_TRUE;
+  }
+
+  case SC_STORAGE_WAL_RECORD_LINK_CONTENT:
+  {
+    sc_addr addr;
+    sc_bool is_searchable_string;
+    sc_uint32 const header_size = sizeof(addr) + sizeof(is_searchable_string);
+    if (size < header_size)
+      return SC_FALSE;
+    sc_mem_cpy(&addr, data, sizeof(addr));
+    sc_mem_cpy(&is_searchable_string, data + sizeof(addr), sizeof(is_searchable_string));
+
+    // not searchable strings aren't shared by sc-links, so the same content would be written to strings file again
+    if (_sc_storage_has_link_content(addr, data + header_size, size - header_size))
+      return SC_TRUE;
+
+    return sc_fs_memory_link_string_ext(
+               SC_ADDR_LOCAL_TO_INT(addr), data + header_size, size - header_size, is_searchable_string)
+           == SC_FS_MEMORY_OK;
+  }
+
+  case SC_STORAGE_WAL_RECORD_LINK_CONTENT_ERASE:
+  {
+    sc_addr addr;
+    if (size != sizeof(addr))
+      return SC_FALSE;
+    sc_mem_cpy(&addr, data, sizeof(addr));
+
+    // content of sc-link may be already erased in loaded dump
+    sc_fs_memory_unlink_string(SC_ADDR_LOCAL_TO_INT(addr));
+    return SC_TRUE;
+  }
+
+  default:
+    return SC_FALSE;
+  }
+}
+
+// records of write-ahead log and skipped corrupted segments don't contain lists of free sc-elements, so they are
+// restored after records are applied or segments are loaded
+void sc_storage_restore_free_elements(sc_storage * storage)
+{
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    storage->last_not_engaged_segment_num[pool] = 0;
+    storage->last_released_segment_num[pool] = 0;
+  }
+
+  // segments are pushed to lists in reverse order, so sc-elements are allocated from the first segments
+  for (sc_addr_seg num = storage->segments_count; num > 0; --num)
+  {
+    sc_segment * segment = storage->segments[num - 1];
+    sc_uint32 const element_size = SC_SEGMENT_ELEMENT_SIZE(segment->pool);
+
+    sc_addr_offset last_engaged_offset = SC_SEGMENT_ELEMENTS_COUNT - 1;
+    while (last_engaged_offset != 0
+           && (sc_segment_get_element(segment, last_engaged_offset)->flags.states & SC_STATE_ELEMENT_EXIST) == 0)
+      --last_engaged_offset;
+
+    sc_addr_offset last_released_offset = 0;
+    for (sc_addr_offset offset = last_engaged_offset; offset != 0; --offset)
+    {
+      sc_element * element = sc_segment_get_element(segment, offset);
+      if ((element->flags.states & SC_STATE_ELEMENT_EXIST) == SC_STATE_ELEMENT_EXIST)
+        continue;
+
+      sc_mem_set(element, 0, element_size);
+      element->flags.type = last_released_offset;
+      last_released_offset = offset;
+    }
+    segment->last_engaged_offset = last_engaged_offset;
+    segment->last_released_offset = last_released_offset;
+
+    sc_element * list_element = sc_segment_get_element(segment, 0);
+    list_element->flags.states = 0;
+    list_element->flags.type = 0;
+    if (last_engaged_offset + 1 != SC_SEGMENT_ELEMENTS_COUNT || last_released_offset != 0)
+    {
+      list_element->flags.states = storage->last_not_engaged_segment_num[segment->pool];
+      storage->last_not_engaged_segment_num[segment->pool] = num;
+    }
+    if (last_released_offset != 0)
+    {
+      list_element->flags.type = storage->last_released_segment_num[segment->pool];
+      storage->last_released_segment_num[segment->pool] = num;
+    }
+    segment->is_dirty = SC_TRUE;
+  }
+}
 
 sc_result sc_storage_initialize(sc_memory_params const * params)
 {
@@ -30,33 +281,57 @@ sc_result sc_storage_initialize(sc_memory_params const * params)
     return SC_RESULT_ERROR;
 
   storage = sc_mem_new(sc_storage, 1);
-  storage->max_segments_count = params->max_loaded_segments;
+  storage->segments = null_ptr;
   storage->segments_count = 0;
-  storage->last_not_engaged_segment_num = 0;
-  storage->last_released_segment_num = 0;
-  storage->segments = sc_mem_new(sc_segment *, params->max_loaded_segments);
+  storage->segments_capacity = 0;
+  sc_list_init(&storage->retired_segments_tables);
+  sc_storage_reserve_segments(storage, sc_min(params->max_loaded_segments, SC_ADDR_SEG_MAX));
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    storage->last_not_engaged_segment_num[pool] = 0;
+    storage->last_released_segment_num[pool] = 0;
+  }
+  ++storage_generation;
   sc_monitor_init(&storage->segments_monitor);
-  _sc_monitor_table_init(&storage->addr_monitors_table);
+  _sc_monitor_table_init(&storage->addr_monitors_table, SC_MONITOR_TABLE_DEFAULT_SIZE);
 
   sc_memory_info("Sc-memory configuration:");
   sc_message("\tClean on initialize: %s", params->clear ? "On" : "Off");
-  sc_message("\tSc-element size: %zd", sizeof(sc_element));
+  sc_message("\tSc-element size: %zd", SC_SEGMENT_ELEMENT_SIZE(SC_SEGMENT_POOL_NODES));
+#ifdef SC_COMPACT_ELEMENTS
+  sc_message("\tSc-connector size: %zd", SC_SEGMENT_ELEMENT_SIZE(SC_SEGMENT_POOL_CONNECTORS));
+#endif
   sc_message("\tSc-segment size: %zd", sizeof(sc_segment));
   sc_message("\tSc-segment elements count: %d", SC_SEGMENT_ELEMENTS_COUNT);
   sc_message("\tSc-storage size: %zd", sizeof(sc_storage));
-  sc_message("\tMax segments count: %d", storage->max_segments_count);
-
-  storage->processes_segments_table = sc_hash_table_init(g_direct_hash, g_direct_equal, null_ptr, null_ptr);
-  sc_monitor_init(&storage->processes_monitor);
+  sc_message("\tInitial segments capacity: %d", storage->segments_capacity);
+  sc_message("\tMax segments count: %d", SC_ADDR_SEG_MAX);
+  sc_segment_allocator_initialize(params);
+  sc_segment_pager_initialize(params);
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  sc_arcs_index_initialize(params);
+#endif
+  sc_connectors_index_initialize(params);
 
   sc_result result = SC_TRUE;
+  sc_monitor_acquire_write(&storage->segments_monitor);
   if (params->clear == SC_FALSE)
-  {
-    sc_monitor_acquire_write(&storage->segments_monitor);
     result = sc_fs_memory_load(storage) == SC_FS_MEMORY_OK;
-    sc_monitor_release_write(&storage->segments_monitor);
+
+  // changes logged after the last dump are applied to loaded sc-memory before it is used
+  sc_uint32 redone_count = 0;
+  if (result)
+    result = sc_storage_wal_initialize(params, _sc_storage_redo_wal_record, &redone_count);
+  if (redone_count != 0)
+  {
+    sc_memory_info("Applied records of write-ahead log: %u", redone_count);
+    sc_storage_restore_free_elements(storage);
   }
 
+  if (result && params->clear == SC_FALSE && sc_connectors_index_is_enabled())
+    _sc_storage_index_connectors(storage->segments_count);
+  sc_monitor_release_write(&storage->segments_monitor);
+
   sc_storage_dump_manager_initialize(&storage->dump_manager, params);
 
   sc_event_subscription_manager_initialize(&storage->events_subscription_manager);
@@ -65,6 +340,138 @@ sc_result sc_storage_initialize(sc_memory_params const * params)
   return result;
 }
 
+sc_result sc_storage_verify(sc_memory_params const * params, sc_uint32 * corrupted_count)
+{
+  *corrupted_count = 0;
+  if (params->storage == null_ptr || sc_fs_is_directory(params->storage) == SC_FALSE)
+  {
+    sc_memory_error("Sc-storage `%s` doesn't exist", params->storage);
+    return SC_RESULT_ERROR;
+  }
+
+  // saved sc-storage is only read, so it mustn't be cleared on initialize
+  sc_memory_params verify_params = *params;
+  verify_params.clear = SC_FALSE;
+  if (sc_fs_memory_initialize_ext(&verify_params) != SC_FS_MEMORY_OK)
+    return SC_RESULT_ERROR;
+
+  sc_result const result = sc_fs_memory_verify(corrupted_count) == SC_FS_MEMORY_OK ? SC_RESULT_OK : SC_RESULT_ERROR;
+  sc_fs_memory_shutdown();
+  return result;
+}
+
+sc_result sc_storage_compact(
+    sc_memory_params const * params,
+    sc_uint32 * moved_count,
+    sc_addr_seg * freed_segments_count)
+{
+  *moved_count = 0;
+  *freed_segments_count = 0;
+  if (params->storage == null_ptr || sc_fs_is_directory(params->storage) == SC_FALSE)
+  {
+    sc_memory_error("Sc-storage `%s` doesn't exist", params->storage);
+    return SC_RESULT_ERROR;
+  }
+
+  // index of sc-connectors is keyed by addresses of sc-elements, so it isn't built for relocated sc-elements
+  sc_memory_params compact_params = *params;
+  compact_params.clear = SC_FALSE;
+  compact_params.dump_memory = SC_FALSE;
+  compact_params.dump_memory_statistics = SC_FALSE;
+  compact_params.connectors_index = SC_FALSE;
+  if (sc_storage_initialize(&compact_params) != SC_RESULT_OK)
+  {
+    sc_storage_shutdown(SC_FALSE);
+    return SC_RESULT_ERROR;
+  }
+
+  sc_monitor_acquire_write(&storage->segments_monitor);
+  sc_storage_compact_segments(storage, moved_count, freed_segments_count);
+  sc_monitor_release_write(&storage->segments_monitor);
+  sc_memory_info("Relocated sc-elements: %u, freed segments: %u", *moved_count, *freed_segments_count);
+
+  // all segments are saved, so changes of compaction aren't needed in write-ahead log
+  sc_result const result = sc_storage_save(null_ptr);
+  sc_storage_shutdown(SC_FALSE);
+  return result;
+}
+
+sc_uint32 _sc_storage_get_export_threads_count(sc_memory_params const * params)
+{
+  // sc-elements are exported and imported by the same count of threads as sc-segments are loaded and saved
+  return params->limit_max_threads_by_max_physical_cores
+             ? sc_boundary(params->max_events_and_agents_threads, 1, g_get_num_processors())
+             : sc_max(1, params->max_events_and_agents_threads);
+}
+
+sc_result sc_storage_export(sc_memory_params const * params, sc_char const * path, sc_uint64 * exported_count)
+{
+  *exported_count = 0;
+  if (params->storage == null_ptr || sc_fs_is_directory(params->storage) == SC_FALSE)
+  {
+    sc_memory_error("Sc-storage `%s` doesn't exist", params->storage);
+    return SC_RESULT_ERROR;
+  }
+
+  // saved sc-storage is only read, so it isn't dumped and its reading isn't logged
+  sc_memory_params export_params = *params;
+  export_params.clear = SC_FALSE;
+  export_params.dump_memory = SC_FALSE;
+  export_params.dump_memory_statistics = SC_FALSE;
+  export_params.connectors_index = SC_FALSE;
+  export_params.write_ahead_log = SC_FALSE;
+  if (sc_storage_initialize(&export_params) != SC_RESULT_OK)
+  {
+    sc_storage_shutdown(SC_FALSE);
+    return SC_RESULT_ERROR;
+  }
+
+  sc_monitor_acquire_read(&storage->segments_monitor);
+  sc_result const result =
+      sc_storage_export_elements(storage, path, _sc_storage_get_export_threads_count(params), exported_count)
+          ? SC_RESULT_OK
+          : SC_RESULT_ERROR;
+  sc_monitor_release_read(&storage->segments_monitor);
+  sc_memory_info("Exported sc-elements: %" PRIu64, *exported_count);
+
+  sc_storage_shutdown(SC_FALSE);
+  return result;
+}
+
+sc_result sc_storage_import(sc_memory_params const * params, sc_char const * path, sc_uint64 * imported_count)
+{
+  *imported_count = 0;
+  if (sc_fs_is_file(path) == SC_FALSE)
+  {
+    sc_memory_error("File `%s` with exported sc-elements doesn't exist", path);
+    return SC_RESULT_ERROR;
+  }
+
+  // all segments are saved after import, so imported sc-elements aren't logged, and index of sc-connectors is built on
+  // the next load
+  sc_memory_params import_params = *params;
+  import_params.dump_memory = SC_FALSE;
+  import_params.dump_memory_statistics = SC_FALSE;
+  import_params.connectors_index = SC_FALSE;
+  import_params.write_ahead_log = SC_FALSE;
+  if (sc_storage_initialize(&import_params) != SC_RESULT_OK)
+  {
+    sc_storage_shutdown(SC_FALSE);
+    return SC_RESULT_ERROR;
+  }
+
+  sc_result result =
+      sc_storage_import_elements(path, _sc_storage_get_export_threads_count(params), imported_count)
+          ? SC_RESULT_OK
+          : SC_RESULT_ERROR;
+  sc_memory_info("Imported sc-elements: %" PRIu64, *imported_count);
+
+  if (result == SC_RESULT_OK)
+    result = sc_storage_save(null_ptr);
+  sc_storage_shutdown(SC_FALSE);
+  return result;
+}
+
 sc_result sc_storage_shutdown(sc_bool save_state)
 {
   if (storage == null_ptr)
@@ -78,11 +485,12 @@ sc_result sc_storage_shutdown(sc_bool save_state)
 
   sc_storage_dump_manager_shutdown(storage->dump_manager);
 
-  if (save_state == SC_TRUE)
-  {
-    if (sc_fs_memory_save(storage) != SC_FS_MEMORY_OK)
-      return SC_RESULT_ERROR;
-  }
+  // sc-elements held by caches of threads are returned to segments before they are saved
+  sc_storage_drain_allocation_caches();
+  if (save_state == SC_TRUE && sc_storage_save(null_ptr) != SC_RESULT_OK)
+    return SC_RESULT_ERROR;
+
+  sc_storage_wal_shutdown();
 
 error:
   if (sc_fs_memory_shutdown() != SC_FS_MEMORY_OK)
@@ -91,17 +499,6 @@ error:
   if (storage == null_ptr)
     return SC_RESULT_NO;
 
-  sc_monitor_acquire_write(&storage->processes_monitor);
-
-  if (storage->processes_segments_table != null_ptr)
-  {
-    sc_hash_table_destroy(storage->processes_segments_table);
-    storage->processes_segments_table = null_ptr;
-  }
-
-  sc_monitor_release_write(&storage->processes_monitor);
-  sc_monitor_destroy(&storage->processes_monitor);
-
   sc_monitor_acquire_write(&storage->segments_monitor);
 
   for (sc_addr_seg idx = 0; idx < storage->segments_count; idx++)
@@ -115,14 +512,50 @@ error:
   sc_monitor_release_write(&storage->segments_monitor);
 
   sc_mem_free(storage->segments);
+  sc_list_clear(storage->retired_segments_tables);
+  sc_list_destroy(storage->retired_segments_tables);
   sc_monitor_destroy(&storage->segments_monitor);
   _sc_monitor_table_destroy(&storage->addr_monitors_table);
   sc_mem_free(storage);
   storage = null_ptr;
+  sc_segment_allocator_shutdown();
+  sc_segment_pager_shutdown();
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  sc_arcs_index_shutdown();
+#endif
+  sc_connectors_index_shutdown();
 
   return SC_RESULT_OK;
 }
 
+sc_result sc_storage_set_connectors_index(sc_bool is_enabled)
+{
+  if (storage == null_ptr)
+    return SC_RESULT_ERROR;
+
+  // index is changed under monitors of all sc-addrs, because it is updated and read under monitors of sc-addrs only
+  _sc_monitor_table_acquire_all_write(&storage->addr_monitors_table);
+  if (is_enabled == sc_connectors_index_is_enabled())
+    goto end;
+
+  if (is_enabled)
+  {
+    sc_monitor_acquire_read(&storage->segments_monitor);
+    sc_addr_seg const segments_count = storage->segments_count;
+    sc_monitor_release_read(&storage->segments_monitor);
+
+    sc_connectors_index_enable();
+    _sc_storage_index_connectors(segments_count);
+  }
+  else
+    sc_connectors_index_disable();
+
+  sc_memory_info("Connectors index: %s", is_enabled ? "On" : "Off");
+end:
+  _sc_monitor_table_release_all_write(&storage->addr_monitors_table);
+  return SC_RESULT_OK;
+}
+
 sc_bool sc_storage_is_initialized()
 {
   return storage != null_ptr;
@@ -151,20 +584,113 @@ sc_bool sc_storage_is_element(sc_memory_context const * ctx, sc_addr addr)
   return result == SC_RESULT_OK;
 }
 
+sc_bool sc_storage_reserve_segments(sc_storage * storage, sc_uint32 count)
+{
+  sc_uint32 capacity = storage->segments_capacity;
+  if (count <= capacity)
+    return SC_TRUE;
+  if (count > SC_ADDR_SEG_MAX)
+    return SC_FALSE;
+
+  sc_uint32 new_capacity = capacity == 0 ? count : capacity;
+  while (new_capacity < count)
+    new_capacity *= 2;
+  new_capacity = sc_min(new_capacity, SC_ADDR_SEG_MAX);
+
+  sc_segment ** segments = sc_mem_new(sc_segment *, new_capacity);
+  if (storage->segments != null_ptr)
+  {
+    sc_mem_cpy(segments, storage->segments, sizeof(sc_segment *) * capacity);
+    sc_list_push_back(storage->retired_segments_tables, storage->segments);
+  }
+
+  // table is published before its capacity, so readers never index a table smaller than the read capacity
+  g_atomic_pointer_set(&storage->segments, segments);
+  g_atomic_int_set(&storage->segments_capacity, new_capacity);
+
+  return SC_TRUE;
+}
+
+sc_segment * _sc_storage_get_segment_by_num(sc_addr_seg num)
+{
+  if (num == 0 || num > (sc_uint32)g_atomic_int_get(&storage->segments_capacity))
+    return null_ptr;
+
+  sc_segment ** segments = g_atomic_pointer_get(&storage->segments);
+  return segments[num - 1];
+}
+
+/*! Marks segment as changed after the last dump, so it is written by the next incremental dump. Dumps reset the flag
+ * before they copy segment, so it must be set after sc-elements of segment are changed.
+ */
+void _sc_storage_mark_segment_dirty(sc_segment * segment)
+{
+  // the flag is read first, so threads changing the same segment don't write its cache line every time
+  if (g_atomic_int_get(&segment->is_dirty) == SC_FALSE)
+    g_atomic_int_set(&segment->is_dirty, SC_TRUE);
+}
+
+void _sc_storage_mark_element_dirty(sc_addr addr)
+{
+  sc_segment * segment = _sc_storage_get_segment_by_num(addr.seg);
+  if (segment != null_ptr)
+    _sc_storage_mark_segment_dirty(segment);
+}
+
+// Size of buffer for records of write-ahead log with images of sc-elements changed by one sc-connector
+#define SC_STORAGE_WAL_ELEMENTS_BUFFER_SIZE 1024
+
+/*! Appends after-images of sc-elements to write-ahead log. Empty sc-addrs are skipped.
+ * @note Monitors of sc-elements must be acquired, if other threads can change them.
+ */
+void _sc_storage_log_elements(sc_uint8 kind, sc_addr const * addrs, sc_uint32 count)
+{
+  if (sc_storage_wal_is_enabled() == SC_FALSE)
+    return;
+
+  sc_uint32 size = 0;
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_segment * segment = _sc_storage_get_segment_by_num(addrs[i].seg);
+    if (segment != null_ptr)
+      size += sizeof(sc_addr) + SC_SEGMENT_ELEMENT_SIZE(segment->pool);
+  }
+
+  sc_char buffer[SC_STORAGE_WAL_ELEMENTS_BUFFER_SIZE];
+  sc_char * data = size <= sizeof(buffer) ? buffer : sc_mem_new(sc_char, size);
+
+  sc_char * image = data;
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_segment * segment = _sc_storage_get_segment_by_num(addrs[i].seg);
+    if (segment == null_ptr)
+      continue;
+
+    sc_uint32 const element_size = SC_SEGMENT_ELEMENT_SIZE(segment->pool);
+    sc_mem_cpy(image, &addrs[i], sizeof(sc_addr));
+    sc_mem_cpy(image + sizeof(sc_addr), sc_segment_get_element(segment, addrs[i].offset), element_size);
+    image += sizeof(sc_addr) + element_size;
+  }
+
+  sc_storage_wal_append(kind, data, size);
+  if (data != buffer)
+    sc_mem_free(data);
+}
+
 sc_result sc_storage_get_element_by_addr(sc_addr addr, sc_element ** el)
 {
   *el = null_ptr;
   sc_result result = SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
 
-  if (storage == null_ptr || addr.seg == 0 || addr.offset == 0 || addr.seg > storage->max_segments_count
-      || addr.offset > SC_SEGMENT_ELEMENTS_COUNT)
+  if (storage == null_ptr || addr.offset == 0 || addr.offset > SC_SEGMENT_ELEMENTS_COUNT)
     goto error;
 
-  sc_segment * segment = storage->segments[addr.seg - 1];
+  sc_segment * segment = _sc_storage_get_segment_by_num(addr.seg);
   if (segment == null_ptr)
     goto error;
 
-  *el = &segment->elements[addr.offset];
+  sc_segment_pager_access(segment);
+  *el = sc_segment_get_element(segment, addr.offset);
   if (((*el)->flags.states & SC_STATE_ELEMENT_EXIST) != SC_STATE_ELEMENT_EXIST)
     goto error;
 
@@ -173,6 +699,167 @@ error:
   return result;
 }
 
+void _sc_storage_clear_element(sc_segment * segment, sc_element * element, sc_addr_offset next_released_offset)
+{
+  *element = (sc_element){(sc_element_flags){.type = next_released_offset}};
+#ifdef SC_COMPACT_ELEMENTS
+  if (segment->pool == SC_SEGMENT_POOL_CONNECTORS)
+    sc_mem_set(sc_element_get_arc(element), 0, sizeof(sc_arc_info));
+#endif
+  _sc_storage_mark_segment_dirty(segment);
+}
+
+void _sc_storage_register_released_segment(sc_segment * segment)
+{
+  sc_monitor_acquire_write(&storage->segments_monitor);
+  sc_segment_get_element(segment, 0)->flags.type = storage->last_released_segment_num[segment->pool];
+  storage->last_released_segment_num[segment->pool] = segment->num;
+  sc_monitor_release_write(&storage->segments_monitor);
+  _sc_storage_mark_segment_dirty(segment);
+}
+
+void _sc_storage_release_element_offset(sc_segment * segment, sc_addr_offset offset)
+{
+  sc_monitor_acquire_write(&segment->monitor);
+  sc_addr_offset const last_released_offset = segment->last_released_offset;
+  _sc_storage_clear_element(segment, sc_segment_get_element(segment, offset), last_released_offset);
+  segment->last_released_offset = offset;
+  sc_monitor_release_write(&segment->monitor);
+
+  if (last_released_offset == 0)
+    _sc_storage_register_released_segment(segment);
+}
+
+void _sc_storage_flush_allocation_cache(sc_storage_allocation_cache * cache)
+{
+  for (sc_uint32 i = 0; i < cache->released_addrs_count; ++i)
+  {
+    sc_addr const addr = cache->released_addrs[i];
+    _sc_storage_release_element_offset(_sc_storage_get_segment_by_num(addr.seg), addr.offset);
+  }
+  cache->released_addrs_count = 0;
+
+  sc_segment * segment = cache->segment;
+  if (segment == null_ptr)
+    return;
+
+  for (sc_addr_offset offset = cache->next_offset; offset < cache->end_offset; ++offset)
+    _sc_storage_release_element_offset(segment, offset);
+  cache->segment = null_ptr;
+  cache->next_offset = 0;
+  cache->end_offset = 0;
+
+  // segment can be engaged by other threads if it has free sc-elements
+  sc_monitor_acquire_read(&segment->monitor);
+  sc_bool const has_free_elements =
+      segment->last_engaged_offset + 1 != SC_SEGMENT_ELEMENTS_COUNT || segment->last_released_offset != 0;
+  sc_monitor_release_read(&segment->monitor);
+
+  if (has_free_elements)
+  {
+    sc_monitor_acquire_write(&storage->segments_monitor);
+
+    sc_addr_seg const last_not_engaged_segment_num = storage->last_not_engaged_segment_num[segment->pool];
+    sc_segment_get_element(segment, 0)->flags.states = last_not_engaged_segment_num;
+    storage->last_not_engaged_segment_num[segment->pool] = segment->num;
+
+    sc_monitor_release_write(&storage->segments_monitor);
+    _sc_storage_mark_segment_dirty(segment);
+  }
+}
+
+// list of allocation caches of all threads, statically allocated mutex doesn't need initialization
+sc_storage_allocation_caches * allocation_caches_list = null_ptr;
+sc_mutex allocation_caches_list_mutex;
+
+void _sc_storage_allocation_caches_free(sc_pointer data)
+{
+  sc_storage_allocation_caches * caches = data;
+
+  sc_mutex_lock(&allocation_caches_list_mutex);
+  if (caches->prev != null_ptr)
+    caches->prev->next = caches->next;
+  else
+    allocation_caches_list = caches->next;
+  if (caches->next != null_ptr)
+    caches->next->prev = caches->prev;
+  sc_mutex_unlock(&allocation_caches_list_mutex);
+
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    sc_storage_allocation_cache * cache = &caches->pools[pool];
+    if (storage != null_ptr && cache->storage_generation == storage_generation)
+      _sc_storage_flush_allocation_cache(cache);
+    sc_mutex_destroy(&cache->mutex);
+  }
+
+  sc_mem_free(caches);
+}
+
+sc_thread_local allocation_caches = SC_THREAD_LOCAL_INIT(_sc_storage_allocation_caches_free);
+
+void sc_storage_drain_allocation_caches()
+{
+  sc_mutex_lock(&allocation_caches_list_mutex);
+  for (sc_storage_allocation_caches * caches = allocation_caches_list; caches != null_ptr; caches = caches->next)
+  {
+    for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    {
+      sc_storage_allocation_cache * cache = &caches->pools[pool];
+      sc_mutex_lock(&cache->mutex);
+      if (cache->storage_generation == storage_generation)
+        _sc_storage_flush_allocation_cache(cache);
+      sc_mutex_unlock(&cache->mutex);
+    }
+  }
+  sc_mutex_unlock(&allocation_caches_list_mutex);
+}
+
+/*! Gets allocation cache of the current thread for pool and locks it. The lock isn't contended, other threads acquire
+ * it only when they drain caches.
+ * @param pool Pool of segments
+ * @returns Locked allocation cache, it must be released by `_sc_storage_release_allocation_cache`.
+ */
+sc_storage_allocation_cache * _sc_storage_acquire_allocation_cache(sc_uint8 pool)
+{
+  sc_storage_allocation_caches * caches = sc_thread_local_get(&allocation_caches);
+  if (caches == null_ptr)
+  {
+    caches = sc_mem_new(sc_storage_allocation_caches, 1);
+    for (sc_uint8 i = 0; i < SC_SEGMENT_POOLS_COUNT; ++i)
+      sc_mutex_init(&caches->pools[i].mutex);
+    sc_thread_local_set(&allocation_caches, caches);
+
+    sc_mutex_lock(&allocation_caches_list_mutex);
+    caches->next = allocation_caches_list;
+    if (allocation_caches_list != null_ptr)
+      allocation_caches_list->prev = caches;
+    allocation_caches_list = caches;
+    sc_mutex_unlock(&allocation_caches_list_mutex);
+  }
+
+  sc_storage_allocation_cache * cache = &caches->pools[pool];
+  sc_mutex_lock(&cache->mutex);
+
+  // segments of previous sc-storage don't exist anymore, so the cache is just reset
+  if (cache->storage_generation != storage_generation)
+  {
+    cache->storage_generation = storage_generation;
+    cache->pool = pool;
+    cache->segment = null_ptr;
+    cache->next_offset = 0;
+    cache->end_offset = 0;
+    cache->released_addrs_count = 0;
+  }
+
+  return cache;
+}
+
+void _sc_storage_release_allocation_cache(sc_storage_allocation_cache * cache)
+{
+  sc_mutex_unlock(&cache->mutex);
+}
+
 sc_result sc_storage_free_element(sc_addr addr)
 {
   sc_result result = SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
@@ -181,45 +868,43 @@ sc_result sc_storage_free_element(sc_addr addr)
   if (sc_storage_get_element_by_addr(addr, &element) != SC_RESULT_OK)
     goto error;
 
-  sc_monitor_acquire_read(&storage->segments_monitor);
-  sc_segment * segment = storage->segments[addr.seg - 1];
-  sc_monitor_release_read(&storage->segments_monitor);
+  sc_segment * segment = _sc_storage_get_segment_by_num(addr.seg);
   if (segment == null_ptr)
     goto error;
 
-  sc_monitor_acquire_write(&segment->monitor);
-  sc_addr_offset const last_released_offset = segment->last_released_offset;
-  segment->elements[addr.offset] = (sc_element){(sc_element_flags){.type = last_released_offset}};
-  segment->last_released_offset = addr.offset;
-  sc_monitor_release_write(&segment->monitor);
+  sc_storage_wal_append(SC_STORAGE_WAL_RECORD_ELEMENTS_ERASE, &addr, sizeof(addr));
 
-  if (last_released_offset == 0)
+  sc_storage_allocation_cache * cache = _sc_storage_acquire_allocation_cache(segment->pool);
+  if (cache->released_addrs_count < SC_STORAGE_RELEASED_ADDRS_CACHE_SIZE)
   {
-    sc_monitor_acquire_write(&storage->segments_monitor);
-    segment->elements[0].flags.type = storage->last_released_segment_num;
-    storage->last_released_segment_num = segment->num;
-    sc_monitor_release_write(&storage->segments_monitor);
+    _sc_storage_clear_element(segment, element, 0);
+    cache->released_addrs[cache->released_addrs_count++] = addr;
   }
+  else
+    _sc_storage_release_element_offset(segment, addr.offset);
+  _sc_storage_release_allocation_cache(cache);
 
   result = SC_RESULT_OK;
 error:
   return result;
 }
 
-sc_segment * _sc_storage_get_last_not_engaged_segment()
+sc_segment * _sc_storage_get_last_not_engaged_segment(sc_uint8 pool)
 {
   sc_segment * segment = null_ptr;
   sc_addr_seg segment_num;
 
   do
   {
-    segment_num = storage->last_not_engaged_segment_num;
+    segment_num = storage->last_not_engaged_segment_num[pool];
     segment = segment_num == 0 ? null_ptr : storage->segments[segment_num - 1];
 
     if (segment != null_ptr)
     {
-      storage->last_not_engaged_segment_num = segment->elements[0].flags.states;
-      segment->elements[0].flags.states = 0;
+      sc_element * list_element = sc_segment_get_element(segment, 0);
+      storage->last_not_engaged_segment_num[pool] = list_element->flags.states;
+      list_element->flags.states = 0;
+      _sc_storage_mark_segment_dirty(segment);
     }
   }
   while (segment != null_ptr
@@ -228,20 +913,30 @@ sc_segment * _sc_storage_get_last_not_engaged_segment()
   return segment;
 }
 
-sc_segment * _sc_storage_get_new_segment()
+sc_segment * _sc_storage_get_new_segment(sc_uint8 pool)
 {
   sc_segment * segment = null_ptr;
-  if (storage->segments_count == storage->max_segments_count)
+  if (!sc_storage_reserve_segments(storage, storage->segments_count + 1))
     goto error;
 
-  segment = storage->segments[storage->segments_count] = sc_segment_new(storage->segments_count + 1);
+  segment = storage->segments[storage->segments_count] = sc_segment_new(storage->segments_count + 1, pool);
+  // segment is dirty before it is counted, so dumps that count it also write it
+  segment->is_dirty = SC_TRUE;
   ++storage->segments_count;
 
+  if (sc_storage_wal_is_enabled())
+  {
+    sc_char data[sizeof(sc_addr_seg) + sizeof(sc_uint8)];
+    sc_mem_cpy(data, &segment->num, sizeof(sc_addr_seg));
+    sc_mem_cpy(data + sizeof(sc_addr_seg), &pool, sizeof(sc_uint8));
+    sc_storage_wal_append(SC_STORAGE_WAL_RECORD_SEGMENT_NEW, data, sizeof(data));
+  }
+
 error:
   return segment;
 }
 
-sc_segment * _sc_storage_get_last_free_segment()
+sc_segment * _sc_storage_get_last_free_segment(sc_uint8 pool)
 {
   sc_segment * segment = null_ptr;
 
@@ -251,7 +946,7 @@ sc_segment * _sc_storage_get_last_free_segment()
   sc_addr_seg last_segment_idx = storage->segments_count - 1;
   segment = storage->segments[last_segment_idx];
 
-  if (segment->last_engaged_offset + 1 == SC_SEGMENT_ELEMENTS_COUNT)
+  if (segment->pool != pool || segment->last_engaged_offset + 1 == SC_SEGMENT_ELEMENTS_COUNT)
   {
     segment = null_ptr;
     goto error;
@@ -261,95 +956,100 @@ error:
   return segment;
 }
 
-void _sc_storage_check_segment_type(sc_segment ** segment)
-{
-  sc_monitor_acquire_read(&(*segment)->monitor);
-  sc_addr_offset last_released_offset = (*segment)->last_released_offset;
-  sc_addr_offset last_engaged_offset = (*segment)->last_engaged_offset;
-  sc_monitor_release_read(&(*segment)->monitor);
-
-  if (last_released_offset != 0)
-    return;
-  else if (last_engaged_offset + 1 == SC_SEGMENT_ELEMENTS_COUNT)
-    *segment = null_ptr;
-}
-
-sc_segment * _sc_storage_get_segment()
+sc_segment * _sc_storage_get_segment(sc_uint8 pool)
 {
   sc_segment * segment = null_ptr;
-  sc_thread * thread = sc_thread_self();
 
-  sc_monitor_acquire_read(&storage->processes_monitor);
+  sc_monitor_acquire_write(&storage->segments_monitor);
 
-  if (storage->processes_segments_table != null_ptr)
-    segment = (sc_segment *)sc_hash_table_get(storage->processes_segments_table, thread);
+  segment = _sc_storage_get_last_not_engaged_segment(pool);
+  if (segment == null_ptr)
+  {
+    segment = _sc_storage_get_new_segment(pool);
+    if (segment == null_ptr)
+      segment = _sc_storage_get_last_free_segment(pool);
+  }
 
-  sc_monitor_release_read(&storage->processes_monitor);
+  sc_monitor_release_write(&storage->segments_monitor);
 
-  if (segment != null_ptr)
-    _sc_storage_check_segment_type(&segment);
+  return segment;
+}
 
-  if (segment == null_ptr)
+/*! Reserves a block of sc-elements for the thread-local allocation cache.
+ * @param cache Thread-local allocation cache to fill
+ * @param block_size Maximum count of not engaged sc-elements reserved in a segment at once
+ * @returns SC_FALSE, if there are no segments to reserve sc-elements in, otherwise SC_TRUE.
+ */
+sc_bool _sc_storage_fill_allocation_cache(sc_storage_allocation_cache * cache, sc_addr_offset block_size)
+{
+  while (SC_TRUE)
   {
-    sc_monitor_acquire_write(&storage->processes_monitor);
-    sc_monitor_acquire_write(&storage->segments_monitor);
-
-    segment = _sc_storage_get_last_not_engaged_segment();
-    if (segment == null_ptr)
+    if (cache->segment == null_ptr)
     {
-      segment = _sc_storage_get_new_segment();
-      if (segment == null_ptr)
-        segment = _sc_storage_get_last_free_segment();
+      cache->segment = _sc_storage_get_segment(cache->pool);
+      if (cache->segment == null_ptr)
+        return SC_FALSE;
     }
 
-    if (segment != null_ptr)
+    sc_segment * segment = cache->segment;
+    sc_monitor_acquire_write(&segment->monitor);
+
+    // reserve a block of not engaged sc-elements, or take released ones if the segment is fully engaged
+    if (segment->last_engaged_offset + 1 != SC_SEGMENT_ELEMENTS_COUNT)
     {
-      if (storage->processes_segments_table != null_ptr)
-        sc_hash_table_insert(storage->processes_segments_table, thread, segment);
+      sc_addr_offset count = SC_SEGMENT_ELEMENTS_COUNT - 1 - segment->last_engaged_offset;
+      if (count > block_size)
+        count = block_size;
+
+      cache->next_offset = segment->last_engaged_offset + 1;
+      cache->end_offset = cache->next_offset + count;
+      segment->last_engaged_offset += count;
     }
+    else
+    {
+      while (segment->last_released_offset != 0 && cache->released_addrs_count < SC_STORAGE_ALLOCATION_BLOCK_SIZE)
+      {
+        sc_addr_offset const element_offset = segment->last_released_offset;
+        sc_element * element = sc_segment_get_element(segment, element_offset);
+        segment->last_released_offset = element->flags.type;
+        element->flags.type = 0;
 
-    sc_monitor_release_write(&storage->segments_monitor);
-    sc_monitor_release_write(&storage->processes_monitor);
-  }
+        cache->released_addrs[cache->released_addrs_count++] = (sc_addr){segment->num, element_offset};
+      }
+    }
 
-  return segment;
+    _sc_storage_mark_segment_dirty(segment);
+    sc_monitor_release_write(&segment->monitor);
+
+    if (cache->next_offset != cache->end_offset || cache->released_addrs_count != 0)
+      return SC_TRUE;
+
+    cache->segment = null_ptr;
+  }
 }
 
-sc_element * _sc_storage_get_element(sc_addr * addr)
+sc_element * _sc_storage_get_element(sc_uint8 pool, sc_addr * addr)
 {
   sc_element * element = null_ptr;
-  sc_addr_offset element_offset;
 
-  sc_segment * segment = _sc_storage_get_segment();
-  if (segment == null_ptr)
+  sc_storage_allocation_cache * cache = _sc_storage_acquire_allocation_cache(pool);
+  if (cache->released_addrs_count == 0 && cache->next_offset == cache->end_offset
+      && !_sc_storage_fill_allocation_cache(cache, SC_STORAGE_ALLOCATION_BLOCK_SIZE))
     goto error;
 
-  sc_monitor_acquire_write(&segment->monitor);
-
-  if (segment->last_engaged_offset + 1 != SC_SEGMENT_ELEMENTS_COUNT)
-  {
-    element_offset = ++segment->last_engaged_offset;
-    element = &segment->elements[element_offset];
-
-    *addr = (sc_addr){segment->num, element_offset};
-  }
-  else if (segment->last_released_offset != 0)
-  {
-    element_offset = segment->last_released_offset;
-    element = &segment->elements[element_offset];
-    segment->last_released_offset = element->flags.type;
-    element->flags.type = 0;
-
-    *addr = (sc_addr){segment->num, element_offset};
-  }
+  if (cache->released_addrs_count != 0)
+    *addr = cache->released_addrs[--cache->released_addrs_count];
+  else
+    *addr = (sc_addr){cache->segment->num, cache->next_offset++};
 
-  sc_monitor_release_write(&segment->monitor);
+  element = sc_segment_get_element(_sc_storage_get_segment_by_num(addr->seg), addr->offset);
 
 error:
+  _sc_storage_release_allocation_cache(cache);
   return element;
 }
 
-sc_element * _sc_storage_get_released_element(sc_addr * addr)
+sc_element * _sc_storage_get_released_element(sc_uint8 pool, sc_addr * addr)
 {
   sc_segment * segment = null_ptr;
   sc_element * element = null_ptr;
@@ -360,8 +1060,8 @@ sc_element * _sc_storage_get_released_element(sc_addr * addr)
   sc_addr_seg segment_num = 0;
 new_segment:
 {
-  segment_num = storage->last_released_segment_num;
-  if (segment_num == 0 || segment_num > storage->max_segments_count)
+  segment_num = storage->last_released_segment_num[pool];
+  if (segment_num == 0 || segment_num > storage->segments_count)
     goto error;
 }
 
@@ -370,22 +1070,24 @@ new_segment:
   element_offset = segment->last_released_offset;
   if (segment->last_released_offset == 0)
   {
-    storage->last_released_segment_num = segment->elements[0].flags.type;
-    segment->elements[0].flags.type = 0;
+    storage->last_released_segment_num[pool] = sc_segment_get_element(segment, 0)->flags.type;
+    sc_segment_get_element(segment, 0)->flags.type = 0;
+    _sc_storage_mark_segment_dirty(segment);
     goto new_segment;
   }
   else
   {
-    element = &segment->elements[element_offset];
+    element = sc_segment_get_element(segment, element_offset);
     segment->last_released_offset = element->flags.type;
     element->flags.type = 0;
   }
 
   if (segment->last_released_offset == 0)
   {
-    storage->last_released_segment_num = segment->elements[0].flags.type;
-    segment->elements[0].flags.type = 0;
+    storage->last_released_segment_num[pool] = sc_segment_get_element(segment, 0)->flags.type;
+    sc_segment_get_element(segment, 0)->flags.type = 0;
   }
+  _sc_storage_mark_segment_dirty(segment);
 
 error:
   sc_monitor_release_write(&storage->segments_monitor);
@@ -395,19 +1097,23 @@ error:
   return element;
 }
 
-sc_element * sc_storage_allocate_new_element(sc_memory_context const * ctx, sc_addr * addr)
+sc_element * sc_storage_allocate_new_element(sc_memory_context const * ctx, sc_type type, sc_addr * addr)
 {
   *addr = SC_ADDR_EMPTY;
   sc_element * element = null_ptr;
 
-  element = _sc_storage_get_element(addr);
+  sc_uint8 const pool = sc_segment_pool_of_type(type);
+  element = _sc_storage_get_element(pool, addr);
+  if (element == null_ptr)
+    element = _sc_storage_get_released_element(pool, addr);
   if (element == null_ptr)
   {
-    element = _sc_storage_get_released_element(addr);
+    // sc-elements held by caches of other threads are the last free ones
+    sc_storage_drain_allocation_caches();
+    element = _sc_storage_get_released_element(pool, addr);
     if (element == null_ptr)
       sc_memory_error(
-          "Max segments count is %d. SC-memory is full. Please, extends or swap sc-memory",
-          storage->max_segments_count);
+          "Max segments count is %d. SC-memory is full. Please, extends or swap sc-memory", SC_ADDR_SEG_MAX);
   }
 
   if (element != null_ptr)
@@ -416,275 +1122,472 @@ sc_element * sc_storage_allocate_new_element(sc_memory_context const * ctx, sc_a
   return element;
 }
 
-void sc_storage_start_new_process()
+/*! Allocates sc-elements of the same pool in batch. Sc-elements are taken from contiguous ranges reserved in segments,
+ * then from released sc-elements.
+ * @param type Type of allocated sc-elements, it selects pool of segments
+ * @param count Count of allocated sc-elements
+ * @param addrs Array of size `count` to store sc-addrs of allocated sc-elements
+ * @returns Count of allocated sc-elements, it is less than `count` if sc-memory is full.
+ */
+sc_uint32 _sc_storage_allocate_new_elements(sc_type type, sc_uint32 count, sc_addr * addrs)
 {
-  if (storage == null_ptr)
-    return;
+  sc_uint8 const pool = sc_segment_pool_of_type(type);
+  sc_storage_allocation_cache * cache = _sc_storage_acquire_allocation_cache(pool);
 
-  sc_thread * thread = sc_thread_self();
-  sc_monitor_acquire_write(&storage->processes_monitor);
-  if (storage->processes_segments_table == null_ptr)
-    goto end;
+  sc_uint32 allocated_count = 0;
+  while (allocated_count < count)
+  {
+    if (cache->released_addrs_count == 0 && cache->next_offset == cache->end_offset)
+    {
+      sc_uint32 const block_size = sc_max(count - allocated_count, SC_STORAGE_ALLOCATION_BLOCK_SIZE);
+      if (!_sc_storage_fill_allocation_cache(cache, sc_min(block_size, SC_SEGMENT_ELEMENTS_COUNT)))
+        break;
+    }
 
-  sc_hash_table_insert(storage->processes_segments_table, thread, null_ptr);
+    while (cache->next_offset != cache->end_offset && allocated_count < count)
+      addrs[allocated_count++] = (sc_addr){cache->segment->num, cache->next_offset++};
 
-end:
-  sc_monitor_release_write(&storage->processes_monitor);
+    while (cache->released_addrs_count != 0 && allocated_count < count)
+      addrs[allocated_count++] = cache->released_addrs[--cache->released_addrs_count];
+  }
+  _sc_storage_release_allocation_cache(cache);
+
+  sc_bool is_drained = SC_FALSE;
+  while (allocated_count < count)
+  {
+    if (_sc_storage_get_released_element(pool, &addrs[allocated_count]) != null_ptr)
+      ++allocated_count;
+    else if (is_drained == SC_FALSE)
+    {
+      // sc-elements held by caches of other threads are the last free ones
+      sc_storage_drain_allocation_caches();
+      is_drained = SC_TRUE;
+    }
+    else
+    {
+      sc_memory_error(
+          "Max segments count is %d. SC-memory is full. Please, extends or swap sc-memory", SC_ADDR_SEG_MAX);
+      break;
+    }
+  }
+
+  for (sc_uint32 i = 0; i < allocated_count; ++i)
+  {
+    sc_element * element = sc_segment_get_element(_sc_storage_get_segment_by_num(addrs[i].seg), addrs[i].offset);
+    element->flags.states |= SC_STATE_ELEMENT_EXIST;
+  }
+
+  return allocated_count;
 }
 
-void sc_storage_end_new_process()
-{
-  if (storage == null_ptr)
-    return;
+#define SC_STORAGE_ADJACENT_CONNECTORS_COUNT 6
 
-  sc_thread * thread = sc_thread_self();
-  sc_monitor_acquire_write(&storage->processes_monitor);
-  if (storage->processes_segments_table == null_ptr)
-    goto end;
+sc_monitor * _sc_storage_get_not_acquired_monitor(sc_addr addr, sc_monitor * beg_monitor, sc_monitor * end_monitor)
+{
+  // different sc-addrs can share the same monitor stripe, so acquired monitors are compared instead of sc-addrs
+  sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, addr);
+  return monitor == beg_monitor || monitor == end_monitor ? null_ptr : monitor;
+}
 
-  sc_segment * segment = sc_hash_table_get(storage->processes_segments_table, thread);
-  if (segment != null_ptr
-      && (segment->last_engaged_offset + 1 != SC_SEGMENT_ELEMENTS_COUNT || segment->last_released_offset != 0))
+sc_bool _sc_storage_are_adjacent_connectors_equal(sc_addr const * connectors, sc_addr const * other_connectors)
+{
+  for (sc_uint32 i = 0; i < SC_STORAGE_ADJACENT_CONNECTORS_COUNT; ++i)
   {
-    sc_monitor_acquire_write(&storage->segments_monitor);
+    if (SC_ADDR_IS_NOT_EQUAL(connectors[i], other_connectors[i]))
+      return SC_FALSE;
+  }
 
-    sc_addr_seg const last_not_engaged_segment_num = storage->last_not_engaged_segment_num;
-    segment->elements[0].flags.states = last_not_engaged_segment_num;
-    storage->last_not_engaged_segment_num = segment->num;
+  return SC_TRUE;
+}
 
-    sc_monitor_release_write(&storage->segments_monitor);
-  }
-  sc_hash_table_insert(storage->processes_segments_table, thread, null_ptr);
+/*! Acquires monitors of sc-connectors adjacent to a changed sc-connector while monitors of its begin and end
+ * sc-elements are held. Different sc-addrs can share the same monitor stripe, so waiting on adjacent monitors here
+ * could form a lock cycle with another thread. Adjacent monitors are tried first; if any of them is busy, begin and
+ * end monitors are released, and all monitors are acquired again in one ordered pass.
+ * @param beg_monitor Held monitor of begin sc-element.
+ * @param end_monitor Held monitor of end sc-element.
+ * @param adjacent_connectors Adjacent sc-connectors read under `beg_monitor` and `end_monitor`.
+ * @param adjacent_monitors Acquired monitors of adjacent sc-connectors.
+ * @returns SC_TRUE if monitors were acquired without releasing `beg_monitor` and `end_monitor`, otherwise SC_FALSE and
+ * adjacent sc-connectors must be read again.
+ */
+sc_bool _sc_storage_acquire_adjacent_connectors_monitors(
+    sc_monitor * beg_monitor,
+    sc_monitor * end_monitor,
+    sc_addr const * adjacent_connectors,
+    sc_monitor ** adjacent_monitors)
+{
+  for (sc_uint32 i = 0; i < SC_STORAGE_ADJACENT_CONNECTORS_COUNT; ++i)
+    adjacent_monitors[i] = _sc_storage_get_not_acquired_monitor(adjacent_connectors[i], beg_monitor, end_monitor);
+
+  if (sc_monitor_try_acquire_write_n(
+          6,
+          adjacent_monitors[0],
+          adjacent_monitors[1],
+          adjacent_monitors[2],
+          adjacent_monitors[3],
+          adjacent_monitors[4],
+          adjacent_monitors[5]))
+    return SC_TRUE;
 
-end:
-  sc_monitor_release_write(&storage->processes_monitor);
+  sc_monitor_release_write_n(2, beg_monitor, end_monitor);
+  sc_monitor_acquire_write_n(
+      8,
+      beg_monitor,
+      end_monitor,
+      adjacent_monitors[0],
+      adjacent_monitors[1],
+      adjacent_monitors[2],
+      adjacent_monitors[3],
+      adjacent_monitors[4],
+      adjacent_monitors[5]);
+  return SC_FALSE;
 }
 
-sc_result _sc_storage_element_erase(sc_addr addr)
+void _sc_storage_release_adjacent_connectors_monitors(sc_monitor ** adjacent_monitors)
 {
-  sc_result result;
+  sc_monitor_release_write_n(
+      6,
+      adjacent_monitors[0],
+      adjacent_monitors[1],
+      adjacent_monitors[2],
+      adjacent_monitors[3],
+      adjacent_monitors[4],
+      adjacent_monitors[5]);
+}
+
+void _sc_storage_mark_connectors_dirty(sc_addr const * adjacent_connectors)
+{
+  for (sc_uint32 i = 0; i < SC_STORAGE_ADJACENT_CONNECTORS_COUNT; ++i)
+    _sc_storage_mark_element_dirty(adjacent_connectors[i]);
+}
 
+void _sc_storage_get_erased_connector_adjacent_connectors(sc_element * element, sc_addr * adjacent_connectors)
+{
+  adjacent_connectors[0] = sc_element_get_arc(element)->prev_begin_out_arc;
+  adjacent_connectors[1] = sc_element_get_arc(element)->next_begin_out_arc;
+  adjacent_connectors[2] = sc_element_get_arc(element)->prev_end_in_arc;
+  adjacent_connectors[3] = sc_element_get_arc(element)->next_end_in_arc;
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+  adjacent_connectors[4] = sc_element_get_arc(element)->prev_in_arc_from_structure;
+  adjacent_connectors[5] = sc_element_get_arc(element)->next_in_arc_from_structure;
+#else
+  adjacent_connectors[4] = SC_ADDR_EMPTY;
+  adjacent_connectors[5] = SC_ADDR_EMPTY;
+#endif
+}
+
+sc_bool _sc_storage_request_element_erasure(sc_addr addr, sc_element ** element)
+{
   sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, addr);
   sc_monitor_acquire_write(monitor);
 
-  sc_element * element;
-  result = sc_storage_get_element_by_addr(addr, &element);
-  if (result != SC_RESULT_OK || (element->flags.states & SC_STATE_REQUEST_ERASURE) == SC_STATE_REQUEST_ERASURE)
+  if (sc_storage_get_element_by_addr(addr, element) != SC_RESULT_OK
+      || ((*element)->flags.states & SC_STATE_REQUEST_ERASURE) == SC_STATE_REQUEST_ERASURE)
   {
     sc_monitor_release_write(monitor);
-    return result;
+    return SC_FALSE;
   }
 
-  element->flags.states |= SC_STATE_REQUEST_ERASURE;
-  sc_type type = element->flags.type;
+  (*element)->flags.states |= SC_STATE_REQUEST_ERASURE;
 
   sc_monitor_release_write(monitor);
+  return SC_TRUE;
+}
 
-  if (sc_type_has_subtype(type, sc_type_node_link))
-    sc_fs_memory_unlink_string(SC_ADDR_LOCAL_TO_INT(addr));
-  else if (sc_type_has_subtype_in_mask(type, sc_type_connector_mask))
-  {
-    sc_bool const is_edge = sc_type_has_subtype(type, sc_type_common_edge);
+void _sc_storage_unlink_erased_connector(sc_addr addr, sc_element * element)
+{
+  sc_result result;
+  sc_type const type = element->flags.type;
+  sc_bool const is_edge = sc_type_has_subtype(type, sc_type_common_edge);
 
-    sc_addr begin_addr = element->arc.begin;
-    sc_addr end_addr = element->arc.end;
+  sc_addr begin_addr = sc_element_get_arc(element)->begin;
+  sc_addr end_addr = sc_element_get_arc(element)->end;
 
-    sc_bool const is_not_loop = SC_ADDR_IS_NOT_EQUAL(begin_addr, end_addr);
+  sc_bool const is_not_loop = SC_ADDR_IS_NOT_EQUAL(begin_addr, end_addr);
 
-    sc_monitor * beg_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, begin_addr);
-    sc_monitor * end_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, end_addr);
+  sc_monitor * beg_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, begin_addr);
+  sc_monitor * end_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, end_addr);
 
-    sc_monitor_acquire_write_n(2, beg_monitor, end_monitor);
+  sc_monitor_acquire_write_n(2, beg_monitor, end_monitor);
+
+  sc_addr adjacent_connectors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT];
+  sc_monitor * adjacent_monitors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT];
+  _sc_storage_get_erased_connector_adjacent_connectors(element, adjacent_connectors);
+  while (!_sc_storage_acquire_adjacent_connectors_monitors(
+      beg_monitor, end_monitor, adjacent_connectors, adjacent_monitors))
+  {
+    sc_addr actual_adjacent_connectors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT];
+    _sc_storage_get_erased_connector_adjacent_connectors(element, actual_adjacent_connectors);
+    if (_sc_storage_are_adjacent_connectors_equal(adjacent_connectors, actual_adjacent_connectors))
+      break;
+
+    _sc_storage_release_adjacent_connectors_monitors(adjacent_monitors);
+    _sc_storage_get_erased_connector_adjacent_connectors(element, adjacent_connectors);
+  }
+
+  // outgoing sc-arcs
+  sc_addr prev_out_connector_addr = adjacent_connectors[0];
+  sc_addr next_out_connector_addr = adjacent_connectors[1];
 
-    // outgoing sc-arcs
-    sc_addr prev_out_connector_addr = element->arc.prev_begin_out_arc;
-    sc_monitor * prev_out_arc_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, prev_out_connector_addr)
-        && SC_ADDR_IS_NOT_EQUAL(end_addr, prev_out_connector_addr))
-      prev_out_arc_monitor =
-          sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, prev_out_connector_addr);
-
-    sc_addr next_out_connector_addr = element->arc.next_begin_out_arc;
-    sc_monitor * next_out_arc_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, next_out_connector_addr)
-        && SC_ADDR_IS_NOT_EQUAL(end_addr, next_out_connector_addr))
-      next_out_arc_monitor =
-          sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, next_out_connector_addr);
-
-    // incoming sc-arcs
-    sc_addr prev_in_connector_addr = element->arc.prev_end_in_arc;
-    sc_monitor * prev_in_arc_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, prev_in_connector_addr)
-        && SC_ADDR_IS_NOT_EQUAL(end_addr, prev_in_connector_addr))
-      prev_in_arc_monitor =
-          sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, prev_in_connector_addr);
-
-    sc_addr next_in_arc = element->arc.next_end_in_arc;
-    sc_monitor * next_in_arc_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, next_in_arc) && SC_ADDR_IS_NOT_EQUAL(end_addr, next_in_arc))
-      next_in_arc_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, next_in_arc);
+  // incoming sc-arcs
+  sc_addr prev_in_connector_addr = adjacent_connectors[2];
+  sc_addr next_in_arc = adjacent_connectors[3];
 
 #ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-    sc_addr prev_in_arc_from_structure = element->arc.prev_in_arc_from_structure;
-    sc_monitor * prev_in_arc_from_structure_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, prev_in_arc_from_structure)
-        && SC_ADDR_IS_NOT_EQUAL(end_addr, prev_in_arc_from_structure))
-      prev_in_arc_from_structure_monitor =
-          sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, prev_in_arc_from_structure);
-
-    sc_addr next_in_arc_from_structure_addr = element->arc.next_in_arc_from_structure;
-    sc_monitor * next_in_arc_from_structure_monitor = null_ptr;
-    if (SC_ADDR_IS_NOT_EQUAL(begin_addr, next_in_arc_from_structure_addr)
-        && SC_ADDR_IS_NOT_EQUAL(end_addr, next_in_arc_from_structure_addr))
-      next_in_arc_from_structure_monitor =
-          sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, next_in_arc_from_structure_addr);
+  sc_addr prev_in_arc_from_structure = adjacent_connectors[4];
+  sc_addr next_in_arc_from_structure_addr = adjacent_connectors[5];
 #endif
 
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-    sc_monitor_acquire_write_n(
-        6,
-        prev_out_arc_monitor,
-        next_out_arc_monitor,
-        prev_in_arc_monitor,
-        next_in_arc_monitor,
-        prev_in_arc_from_structure_monitor,
-        next_in_arc_from_structure_monitor);
-#else
-    sc_monitor_acquire_write_n(3, prev_out_arc_monitor, next_out_arc_monitor, prev_in_arc_monitor, next_in_arc_monitor);
+  if (SC_ADDR_IS_NOT_EMPTY(prev_out_connector_addr))
+  {
+    sc_element * prev_el_arc;
+    result = sc_storage_get_element_by_addr(prev_out_connector_addr, &prev_el_arc);
+    if (result == SC_RESULT_OK)
+      sc_element_get_arc(prev_el_arc)->next_begin_out_arc = next_out_connector_addr;
+  }
+
+  if (SC_ADDR_IS_NOT_EMPTY(next_out_connector_addr))
+  {
+    sc_element * next_el_arc;
+    result = sc_storage_get_element_by_addr(next_out_connector_addr, &next_el_arc);
+    if (result == SC_RESULT_OK)
+      sc_element_get_arc(next_el_arc)->prev_begin_out_arc = prev_out_connector_addr;
+  }
+
+  sc_element * b_el;
+  result = sc_storage_get_element_by_addr(begin_addr, &b_el);
+  if (result == SC_RESULT_OK)
+  {
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    if (!is_edge)
+      sc_arcs_index_remove_arc(begin_addr, b_el, addr, element, SC_TRUE);
 #endif
 
-    if (SC_ADDR_IS_NOT_EMPTY(prev_out_connector_addr))
-    {
-      sc_element * prev_el_arc;
-      result = sc_storage_get_element_by_addr(prev_out_connector_addr, &prev_el_arc);
-      if (result == SC_RESULT_OK)
-        prev_el_arc->arc.next_begin_out_arc = next_out_connector_addr;
-    }
+    if (SC_ADDR_IS_EQUAL(addr, b_el->first_out_arc))
+      b_el->first_out_arc = next_out_connector_addr;
+
+    --b_el->outgoing_arcs_count;
 
-    if (SC_ADDR_IS_NOT_EMPTY(next_out_connector_addr))
+    if (is_edge && is_not_loop)
     {
-      sc_element * next_el_arc;
-      result = sc_storage_get_element_by_addr(next_out_connector_addr, &next_el_arc);
-      if (result == SC_RESULT_OK)
-        next_el_arc->arc.prev_begin_out_arc = prev_out_connector_addr;
+      if (SC_ADDR_IS_EQUAL(addr, b_el->first_in_arc))
+        b_el->first_in_arc = next_in_arc;
+
+      --b_el->incoming_arcs_count;
     }
+  }
 
-    sc_element * b_el;
-    result = sc_storage_get_element_by_addr(begin_addr, &b_el);
+  if (SC_ADDR_IS_NOT_EMPTY(prev_in_connector_addr))
+  {
+    sc_element * prev_el_arc;
+    result = sc_storage_get_element_by_addr(prev_in_connector_addr, &prev_el_arc);
     if (result == SC_RESULT_OK)
-    {
-      if (SC_ADDR_IS_EQUAL(addr, b_el->first_out_arc))
-        b_el->first_out_arc = next_out_connector_addr;
+      sc_element_get_arc(prev_el_arc)->next_end_in_arc = next_in_arc;
+  }
 
-      --b_el->outgoing_arcs_count;
+  if (SC_ADDR_IS_NOT_EMPTY(next_in_arc))
+  {
+    sc_element * next_el_arc;
+    result = sc_storage_get_element_by_addr(next_in_arc, &next_el_arc);
+    if (result == SC_RESULT_OK)
+      sc_element_get_arc(next_el_arc)->prev_end_in_arc = prev_in_connector_addr;
+  }
 
-      if (is_edge && is_not_loop)
-      {
-        if (SC_ADDR_IS_EQUAL(addr, b_el->first_in_arc))
-          b_el->first_in_arc = next_in_arc;
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+  if (SC_ADDR_IS_NOT_EMPTY(prev_in_arc_from_structure))
+  {
+    sc_element * prev_el_arc;
+    result = sc_storage_get_element_by_addr(prev_in_arc_from_structure, &prev_el_arc);
+    if (result == SC_RESULT_OK)
+      sc_element_get_arc(prev_el_arc)->next_in_arc_from_structure = next_in_arc_from_structure_addr;
+  }
 
-        --b_el->incoming_arcs_count;
-      }
-    }
+  if (SC_ADDR_IS_NOT_EMPTY(next_in_arc_from_structure_addr))
+  {
+    sc_element * next_el_arc;
+    result = sc_storage_get_element_by_addr(next_in_arc_from_structure_addr, &next_el_arc);
+    if (result == SC_RESULT_OK)
+      sc_element_get_arc(next_el_arc)->prev_in_arc_from_structure = prev_in_arc_from_structure;
+  }
+#endif
 
-    if (SC_ADDR_IS_NOT_EMPTY(prev_in_connector_addr))
-    {
-      sc_element * prev_el_arc;
-      result = sc_storage_get_element_by_addr(prev_in_connector_addr, &prev_el_arc);
-      if (result == SC_RESULT_OK)
-        prev_el_arc->arc.next_end_in_arc = next_in_arc;
-    }
+  sc_element * e_el;
+  result = sc_storage_get_element_by_addr(end_addr, &e_el);
+  if (result == SC_RESULT_OK)
+  {
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    if (!is_edge)
+      sc_arcs_index_remove_arc(end_addr, e_el, addr, element, SC_FALSE);
+#endif
 
-    if (SC_ADDR_IS_NOT_EMPTY(next_in_arc))
-    {
-      sc_element * next_el_arc;
-      result = sc_storage_get_element_by_addr(next_in_arc, &next_el_arc);
-      if (result == SC_RESULT_OK)
-        next_el_arc->arc.prev_end_in_arc = prev_in_connector_addr;
-    }
+    if (SC_ADDR_IS_EQUAL(addr, e_el->first_in_arc))
+      e_el->first_in_arc = next_in_arc;
 
 #ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-    if (SC_ADDR_IS_NOT_EMPTY(prev_in_arc_from_structure))
-    {
-      sc_element * prev_el_arc;
-      result = sc_storage_get_element_by_addr(prev_in_arc_from_structure, &prev_el_arc);
-      if (result == SC_RESULT_OK)
-        prev_el_arc->arc.next_in_arc_from_structure = next_in_arc_from_structure_addr;
-    }
+    if (SC_ADDR_IS_EQUAL(addr, e_el->first_in_arc_from_structure))
+      e_el->first_in_arc_from_structure = next_in_arc_from_structure_addr;
+#endif
+
+    --e_el->incoming_arcs_count;
 
-    if (SC_ADDR_IS_NOT_EMPTY(next_in_arc_from_structure_addr))
+    if (is_edge && is_not_loop)
     {
-      sc_element * next_el_arc;
-      result = sc_storage_get_element_by_addr(next_in_arc_from_structure_addr, &next_el_arc);
-      if (result == SC_RESULT_OK)
-        next_el_arc->arc.prev_in_arc_from_structure = prev_in_arc_from_structure;
+      if (SC_ADDR_IS_EQUAL(addr, e_el->first_out_arc))
+        e_el->first_out_arc = next_out_connector_addr;
+
+      --e_el->outgoing_arcs_count;
     }
-#endif
+  }
 
-    sc_element * e_el;
-    result = sc_storage_get_element_by_addr(end_addr, &e_el);
-    if (result == SC_RESULT_OK)
-    {
-      if (SC_ADDR_IS_EQUAL(addr, e_el->first_in_arc))
-        e_el->first_in_arc = next_in_arc;
+  _sc_storage_mark_element_dirty(begin_addr);
+  _sc_storage_mark_element_dirty(end_addr);
+  _sc_storage_mark_connectors_dirty(adjacent_connectors);
+
+  sc_addr const changed_addrs[] = {
+      begin_addr,
+      end_addr,
+      adjacent_connectors[0],
+      adjacent_connectors[1],
+      adjacent_connectors[2],
+      adjacent_connectors[3],
+      adjacent_connectors[4],
+      adjacent_connectors[5]};
+  _sc_storage_log_elements(
+      SC_STORAGE_WAL_RECORD_CONNECTOR_UNLINK, changed_addrs, sizeof(changed_addrs) / sizeof(sc_addr));
+
+  _sc_storage_release_adjacent_connectors_monitors(adjacent_monitors);
+  sc_monitor_release_write_n(2, beg_monitor, end_monitor);
+}
 
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-      if (SC_ADDR_IS_EQUAL(addr, e_el->first_in_arc_from_structure))
-        e_el->first_in_arc_from_structure = next_in_arc_from_structure_addr;
+void _sc_storage_release_elements(sc_segment * segment, sc_addr const * addrs, sc_uint32 count)
+{
+  // released offsets are chained by themselves, so the chain is spliced into list of segment under one lock
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, addrs[i]);
+    sc_monitor_acquire_write(monitor);
+    sc_addr_offset const next_released_offset = i + 1 < count ? addrs[i + 1].offset : 0;
+    sc_element * element = sc_segment_get_element(segment, addrs[i].offset);
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+    sc_arcs_index_erase(addrs[i], element);
 #endif
+    if (sc_type_has_subtype_in_mask(element->flags.type, sc_type_connector_mask))
+      _sc_storage_unindex_connector(addrs[i], element);
+    _sc_storage_clear_element(segment, element, next_released_offset);
+    sc_monitor_release_write(monitor);
+  }
 
-      --e_el->incoming_arcs_count;
+  // erasure is logged before sc-elements are released, so records of their reuse follow it
+  sc_storage_wal_append(SC_STORAGE_WAL_RECORD_ELEMENTS_ERASE, addrs, count * sizeof(sc_addr));
 
-      if (is_edge && is_not_loop)
-      {
-        if (SC_ADDR_IS_EQUAL(addr, e_el->first_out_arc))
-          e_el->first_out_arc = next_out_connector_addr;
+  sc_monitor_acquire_write(&segment->monitor);
+  sc_addr_offset const last_released_offset = segment->last_released_offset;
+  sc_segment_get_element(segment, addrs[count - 1].offset)->flags.type = last_released_offset;
+  segment->last_released_offset = addrs[0].offset;
+  sc_monitor_release_write(&segment->monitor);
 
-        --e_el->outgoing_arcs_count;
-      }
+  if (last_released_offset == 0)
+    _sc_storage_register_released_segment(segment);
+}
+
+int _sc_storage_compare_addrs(void const * a, void const * b)
+{
+  sc_addr_hash const first = SC_ADDR_LOCAL_TO_INT(*(sc_addr const *)a);
+  sc_addr_hash const second = SC_ADDR_LOCAL_TO_INT(*(sc_addr const *)b);
+  return (first > second) - (first < second);
+}
+
+sc_bool _sc_storage_is_addr_erased(sc_addr addr, sc_addr const * addrs, sc_uint32 count)
+{
+  return bsearch(&addr, addrs, count, sizeof(sc_addr), _sc_storage_compare_addrs) != null_ptr;
+}
+
+void _sc_storage_elements_erase(sc_addr * addrs, sc_uint32 count, sc_bool is_closed)
+{
+  qsort(addrs, count, sizeof(sc_addr), _sc_storage_compare_addrs);
+
+  sc_uint32 erased_count = 0;
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_element * element;
+    if ((erased_count != 0 && SC_ADDR_IS_EQUAL(addrs[erased_count - 1], addrs[i]))
+        || !_sc_storage_request_element_erasure(addrs[i], &element))
+      continue;
+
+    addrs[erased_count++] = addrs[i];
+  }
+
+  for (sc_uint32 i = 0; i < erased_count; ++i)
+  {
+    sc_addr const addr = addrs[i];
+    sc_element * element = sc_segment_get_element(_sc_storage_get_segment_by_num(addr.seg), addr.offset);
+    sc_type const type = element->flags.type;
+
+    if (sc_type_has_subtype(type, sc_type_node_link))
+    {
+      sc_fs_memory_unlink_string(SC_ADDR_LOCAL_TO_INT(addr));
+      sc_storage_wal_append(SC_STORAGE_WAL_RECORD_LINK_CONTENT_ERASE, &addr, sizeof(addr));
     }
+    else if (sc_type_has_subtype_in_mask(type, sc_type_connector_mask))
+    {
+      // lists of erased sc-elements are erased with them, so only sc-connectors of remaining sc-elements are unlinked
+      if (is_closed && _sc_storage_is_addr_erased(sc_element_get_arc(element)->begin, addrs, erased_count)
+          && _sc_storage_is_addr_erased(sc_element_get_arc(element)->end, addrs, erased_count))
+        continue;
 
-#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-    sc_monitor_release_write_n(
-        6,
-        prev_out_arc_monitor,
-        next_out_arc_monitor,
-        prev_in_arc_monitor,
-        next_in_arc_monitor,
-        prev_in_arc_from_structure_monitor,
-        next_in_arc_from_structure_monitor);
-#else
-    sc_monitor_release_write_n(4, prev_out_arc_monitor, next_out_arc_monitor, prev_in_arc_monitor, next_in_arc_monitor);
-#endif
-    sc_monitor_release_write_n(2, beg_monitor, end_monitor);
+      _sc_storage_unlink_erased_connector(addr, element);
+    }
   }
 
-  sc_monitor_acquire_write(monitor);
-  sc_storage_free_element(addr);
-  sc_monitor_release_write(monitor);
+  sc_uint32 run_begin = 0;
+  for (sc_uint32 i = 1; i <= erased_count; ++i)
+  {
+    if (i < erased_count && addrs[i].seg == addrs[run_begin].seg)
+      continue;
 
-  // erase registered events before deletion
-  sc_event_notify_element_deleted(addr);
+    sc_segment * segment = _sc_storage_get_segment_by_num(addrs[run_begin].seg);
+    _sc_storage_release_elements(segment, addrs + run_begin, i - run_begin);
+    run_begin = i;
+  }
 
-  return result;
+  // erase registered events before deletion
+  sc_event_notify_elements_deleted(addrs, erased_count);
 }
 
 sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
 {
-  sc_result result;
+  return sc_storage_elements_erase(ctx, 1, &addr);
+}
 
-  sc_element * el = null_ptr;
-  result = sc_storage_get_element_by_addr(addr, &el);
-  if (result != SC_RESULT_OK)
-    goto error;
+sc_result sc_storage_elements_erase(sc_memory_context const * ctx, sc_uint32 count, sc_addr const * addrs)
+{
+  sc_result result = SC_RESULT_OK;
 
+  sc_element * el = null_ptr;
+  sc_pointer p_addr;
   sc_hash_table * cache_table = sc_hash_table_init(g_direct_hash, g_direct_equal, null_ptr, null_ptr);
 
+  // closure of all sc-elements is computed once, so shared sc-connectors are visited once
   sc_queue iter_queue;
   sc_queue_init(&iter_queue);
-  sc_pointer p_addr = GUINT_TO_POINTER(SC_ADDR_LOCAL_TO_INT(addr));
-  sc_queue_push(&iter_queue, p_addr);
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    if (sc_storage_get_element_by_addr(addrs[i], &el) != SC_RESULT_OK)
+    {
+      result = SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
+      continue;
+    }
+
+    p_addr = GUINT_TO_POINTER(SC_ADDR_LOCAL_TO_INT(addrs[i]));
+    if (sc_hash_table_get(cache_table, p_addr) != null_ptr)
+      continue;
+
+    sc_hash_table_insert(cache_table, p_addr, el);
+    sc_queue_push(&iter_queue, p_addr);
+  }
 
+  sc_bool is_closed = SC_TRUE;
   sc_queue addrs_with_not_emitted_erase_events;
   sc_queue_init(&addrs_with_not_emitted_erase_events);
   while (!sc_queue_empty(&iter_queue))
@@ -697,16 +1600,15 @@ sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
 
     sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, element_addr);
     sc_monitor_acquire_read(monitor);
-    result = sc_storage_get_element_by_addr(element_addr, &el);
-    if (result != SC_RESULT_OK)
+    if (sc_storage_get_element_by_addr(element_addr, &el) != SC_RESULT_OK)
     {
       sc_monitor_release_read(monitor);
       continue;
     }
 
     sc_type const type = el->flags.type;
-    sc_addr const begin_addr = el->arc.begin;
-    sc_addr const end_addr = el->arc.end;
+    sc_addr const begin_addr = sc_element_get_arc(el)->begin;
+    sc_addr const end_addr = sc_element_get_arc(el)->end;
 
     sc_result erase_incoming_connector_result = SC_RESULT_NO;
     sc_result erase_outgoing_connector_result = SC_RESULT_NO;
@@ -798,6 +1700,7 @@ sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
         || erase_incoming_arc_result == SC_RESULT_OK || erase_outgoing_arc_result == SC_RESULT_OK
         || erase_element_result == SC_RESULT_OK)
     {
+      is_closed = SC_FALSE;
       sc_monitor_release_read(monitor);
       continue;
     }
@@ -812,15 +1715,14 @@ sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
       sc_element * connector = sc_hash_table_get(cache_table, p_addr);
       if (connector == null_ptr)
       {
-        result = sc_storage_get_element_by_addr(connector_addr, &connector);
-        if (result != SC_RESULT_OK)
+        if (sc_storage_get_element_by_addr(connector_addr, &connector) != SC_RESULT_OK)
           break;
 
         sc_hash_table_insert(cache_table, p_addr, connector);
         sc_queue_push(&iter_queue, p_addr);
       }
 
-      connector_addr = connector->arc.next_begin_out_arc;
+      connector_addr = sc_element_get_arc(connector)->next_begin_out_arc;
     }
 
     connector_addr = el->first_in_arc;
@@ -831,15 +1733,14 @@ sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
       sc_element * connector = sc_hash_table_get(cache_table, p_addr);
       if (connector == null_ptr)
       {
-        result = sc_storage_get_element_by_addr(connector_addr, &connector);
-        if (result != SC_RESULT_OK)
+        if (sc_storage_get_element_by_addr(connector_addr, &connector) != SC_RESULT_OK)
           break;
 
         sc_hash_table_insert(cache_table, p_addr, connector);
         sc_queue_push(&iter_queue, p_addr);
       }
 
-      connector_addr = connector->arc.next_end_in_arc;
+      connector_addr = sc_element_get_arc(connector)->next_end_in_arc;
     }
 
     sc_monitor_release_read(monitor);
@@ -848,19 +1749,24 @@ sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr)
   sc_queue_destroy(&iter_queue);
   sc_hash_table_destroy(cache_table);
 
-  while (!sc_queue_empty(&addrs_with_not_emitted_erase_events))
+  sc_uint32 const erased_count = addrs_with_not_emitted_erase_events.size;
+  if (erased_count != 0)
   {
-    sc_addr_hash addr_int = (sc_pointer_to_sc_addr_hash)sc_queue_pop(&addrs_with_not_emitted_erase_events);
-    addr.seg = SC_ADDR_LOCAL_SEG_FROM_INT(addr_int);
-    addr.offset = SC_ADDR_LOCAL_OFFSET_FROM_INT(addr_int);
+    sc_addr * erased_addrs = sc_mem_new(sc_addr, erased_count);
+    for (sc_uint32 i = 0; i < erased_count; ++i)
+    {
+      sc_addr_hash addr_int = (sc_pointer_to_sc_addr_hash)sc_queue_pop(&addrs_with_not_emitted_erase_events);
+      SC_ADDR_LOCAL_FROM_INT(addr_int, erased_addrs[i]);
+    }
 
-    _sc_storage_element_erase(addr);
+    _sc_storage_elements_erase(erased_addrs, erased_count, is_closed);
+    sc_mem_free(erased_addrs);
   }
 
   sc_queue_destroy(&addrs_with_not_emitted_erase_events);
 
-  result = SC_RESULT_OK;
-error:
+  if (sc_storage_wal_commit() != SC_RESULT_OK && result == SC_RESULT_OK)
+    result = SC_RESULT_ERROR_FILE_MEMORY_IO;
   return result;
 }
 
@@ -880,7 +1786,7 @@ sc_addr sc_storage_node_new_ext(sc_memory_context const * ctx, sc_type type, sc_
     return addr;
   }
 
-  sc_element * element = sc_storage_allocate_new_element(ctx, &addr);
+  sc_element * element = sc_storage_allocate_new_element(ctx, type, &addr);
   if (element == null_ptr)
   {
     *result = SC_RESULT_ERROR_FULL_MEMORY;
@@ -888,10 +1794,42 @@ sc_addr sc_storage_node_new_ext(sc_memory_context const * ctx, sc_type type, sc_
   }
 
   element->flags.type = sc_type_node | type;
-  *result = SC_RESULT_OK;
+  _sc_storage_mark_element_dirty(addr);
+  _sc_storage_log_elements(SC_STORAGE_WAL_RECORD_ELEMENTS_NEW, &addr, 1);
+  *result = sc_storage_wal_commit();
   return addr;
 }
 
+sc_result sc_storage_nodes_new_batch(sc_memory_context const * ctx, sc_type type, sc_uint32 count, sc_addr * addrs)
+{
+  for (sc_uint32 i = 0; i < count; ++i)
+    addrs[i] = SC_ADDR_EMPTY;
+
+  if (sc_type_is_not_node(type) && (!sc_type_is(type, sc_type_const) && !sc_type_is(type, sc_type_var)))
+    return SC_RESULT_ERROR_ELEMENT_IS_NOT_NODE;
+
+  sc_uint32 const allocated_count = _sc_storage_allocate_new_elements(type, count, addrs);
+  for (sc_uint32 i = 0; i < allocated_count; ++i)
+  {
+    if (allocated_count != count)
+    {
+      sc_storage_free_element(addrs[i]);
+      addrs[i] = SC_ADDR_EMPTY;
+      continue;
+    }
+
+    sc_element * element = sc_segment_get_element(_sc_storage_get_segment_by_num(addrs[i].seg), addrs[i].offset);
+    element->flags.type = sc_type_node | type;
+    _sc_storage_mark_element_dirty(addrs[i]);
+  }
+
+  if (allocated_count != count)
+    return SC_RESULT_ERROR_FULL_MEMORY;
+
+  _sc_storage_log_elements(SC_STORAGE_WAL_RECORD_ELEMENTS_NEW, addrs, count);
+  return sc_storage_wal_commit();
+}
+
 sc_addr sc_storage_link_new(sc_memory_context const * ctx, sc_type type)
 {
   sc_result result;
@@ -908,7 +1846,7 @@ sc_addr sc_storage_link_new_ext(sc_memory_context const * ctx, sc_type type, sc_
     return addr;
   }
 
-  sc_element * element = sc_storage_allocate_new_element(ctx, &addr);
+  sc_element * element = sc_storage_allocate_new_element(ctx, type, &addr);
   if (element == null_ptr)
   {
     *result = SC_RESULT_ERROR_FULL_MEMORY;
@@ -916,16 +1854,16 @@ sc_addr sc_storage_link_new_ext(sc_memory_context const * ctx, sc_type type, sc_
   }
 
   element->flags.type = sc_type_node_link | type;
-  *result = SC_RESULT_OK;
+  _sc_storage_mark_element_dirty(addr);
+  _sc_storage_log_elements(SC_STORAGE_WAL_RECORD_ELEMENTS_NEW, &addr, 1);
+  *result = sc_storage_wal_commit();
   return addr;
 }
 
 void _sc_storage_make_elements_incident_to_arc(
     sc_addr connector_addr,
     sc_element * arc_el,
-    sc_addr beg_addr,
     sc_element * beg_el,
-    sc_addr end_addr,
     sc_element * end_el,
     sc_bool is_reverse,
     sc_bool is_loop)
@@ -935,20 +1873,6 @@ void _sc_storage_make_elements_incident_to_arc(
   sc_addr first_out_connector_addr = beg_el->first_out_arc;
   sc_addr first_in_connector_addr = end_el->first_in_arc;
 
-  sc_monitor * first_out_arc_monitor = null_ptr;
-  sc_monitor * first_in_arc_monitor = null_ptr;
-
-  if (SC_ADDR_IS_NOT_EQUAL(first_out_connector_addr, beg_addr)
-      && SC_ADDR_IS_NOT_EQUAL(first_out_connector_addr, end_addr))
-    first_out_arc_monitor =
-        sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, first_out_connector_addr);
-  if (SC_ADDR_IS_NOT_EQUAL(first_in_connector_addr, beg_addr)
-      && SC_ADDR_IS_NOT_EQUAL(first_in_connector_addr, end_addr))
-    first_in_arc_monitor =
-        sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, first_in_connector_addr);
-
-  sc_monitor_acquire_write_n(2, first_out_arc_monitor, first_in_arc_monitor);
-
   if (SC_ADDR_IS_NOT_EMPTY(first_out_connector_addr))
     sc_storage_get_element_by_addr(first_out_connector_addr, &first_out_arc);
 
@@ -958,29 +1882,27 @@ void _sc_storage_make_elements_incident_to_arc(
   // set next outgoing sc-arc for our generated arc
   if (is_reverse)
   {
-    arc_el->arc.next_end_out_arc = first_out_connector_addr;
-    arc_el->arc.next_begin_in_arc = first_in_connector_addr;
+    sc_element_get_arc(arc_el)->next_end_out_arc = first_out_connector_addr;
+    sc_element_get_arc(arc_el)->next_begin_in_arc = first_in_connector_addr;
   }
   else
   {
-    arc_el->arc.next_begin_out_arc = first_out_connector_addr;
-    arc_el->arc.next_end_in_arc = first_in_connector_addr;
+    sc_element_get_arc(arc_el)->next_begin_out_arc = first_out_connector_addr;
+    sc_element_get_arc(arc_el)->next_end_in_arc = first_in_connector_addr;
 
     if (is_loop)
     {
-      arc_el->arc.next_end_out_arc = first_out_connector_addr;
-      arc_el->arc.next_begin_in_arc = first_in_connector_addr;
+      sc_element_get_arc(arc_el)->next_end_out_arc = first_out_connector_addr;
+      sc_element_get_arc(arc_el)->next_begin_in_arc = first_in_connector_addr;
     }
 
     if (first_out_arc)
-      first_out_arc->arc.prev_begin_out_arc = connector_addr;
+      sc_element_get_arc(first_out_arc)->prev_begin_out_arc = connector_addr;
 
     if (first_in_arc)
-      first_in_arc->arc.prev_end_in_arc = connector_addr;
+      sc_element_get_arc(first_in_arc)->prev_end_in_arc = connector_addr;
   }
 
-  sc_monitor_release_write_n(2, first_out_arc_monitor, first_in_arc_monitor);
-
   // set our arc as first output/input at begin/end elements
   beg_el->first_out_arc = connector_addr;
   end_el->first_in_arc = connector_addr;
@@ -990,108 +1912,146 @@ void _sc_storage_make_elements_incident_to_arc(
 }
 
 #ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
-void _sc_storage_update_structure_arcs(
-    sc_addr connector_addr,
-    sc_element * arc_el,
-    sc_addr beg_addr,
-    sc_addr end_addr,
-    sc_element * end_el)
+void _sc_storage_update_structure_arcs(sc_addr connector_addr, sc_element * arc_el, sc_element * end_el)
 {
   sc_element * first_in_accessed_arc = null_ptr;
   sc_addr first_in_accessed_connector_addr = end_el->first_in_arc_from_structure;
-  sc_monitor * first_in_accessed_arc_monitor = null_ptr;
-
-  if (SC_ADDR_IS_NOT_EQUAL(first_in_accessed_connector_addr, beg_addr)
-      && SC_ADDR_IS_NOT_EQUAL(first_in_accessed_connector_addr, end_addr))
-    first_in_accessed_arc_monitor =
-        sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, first_in_accessed_connector_addr);
-
-  sc_monitor_acquire_write(first_in_accessed_arc_monitor);
 
   if (SC_ADDR_IS_NOT_EMPTY(first_in_accessed_connector_addr))
     sc_storage_get_element_by_addr(first_in_accessed_connector_addr, &first_in_accessed_arc);
 
-  arc_el->arc.next_in_arc_from_structure = first_in_accessed_connector_addr;
+  sc_element_get_arc(arc_el)->next_in_arc_from_structure = first_in_accessed_connector_addr;
 
   if (first_in_accessed_arc)
-    first_in_accessed_arc->arc.prev_in_arc_from_structure = connector_addr;
-
-  sc_monitor_release_write(first_in_accessed_arc_monitor);
+    sc_element_get_arc(first_in_accessed_arc)->prev_in_arc_from_structure = connector_addr;
 
   end_el->first_in_arc_from_structure = connector_addr;
 }
 #endif
 
+void _sc_storage_get_generated_connector_adjacent_connectors(
+    sc_type type,
+    sc_element * beg_el,
+    sc_element * end_el,
+    sc_addr * adjacent_connectors)
+{
+  // only sc-connectors that become next to the generated one in lists of its begin and end sc-elements are changed
+  adjacent_connectors[0] = beg_el->first_out_arc;
+  adjacent_connectors[1] = end_el->first_in_arc;
+  adjacent_connectors[2] = SC_ADDR_EMPTY;
+  adjacent_connectors[3] = SC_ADDR_EMPTY;
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+  adjacent_connectors[4] =
+      sc_type_is_structure_and_arc(beg_el->flags.type, type) ? end_el->first_in_arc_from_structure : SC_ADDR_EMPTY;
+#else
+  (void)type;
+  adjacent_connectors[4] = SC_ADDR_EMPTY;
+#endif
+  adjacent_connectors[5] = SC_ADDR_EMPTY;
+}
+
 sc_addr sc_storage_arc_new(sc_memory_context const * ctx, sc_type type, sc_addr beg_addr, sc_addr end_addr)
 {
   sc_result result;
   return sc_storage_arc_new_ext(ctx, type, beg_addr, end_addr, &result);
 }
 
-sc_addr sc_storage_arc_new_ext(
-    sc_memory_context const * ctx,
-    sc_type type,
-    sc_addr beg_addr,
-    sc_addr end_addr,
-    sc_result * result)
+/*! Links generated sc-connector into lists of sc-connectors of its begin and end sc-elements.
+ * @param connector_addr Sc-addr of the generated sc-connector.
+ * @param arc_el Generated sc-connector with filled type, begin and end.
+ * @param beg_monitor Held monitor of begin sc-element.
+ * @param end_monitor Held monitor of end sc-element.
+ * @returns SC_RESULT_ERROR_ADDR_IS_NOT_VALID, if begin or end sc-element doesn't exist, otherwise SC_RESULT_OK.
+ */
+sc_result _sc_storage_link_generated_connector(
+    sc_addr connector_addr,
+    sc_element * arc_el,
+    sc_monitor * beg_monitor,
+    sc_monitor * end_monitor)
 {
-  sc_addr connector_addr = SC_ADDR_EMPTY;
-
-  if (sc_type_is_not_connector(type))
-  {
-    *result = SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR;
-    return connector_addr;
-  }
-
-  if (SC_ADDR_IS_EMPTY(beg_addr) || SC_ADDR_IS_EMPTY(end_addr))
-  {
-    *result = SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
-    return connector_addr;
-  }
-
+  sc_result result;
+  sc_type const type = arc_el->flags.type;
+  sc_addr const beg_addr = sc_element_get_arc(arc_el)->begin;
+  sc_addr const end_addr = sc_element_get_arc(arc_el)->end;
   sc_element *beg_el = null_ptr, *end_el = null_ptr;
 
-  sc_element * arc_el = sc_storage_allocate_new_element(ctx, &connector_addr);
-  if (arc_el == null_ptr)
-  {
-    *result = SC_RESULT_ERROR_FULL_MEMORY;
-    return connector_addr;
-  }
-
-  arc_el->flags.type = type;
-  arc_el->arc.begin = beg_addr;
-  arc_el->arc.end = end_addr;
-
   sc_bool is_edge = sc_type_has_subtype(type, sc_type_common_edge);
   sc_bool is_not_loop = SC_ADDR_IS_NOT_EQUAL(beg_addr, end_addr);
 
-  // try to lock begin and end elements
-  sc_monitor * beg_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, beg_addr);
-  sc_monitor * end_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, end_addr);
-  sc_monitor_acquire_write_n(2, beg_monitor, end_monitor);
-
-  *result = sc_storage_get_element_by_addr(beg_addr, &beg_el);
-  if (*result != SC_RESULT_OK)
-    goto error;
-
-  *result = sc_storage_get_element_by_addr(end_addr, &end_el);
-  if (*result != SC_RESULT_OK)
-    goto error;
+  sc_addr adjacent_connectors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT];
+  sc_monitor * adjacent_monitors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT] = {null_ptr};
+  sc_bool are_adjacent_monitors_acquired = SC_FALSE;
+  do
+  {
+    result = sc_storage_get_element_by_addr(beg_addr, &beg_el);
+    if (result != SC_RESULT_OK)
+      goto error;
 
-  // lock arcs to change output/input list
-  _sc_storage_make_elements_incident_to_arc(
-      connector_addr, arc_el, beg_addr, beg_el, end_addr, end_el, SC_FALSE, !is_not_loop);
+    result = sc_storage_get_element_by_addr(end_addr, &end_el);
+    if (result != SC_RESULT_OK)
+      goto error;
+
+    sc_addr actual_adjacent_connectors[SC_STORAGE_ADJACENT_CONNECTORS_COUNT];
+    _sc_storage_get_generated_connector_adjacent_connectors(type, beg_el, end_el, actual_adjacent_connectors);
+    if (are_adjacent_monitors_acquired
+        && _sc_storage_are_adjacent_connectors_equal(adjacent_connectors, actual_adjacent_connectors))
+      break;
+
+    _sc_storage_release_adjacent_connectors_monitors(adjacent_monitors);
+    _sc_storage_get_generated_connector_adjacent_connectors(type, beg_el, end_el, adjacent_connectors);
+    are_adjacent_monitors_acquired = SC_TRUE;
+  } while (!_sc_storage_acquire_adjacent_connectors_monitors(
+      beg_monitor, end_monitor, adjacent_connectors, adjacent_monitors));
+
+  // change output/input lists
+  _sc_storage_make_elements_incident_to_arc(connector_addr, arc_el, beg_el, end_el, SC_FALSE, !is_not_loop);
   if (is_edge && is_not_loop)
-    _sc_storage_make_elements_incident_to_arc(
-        connector_addr, arc_el, end_addr, end_el, beg_addr, beg_el, SC_TRUE, SC_FALSE);
+    _sc_storage_make_elements_incident_to_arc(connector_addr, arc_el, end_el, beg_el, SC_TRUE, SC_FALSE);
+  _sc_storage_index_connector(connector_addr, arc_el);
+
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  if (!is_edge)
+  {
+    sc_arcs_index_add_arc(beg_addr, beg_el, connector_addr, arc_el, SC_TRUE);
+    sc_arcs_index_add_arc(end_addr, end_el, connector_addr, arc_el, SC_FALSE);
+  }
+#endif
 
 #ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
   if (sc_type_is_structure_and_arc(beg_el->flags.type, type))
-    _sc_storage_update_structure_arcs(connector_addr, arc_el, beg_addr, end_addr, end_el);
+    _sc_storage_update_structure_arcs(connector_addr, arc_el, end_el);
 #endif
 
-  // emit events
-  if (is_edge && is_not_loop)
+  _sc_storage_mark_element_dirty(connector_addr);
+  _sc_storage_mark_element_dirty(beg_addr);
+  _sc_storage_mark_element_dirty(end_addr);
+  _sc_storage_mark_connectors_dirty(adjacent_connectors);
+
+  sc_addr const changed_addrs[] = {
+      connector_addr,
+      beg_addr,
+      end_addr,
+      adjacent_connectors[0],
+      adjacent_connectors[1],
+      adjacent_connectors[2],
+      adjacent_connectors[3],
+      adjacent_connectors[4],
+      adjacent_connectors[5]};
+  _sc_storage_log_elements(SC_STORAGE_WAL_RECORD_CONNECTOR_NEW, changed_addrs, sizeof(changed_addrs) / sizeof(sc_addr));
+
+error:
+  _sc_storage_release_adjacent_connectors_monitors(adjacent_monitors);
+  return result;
+}
+
+void _sc_storage_emit_generated_connector_events(
+    sc_memory_context const * ctx,
+    sc_addr connector_addr,
+    sc_type type,
+    sc_addr beg_addr,
+    sc_addr end_addr)
+{
+  if (sc_type_has_subtype(type, sc_type_common_edge) && SC_ADDR_IS_NOT_EQUAL(beg_addr, end_addr))
   {
     sc_event_emit(
         ctx, end_addr, sc_event_after_generate_edge_addr, connector_addr, type, beg_addr, null_ptr, SC_ADDR_EMPTY);
@@ -1124,10 +2084,54 @@ sc_addr sc_storage_arc_new_ext(
       ctx, end_addr, sc_event_after_generate_connector_addr, connector_addr, type, beg_addr, null_ptr, SC_ADDR_EMPTY);
   sc_event_emit(
       ctx, beg_addr, sc_event_after_generate_connector_addr, connector_addr, type, end_addr, null_ptr, SC_ADDR_EMPTY);
+}
+
+sc_addr sc_storage_arc_new_ext(
+    sc_memory_context const * ctx,
+    sc_type type,
+    sc_addr beg_addr,
+    sc_addr end_addr,
+    sc_result * result)
+{
+  sc_addr connector_addr = SC_ADDR_EMPTY;
+
+  if (sc_type_is_not_connector(type))
+  {
+    *result = SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR;
+    return connector_addr;
+  }
+
+  if (SC_ADDR_IS_EMPTY(beg_addr) || SC_ADDR_IS_EMPTY(end_addr))
+  {
+    *result = SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
+    return connector_addr;
+  }
+
+  sc_element * arc_el = sc_storage_allocate_new_element(ctx, type, &connector_addr);
+  if (arc_el == null_ptr)
+  {
+    *result = SC_RESULT_ERROR_FULL_MEMORY;
+    return connector_addr;
+  }
+
+  arc_el->flags.type = type;
+  sc_element_get_arc(arc_el)->begin = beg_addr;
+  sc_element_get_arc(arc_el)->end = end_addr;
+
+  // try to lock begin and end elements
+  sc_monitor * beg_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, beg_addr);
+  sc_monitor * end_monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, end_addr);
+  sc_monitor_acquire_write_n(2, beg_monitor, end_monitor);
+
+  *result = _sc_storage_link_generated_connector(connector_addr, arc_el, beg_monitor, end_monitor);
+  if (*result != SC_RESULT_OK)
+    goto error;
+
+  _sc_storage_emit_generated_connector_events(ctx, connector_addr, type, beg_addr, end_addr);
 
   sc_monitor_release_write_n(2, beg_monitor, end_monitor);
 
-  *result = SC_RESULT_OK;
+  *result = sc_storage_wal_commit();
   return connector_addr;
 error:
   sc_storage_free_element(connector_addr);
@@ -1135,6 +2139,124 @@ error:
   return SC_ADDR_EMPTY;
 }
 
+//! Sc-connector generated in batch, it is ordered by monitors of its begin and end sc-elements
+typedef struct
+{
+  sc_monitor * beg_monitor;
+  sc_monitor * end_monitor;
+  sc_uint32 index;  // index of sc-connector in batch
+} sc_storage_batch_connector;
+
+int _sc_storage_compare_batch_connectors(void const * a, void const * b)
+{
+  sc_storage_batch_connector const * first = a;
+  sc_storage_batch_connector const * second = b;
+  if (first->beg_monitor != second->beg_monitor)
+    return first->beg_monitor < second->beg_monitor ? -1 : 1;
+  if (first->end_monitor != second->end_monitor)
+    return first->end_monitor < second->end_monitor ? -1 : 1;
+  if (first->index != second->index)
+    return first->index < second->index ? -1 : 1;
+  return 0;
+}
+
+sc_result sc_storage_arcs_new_batch(
+    sc_memory_context const * ctx,
+    sc_uint32 count,
+    sc_connector_triple const * triples,
+    sc_addr * connectors,
+    sc_bool emit_events)
+{
+  sc_result result = SC_RESULT_OK;
+
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    connectors[i] = SC_ADDR_EMPTY;
+    if (sc_type_is_not_connector(triples[i].type))
+      return SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR;
+    if (SC_ADDR_IS_EMPTY(triples[i].begin) || SC_ADDR_IS_EMPTY(triples[i].end))
+      return SC_RESULT_ERROR_ADDR_IS_NOT_VALID;
+  }
+
+  if (count == 0)
+    return result;
+
+  sc_uint32 const allocated_count = _sc_storage_allocate_new_elements(triples[0].type, count, connectors);
+  if (allocated_count != count)
+  {
+    for (sc_uint32 i = 0; i < allocated_count; ++i)
+    {
+      sc_storage_free_element(connectors[i]);
+      connectors[i] = SC_ADDR_EMPTY;
+    }
+    return SC_RESULT_ERROR_FULL_MEMORY;
+  }
+
+  sc_storage_batch_connector * batch_connectors = sc_mem_new(sc_storage_batch_connector, count);
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_element * arc_el =
+        sc_segment_get_element(_sc_storage_get_segment_by_num(connectors[i].seg), connectors[i].offset);
+    arc_el->flags.type = triples[i].type;
+    sc_element_get_arc(arc_el)->begin = triples[i].begin;
+    sc_element_get_arc(arc_el)->end = triples[i].end;
+
+    batch_connectors[i].beg_monitor =
+        sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, triples[i].begin);
+    batch_connectors[i].end_monitor =
+        sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, triples[i].end);
+    batch_connectors[i].index = i;
+  }
+  qsort(batch_connectors, count, sizeof(sc_storage_batch_connector), _sc_storage_compare_batch_connectors);
+
+  sc_uint32 group_begin = 0;
+  while (group_begin < count)
+  {
+    sc_monitor * beg_monitor = batch_connectors[group_begin].beg_monitor;
+    sc_monitor * end_monitor = batch_connectors[group_begin].end_monitor;
+    sc_uint32 group_end = group_begin + 1;
+    while (group_end < count && batch_connectors[group_end].beg_monitor == beg_monitor
+           && batch_connectors[group_end].end_monitor == end_monitor)
+      ++group_end;
+
+    sc_monitor_acquire_write_n(2, beg_monitor, end_monitor);
+
+    for (sc_uint32 i = group_begin; i < group_end; ++i)
+    {
+      sc_uint32 const index = batch_connectors[i].index;
+      sc_element * arc_el =
+          sc_segment_get_element(_sc_storage_get_segment_by_num(connectors[index].seg), connectors[index].offset);
+      sc_result const link_result =
+          _sc_storage_link_generated_connector(connectors[index], arc_el, beg_monitor, end_monitor);
+      if (link_result != SC_RESULT_OK)
+      {
+        sc_storage_free_element(connectors[index]);
+        connectors[index] = SC_ADDR_EMPTY;
+        result = link_result;
+      }
+    }
+
+    if (emit_events)
+    {
+      for (sc_uint32 i = group_begin; i < group_end; ++i)
+      {
+        sc_uint32 const index = batch_connectors[i].index;
+        if (SC_ADDR_IS_NOT_EMPTY(connectors[index]))
+          _sc_storage_emit_generated_connector_events(
+              ctx, connectors[index], triples[index].type, triples[index].begin, triples[index].end);
+      }
+    }
+
+    sc_monitor_release_write_n(2, beg_monitor, end_monitor);
+    group_begin = group_end;
+  }
+
+  sc_mem_free(batch_connectors);
+  if (sc_storage_wal_commit() != SC_RESULT_OK && result == SC_RESULT_OK)
+    result = SC_RESULT_ERROR_FILE_MEMORY_IO;
+  return result;
+}
+
 sc_uint32 sc_storage_get_element_outgoing_arcs_count(sc_memory_context const * ctx, sc_addr addr, sc_result * result)
 {
   sc_uint32 count = 0;
@@ -1294,9 +2416,13 @@ sc_result sc_storage_change_element_subtype(sc_memory_context const * ctx, sc_ad
   }
 
   el->flags.type = type;
+  _sc_storage_mark_element_dirty(addr);
+  _sc_storage_log_elements(SC_STORAGE_WAL_RECORD_SUBTYPE_CHANGE, &addr, 1);
 
 error:
   sc_monitor_release_write(monitor);
+  if (sc_storage_wal_commit() != SC_RESULT_OK && result == SC_RESULT_OK)
+    result = SC_RESULT_ERROR_FILE_MEMORY_IO;
   return result;
 }
 
@@ -1320,7 +2446,7 @@ sc_result sc_storage_get_arc_begin(sc_memory_context const * ctx, sc_addr addr,
     goto error;
   }
 
-  *result_begin_addr = el->arc.begin;
+  *result_begin_addr = sc_element_get_arc(el)->begin;
 
 error:
   sc_monitor_release_read(monitor);
@@ -1347,7 +2473,7 @@ sc_result sc_storage_get_arc_end(sc_memory_context const * ctx, sc_addr addr, sc
     goto error;
   }
 
-  *result_end_addr = el->arc.end;
+  *result_end_addr = sc_element_get_arc(el)->end;
 
 error:
   sc_monitor_release_read(monitor);
@@ -1379,14 +2505,29 @@ sc_result sc_storage_get_arc_info(
     goto error;
   }
 
-  *result_begin_addr = el->arc.begin;
-  *result_end_addr = el->arc.end;
+  *result_begin_addr = sc_element_get_arc(el)->begin;
+  *result_end_addr = sc_element_get_arc(el)->end;
 
 error:
   sc_monitor_release_read(monitor);
   return result;
 }
 
+//! Appends content of sc-link to write-ahead log, it is called under monitor of sc-link
+void _sc_storage_log_link_content(sc_addr addr, sc_char const * string, sc_uint32 string_size, sc_bool is_searchable)
+{
+  if (sc_storage_wal_is_enabled() == SC_FALSE)
+    return;
+
+  sc_uint32 const header_size = sizeof(addr) + sizeof(is_searchable);
+  sc_char * data = sc_mem_new(sc_char, header_size + string_size);
+  sc_mem_cpy(data, &addr, sizeof(addr));
+  sc_mem_cpy(data + sizeof(addr), &is_searchable, sizeof(is_searchable));
+  sc_mem_cpy(data + header_size, string, string_size);
+  sc_storage_wal_append(SC_STORAGE_WAL_RECORD_LINK_CONTENT, data, header_size + string_size);
+  sc_mem_free(data);
+}
+
 sc_result sc_storage_set_link_content(
     sc_memory_context const * ctx,
     sc_addr addr,
@@ -1427,6 +2568,7 @@ sc_result sc_storage_set_link_content(
     result = SC_RESULT_ERROR_FILE_MEMORY_IO;
     goto error;
   }
+  _sc_storage_log_link_content(addr, string, string_size, is_searchable_string);
 
   sc_event_emit(
       ctx, addr, sc_event_before_change_link_content_addr, SC_ADDR_EMPTY, 0, SC_ADDR_EMPTY, null_ptr, SC_ADDR_EMPTY);
@@ -1434,7 +2576,7 @@ sc_result sc_storage_set_link_content(
   sc_monitor_release_write(monitor);
   sc_mem_free(string);
 
-  return SC_RESULT_OK;
+  return sc_storage_wal_commit();
 error:
   sc_monitor_release_write(monitor);
   sc_mem_free(string);
@@ -1448,8 +2590,6 @@ sc_result sc_storage_get_link_content(sc_memory_context const * ctx, sc_addr add
   sc_result result;
 
   sc_element * el = null_ptr;
-  sc_char * string = null_ptr;
-  sc_uint32 string_size = 0;
 
   sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&storage->addr_monitors_table, addr);
   sc_monitor_acquire_read(monitor);
@@ -1464,8 +2604,8 @@ sc_result sc_storage_get_link_content(sc_memory_context const * ctx, sc_addr add
     goto error;
   }
 
-  sc_fs_memory_status const fs_memory_status =
-      sc_fs_memory_get_string_by_link_hash(SC_ADDR_LOCAL_TO_INT(addr), &string, &string_size);
+  // content is read by stream from strings of fs-memory without copying, if it is possible
+  sc_fs_memory_status const fs_memory_status = sc_fs_memory_get_stream_by_link_hash(SC_ADDR_LOCAL_TO_INT(addr), stream);
   if (fs_memory_status != SC_FS_MEMORY_OK && fs_memory_status != SC_FS_MEMORY_NO_STRING)
   {
     result = SC_RESULT_ERROR_FILE_MEMORY_IO;
@@ -1474,10 +2614,12 @@ sc_result sc_storage_get_link_content(sc_memory_context const * ctx, sc_addr add
 
   sc_monitor_release_read(monitor);
 
-  if (string == null_ptr)
+  if (*stream == null_ptr)
+  {
+    sc_char * string;
     sc_string_empty(string);
-
-  *stream = sc_stream_memory_new(string, string_size, SC_STREAM_FLAG_READ, SC_TRUE);
+    *stream = sc_stream_memory_new(string, 0, SC_STREAM_FLAG_READ, SC_TRUE);
+  }
 
   return SC_RESULT_OK;
 error:
@@ -1592,17 +2734,79 @@ sc_result sc_storage_get_elements_stat(sc_stat * stat)
 
   for (sc_addr_seg i = 0; i < count; ++i)
   {
-    sc_segment * segment = storage->segments[i];
+    sc_segment * segment = _sc_storage_get_segment_by_num(i + 1);
 
     sc_monitor_acquire_read(&segment->monitor);
     sc_segment_collect_elements_stat(segment, stat);
     sc_monitor_release_read(&segment->monitor);
+    sc_segment_pager_release(segment);
+
+    if (g_atomic_int_get(&segment->access_count) != 0)
+      ++stat->accessed_segments_count;
   }
 
+  stat->connectors_index_size = sc_connectors_index_get_size();
+  sc_segment_pager_get_stat(stat);
+
   return SC_RESULT_OK;
 }
 
+sc_uint32 sc_storage_reset_segments_access_counts(sc_addr_seg * nums, sc_uint32 * counts, sc_uint32 max_count)
+{
+  sc_monitor_acquire_read(&storage->segments_monitor);
+  sc_addr_seg segments_count = storage->segments_count;
+  sc_monitor_release_read(&storage->segments_monitor);
+
+  sc_uint32 count = 0;
+  for (sc_addr_seg num = 1; num <= segments_count; ++num)
+  {
+    sc_segment * segment = _sc_storage_get_segment_by_num(num);
+    // accesses counted after reading of access count are kept for the next reset
+    sc_uint32 const access_count = g_atomic_int_get(&segment->access_count);
+    if (access_count == 0)
+      continue;
+    g_atomic_int_add(&segment->access_count, -(sc_int32)access_count);
+
+    sc_uint32 i = count < max_count ? count++ : max_count;
+    for (; i > 0 && counts[i - 1] < access_count; --i)
+    {
+      if (i < max_count)
+      {
+        nums[i] = nums[i - 1];
+        counts[i] = counts[i - 1];
+      }
+    }
+    if (i < max_count)
+    {
+      nums[i] = num;
+      counts[i] = access_count;
+    }
+  }
+
+  return count;
+}
+
 sc_result sc_storage_save(sc_memory_context const * ctx)
 {
-  return sc_fs_memory_save(storage) == SC_FS_MEMORY_OK ? SC_RESULT_OK : SC_RESULT_ERROR;
+  sc_storage_drain_allocation_caches();
+
+  // changes logged before the new log file is started are contained in the dump, so their log files are removed
+  sc_uint32 const wal_number = sc_storage_wal_rotate();
+  if (sc_fs_memory_save(storage) != SC_FS_MEMORY_OK)
+    return SC_RESULT_ERROR;
+
+  sc_storage_wal_remove_before(wal_number);
+  return SC_RESULT_OK;
+}
+
+sc_result sc_storage_save_changes(sc_memory_context const * ctx)
+{
+  sc_storage_drain_allocation_caches();
+
+  sc_uint32 const wal_number = sc_storage_wal_rotate();
+  if (sc_fs_memory_save_changes(storage) != SC_FS_MEMORY_OK)
+    return SC_RESULT_ERROR;
+
+  sc_storage_wal_remove_before(wal_number);
+  return SC_RESULT_OK;
 }
@@ -70,6 +70,79 @@ sc_result sc_storage_initialize(sc_memory_params const * params);
  */
 sc_result sc_storage_shutdown(sc_bool save_state);
 
+/*!
+ * @brief Verifies checksums of sc-storage saved in file system without loading it.
+ *
+ * This function reads saved sc-segments and strings channels and reports every corrupted one. It is called when
+ * sc-storage isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param[out] corrupted_count Count of corrupted sc-segments and strings channels.
+ * @return Returns the result of the verification.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK Sc-storage is verified, even if it is corrupted.
+ * @retval SC_RESULT_ERROR Sc-storage can't be read.
+ */
+sc_result sc_storage_verify(sc_memory_params const * params, sc_uint32 * corrupted_count);
+
+/*!
+ * @brief Compacts sc-storage saved in file system.
+ *
+ * This function loads saved sc-storage, relocates its sc-elements into the first sc-segments, frees emptied
+ * sc-segments and saves sc-storage. Addresses of relocated sc-elements are changed. It is called when sc-storage isn't
+ * initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param[out] moved_count Count of relocated sc-elements.
+ * @param[out] freed_segments_count Count of freed sc-segments.
+ * @return Returns the result of the compaction.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK Sc-storage is compacted and saved.
+ * @retval SC_RESULT_ERROR Sc-storage can't be loaded or saved.
+ */
+sc_result sc_storage_compact(
+    sc_memory_params const * params,
+    sc_uint32 * moved_count,
+    sc_addr_seg * freed_segments_count);
+
+/*!
+ * @brief Exports sc-elements of sc-storage saved in file system to file.
+ *
+ * This function loads saved sc-storage and writes its sc-elements with types, begin and end sc-elements of
+ * sc-connectors and contents of sc-links to file of binary format independent of layout of sc-elements. It is called
+ * when sc-storage isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param path Path to file to export sc-elements to.
+ * @param[out] exported_count Count of exported sc-elements.
+ * @return Returns the result of the export.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK Sc-elements are exported.
+ * @retval SC_RESULT_ERROR Sc-storage can't be loaded or file can't be written.
+ */
+sc_result sc_storage_export(sc_memory_params const * params, sc_char const * path, sc_uint64 * exported_count);
+
+/*!
+ * @brief Imports sc-elements from file to sc-storage saved in file system.
+ *
+ * This function loads saved sc-storage, or initializes empty one if `clear` parameter is set, generates sc-elements
+ * exported to file by `sc_storage_export` and saves sc-storage. Imported sc-elements get new addresses. It is called
+ * when sc-storage isn't initialized.
+ *
+ * @param params Pointer to the structure containing parameters with path to sc-storage.
+ * @param path Path to file to import sc-elements from.
+ * @param[out] imported_count Count of imported sc-elements.
+ * @return Returns the result of the import.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK Sc-elements are imported and sc-storage is saved.
+ * @retval SC_RESULT_ERROR File can't be read or it is corrupted, or sc-storage can't be loaded or saved.
+ */
+sc_result sc_storage_import(sc_memory_params const * params, sc_char const * path, sc_uint64 * imported_count);
+
 //! Check if storage initialized
 sc_bool sc_storage_is_initialized();
 
@@ -89,10 +162,6 @@ sc_bool sc_storage_is_initialized();
  */
 sc_bool sc_storage_is_element(sc_memory_context const * ctx, sc_addr addr);
 
-void sc_storage_start_new_process();
-
-void sc_storage_end_new_process();
-
 /*!
  * @brief Erases the memory occupied by a sc-element and all connected sc-elements.
  *
@@ -114,6 +183,27 @@ void sc_storage_end_new_process();
  */
 sc_result sc_storage_element_erase(sc_memory_context const * ctx, sc_addr addr);
 
+/*!
+ * @brief Erases sc-elements and all sc-connectors related to them in batch.
+ *
+ * This function computes closure of all specified sc-elements once, unlinks only sc-connectors of remaining
+ * sc-elements, releases sc-elements segment by segment and notifies about their deletion in one batch.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param count Count of sc-elements to be erased.
+ * @param addrs A pointer to array of sc-addresses of sc-elements to be erased.
+ *
+ * @return Returns SC_RESULT_OK if all sc-elements are erased.
+ *
+ * @note Valid sc-elements are erased even if some sc-addresses are not valid.
+ * @note This function is thread-safe.
+ *
+ * Possible values for the result:
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ADDR_IS_NOT_VALID Some of specified sc-addresses are not valid.
+ */
+sc_result sc_storage_elements_erase(sc_memory_context const * ctx, sc_uint32 count, sc_addr const * addrs);
+
 /*!
  * @brief Generates a new sc-node with the specified type.
  *
@@ -157,6 +247,28 @@ sc_addr sc_storage_node_new(sc_memory_context const * ctx, sc_type type);
  */
 sc_addr sc_storage_node_new_ext(sc_memory_context const * ctx, sc_type type, sc_result * result);
 
+/*!
+ * @brief Generates sc-nodes with the specified type in batch.
+ *
+ * This function reserves contiguous ranges of sc-addrs in sc-segments for all sc-nodes at once, so it is faster than
+ * generation of the same sc-nodes one by one.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param type Type of the new sc-nodes.
+ * @param count Count of the new sc-nodes.
+ * @param addrs Array of size `count` that will store sc-addrs of the created sc-nodes.
+ *
+ * @return Returns the result of the operation. If it isn't SC_RESULT_OK, then no sc-node is created and all sc-addrs
+ *         in `addrs` are empty.
+ *
+ * @note This function is thread-safe.
+ *
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ELEMENT_IS_NOT_NODE The specified sc-type is not valid for a sc-node.
+ * @retval SC_RESULT_ERROR_FULL_MEMORY Unable to allocate memory for all new sc-nodes.
+ */
+sc_result sc_storage_nodes_new_batch(sc_memory_context const * ctx, sc_type type, sc_uint32 count, sc_addr * addrs);
+
 /*!
  * @brief Generates a new sc-link with the specified type.
  *
@@ -258,6 +370,39 @@ sc_addr sc_storage_arc_new_ext(
     sc_addr end_addr,
     sc_result * result);
 
+/*!
+ * @brief Generates sc-connectors in batch.
+ *
+ * This function reserves contiguous ranges of sc-addrs in sc-segments for all sc-connectors at once. Then sc-connectors
+ * are grouped by monitors of their begin and end sc-elements, and each group is linked into lists of sc-connectors
+ * under one lock of these monitors.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ * @param count Count of the new sc-connectors.
+ * @param triples Array of size `count` with types, begin and end sc-elements of the new sc-connectors.
+ * @param connectors Array of size `count` that will store sc-addrs of the created sc-connectors.
+ * @param emit_events Boolean indicating whether to emit events of generated sc-connectors. If it is SC_FALSE, then no
+ *                    sc-event is emitted, otherwise sc-events of each group are emitted in one pass.
+ *
+ * @return Returns the result of the operation. If the begin or end sc-element of some sc-connector doesn't exist, then
+ *         this sc-connector isn't created and its sc-addr in `connectors` is empty, but other sc-connectors are
+ *         created.
+ *         If type or sc-addrs of some sc-connector are invalid or sc-memory is full, then no sc-connector is created.
+ *
+ * @note This function is thread-safe.
+ *
+ * @retval SC_RESULT_OK The function executed successfully.
+ * @retval SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR Some specified type is not a valid sc-connector type.
+ * @retval SC_RESULT_ERROR_ADDR_IS_NOT_VALID Some begin or end sc-addr is not valid.
+ * @retval SC_RESULT_ERROR_FULL_MEMORY Unable to allocate memory for all new sc-connectors.
+ */
+sc_result sc_storage_arcs_new_batch(
+    sc_memory_context const * ctx,
+    sc_uint32 count,
+    sc_connector_triple const * triples,
+    sc_addr * connectors,
+    sc_bool emit_events);
+
 /*!
  * @brief Retrieves the count of output connectors for the specified sc-element.
  *
@@ -636,6 +781,31 @@ sc_result sc_storage_find_links_contents_by_content_substring(
  */
 sc_result sc_storage_get_elements_stat(sc_stat * stat);
 
+/*!
+ * @brief Gets the most accessed sc-segments and resets access counts of all sc-segments.
+ *
+ * Accesses to sc-elements of sc-segments mapped from dump are sampled, if `segments_memory_limit` is set: every
+ * `SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD`-th access of a thread is counted as the whole sampling period.
+ *
+ * @param[out] nums Numbers of the most accessed sc-segments in descending order of their access counts.
+ * @param[out] counts Access counts of the most accessed sc-segments after the previous reset.
+ * @param max_count Max count of the most accessed sc-segments.
+ * @return Returns count of accessed sc-segments written to `nums` and `counts`.
+ */
+sc_uint32 sc_storage_reset_segments_access_counts(sc_addr_seg * nums, sc_uint32 * counts, sc_uint32 max_count);
+
+/*!
+ * @brief Enables or disables index of sc-connectors by pairs of their begin and end sc-elements.
+ *
+ * Enabled index is built from existing sc-connectors, disabled index is cleared. The index is switched when monitors
+ * of all sc-addrs are acquired, so no other thread generates, erases or iterates sc-connectors meanwhile.
+ *
+ * @param is_enabled SC_TRUE to enable index of sc-connectors, SC_FALSE to disable it.
+ *
+ * @return Returns SC_RESULT_ERROR, if sc-storage isn't initialized, otherwise SC_RESULT_OK.
+ */
+sc_result sc_storage_set_connectors_index(sc_bool is_enabled);
+
 /*!
  * @brief Saves the current state of the sc-storage to persistent storage.
  *
@@ -652,4 +822,16 @@ sc_result sc_storage_get_elements_stat(sc_stat * stat);
  */
 sc_result sc_storage_save(sc_memory_context const * ctx);
 
+/*!
+ * @brief Saves changes of the sc-storage made after the last dump.
+ *
+ * Only segments changed after the last dump are appended to the file of changes of the last saved state. The whole
+ * state is saved instead, if it isn't saved yet or if `dump_memory_deltas_count` changes are already appended.
+ *
+ * @param ctx A pointer to the sc-memory context that manages the operation.
+ *
+ * @return Returns SC_RESULT_OK, if changes are saved, otherwise SC_RESULT_ERROR.
+ */
+sc_result sc_storage_save_changes(sc_memory_context const * ctx);
+
 #endif
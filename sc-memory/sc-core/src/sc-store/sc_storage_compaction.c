@@ -0,0 +1,301 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_storage_compaction.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include "sc-fs-memory/sc_fs_memory.h"
+
+#include "sc_element.h"
+#include "sc_segment.h"
+#include "sc_storage.h"
+#include "sc_storage_private.h"
+#include "sc_memory_private.h"
+
+// count of words of bits of all sc-elements of segment
+#define SC_STORAGE_COMPACTION_WORDS_COUNT ((SC_SEGMENT_ELEMENTS_COUNT + 63) / 64)
+// sc-elements are placed from offset 1, the first sc-element of segment stores lists of released sc-elements
+#define SC_STORAGE_COMPACTION_SEGMENT_CAPACITY (SC_SEGMENT_ELEMENTS_COUNT - 1)
+
+//! Index of existing sc-elements of segment before compaction, new addresses of sc-elements are calculated by it
+typedef struct
+{
+  sc_uint64 existing[SC_STORAGE_COMPACTION_WORDS_COUNT];  // bits of existing sc-elements by their offsets
+  sc_uint16 ranks[SC_STORAGE_COMPACTION_WORDS_COUNT];     // counts of existing sc-elements before words of bits
+  sc_uint32 first_rank;                                   // count of existing sc-elements in previous segments of pool
+  sc_uint8 pool;
+} sc_storage_compaction_segment;
+
+typedef struct
+{
+  sc_storage * storage;
+  sc_addr_seg segments_count;                               // count of segments before compaction
+  sc_storage_compaction_segment * segments;                 // indexes of segments by numbers before compaction
+  sc_addr_seg * pool_segment_nums[SC_SEGMENT_POOLS_COUNT];  // numbers of segments of pools in ascending order
+  sc_addr_seg * new_segment_nums;                           // numbers after compaction by numbers before it, or 0
+  sc_uint32 dangling_count;                                 // count of sc-addrs of not existing sc-elements
+} sc_storage_compaction;
+
+sc_bool _sc_storage_compaction_is_element_exist(sc_element const * element)
+{
+  return (element->flags.states & SC_STATE_ELEMENT_EXIST) == SC_STATE_ELEMENT_EXIST;
+}
+
+void _sc_storage_compaction_index_segments(sc_storage_compaction * compaction)
+{
+  sc_uint32 pool_ranks[SC_SEGMENT_POOLS_COUNT] = {0};
+  sc_addr_seg pool_segments_counts[SC_SEGMENT_POOLS_COUNT] = {0};
+  for (sc_addr_seg num = 1; num <= compaction->segments_count; ++num)
+  {
+    sc_segment * segment = compaction->storage->segments[num - 1];
+    sc_storage_compaction_segment * indexed_segment = &compaction->segments[num - 1];
+    indexed_segment->pool = segment->pool;
+    indexed_segment->first_rank = pool_ranks[segment->pool];
+    compaction->pool_segment_nums[segment->pool][pool_segments_counts[segment->pool]++] = num;
+
+    for (sc_addr_offset offset = 1; offset <= segment->last_engaged_offset; ++offset)
+    {
+      if (_sc_storage_compaction_is_element_exist(sc_segment_get_element(segment, offset)))
+        indexed_segment->existing[offset / 64] |= (sc_uint64)1 << (offset % 64);
+    }
+
+    sc_uint32 rank = 0;
+    for (sc_uint32 word = 0; word < SC_STORAGE_COMPACTION_WORDS_COUNT; ++word)
+    {
+      indexed_segment->ranks[word] = rank;
+      rank += __builtin_popcountll(indexed_segment->existing[word]);
+    }
+    pool_ranks[segment->pool] += rank;
+  }
+
+  // the first segments of pools are enough to store existing sc-elements, the other segments are freed
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    sc_uint32 const used_segments_count =
+        (pool_ranks[pool] + SC_STORAGE_COMPACTION_SEGMENT_CAPACITY - 1) / SC_STORAGE_COMPACTION_SEGMENT_CAPACITY;
+    for (sc_uint32 i = 0; i < used_segments_count; ++i)
+      compaction->new_segment_nums[compaction->pool_segment_nums[pool][i] - 1] = 1;
+  }
+
+  sc_addr_seg new_num = 0;
+  for (sc_addr_seg num = 1; num <= compaction->segments_count; ++num)
+  {
+    if (compaction->new_segment_nums[num - 1] != 0)
+      compaction->new_segment_nums[num - 1] = ++new_num;
+  }
+}
+
+/*! Gets segment and offset of sc-element after compaction.
+ * @param compaction Compaction of sc-storage
+ * @param addr Sc-addr of sc-element before compaction
+ * @param[out] segment_num Number of segment before compaction, which stores sc-element after compaction
+ * @param[out] offset Offset of sc-element after compaction
+ * @returns SC_FALSE, if sc-element doesn't exist.
+ */
+sc_bool _sc_storage_compaction_locate_element(
+    sc_storage_compaction const * compaction,
+    sc_addr addr,
+    sc_addr_seg * segment_num,
+    sc_addr_offset * offset)
+{
+  if (addr.seg == 0 || addr.seg > compaction->segments_count || addr.offset == 0
+      || addr.offset > SC_STORAGE_COMPACTION_SEGMENT_CAPACITY)
+    return SC_FALSE;
+
+  sc_storage_compaction_segment const * indexed_segment = &compaction->segments[addr.seg - 1];
+  sc_uint32 const word = addr.offset / 64;
+  sc_uint64 const bit = (sc_uint64)1 << (addr.offset % 64);
+  if ((indexed_segment->existing[word] & bit) == 0)
+    return SC_FALSE;
+
+  sc_uint32 const rank = indexed_segment->first_rank + indexed_segment->ranks[word]
+                         + __builtin_popcountll(indexed_segment->existing[word] & (bit - 1));
+  *segment_num = compaction->pool_segment_nums[indexed_segment->pool][rank / SC_STORAGE_COMPACTION_SEGMENT_CAPACITY];
+  *offset = rank % SC_STORAGE_COMPACTION_SEGMENT_CAPACITY + 1;
+  return SC_TRUE;
+}
+
+sc_addr _sc_storage_compaction_get_new_addr(sc_storage_compaction * compaction, sc_addr addr)
+{
+  if (SC_ADDR_IS_EMPTY(addr))
+    return addr;
+
+  sc_addr_seg segment_num;
+  sc_addr_offset offset;
+  if (_sc_storage_compaction_locate_element(compaction, addr, &segment_num, &offset) == SC_FALSE)
+  {
+    ++compaction->dangling_count;
+    return SC_ADDR_EMPTY;
+  }
+
+  return (sc_addr){.seg = compaction->new_segment_nums[segment_num - 1], .offset = offset};
+}
+
+void _sc_storage_compaction_rewrite_addr(sc_storage_compaction * compaction, sc_addr * addr)
+{
+  *addr = _sc_storage_compaction_get_new_addr(compaction, *addr);
+}
+
+void _sc_storage_compaction_rewrite_element_addrs(sc_storage_compaction * compaction, sc_element * element)
+{
+  _sc_storage_compaction_rewrite_addr(compaction, &element->first_out_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &element->first_in_arc);
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+  _sc_storage_compaction_rewrite_addr(compaction, &element->first_in_arc_from_structure);
+#endif
+
+  if (!sc_type_has_subtype_in_mask(element->flags.type, sc_type_connector_mask))
+    return;
+
+  sc_arc_info * arc = sc_element_get_arc(element);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->begin);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->end);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_begin_out_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->prev_begin_out_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_begin_in_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_end_out_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_end_in_arc);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->prev_end_in_arc);
+#ifdef SC_OPTIMIZE_SEARCHING_INCOMING_CONNECTORS_FROM_STRUCTURES
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->prev_in_arc_from_structure);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_in_arc_from_structure);
+#endif
+#ifdef SC_OPTIMIZE_SEARCHING_ARCS_BY_TYPES
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->prev_out_arc_of_type);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_out_arc_of_type);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->prev_in_arc_of_type);
+  _sc_storage_compaction_rewrite_addr(compaction, &arc->next_in_arc_of_type);
+#endif
+}
+
+/*! Moves contents of sc-links, which addresses are changed, to their new addresses. Addresses of sc-links are changed
+ * even if they stay in their places, because segments before them may be freed. New address of every sc-element is
+ * lower than its previous one, so contents are moved in order of previous addresses, and every new sc-link hash
+ * doesn't have content, when content is moved to it: it isn't an address of any sc-link or its content is already
+ * moved.
+ */
+void _sc_storage_compaction_move_link_strings(sc_storage_compaction * compaction)
+{
+  sc_storage * storage = compaction->storage;
+  for (sc_addr_seg num = 1; num <= compaction->segments_count; ++num)
+  {
+    sc_segment * segment = storage->segments[num - 1];
+    for (sc_addr_offset offset = 1; offset <= segment->last_engaged_offset; ++offset)
+    {
+      sc_element * element = sc_segment_get_element(segment, offset);
+      if (!_sc_storage_compaction_is_element_exist(element)
+          || !sc_type_has_subtype(element->flags.type, sc_type_node_link))
+        continue;
+
+      sc_addr const addr = {.seg = num, .offset = offset};
+      sc_addr_seg new_segment_num;
+      sc_addr_offset new_offset;
+      _sc_storage_compaction_locate_element(compaction, addr, &new_segment_num, &new_offset);
+      sc_addr const new_addr = {.seg = compaction->new_segment_nums[new_segment_num - 1], .offset = new_offset};
+      if (SC_ADDR_IS_NOT_EQUAL(new_addr, addr))
+        sc_fs_memory_move_link_string(SC_ADDR_LOCAL_TO_INT(addr), SC_ADDR_LOCAL_TO_INT(new_addr));
+    }
+  }
+}
+
+/*! Moves sc-elements to their new places. Sc-elements are moved to the same or previous places of their pools, and
+ * they are moved in order of their addresses, so every place is freed before it is taken.
+ */
+void _sc_storage_compaction_move_elements(sc_storage_compaction * compaction, sc_uint32 * moved_count)
+{
+  sc_storage * storage = compaction->storage;
+  for (sc_addr_seg num = 1; num <= compaction->segments_count; ++num)
+  {
+    sc_segment * segment = storage->segments[num - 1];
+    sc_uint32 const element_size = SC_SEGMENT_ELEMENT_SIZE(segment->pool);
+    for (sc_addr_offset offset = 1; offset <= segment->last_engaged_offset; ++offset)
+    {
+      sc_element * element = sc_segment_get_element(segment, offset);
+      if (!_sc_storage_compaction_is_element_exist(element))
+        continue;
+
+      sc_addr const addr = {.seg = num, .offset = offset};
+      sc_addr_seg new_segment_num;
+      sc_addr_offset new_offset;
+      _sc_storage_compaction_locate_element(compaction, addr, &new_segment_num, &new_offset);
+      if (new_segment_num == num && new_offset == offset)
+        continue;
+
+      sc_element * new_element = sc_segment_get_element(storage->segments[new_segment_num - 1], new_offset);
+      sc_mem_cpy(new_element, element, element_size);
+      sc_mem_set(element, 0, element_size);
+      ++*moved_count;
+    }
+  }
+}
+
+void _sc_storage_compaction_renumber_segments(sc_storage_compaction * compaction, sc_addr_seg * freed_segments_count)
+{
+  sc_storage * storage = compaction->storage;
+  sc_addr_seg segments_count = 0;
+  for (sc_addr_seg num = 1; num <= compaction->segments_count; ++num)
+  {
+    sc_segment * segment = storage->segments[num - 1];
+    storage->segments[num - 1] = null_ptr;
+
+    sc_addr_seg const new_num = compaction->new_segment_nums[num - 1];
+    if (new_num == 0)
+    {
+      sc_segment_free(segment);
+      ++*freed_segments_count;
+      continue;
+    }
+
+    segment->num = new_num;
+    storage->segments[new_num - 1] = segment;
+    segments_count = new_num;
+  }
+
+  storage->segments_count = segments_count;
+}
+
+void sc_storage_compact_segments(sc_storage * storage, sc_uint32 * moved_count, sc_addr_seg * freed_segments_count)
+{
+  *moved_count = 0;
+  *freed_segments_count = 0;
+
+  sc_storage_compaction compaction;
+  compaction.storage = storage;
+  compaction.segments_count = storage->segments_count;
+  compaction.segments = sc_mem_new(sc_storage_compaction_segment, compaction.segments_count);
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    compaction.pool_segment_nums[pool] = sc_mem_new(sc_addr_seg, compaction.segments_count);
+  compaction.new_segment_nums = sc_mem_new(sc_addr_seg, compaction.segments_count);
+  compaction.dangling_count = 0;
+
+  _sc_storage_compaction_index_segments(&compaction);
+
+  // sc-addrs are rewritten before sc-elements are moved, because new addresses are calculated by old ones
+  for (sc_addr_seg num = 1; num <= compaction.segments_count; ++num)
+  {
+    sc_segment * segment = storage->segments[num - 1];
+    for (sc_addr_offset offset = 1; offset <= segment->last_engaged_offset; ++offset)
+    {
+      sc_element * element = sc_segment_get_element(segment, offset);
+      if (_sc_storage_compaction_is_element_exist(element))
+        _sc_storage_compaction_rewrite_element_addrs(&compaction, element);
+    }
+  }
+  if (compaction.dangling_count != 0)
+    sc_memory_warning("Sc-addrs of not existing sc-elements are cleared: %u", compaction.dangling_count);
+
+  // contents of sc-links are moved before sc-elements, because types of sc-elements are got by their old addresses
+  _sc_storage_compaction_move_link_strings(&compaction);
+  _sc_storage_compaction_move_elements(&compaction, moved_count);
+  _sc_storage_compaction_renumber_segments(&compaction, freed_segments_count);
+  sc_storage_restore_free_elements(storage);
+
+  sc_mem_free(compaction.new_segment_nums);
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    sc_mem_free(compaction.pool_segment_nums[pool]);
+  sc_mem_free(compaction.segments);
+}
@@ -0,0 +1,26 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_storage_compaction_h_
+#define _sc_storage_compaction_h_
+
+#include "sc-core/sc_types.h"
+
+#include "sc_storage.h"
+
+/*! Relocates existing sc-elements of every pool of segments into the first segments of the pool in order of their
+ * addresses, so released sc-elements are left at the end of pools only. Sc-addrs stored in sc-elements and sc-link
+ * hashes of contents in file system memory are rewritten to new addresses. Emptied segments are freed, and the other
+ * segments are renumbered in order.
+ * @param storage Loaded sc-storage
+ * @param[out] moved_count Count of relocated sc-elements
+ * @param[out] freed_segments_count Count of freed segments
+ * @note Addresses of sc-elements are changed, so it is called only when no other threads use sc-storage and no
+ * sc-addrs of sc-elements are kept outside of it.
+ */
+void sc_storage_compact_segments(sc_storage * storage, sc_uint32 * moved_count, sc_addr_seg * freed_segments_count);
+
+#endif
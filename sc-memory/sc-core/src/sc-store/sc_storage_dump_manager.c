@@ -13,6 +13,9 @@
 #include "sc_storage.h"
 #include "sc_memory_private.h"
 
+// Count of the most accessed segments reported in statistics
+#define SC_STORAGE_DUMP_MOST_ACCESSED_SEGMENTS_COUNT 8
+
 typedef void (*sc_timed_callback)();
 typedef pthread_t sc_timer;
 
@@ -63,7 +66,7 @@ void _sc_storage_dump_manager_delete_timer(sc_timer timer)
 void _sc_storage_dump_timer()
 {
   sc_memory_info("Dump sc-memory by period");
-  sc_storage_save(null_ptr);
+  sc_storage_save_changes(null_ptr);
 }
 
 void _sc_storage_dump_statistics_timer()
@@ -82,6 +85,25 @@ void _sc_storage_dump_statistics_timer()
       statistics.connector_count,
       (sc_float)statistics.connector_count / (sc_float)allElements * 100);
   sc_message("Total: %" PRIu64, allElements);
+  if (statistics.connectors_index_size != 0)
+    sc_message("Connectors index size: %" PRIu64 " bytes", statistics.connectors_index_size);
+  if (statistics.resident_segments_size != 0 || statistics.paged_out_segments_count != 0)
+  {
+    sc_message("Resident segments size: %" PRIu64 " bytes", statistics.resident_segments_size);
+    sc_message("Paged out segments: %" PRIu64, statistics.paged_out_segments_count);
+  }
+
+  if (statistics.accessed_segments_count == 0)
+    return;
+
+  // access counts are reset every period, so they are counted by period and don't overflow
+  sc_addr_seg nums[SC_STORAGE_DUMP_MOST_ACCESSED_SEGMENTS_COUNT];
+  sc_uint32 counts[SC_STORAGE_DUMP_MOST_ACCESSED_SEGMENTS_COUNT];
+  sc_uint32 const count =
+      sc_storage_reset_segments_access_counts(nums, counts, SC_STORAGE_DUMP_MOST_ACCESSED_SEGMENTS_COUNT);
+  sc_message("Accessed segments: %" PRIu64, statistics.accessed_segments_count);
+  for (sc_uint32 i = 0; i < count; ++i)
+    sc_message("\tSegment %u: %u accesses", nums[i], counts[i]);
 }
 
 void sc_storage_dump_manager_initialize(sc_storage_dump_manager ** manager, sc_memory_params const * params)
@@ -100,6 +122,7 @@ void sc_storage_dump_manager_initialize(sc_storage_dump_manager ** manager, sc_m
   sc_memory_info("Sc-memory dump manager configuration");
   sc_message("\tDump memory: %s", (*manager)->dump_memory_info.dump ? "On" : "Off");
   sc_message("\tDump memory period: %d seconds", (*manager)->dump_memory_info.dump_period);
+  sc_message("\tDump memory deltas count: %d", params->dump_memory_deltas_count);
   sc_message("\tDump memory statistics: %s", params->dump_memory_statistics ? "On" : "Off");
   sc_message("\tDump memory statistics period: %d seconds", params->dump_memory_statistics_period);
 
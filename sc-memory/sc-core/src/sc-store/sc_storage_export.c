@@ -0,0 +1,719 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_storage_export.h"
+
+#include "sc-core/sc-base/sc_allocator.h"
+
+#include "sc-fs-memory/sc_fs_memory.h"
+#include "sc-fs-memory/sc_fs_memory_checksum.h"
+
+#include "sc_element.h"
+#include "sc_segment.h"
+#include "sc_segment_pager.h"
+#include "sc_storage.h"
+#include "sc_storage_private.h"
+#include "sc_memory_private.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sc-store/sc-base/sc_mutex_private.h"
+
+/* File of exported sc-elements starts with header, then blocks of records of sc-elements follow in any order, and the
+ * last block is empty. Every block stores records of sc-elements of one segment. Record consists of offset and type of
+ * sc-element, then of sc-addr hashes of begin and end sc-elements of sc-connector or of size and bytes of content of
+ * sc-link. Sc-elements are identified by their sc-addr hashes in exported sc-storage. Fields have fixed sizes and
+ * aren't aligned, so the format doesn't depend on layout of sc-elements.
+ */
+#define SC_STORAGE_EXPORT_MAGIC "SCGRAPH"
+#define SC_STORAGE_EXPORT_VERSION 1
+// Size of records after which block is written, so memory of workers is bounded
+#define SC_STORAGE_EXPORT_BLOCK_SIZE (4 * 1024 * 1024)
+// Size of content of sc-link that doesn't have content
+#define SC_STORAGE_EXPORT_NO_CONTENT SC_MAXUINT32
+// Count of sc-connectors generated by worker in one batch
+#define SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE 1024
+
+typedef struct
+{
+  sc_char magic[8];
+  sc_uint32 version;
+  sc_uint32 segments_count;  // count of segments of exported sc-storage
+} sc_storage_export_header;
+
+typedef struct
+{
+  sc_uint32 segment_num;    // number of segment of sc-elements, it is 0 for the last empty block
+  sc_uint32 records_count;  // count of records of sc-elements
+  sc_uint32 size;           // size of records of sc-elements
+  sc_uint32 checksum;       // checksum of records of sc-elements
+} sc_storage_export_block_header;
+
+typedef void * (*sc_storage_export_worker)(void * data);
+
+sc_bool _sc_storage_export_write_at(sc_int32 fd, void const * data, sc_uint64 size, sc_uint64 offset)
+{
+  sc_char const * bytes = data;
+  while (size > 0)
+  {
+    ssize_t const written_bytes = pwrite(fd, bytes, size, (off_t)offset);
+    if (written_bytes < 0 && errno == EINTR)
+      continue;
+    if (written_bytes <= 0)
+      return SC_FALSE;
+
+    bytes += written_bytes;
+    offset += written_bytes;
+    size -= written_bytes;
+  }
+
+  return SC_TRUE;
+}
+
+sc_bool _sc_storage_export_read_at(sc_int32 fd, void * data, sc_uint64 size, sc_uint64 offset)
+{
+  sc_char * bytes = data;
+  while (size > 0)
+  {
+    ssize_t const read_bytes = pread(fd, bytes, size, (off_t)offset);
+    if (read_bytes < 0 && errno == EINTR)
+      continue;
+    if (read_bytes <= 0)
+      return SC_FALSE;
+
+    bytes += read_bytes;
+    offset += read_bytes;
+    size -= read_bytes;
+  }
+
+  return SC_TRUE;
+}
+
+/*! Runs `threads_count` workers with the same data. The calling thread is one of workers.
+ * @param threads_count Count of workers
+ * @param worker Function of worker
+ * @param data Data passed to workers
+ */
+void _sc_storage_export_run_workers(sc_uint32 threads_count, sc_storage_export_worker worker, void * data)
+{
+  pthread_t * threads = sc_mem_new(pthread_t, threads_count);
+  sc_uint32 started_threads_count = 1;
+  for (; started_threads_count < threads_count; ++started_threads_count)
+  {
+    if (pthread_create(&threads[started_threads_count], null_ptr, worker, data) != 0)
+      break;
+  }
+
+  worker(data);
+  for (sc_uint32 i = 1; i < started_threads_count; ++i)
+    pthread_join(threads[i], null_ptr);
+
+  sc_mem_free(threads);
+}
+
+//! Block of records of sc-elements prepared by worker, space for its header precedes its records
+typedef struct
+{
+  sc_char * data;
+  sc_uint64 size;
+  sc_uint64 capacity;
+  sc_uint32 records_count;
+} sc_storage_export_block;
+
+sc_bool _sc_storage_export_block_append(sc_storage_export_block * block, void const * data, sc_uint64 size)
+{
+  if (block->size + size > SC_MAXUINT32)
+    return SC_FALSE;
+
+  if (block->size + size > block->capacity)
+  {
+    sc_uint64 const capacity = sc_min(sc_max(block->capacity * 2, block->size + size), SC_MAXUINT32);
+    sc_char * new_data = sc_mem_new(sc_char, capacity);
+    sc_mem_cpy(new_data, block->data, block->size);
+    sc_mem_free(block->data);
+    block->data = new_data;
+    block->capacity = capacity;
+  }
+
+  sc_mem_cpy(block->data + block->size, data, size);
+  block->size += size;
+  return SC_TRUE;
+}
+
+typedef struct
+{
+  sc_storage * storage;
+  sc_int32 fd;
+  sc_addr_seg segments_count;
+  volatile gint next_segment_num;  // number of the next segment to scan, it is accessed atomically
+  sc_mutex mutex;                  // it protects offset and count of exported sc-elements
+  sc_uint64 offset;                // offset of the next block in file
+  sc_uint64 exported_count;
+  volatile gint is_failed;
+} sc_storage_elements_export;
+
+sc_bool _sc_storage_export_write_block(
+    sc_storage_elements_export * export,
+    sc_storage_export_block * block,
+    sc_addr_seg num)
+{
+  if (block->records_count == 0)
+    return SC_TRUE;
+
+  sc_storage_export_block_header header = {
+      .segment_num = num,
+      .records_count = block->records_count,
+      .size = block->size - sizeof(header),
+  };
+  header.checksum = sc_fs_memory_checksum(0, block->data + sizeof(header), header.size);
+  sc_mem_cpy(block->data, &header, sizeof(header));
+
+  // blocks are written at reserved offsets, so workers don't wait for each other while they write
+  sc_mutex_lock(&export->mutex);
+  sc_uint64 const offset = export->offset;
+  export->offset += block->size;
+  export->exported_count += block->records_count;
+  sc_mutex_unlock(&export->mutex);
+
+  sc_bool const result = _sc_storage_export_write_at(export->fd, block->data, block->size, offset);
+  block->size = sizeof(header);
+  block->records_count = 0;
+  return result;
+}
+
+sc_bool _sc_storage_export_element(sc_storage_export_block * block, sc_addr addr, sc_element const * element)
+{
+  sc_type const type = element->flags.type;
+  if (!_sc_storage_export_block_append(block, &addr.offset, sizeof(addr.offset))
+      || !_sc_storage_export_block_append(block, &type, sizeof(type)))
+    return SC_FALSE;
+
+  ++block->records_count;
+  if (sc_type_has_subtype_in_mask(type, sc_type_connector_mask))
+  {
+    sc_arc_info const * arc = sc_element_get_arc(element);
+    sc_addr_hash const begin_hash = SC_ADDR_LOCAL_TO_INT(arc->begin);
+    sc_addr_hash const end_hash = SC_ADDR_LOCAL_TO_INT(arc->end);
+    return _sc_storage_export_block_append(block, &begin_hash, sizeof(begin_hash))
+           && _sc_storage_export_block_append(block, &end_hash, sizeof(end_hash));
+  }
+
+  if (!sc_type_has_subtype(type, sc_type_node_link))
+    return SC_TRUE;
+
+  sc_char * string = null_ptr;
+  sc_uint32 string_size = 0;
+  sc_fs_memory_status const status =
+      sc_fs_memory_get_string_by_link_hash(SC_ADDR_LOCAL_TO_INT(addr), &string, &string_size);
+  if (status == SC_FS_MEMORY_NO_STRING)
+    string_size = SC_STORAGE_EXPORT_NO_CONTENT;
+
+  sc_bool const result = (status == SC_FS_MEMORY_OK || status == SC_FS_MEMORY_NO_STRING)
+                         && _sc_storage_export_block_append(block, &string_size, sizeof(string_size))
+                         && (status != SC_FS_MEMORY_OK || _sc_storage_export_block_append(block, string, string_size));
+  sc_mem_free(string);
+  return result;
+}
+
+void * _sc_storage_export_segments_by_worker(void * data)
+{
+  sc_storage_elements_export * export = data;
+
+  sc_storage_export_block block = {
+      .data = sc_mem_new(sc_char, SC_STORAGE_EXPORT_BLOCK_SIZE),
+      .size = sizeof(sc_storage_export_block_header),
+      .capacity = SC_STORAGE_EXPORT_BLOCK_SIZE,
+      .records_count = 0,
+  };
+
+  while (g_atomic_int_get(&export->is_failed) == SC_FALSE)
+  {
+    sc_addr_seg const num = g_atomic_int_add(&export->next_segment_num, 1);
+    if (num > export->segments_count)
+      break;
+
+    sc_segment * segment = export->storage->segments[num - 1];
+    sc_bool result = SC_TRUE;
+    for (sc_addr_offset offset = 1; result && offset <= segment->last_engaged_offset; ++offset)
+    {
+      sc_element const * element = sc_segment_get_element(segment, offset);
+      if ((element->flags.states & SC_STATE_ELEMENT_EXIST) != SC_STATE_ELEMENT_EXIST)
+        continue;
+
+      // big segments are written by several blocks
+      if (block.size >= SC_STORAGE_EXPORT_BLOCK_SIZE)
+        result = _sc_storage_export_write_block(export, &block, num);
+      if (result)
+        result = _sc_storage_export_element(&block, (sc_addr){.seg = num, .offset = offset}, element);
+    }
+
+    if (result)
+      result = _sc_storage_export_write_block(export, &block, num);
+    sc_segment_pager_release(segment);
+
+    if (result == SC_FALSE)
+    {
+      sc_memory_error("Can't export sc-elements of segment %u", num);
+      g_atomic_int_set(&export->is_failed, SC_TRUE);
+    }
+  }
+
+  sc_mem_free(block.data);
+  // it is called by the exporting thread too, so it doesn't exit thread
+  return null_ptr;
+}
+
+sc_bool sc_storage_export_elements(
+    sc_storage * storage,
+    sc_char const * path,
+    sc_uint32 threads_count,
+    sc_uint64 * exported_count)
+{
+  *exported_count = 0;
+
+  sc_int32 const fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1)
+  {
+    sc_memory_error("Can't open file `%s` to export sc-elements", path);
+    return SC_FALSE;
+  }
+
+  sc_storage_elements_export export = {
+      .storage = storage,
+      .fd = fd,
+      .segments_count = storage->segments_count,
+      .next_segment_num = 1,
+      .offset = sizeof(sc_storage_export_header),
+      .exported_count = 0,
+      .is_failed = SC_FALSE,
+  };
+  sc_mutex_init(&export.mutex);
+
+  sc_storage_export_header const header = {
+      .magic = SC_STORAGE_EXPORT_MAGIC,
+      .version = SC_STORAGE_EXPORT_VERSION,
+      .segments_count = export.segments_count,
+  };
+  sc_bool result = _sc_storage_export_write_at(fd, &header, sizeof(header), 0);
+  if (result)
+  {
+    _sc_storage_export_run_workers(
+        sc_max(1, sc_min(threads_count, export.segments_count)), _sc_storage_export_segments_by_worker, &export);
+    result = export.is_failed == SC_FALSE;
+  }
+
+  // the last empty block marks the end of file, so truncated files aren't imported
+  sc_storage_export_block_header const last_block_header = {0};
+  if (result)
+    result = _sc_storage_export_write_at(fd, &last_block_header, sizeof(last_block_header), export.offset)
+             && fsync(fd) == 0;
+  if (result == SC_FALSE)
+    sc_memory_error("Can't export sc-elements to file `%s`", path);
+
+  close(fd);
+  sc_mutex_destroy(&export.mutex);
+  *exported_count = export.exported_count;
+  return result;
+}
+
+//! Sc-connector waiting until its begin and end sc-elements are imported
+typedef struct
+{
+  sc_addr_hash hash;   // sc-addr hash of sc-connector in file
+  sc_addr_hash begin;  // sc-addr hash of begin sc-element in file
+  sc_addr_hash end;    // sc-addr hash of end sc-element in file
+  sc_type type;
+} sc_storage_import_connector;
+
+typedef struct
+{
+  sc_uint32 count;
+  sc_storage_import_connector connectors[SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE];
+} sc_storage_import_connectors_batch;
+
+typedef struct
+{
+  sc_int32 fd;
+  sc_addr_seg segments_count;
+  sc_addr_hash ** new_hashes;  // new sc-addr hashes of imported sc-elements by numbers of segments and offsets in file
+
+  sc_mutex mutex;     // it protects offset, batches of sc-connectors and count of imported sc-elements
+  sc_uint64 offset;   // offset of the next block in file
+  sc_bool is_finished;
+  sc_storage_import_connectors_batch ** batches;
+  sc_uint32 batches_count;
+  sc_uint32 batches_capacity;
+  sc_uint64 imported_count;
+  sc_uint64 generated_connectors_count;  // count of sc-connectors generated in the current round
+
+  volatile gint next_batch_index;  // index of the next batch of sc-connectors to generate, it is accessed atomically
+  volatile gint is_failed;
+} sc_storage_elements_import;
+
+sc_addr_hash * _sc_storage_import_get_segment_hashes(sc_storage_elements_import * import, sc_addr_seg num)
+{
+  sc_addr_hash * hashes = g_atomic_pointer_get(&import->new_hashes[num - 1]);
+  if (hashes != null_ptr)
+    return hashes;
+
+  // blocks of the same segment are imported by different workers, so only one of them publishes hashes of segment
+  hashes = sc_mem_new(sc_addr_hash, SC_SEGMENT_ELEMENTS_COUNT);
+  if (g_atomic_pointer_compare_and_exchange(&import->new_hashes[num - 1], null_ptr, hashes))
+    return hashes;
+
+  sc_mem_free(hashes);
+  return g_atomic_pointer_get(&import->new_hashes[num - 1]);
+}
+
+sc_addr _sc_storage_import_get_new_addr(sc_storage_elements_import * import, sc_addr_hash hash)
+{
+  sc_addr addr;
+  SC_ADDR_LOCAL_FROM_INT(hash, addr);
+
+  sc_addr new_addr = SC_ADDR_EMPTY;
+  if (addr.seg == 0 || addr.seg > import->segments_count || addr.offset >= SC_SEGMENT_ELEMENTS_COUNT)
+    return new_addr;
+
+  sc_addr_hash * hashes = g_atomic_pointer_get(&import->new_hashes[addr.seg - 1]);
+  if (hashes != null_ptr)
+  {
+    sc_addr_hash const new_hash = g_atomic_int_get(&hashes[addr.offset]);
+    SC_ADDR_LOCAL_FROM_INT(new_hash, new_addr);
+  }
+  return new_addr;
+}
+
+void _sc_storage_import_set_new_addr(sc_storage_elements_import * import, sc_addr_hash hash, sc_addr new_addr)
+{
+  sc_addr addr;
+  SC_ADDR_LOCAL_FROM_INT(hash, addr);
+  g_atomic_int_set(&import->new_hashes[addr.seg - 1][addr.offset], SC_ADDR_LOCAL_TO_INT(new_addr));
+}
+
+sc_bool _sc_storage_import_read(sc_char const ** record, sc_char const * end, void * data, sc_uint32 size)
+{
+  if ((sc_uint64)(end - *record) < size)
+    return SC_FALSE;
+
+  sc_mem_cpy(data, *record, size);
+  *record += size;
+  return SC_TRUE;
+}
+
+void _sc_storage_import_add_batch(sc_storage_elements_import * import, sc_storage_import_connectors_batch * batch)
+{
+  sc_mutex_lock(&import->mutex);
+  if (import->batches_count == import->batches_capacity)
+  {
+    sc_uint32 const capacity = sc_max(import->batches_capacity * 2, 64);
+    sc_storage_import_connectors_batch ** batches = sc_mem_new(sc_storage_import_connectors_batch *, capacity);
+    sc_mem_cpy(batches, import->batches, sizeof(sc_storage_import_connectors_batch *) * import->batches_count);
+    sc_mem_free(import->batches);
+    import->batches = batches;
+    import->batches_capacity = capacity;
+  }
+  import->batches[import->batches_count++] = batch;
+  sc_mutex_unlock(&import->mutex);
+}
+
+/*! Generates sc-nodes and sc-links of block and sets contents of sc-links. Sc-connectors of block are added to batches
+ * of sc-connectors, they are generated after all blocks are imported.
+ * @param import Import of sc-elements
+ * @param header Header of block
+ * @param records Records of block
+ * @param[in, out] batch Batch of sc-connectors filled by worker, it is replaced by a new one when it is full
+ * @param[out] imported_count Count of generated sc-nodes and sc-links is added to it
+ * @returns SC_FALSE, if records are corrupted or sc-memory is full.
+ */
+sc_bool _sc_storage_import_block(
+    sc_storage_elements_import * import,
+    sc_storage_export_block_header const * header,
+    sc_char const * records,
+    sc_storage_import_connectors_batch ** batch,
+    sc_uint64 * imported_count)
+{
+  sc_addr_hash * new_hashes = _sc_storage_import_get_segment_hashes(import, header->segment_num);
+  sc_char const * record = records;
+  sc_char const * end = records + header->size;
+  for (sc_uint32 i = 0; i < header->records_count; ++i)
+  {
+    sc_addr addr = {.seg = header->segment_num};
+    sc_type type;
+    if (!_sc_storage_import_read(&record, end, &addr.offset, sizeof(addr.offset))
+        || !_sc_storage_import_read(&record, end, &type, sizeof(type)) || addr.offset == 0
+        || addr.offset >= SC_SEGMENT_ELEMENTS_COUNT)
+      return SC_FALSE;
+
+    if (sc_type_has_subtype_in_mask(type, sc_type_connector_mask))
+    {
+      sc_storage_import_connector * connector = &(*batch)->connectors[(*batch)->count];
+      connector->hash = SC_ADDR_LOCAL_TO_INT(addr);
+      connector->type = type;
+      if (!_sc_storage_import_read(&record, end, &connector->begin, sizeof(connector->begin))
+          || !_sc_storage_import_read(&record, end, &connector->end, sizeof(connector->end)))
+        return SC_FALSE;
+
+      if (++(*batch)->count == SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE)
+      {
+        _sc_storage_import_add_batch(import, *batch);
+        *batch = sc_mem_new(sc_storage_import_connectors_batch, 1);
+      }
+      continue;
+    }
+
+    sc_uint32 string_size = SC_STORAGE_EXPORT_NO_CONTENT;
+    if (sc_type_has_subtype(type, sc_type_node_link)
+        && !_sc_storage_import_read(&record, end, &string_size, sizeof(string_size)))
+      return SC_FALSE;
+    if (string_size != SC_STORAGE_EXPORT_NO_CONTENT && (sc_uint64)(end - record) < string_size)
+      return SC_FALSE;
+
+    sc_addr new_addr;
+    sc_element * element = sc_storage_allocate_new_element(null_ptr, type, &new_addr);
+    if (element == null_ptr)
+      return SC_FALSE;
+    element->flags.type = type;
+
+    if (string_size != SC_STORAGE_EXPORT_NO_CONTENT)
+    {
+      // strings are divided into terms as null-terminated ones
+      sc_char * string = sc_mem_new(sc_char, string_size + 1);
+      sc_mem_cpy(string, record, string_size);
+      sc_fs_memory_status const status =
+          sc_fs_memory_link_string_ext(SC_ADDR_LOCAL_TO_INT(new_addr), string, string_size, SC_TRUE);
+      sc_mem_free(string);
+      if (status != SC_FS_MEMORY_OK)
+        return SC_FALSE;
+      record += string_size;
+    }
+
+    g_atomic_int_set(&new_hashes[addr.offset], SC_ADDR_LOCAL_TO_INT(new_addr));
+    ++*imported_count;
+  }
+
+  return record == end;
+}
+
+void * _sc_storage_import_blocks_by_worker(void * data)
+{
+  sc_storage_elements_import * import = data;
+
+  sc_char * records = null_ptr;
+  sc_uint32 records_capacity = 0;
+  sc_storage_import_connectors_batch * batch = sc_mem_new(sc_storage_import_connectors_batch, 1);
+  sc_uint64 imported_count = 0;
+
+  while (g_atomic_int_get(&import->is_failed) == SC_FALSE)
+  {
+    // headers of blocks are read one by one, and records of blocks are read by workers in parallel
+    sc_storage_export_block_header header;
+    sc_uint64 records_offset = 0;
+    sc_mutex_lock(&import->mutex);
+    sc_bool is_finished = import->is_finished;
+    sc_bool const is_read =
+        is_finished || _sc_storage_export_read_at(import->fd, &header, sizeof(header), import->offset);
+    if (is_finished == SC_FALSE && is_read)
+    {
+      records_offset = import->offset + sizeof(header);
+      import->offset = records_offset + header.size;
+      if (header.segment_num == 0)
+        import->is_finished = is_finished = SC_TRUE;
+    }
+    sc_mutex_unlock(&import->mutex);
+
+    if (is_finished)
+      break;
+
+    sc_bool result = is_read && header.segment_num <= import->segments_count;
+    if (result && header.size > records_capacity)
+    {
+      sc_mem_free(records);
+      records_capacity = header.size;
+      records = sc_mem_new(sc_char, records_capacity);
+    }
+    if (result)
+      result = _sc_storage_export_read_at(import->fd, records, header.size, records_offset)
+               && sc_fs_memory_checksum(0, records, header.size) == header.checksum;
+    if (result == SC_FALSE)
+      sc_memory_error("Block of sc-elements at offset %" PRIu64 " is corrupted or truncated", records_offset);
+    else if (_sc_storage_import_block(import, &header, records, &batch, &imported_count) == SC_FALSE)
+    {
+      sc_memory_error("Sc-elements of block at offset %" PRIu64 " can't be imported", records_offset);
+      result = SC_FALSE;
+    }
+
+    if (result == SC_FALSE)
+      g_atomic_int_set(&import->is_failed, SC_TRUE);
+  }
+
+  if (batch->count != 0)
+    _sc_storage_import_add_batch(import, batch);
+  else
+    sc_mem_free(batch);
+  sc_mem_free(records);
+
+  sc_mutex_lock(&import->mutex);
+  import->imported_count += imported_count;
+  sc_mutex_unlock(&import->mutex);
+  // it is called by the importing thread too, so it doesn't exit thread
+  return null_ptr;
+}
+
+void * _sc_storage_import_connectors_by_worker(void * data)
+{
+  sc_storage_elements_import * import = data;
+
+  sc_connector_triple triples[SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE];
+  sc_addr_hash hashes[SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE];
+  sc_addr connectors[SC_STORAGE_IMPORT_CONNECTORS_BATCH_SIZE];
+  sc_uint64 generated_count = 0;
+
+  while (g_atomic_int_get(&import->is_failed) == SC_FALSE)
+  {
+    sc_uint32 const index = g_atomic_int_add(&import->next_batch_index, 1);
+    if (index >= import->batches_count)
+      break;
+
+    // sc-connectors are generated only if their begin and end sc-elements are generated, the others wait in batch
+    sc_storage_import_connectors_batch * batch = import->batches[index];
+    sc_uint32 triples_count = 0;
+    sc_uint32 waiting_count = 0;
+    for (sc_uint32 i = 0; i < batch->count; ++i)
+    {
+      sc_storage_import_connector const connector = batch->connectors[i];
+      sc_addr const begin_addr = _sc_storage_import_get_new_addr(import, connector.begin);
+      sc_addr const end_addr = _sc_storage_import_get_new_addr(import, connector.end);
+      if (SC_ADDR_IS_EMPTY(begin_addr) || SC_ADDR_IS_EMPTY(end_addr))
+      {
+        batch->connectors[waiting_count++] = connector;
+        continue;
+      }
+
+      triples[triples_count] = (sc_connector_triple){.type = connector.type, .begin = begin_addr, .end = end_addr};
+      hashes[triples_count++] = connector.hash;
+    }
+
+    batch->count = waiting_count;
+    if (triples_count == 0)
+      continue;
+
+    if (sc_storage_arcs_new_batch(null_ptr, triples_count, triples, connectors, SC_FALSE) != SC_RESULT_OK)
+    {
+      sc_memory_error("Sc-connectors can't be imported");
+      g_atomic_int_set(&import->is_failed, SC_TRUE);
+      break;
+    }
+
+    for (sc_uint32 i = 0; i < triples_count; ++i)
+      _sc_storage_import_set_new_addr(import, hashes[i], connectors[i]);
+    generated_count += triples_count;
+  }
+
+  sc_mutex_lock(&import->mutex);
+  import->generated_connectors_count += generated_count;
+  sc_mutex_unlock(&import->mutex);
+  // it is called by the importing thread too, so it doesn't exit thread
+  return null_ptr;
+}
+
+sc_bool _sc_storage_import_connectors(sc_storage_elements_import * import, sc_uint32 threads_count)
+{
+  // sc-connectors between sc-connectors are generated after their begin and end sc-connectors in the next rounds
+  while (import->batches_count != 0)
+  {
+    import->next_batch_index = 0;
+    import->generated_connectors_count = 0;
+    _sc_storage_export_run_workers(
+        sc_max(1, sc_min(threads_count, import->batches_count)), _sc_storage_import_connectors_by_worker, import);
+    if (import->is_failed)
+      return SC_FALSE;
+
+    import->imported_count += import->generated_connectors_count;
+
+    sc_uint64 waiting_count = 0;
+    sc_uint32 batches_count = 0;
+    for (sc_uint32 i = 0; i < import->batches_count; ++i)
+    {
+      sc_storage_import_connectors_batch * batch = import->batches[i];
+      waiting_count += batch->count;
+      if (batch->count == 0)
+        sc_mem_free(batch);
+      else
+        import->batches[batches_count++] = batch;
+    }
+    import->batches_count = batches_count;
+
+    if (import->generated_connectors_count == 0)
+    {
+      sc_memory_warning(
+          "Sc-connectors with not existing begin or end sc-elements aren't imported: %" PRIu64, waiting_count);
+      break;
+    }
+  }
+
+  return SC_TRUE;
+}
+
+sc_bool sc_storage_import_elements(sc_char const * path, sc_uint32 threads_count, sc_uint64 * imported_count)
+{
+  *imported_count = 0;
+
+  sc_int32 const fd = open(path, O_RDONLY);
+  if (fd == -1)
+  {
+    sc_memory_error("Can't open file `%s` to import sc-elements", path);
+    return SC_FALSE;
+  }
+
+  sc_storage_export_header header;
+  if (_sc_storage_export_read_at(fd, &header, sizeof(header), 0) == SC_FALSE
+      || memcmp(header.magic, SC_STORAGE_EXPORT_MAGIC, sizeof(header.magic)) != 0
+      || header.version != SC_STORAGE_EXPORT_VERSION || header.segments_count > SC_ADDR_SEG_MAX)
+  {
+    sc_memory_error("File `%s` doesn't contain exported sc-elements of supported version", path);
+    close(fd);
+    return SC_FALSE;
+  }
+
+  sc_storage_elements_import import = {
+      .fd = fd,
+      .segments_count = header.segments_count,
+      .new_hashes = sc_mem_new(sc_addr_hash *, sc_max(1, header.segments_count)),
+      .offset = sizeof(header),
+      .is_finished = SC_FALSE,
+      .batches = null_ptr,
+      .batches_count = 0,
+      .batches_capacity = 0,
+      .imported_count = 0,
+      .generated_connectors_count = 0,
+      .next_batch_index = 0,
+      .is_failed = SC_FALSE,
+  };
+  sc_mutex_init(&import.mutex);
+
+  _sc_storage_export_run_workers(sc_max(1, threads_count), _sc_storage_import_blocks_by_worker, &import);
+  sc_bool result = import.is_failed == SC_FALSE;
+  if (result)
+    result = _sc_storage_import_connectors(&import, threads_count);
+  if (result == SC_FALSE)
+    sc_memory_error("Can't import sc-elements from file `%s`", path);
+
+  for (sc_uint32 i = 0; i < import.batches_count; ++i)
+    sc_mem_free(import.batches[i]);
+  sc_mem_free(import.batches);
+  for (sc_addr_seg i = 0; i < import.segments_count; ++i)
+    sc_mem_free(import.new_hashes[i]);
+  sc_mem_free(import.new_hashes);
+  sc_mutex_destroy(&import.mutex);
+  close(fd);
+
+  *imported_count = import.imported_count;
+  return result;
+}
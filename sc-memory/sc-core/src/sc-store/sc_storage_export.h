@@ -0,0 +1,41 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_storage_export_h_
+#define _sc_storage_export_h_
+
+#include "sc-core/sc_types.h"
+
+#include "sc_storage.h"
+
+/*! Exports existing sc-elements of sc-storage with types, begin and end sc-elements of sc-connectors and contents of
+ * sc-links to file of binary format. The format doesn't depend on layout of sc-elements and segments, so it is imported
+ * by sc-machines built with other options. Segments are scanned directly by `threads_count` workers, and every worker
+ * writes blocks of its sc-elements at its own offsets in file.
+ * @param storage Loaded sc-storage
+ * @param path Path to file to export sc-elements to, it is overwritten
+ * @param threads_count Count of threads to scan segments
+ * @param[out] exported_count Count of exported sc-elements
+ * @returns SC_FALSE, if file can't be written or contents of sc-links can't be read.
+ * @note It is called only when no other threads change sc-storage.
+ */
+sc_bool sc_storage_export_elements(
+    sc_storage * storage,
+    sc_char const * path,
+    sc_uint32 threads_count,
+    sc_uint64 * exported_count);
+
+/*! Imports sc-elements exported by `sc_storage_export_elements` to sc-storage. Imported sc-elements get new addresses.
+ * Blocks of file are read and decoded by `threads_count` workers, sc-nodes and sc-links are generated at once, and
+ * sc-connectors are generated after their begin and end sc-elements.
+ * @param path Path to file to import sc-elements from
+ * @param threads_count Count of threads to read blocks of file
+ * @param[out] imported_count Count of imported sc-elements
+ * @returns SC_FALSE, if file can't be read, it is corrupted or sc-memory is full.
+ */
+sc_bool sc_storage_import_elements(sc_char const * path, sc_uint32 threads_count, sc_uint64 * imported_count);
+
+#endif
@@ -8,36 +8,87 @@
 #define _sc_storage_private_h_
 
 #include "sc-store/sc-base/sc_monitor_table.h"
+#include "sc-store/sc-base/sc_thread.h"
+#include "sc-store/sc-base/sc_mutex_private.h"
+
+#include "sc-store/sc-container/sc_hash_table.h"
 
 #include "sc-store/sc-event/sc_event_private.h"
 
+#include "sc-store/sc_segment.h"
 #include "sc-store/sc_storage_dump_manager.h"
 
 #include "sc-store/sc-base/sc_monitor_table_private.h"
 
 struct _sc_storage
 {
-  sc_segment ** segments;
+  sc_segment ** segments;             // table of segments, it is replaced by a bigger copy when it is full
   sc_addr_seg segments_count;
-  sc_addr_seg max_segments_count;
-  sc_addr_seg last_not_engaged_segment_num;
-  sc_addr_seg last_released_segment_num;
+  volatile gint segments_capacity;    // capacity of the published table of segments
+  sc_list * retired_segments_tables;  // replaced tables of segments, they are freed on shutdown only
+  sc_addr_seg last_not_engaged_segment_num[SC_SEGMENT_POOLS_COUNT];
+  sc_addr_seg last_released_segment_num[SC_SEGMENT_POOLS_COUNT];
   sc_monitor segments_monitor;
   sc_monitor_table addr_monitors_table;
-  sc_hash_table * processes_segments_table;
-  sc_monitor processes_monitor;
   sc_storage_dump_manager * dump_manager;
   sc_event_emission_manager * events_emission_manager;
   sc_event_subscription_manager * events_subscription_manager;
 };
 
+#define SC_STORAGE_ALLOCATION_BLOCK_SIZE 64
+#define SC_STORAGE_RELEASED_ADDRS_CACHE_SIZE 128
+
+//! Thread-local cache to allocate and release sc-elements without global locks
+typedef struct _sc_storage_allocation_cache
+{
+  sc_mutex mutex;                                                // Locked by the owner and by draining threads
+  sc_uint32 storage_generation;                                  // Generation of sc-storage the cache belongs to
+  sc_uint8 pool;                                                 // Pool of segments the cache allocates from
+  sc_segment * segment;                                          // Segment where the thread reserves blocks
+  sc_addr_offset next_offset;                                    // Next free offset of the reserved block
+  sc_addr_offset end_offset;                                     // End of the reserved block
+  sc_uint32 released_addrs_count;                                // Count of cached released sc-elements
+  sc_addr released_addrs[SC_STORAGE_RELEASED_ADDRS_CACHE_SIZE];  // Released sc-elements reused first
+} sc_storage_allocation_cache;
+
+//! Allocation caches of a thread for all pools of segments, they are registered in the list of all threads caches
+typedef struct _sc_storage_allocation_caches
+{
+  struct _sc_storage_allocation_caches * prev;                // Previous registered caches
+  struct _sc_storage_allocation_caches * next;                // Next registered caches
+  sc_storage_allocation_cache pools[SC_SEGMENT_POOLS_COUNT];  // Caches of pools of segments
+} sc_storage_allocation_caches;
+
 struct _sc_storage * sc_storage_get();
 
 sc_event_emission_manager * sc_storage_get_event_emission_manager();
 
 sc_event_subscription_manager * sc_storage_get_event_subscription_manager();
 
-sc_element * sc_storage_allocate_new_element(sc_memory_context const * ctx, sc_addr * addr);
+/*! Grows table of segments to store at least specified count of segments.
+ * The new table is published without locks, so readers may use any of the previous tables until sc-storage shutdown.
+ * @param storage Sc-storage which table of segments is grown
+ * @param count Count of segments the table must store
+ * @returns SC_FALSE, if count is more than SC_ADDR_SEG_MAX, otherwise SC_TRUE.
+ * @note Writers of table of segments must be locked by `segments_monitor`.
+ */
+sc_bool sc_storage_reserve_segments(struct _sc_storage * storage, sc_uint32 count);
+
+/*! Restores lists of free sc-elements of segments and lists of segments with free sc-elements from existing
+ * sc-elements.
+ * @param storage Sc-storage to restore lists of
+ * @note It is called on sc-storage initialization only, when no other threads use sc-storage.
+ */
+void sc_storage_restore_free_elements(struct _sc_storage * storage);
+
+/*! Returns sc-elements reserved and released by allocation caches of all threads to their segments. Caches are kept by
+ * threads, so their next allocations reserve new blocks.
+ * @note It is called before sc-memory is saved, so sc-elements held by caches aren't saved as engaged, and when
+ * sc-memory is full. Monitor `segments_monitor` must not be acquired by the calling thread.
+ */
+void sc_storage_drain_allocation_caches();
+
+sc_element * sc_storage_allocate_new_element(sc_memory_context const * ctx, sc_type type, sc_addr * addr);
 
 sc_result sc_storage_get_element_by_addr(sc_addr addr, sc_element ** el);
 
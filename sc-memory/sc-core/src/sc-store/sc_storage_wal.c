@@ -0,0 +1,602 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include "sc_storage_wal.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "sc-core/sc-base/sc_allocator.h"
+#include "sc-core/sc-container/sc_string.h"
+
+#include "sc-store/sc-base/sc_mutex_private.h"
+#include "sc-store/sc-base/sc_condition_private.h"
+
+#include "sc-store/sc-fs-memory/sc_file_system.h"
+
+#include "sc_segment.h"
+#include "sc_storage.h"
+#include "sc_memory_private.h"
+
+#define SC_STORAGE_WAL_MAGIC 0x4C415753  // "SWAL"
+#define SC_STORAGE_WAL_VERSION 1
+#define SC_STORAGE_WAL_FILE_FORMAT "%s/wal_%u.scdb"
+#define SC_STORAGE_WAL_INITIAL_BUFFER_CAPACITY 4096
+// Size of record header: size of record data and kind of record, and size of checksum after record data
+#define SC_STORAGE_WAL_RECORD_HEADER_SIZE (sizeof(sc_uint32) + sizeof(sc_uint8))
+#define SC_STORAGE_WAL_RECORD_CHECKSUM_SIZE sizeof(sc_uint32)
+
+typedef enum
+{
+  SC_STORAGE_WAL_SYNC_COMMIT,
+  SC_STORAGE_WAL_SYNC_PERIODIC,
+  SC_STORAGE_WAL_SYNC_NONE,
+} sc_storage_wal_sync_policy;
+
+//! Header of log file, log files of other layout of sc-elements aren't applied
+typedef struct
+{
+  sc_uint32 magic;
+  sc_uint32 version;
+  sc_uint32 element_sizes[SC_SEGMENT_POOLS_COUNT];
+} sc_storage_wal_header;
+
+typedef struct
+{
+  sc_char const * path;  // repo path, log files are stored in it
+  sc_storage_wal_sync_policy sync_policy;
+  sc_uint32 sync_period;  // period of synchronization of log file in milliseconds, if sync policy is `Periodic`
+
+  sc_int32 fd;         // descriptor of the current log file
+  sc_uint32 number;    // number of the current log file
+  sc_bool is_failed;   // writing to the current log file is failed, records aren't written anymore
+  sc_bool is_synced;   // records written to the current log file are synchronized
+  sc_char * buffer;    // appended records, which aren't written yet
+  sc_uint32 buffer_size;
+  sc_uint32 buffer_capacity;
+  sc_char * flushed_buffer;  // records written by the current flushing thread, its memory is reused by the next flush
+  sc_uint32 flushed_buffer_capacity;
+  sc_uint64 appended_size;  // size of all appended records
+  sc_uint64 written_size;   // size of all written records
+  sc_uint64 synced_size;    // size of all written and synchronized records
+  sc_bool is_flushing;      // one of threads writes records, others wait for it
+  sc_mutex mutex;
+  sc_condition condition;
+
+  sc_bool is_syncing_periodically;  // it is accessed under `mutex` only
+  sc_condition sync_condition;      // it is signaled to stop periodic synchronization
+  pthread_t sync_thread;
+} sc_storage_wal;
+
+sc_uint32 wal_enabled = SC_FALSE;  // it is accessed atomically
+sc_storage_wal * wal = null_ptr;
+
+// FNV-1a hash, it detects torn and corrupted records
+sc_uint32 _sc_storage_wal_checksum(sc_uint32 hash, void const * data, sc_uint32 size)
+{
+  sc_uint8 const * bytes = data;
+  for (sc_uint32 i = 0; i < size; ++i)
+    hash = (hash ^ bytes[i]) * 16777619u;
+  return hash;
+}
+
+sc_uint32 _sc_storage_wal_record_checksum(sc_uint8 kind, void const * data, sc_uint32 size)
+{
+  return _sc_storage_wal_checksum(_sc_storage_wal_checksum(2166136261u, &kind, sizeof(kind)), data, size);
+}
+
+void _sc_storage_wal_get_file_path(sc_uint32 number, sc_char * path)
+{
+  sc_str_printf(path, MAX_PATH_LENGTH, SC_STORAGE_WAL_FILE_FORMAT, wal->path, number);
+}
+
+sc_storage_wal_header _sc_storage_wal_get_header()
+{
+  sc_storage_wal_header header = {.magic = SC_STORAGE_WAL_MAGIC, .version = SC_STORAGE_WAL_VERSION};
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+    header.element_sizes[pool] = SC_SEGMENT_ELEMENT_SIZE(pool);
+  return header;
+}
+
+sc_bool _sc_storage_wal_is_header_compatible(sc_storage_wal_header header)
+{
+  if (header.magic != SC_STORAGE_WAL_MAGIC || header.version != SC_STORAGE_WAL_VERSION)
+    return SC_FALSE;
+
+  for (sc_uint8 pool = 0; pool < SC_SEGMENT_POOLS_COUNT; ++pool)
+  {
+    if (header.element_sizes[pool] != SC_SEGMENT_ELEMENT_SIZE(pool))
+      return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+sc_bool _sc_storage_wal_write(sc_int32 fd, sc_char const * data, sc_uint64 size)
+{
+  while (size != 0)
+  {
+    ssize_t const written_size = write(fd, data, size);
+    if (written_size < 0)
+      return SC_FALSE;
+
+    data += written_size;
+    size -= written_size;
+  }
+
+  return SC_TRUE;
+}
+
+//! Synchronizes repo directory, so created and removed log files are not lost
+void _sc_storage_wal_sync_directory()
+{
+  sc_int32 const fd = open(wal->path, O_RDONLY);
+  if (fd < 0)
+    return;
+
+  fsync(fd);
+  close(fd);
+}
+
+/*! Collects numbers of existing log files in ascending order.
+ * @param[out] count Count of found log files
+ * @returns Numbers of found log files, they must be freed.
+ */
+sc_uint32 * _sc_storage_wal_get_file_numbers(sc_uint32 * count)
+{
+  *count = 0;
+  GDir * directory = g_dir_open(wal->path, 0, null_ptr);
+  if (directory == null_ptr)
+    return null_ptr;
+
+  sc_uint32 capacity = 0;
+  sc_uint32 * numbers = null_ptr;
+
+  sc_char path[MAX_PATH_LENGTH];
+  sc_char name[MAX_PATH_LENGTH];
+  sc_char const * file = g_dir_read_name(directory);
+  while (file != null_ptr)
+  {
+    sc_uint32 number;
+    // name is checked by formatting it back, since `sscanf` doesn't check text after the number
+    if (sscanf(file, "wal_%u", &number) == 1)
+    {
+      sc_str_printf(name, MAX_PATH_LENGTH, "wal_%u.scdb", number);
+      _sc_storage_wal_get_file_path(number, path);
+      if (sc_str_cmp(file, name) && sc_fs_is_file(path))
+      {
+        if (*count == capacity)
+        {
+          capacity = capacity == 0 ? 8 : capacity * 2;
+          sc_uint32 * new_numbers = sc_mem_new(sc_uint32, capacity);
+          if (numbers != null_ptr)
+            sc_mem_cpy(new_numbers, numbers, *count * sizeof(sc_uint32));
+          sc_mem_free(numbers);
+          numbers = new_numbers;
+        }
+
+        sc_uint32 i = (*count)++;
+        for (; i > 0 && numbers[i - 1] > number; --i)
+          numbers[i] = numbers[i - 1];
+        numbers[i] = number;
+      }
+    }
+
+    file = g_dir_read_name(directory);
+  }
+
+  g_dir_close(directory);
+  return numbers;
+}
+
+/*! Applies records of log file until the first torn or corrupted record. Such records are left by crash, when they are
+ * being written, so they were never committed.
+ * @returns SC_FALSE, if log file has incompatible layout or its record can't be applied.
+ */
+sc_bool _sc_storage_wal_redo_file(sc_uint32 number, sc_storage_wal_redo_callback redo, sc_uint32 * redone_count)
+{
+  sc_char path[MAX_PATH_LENGTH];
+  _sc_storage_wal_get_file_path(number, path);
+
+  FILE * file = fopen(path, "rb");
+  if (file == null_ptr)
+  {
+    sc_memory_error("Can't open write-ahead log file `%s`", path);
+    return SC_FALSE;
+  }
+
+  sc_bool result = SC_TRUE;
+  sc_char * data = null_ptr;
+  sc_uint32 data_capacity = 0;
+
+  sc_storage_wal_header header;
+  if (fread(&header, sizeof(header), 1, file) != 1)
+  {
+    // log file is started, but its header isn't written yet
+    sc_memory_warning("Write-ahead log file `%s` is empty", path);
+    goto end;
+  }
+
+  if (_sc_storage_wal_is_header_compatible(header) == SC_FALSE)
+  {
+    sc_memory_error("Write-ahead log file `%s` has incompatible layout of sc-elements", path);
+    result = SC_FALSE;
+    goto end;
+  }
+
+  while (SC_TRUE)
+  {
+    sc_uint32 size;
+    sc_uint8 kind;
+    sc_uint32 checksum;
+    if (fread(&size, sizeof(size), 1, file) != 1 || fread(&kind, sizeof(kind), 1, file) != 1)
+      break;
+
+    if (size > data_capacity)
+    {
+      sc_mem_free(data);
+      data_capacity = size;
+      data = sc_mem_new(sc_char, data_capacity);
+    }
+
+    if ((size != 0 && fread(data, size, 1, file) != 1) || fread(&checksum, sizeof(checksum), 1, file) != 1)
+    {
+      sc_memory_warning("Write-ahead log file `%s` has torn record, it is skipped", path);
+      break;
+    }
+
+    if (checksum != _sc_storage_wal_record_checksum(kind, data, size))
+    {
+      sc_memory_warning("Write-ahead log file `%s` has corrupted record, the rest of file is skipped", path);
+      break;
+    }
+
+    if (redo(kind, data, size) == SC_FALSE)
+    {
+      sc_memory_error("Record of write-ahead log file `%s` can't be applied to sc-memory", path);
+      result = SC_FALSE;
+      break;
+    }
+    ++*redone_count;
+  }
+
+end:
+  sc_mem_free(data);
+  fclose(file);
+  return result;
+}
+
+//! Starts log file with specified number, it must be called under mutex of write-ahead log
+sc_bool _sc_storage_wal_open_file(sc_uint32 number)
+{
+  sc_char path[MAX_PATH_LENGTH];
+  _sc_storage_wal_get_file_path(number, path);
+
+  sc_int32 const fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    sc_memory_error("Can't start write-ahead log file `%s`", path);
+    return SC_FALSE;
+  }
+
+  sc_storage_wal_header const header = _sc_storage_wal_get_header();
+  if (_sc_storage_wal_write(fd, (sc_char const *)&header, sizeof(header)) == SC_FALSE || fsync(fd) != 0)
+  {
+    sc_memory_error("Can't write header of write-ahead log file `%s`", path);
+    close(fd);
+    return SC_FALSE;
+  }
+  _sc_storage_wal_sync_directory();
+
+  wal->fd = fd;
+  wal->number = number;
+  wal->is_failed = SC_FALSE;
+  wal->is_synced = SC_TRUE;
+  return SC_TRUE;
+}
+
+/*! Writes all appended records to log file, and synchronizes it if it is required. It is called under mutex of
+ * write-ahead log by a thread, which isn't flushing. The mutex is released while records are written, so other threads
+ * can append new records meanwhile.
+ */
+void _sc_storage_wal_flush(sc_bool sync)
+{
+  wal->is_flushing = SC_TRUE;
+
+  sc_char * data = wal->buffer;
+  sc_uint32 const data_capacity = wal->buffer_capacity;
+  sc_uint32 const data_size = wal->buffer_size;
+  sc_uint64 const flushed_size = wal->appended_size;
+  wal->buffer = wal->flushed_buffer;
+  wal->buffer_capacity = wal->flushed_buffer_capacity;
+  wal->buffer_size = 0;
+
+  sc_mutex_unlock(&wal->mutex);
+
+  sc_bool is_written = wal->is_failed == SC_FALSE && _sc_storage_wal_write(wal->fd, data, data_size);
+  sc_bool const is_synced = is_written && (sync == SC_FALSE || fsync(wal->fd) == 0);
+
+  sc_mutex_lock(&wal->mutex);
+
+  if (wal->is_failed == SC_FALSE && is_synced == SC_FALSE)
+  {
+    sc_memory_error("Can't write write-ahead log file %u, sc-memory changes aren't logged anymore", wal->number);
+    wal->is_failed = SC_TRUE;
+  }
+
+  // records of failed flush aren't counted as written, so commits waiting for them report failure
+  wal->flushed_buffer = data;
+  wal->flushed_buffer_capacity = data_capacity;
+  if (is_written)
+    wal->written_size = flushed_size;
+  if (sync && is_synced)
+  {
+    wal->synced_size = flushed_size;
+    wal->is_synced = SC_TRUE;
+  }
+  else if (is_written && data_size != 0)
+    wal->is_synced = SC_FALSE;
+  wal->is_flushing = SC_FALSE;
+  sc_cond_broadcast(&wal->condition);
+}
+
+void * _sc_storage_wal_sync_periodically(void * arg)
+{
+  (void)arg;
+
+  sc_mutex_lock(&wal->mutex);
+  while (wal->is_syncing_periodically)
+  {
+    // shutdown wakes the thread up, so it doesn't wait for the end of the period
+    if (sc_cond_wait_for(&wal->sync_condition, &wal->mutex, wal->sync_period))
+      continue;
+
+    while (wal->is_flushing)
+      sc_cond_wait(&wal->condition, &wal->mutex);
+    if (wal->is_failed == SC_FALSE && (wal->written_size != wal->appended_size || wal->is_synced == SC_FALSE))
+      _sc_storage_wal_flush(SC_TRUE);
+  }
+  sc_mutex_unlock(&wal->mutex);
+
+  pthread_exit(null_ptr);
+}
+
+sc_bool sc_storage_wal_initialize(
+    sc_memory_params const * params,
+    sc_storage_wal_redo_callback redo,
+    sc_uint32 * redone_count)
+{
+  *redone_count = 0;
+
+  sc_message("\tWrite-ahead log: %s", params->write_ahead_log ? "On" : "Off");
+
+  wal = sc_mem_new(sc_storage_wal, 1);
+  wal->path = params->storage;
+  wal->fd = -1;
+
+  sc_char const * policy = params->write_ahead_log_sync_policy;
+  if (policy == null_ptr || sc_str_cmp(policy, SC_STORAGE_WAL_SYNC_POLICY_COMMIT))
+    wal->sync_policy = SC_STORAGE_WAL_SYNC_COMMIT;
+  else if (sc_str_cmp(policy, SC_STORAGE_WAL_SYNC_POLICY_PERIODIC))
+    wal->sync_policy = SC_STORAGE_WAL_SYNC_PERIODIC;
+  else if (sc_str_cmp(policy, SC_STORAGE_WAL_SYNC_POLICY_NONE))
+    wal->sync_policy = SC_STORAGE_WAL_SYNC_NONE;
+  else
+  {
+    sc_memory_warning("Unknown sync policy of write-ahead log `%s`, it is synchronized on every commit", policy);
+    wal->sync_policy = SC_STORAGE_WAL_SYNC_COMMIT;
+    policy = SC_STORAGE_WAL_SYNC_POLICY_COMMIT;
+  }
+  wal->sync_period = params->write_ahead_log_sync_period == 0 ? 1 : params->write_ahead_log_sync_period;
+
+  sc_mutex_init(&wal->mutex);
+  sc_cond_init(&wal->condition);
+  sc_cond_init(&wal->sync_condition);
+
+  sc_bool result = SC_TRUE;
+  sc_uint32 count;
+  sc_uint32 * numbers = _sc_storage_wal_get_file_numbers(&count);
+  sc_uint32 const next_number = count == 0 ? 1 : numbers[count - 1] + 1;
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    sc_char path[MAX_PATH_LENGTH];
+    _sc_storage_wal_get_file_path(numbers[i], path);
+    // records of log files are applied before sc-memory is changed, so they don't apply to cleared sc-memory
+    if (params->clear)
+      sc_fs_remove_file(path);
+    else if (result)
+      result = _sc_storage_wal_redo_file(numbers[i], redo, redone_count);
+  }
+  sc_mem_free(numbers);
+
+  // applied log files are removed after the next dump, even if write-ahead log is disabled now
+  if (count != 0 && params->clear == SC_FALSE)
+    wal->number = next_number;
+
+  if (result == SC_FALSE || params->write_ahead_log == SC_FALSE)
+    return result;
+
+  sc_message(
+      "\tWrite-ahead log sync policy: %s (period: %u ms)",
+      wal->sync_policy == SC_STORAGE_WAL_SYNC_COMMIT ? SC_STORAGE_WAL_SYNC_POLICY_COMMIT : policy,
+      wal->sync_period);
+
+  // log files of previous runs are kept until the next dump, so records of them are applied again after a crash
+  if (_sc_storage_wal_open_file(next_number) == SC_FALSE)
+    return SC_FALSE;
+
+  wal->buffer_capacity = SC_STORAGE_WAL_INITIAL_BUFFER_CAPACITY;
+  wal->buffer = sc_mem_new(sc_char, wal->buffer_capacity);
+  wal->flushed_buffer_capacity = SC_STORAGE_WAL_INITIAL_BUFFER_CAPACITY;
+  wal->flushed_buffer = sc_mem_new(sc_char, wal->flushed_buffer_capacity);
+
+  if (wal->sync_policy == SC_STORAGE_WAL_SYNC_PERIODIC)
+  {
+    wal->is_syncing_periodically = SC_TRUE;
+    pthread_create(&wal->sync_thread, null_ptr, _sc_storage_wal_sync_periodically, null_ptr);
+  }
+
+  g_atomic_int_set(&wal_enabled, SC_TRUE);
+  return SC_TRUE;
+}
+
+void sc_storage_wal_shutdown()
+{
+  if (wal == null_ptr)
+    return;
+
+  sc_mutex_lock(&wal->mutex);
+  sc_bool const is_syncing_periodically = wal->is_syncing_periodically;
+  wal->is_syncing_periodically = SC_FALSE;
+  sc_cond_signal(&wal->sync_condition);
+  sc_mutex_unlock(&wal->mutex);
+  if (is_syncing_periodically)
+    pthread_join(wal->sync_thread, null_ptr);
+
+  g_atomic_int_set(&wal_enabled, SC_FALSE);
+
+  if (wal->fd >= 0)
+  {
+    sc_mutex_lock(&wal->mutex);
+    while (wal->is_flushing)
+      sc_cond_wait(&wal->condition, &wal->mutex);
+    _sc_storage_wal_flush(SC_TRUE);
+    sc_mutex_unlock(&wal->mutex);
+
+    close(wal->fd);
+  }
+
+  sc_mem_free(wal->buffer);
+  sc_mem_free(wal->flushed_buffer);
+  sc_mutex_destroy(&wal->mutex);
+  sc_cond_destroy(&wal->condition);
+  sc_cond_destroy(&wal->sync_condition);
+  sc_mem_free(wal);
+  wal = null_ptr;
+}
+
+sc_bool sc_storage_wal_is_enabled()
+{
+  return g_atomic_int_get(&wal_enabled);
+}
+
+void sc_storage_wal_append(sc_uint8 kind, void const * data, sc_uint32 size)
+{
+  if (sc_storage_wal_is_enabled() == SC_FALSE)
+    return;
+
+  sc_uint32 const checksum = _sc_storage_wal_record_checksum(kind, data, size);
+  sc_uint32 const record_size = SC_STORAGE_WAL_RECORD_HEADER_SIZE + size + SC_STORAGE_WAL_RECORD_CHECKSUM_SIZE;
+
+  sc_mutex_lock(&wal->mutex);
+
+  // records aren't written to failed log file, so they aren't kept until a new log file is started
+  if (wal->is_failed)
+  {
+    sc_mutex_unlock(&wal->mutex);
+    return;
+  }
+
+  if (wal->buffer_size + record_size > wal->buffer_capacity)
+  {
+    sc_uint32 capacity = wal->buffer_capacity;
+    while (wal->buffer_size + record_size > capacity)
+      capacity *= 2;
+
+    sc_char * buffer = sc_mem_new(sc_char, capacity);
+    sc_mem_cpy(buffer, wal->buffer, wal->buffer_size);
+    sc_mem_free(wal->buffer);
+    wal->buffer = buffer;
+    wal->buffer_capacity = capacity;
+  }
+
+  sc_char * record = wal->buffer + wal->buffer_size;
+  sc_mem_cpy(record, &size, sizeof(size));
+  sc_mem_cpy(record + sizeof(size), &kind, sizeof(kind));
+  sc_mem_cpy(record + SC_STORAGE_WAL_RECORD_HEADER_SIZE, data, size);
+  sc_mem_cpy(record + SC_STORAGE_WAL_RECORD_HEADER_SIZE + size, &checksum, sizeof(checksum));
+  wal->buffer_size += record_size;
+  wal->appended_size += record_size;
+
+  sc_mutex_unlock(&wal->mutex);
+}
+
+sc_result sc_storage_wal_commit()
+{
+  if (sc_storage_wal_is_enabled() == SC_FALSE)
+    return SC_RESULT_OK;
+
+  sc_bool const sync = wal->sync_policy == SC_STORAGE_WAL_SYNC_COMMIT;
+
+  sc_mutex_lock(&wal->mutex);
+  sc_uint64 const committed_size = wal->appended_size;
+  // records appended by other threads while the current flush is written are written by one of waiting threads
+  while (wal->is_failed == SC_FALSE && (sync ? wal->synced_size : wal->written_size) < committed_size)
+  {
+    if (wal->is_flushing)
+      sc_cond_wait(&wal->condition, &wal->mutex);
+    else
+      _sc_storage_wal_flush(sync);
+  }
+  sc_result const result = (sync ? wal->synced_size : wal->written_size) < committed_size
+                               ? SC_RESULT_ERROR_FILE_MEMORY_IO
+                               : SC_RESULT_OK;
+  sc_mutex_unlock(&wal->mutex);
+
+  return result;
+}
+
+sc_uint32 sc_storage_wal_rotate()
+{
+  if (sc_storage_wal_is_enabled() == SC_FALSE)
+    return wal == null_ptr ? 0 : wal->number;
+
+  sc_mutex_lock(&wal->mutex);
+  while (wal->is_flushing)
+    sc_cond_wait(&wal->condition, &wal->mutex);
+
+  // records written to the previous log file are synchronized, not written ones are written to the new log file
+  sc_int32 const fd = wal->fd;
+  sc_uint32 const number = wal->number;
+  if ((wal->is_failed == SC_FALSE && fsync(fd) != 0) || _sc_storage_wal_open_file(number + 1) == SC_FALSE)
+  {
+    sc_memory_error("Can't start write-ahead log file %u, log files aren't removed after dumps", number + 1);
+    sc_mutex_unlock(&wal->mutex);
+    return 0;
+  }
+  close(fd);
+
+  // records not written to the failed log file are contained by the dump started after the call
+  wal->written_size = wal->appended_size - wal->buffer_size;
+  wal->synced_size = wal->written_size;
+
+  sc_uint32 const new_number = wal->number;
+  sc_mutex_unlock(&wal->mutex);
+
+  return new_number;
+}
+
+void sc_storage_wal_remove_before(sc_uint32 number)
+{
+  if (number == 0 || wal == null_ptr)
+    return;
+
+  sc_uint32 count;
+  sc_uint32 * numbers = _sc_storage_wal_get_file_numbers(&count);
+  for (sc_uint32 i = 0; i < count && numbers[i] < number; ++i)
+  {
+    sc_char path[MAX_PATH_LENGTH];
+    _sc_storage_wal_get_file_path(numbers[i], path);
+    if (sc_fs_remove_file(path) == SC_FALSE)
+      sc_memory_warning("Can't remove write-ahead log file `%s`", path);
+  }
+  sc_mem_free(numbers);
+  _sc_storage_wal_sync_directory();
+}
@@ -0,0 +1,93 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef _sc_storage_wal_h_
+#define _sc_storage_wal_h_
+
+#include "sc-core/sc_types.h"
+#include "sc-core/sc_memory_params.h"
+
+/* Write-ahead log of sc-memory changes. Every change of sc-memory is appended to the log as a record with after-images
+ * of changed sc-elements, so records can be applied to a dump made at any moment before or while they are appended.
+ * Records are appended under monitors of changed sc-elements, thus records of the same sc-element follow in the order
+ * of its changes.
+ *
+ * Records are buffered in memory and written to file when changing function of sc-storage commits them. Commits of
+ * concurrent threads are written and synchronized by one of them at once (group commit). Log files are named
+ * `wal_<number>.scdb`. A new log file is started before every dump of sc-memory, and log files started before it are
+ * removed after the dump is finished. Records of the remaining log files are applied when sc-memory is loaded.
+ */
+
+#define SC_STORAGE_WAL_SYNC_POLICY_COMMIT "Commit"
+#define SC_STORAGE_WAL_SYNC_POLICY_PERIODIC "Periodic"
+#define SC_STORAGE_WAL_SYNC_POLICY_NONE "None"
+
+typedef enum
+{
+  SC_STORAGE_WAL_RECORD_SEGMENT_NEW = 1,    // number and pool of new segment
+  SC_STORAGE_WAL_RECORD_ELEMENTS_NEW,       // sc-addrs and images of generated sc-nodes or sc-links
+  SC_STORAGE_WAL_RECORD_CONNECTOR_NEW,      // sc-addrs and images of generated sc-connector and changed sc-elements
+  SC_STORAGE_WAL_RECORD_CONNECTOR_UNLINK,   // sc-addrs and images of sc-elements changed by erased sc-connector
+  SC_STORAGE_WAL_RECORD_ELEMENTS_ERASE,     // sc-addrs of erased sc-elements
+  SC_STORAGE_WAL_RECORD_SUBTYPE_CHANGE,     // sc-addr and image of sc-element with changed subtype
+  SC_STORAGE_WAL_RECORD_LINK_CONTENT,       // sc-addr of sc-link, searchable flag and content
+  SC_STORAGE_WAL_RECORD_LINK_CONTENT_ERASE  // sc-addr of erased sc-link
+} sc_storage_wal_record_kind;
+
+/*! Applies record of write-ahead log to sc-memory.
+ * @param kind Kind of record
+ * @param data Data of record
+ * @param size Size of data of record
+ * @returns SC_FALSE, if record can't be applied to sc-memory.
+ */
+typedef sc_bool (*sc_storage_wal_redo_callback)(sc_uint8 kind, sc_char const * data, sc_uint32 size);
+
+/*! Configures write-ahead log, applies records of existing log files and starts a new log file. Log files are removed
+ * instead, if sc-memory is cleared.
+ * @param params Sc-memory params with `storage`, `clear` and `write_ahead_log*` options
+ * @param redo Callback to apply records of existing log files
+ * @param[out] redone_count Count of applied records
+ * @returns SC_FALSE, if records of existing log files can't be applied or a new log file can't be started.
+ */
+sc_bool sc_storage_wal_initialize(
+    sc_memory_params const * params,
+    sc_storage_wal_redo_callback redo,
+    sc_uint32 * redone_count);
+
+//! Writes and synchronizes all appended records and closes log file. Log files are kept until the next dump.
+void sc_storage_wal_shutdown();
+
+//! Returns SC_TRUE, if write-ahead log is enabled and its log file is started.
+sc_bool sc_storage_wal_is_enabled();
+
+/*! Appends record to the memory buffer of write-ahead log. It does nothing, if write-ahead log isn't enabled.
+ * @param kind Kind of record
+ * @param data Data of record
+ * @param size Size of data of record
+ * @note Record must be appended under monitors of sc-elements it changes.
+ */
+void sc_storage_wal_append(sc_uint8 kind, void const * data, sc_uint32 size);
+
+/*! Waits until all records appended before the call are written to log file and synchronized, if sync policy is
+ * `Commit`. Concurrent commits are written by one of committing threads.
+ * @returns SC_RESULT_ERROR_FILE_MEMORY_IO, if some of the records can't be written or synchronized. Then changes of
+ * sc-memory aren't logged until a new log file is started by the next dump, which contains these changes.
+ * @note It is called after monitors of sc-elements are released, so other threads aren't blocked by writing.
+ */
+sc_result sc_storage_wal_commit();
+
+/*! Starts a new log file. Records appended before the call are already applied to sc-memory, so a dump started after
+ * the call contains them.
+ * @returns Number of the started log file. If write-ahead log isn't enabled, it is number after applied log files or 0.
+ */
+sc_uint32 sc_storage_wal_rotate();
+
+/*! Removes log files started before specified one.
+ * @param number Number of log file returned by `sc_storage_wal_rotate` before successful dump
+ */
+void sc_storage_wal_remove_before(sc_uint32 number);
+
+#endif
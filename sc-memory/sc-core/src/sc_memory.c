@@ -52,8 +52,6 @@ sc_memory_context * sc_memory_initialize(sc_memory_params const * params, sc_mem
 
   memory = sc_mem_new(sc_memory, 1);
 
-  sc_storage_start_new_process();
-
   _sc_memory_context_manager_initialize(&memory->context_manager, params->user_mode);
 
   if (sc_helper_init(s_memory_default_ctx) != SC_RESULT_OK)
@@ -88,12 +86,10 @@ sc_memory_context * sc_memory_initialize(sc_memory_params const * params, sc_mem
       != SC_RESULT_OK)
     goto error;
 
-  sc_storage_end_new_process();
   sc_memory_info("Successfully initialized");
   return s_memory_default_ctx;
 
 error:
-  sc_storage_end_new_process();
   sc_memory_info("Initialized with errors");
   return null_ptr;
 }
@@ -148,6 +144,63 @@ void sc_memory_shutdown_extensions()
   sc_memory_info("Extensions shutdown");
 }
 
+sc_result sc_memory_verify_storage(sc_memory_params const * params, sc_uint32 * corrupted_count)
+{
+  if (memory != null_ptr)
+  {
+    sc_memory_error("Sc-memory is initialized, so its storage can't be verified");
+    return SC_RESULT_ERROR;
+  }
+
+  sc_memory_info("Verify storage");
+  sc_result const result = sc_storage_verify(params, corrupted_count);
+  sc_memory_info("Storage verified");
+  return result;
+}
+
+sc_result sc_memory_compact_storage(sc_memory_params const * params, sc_uint32 * moved_count)
+{
+  if (memory != null_ptr)
+  {
+    sc_memory_error("Sc-memory is initialized, so its storage can't be compacted");
+    return SC_RESULT_ERROR;
+  }
+
+  sc_memory_info("Compact storage");
+  sc_addr_seg freed_segments_count = 0;
+  sc_result const result = sc_storage_compact(params, moved_count, &freed_segments_count);
+  sc_memory_info("Storage compacted");
+  return result;
+}
+
+sc_result sc_memory_export_storage(sc_memory_params const * params, sc_char const * path, sc_uint64 * exported_count)
+{
+  if (memory != null_ptr)
+  {
+    sc_memory_error("Sc-memory is initialized, so its storage can't be exported");
+    return SC_RESULT_ERROR;
+  }
+
+  sc_memory_info("Export storage to `%s`", path);
+  sc_result const result = sc_storage_export(params, path, exported_count);
+  sc_memory_info("Storage exported");
+  return result;
+}
+
+sc_result sc_memory_import_storage(sc_memory_params const * params, sc_char const * path, sc_uint64 * imported_count)
+{
+  if (memory != null_ptr)
+  {
+    sc_memory_error("Sc-memory is initialized, so sc-elements can't be imported to its storage");
+    return SC_RESULT_ERROR;
+  }
+
+  sc_memory_info("Import storage from `%s`", path);
+  sc_result const result = sc_storage_import(params, path, imported_count);
+  sc_memory_info("Storage imported");
+  return result;
+}
+
 void * sc_memory_get_context_manager()
 {
   return memory->context_manager;
@@ -286,6 +339,27 @@ sc_result sc_memory_element_free(sc_memory_context * ctx, sc_addr addr)
   return sc_storage_element_erase(ctx, addr);
 }
 
+sc_result sc_memory_elements_erase(sc_memory_context * ctx, sc_uint32 count, sc_addr const * addrs)
+{
+  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
+    return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
+
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    if (_sc_memory_context_check_local_and_global_permissions(
+            memory->context_manager, ctx, SC_CONTEXT_PERMISSIONS_ERASE, addrs[i])
+        == SC_FALSE)
+      return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_ERASE_PERMISSIONS;
+
+    if (_sc_memory_context_check_global_permissions_to_erase_permissions(
+            memory->context_manager, ctx, addrs[i], SC_CONTEXT_PERMISSIONS_TO_ERASE_PERMISSIONS)
+        == SC_FALSE)
+      return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_ERASE_PERMISSIONS;
+  }
+
+  return sc_storage_elements_erase(ctx, count, addrs);
+}
+
 sc_addr sc_memory_node_new(sc_memory_context const * ctx, sc_type type)
 {
   sc_result result;
@@ -303,6 +377,18 @@ sc_addr sc_memory_node_new_ext(sc_memory_context const * ctx, sc_type type, sc_r
   return sc_storage_node_new_ext(ctx, type, result);
 }
 
+sc_result sc_memory_nodes_new_batch(sc_memory_context const * ctx, sc_type type, sc_uint32 count, sc_addr * addrs)
+{
+  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
+  {
+    for (sc_uint32 i = 0; i < count; ++i)
+      addrs[i] = SC_ADDR_EMPTY;
+    return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
+  }
+
+  return sc_storage_nodes_new_batch(ctx, type, count, addrs);
+}
+
 sc_addr sc_memory_link_new(sc_memory_context const * ctx)
 {
   return sc_memory_link_new2(ctx, sc_type_const_node_link);
@@ -331,14 +417,8 @@ sc_addr sc_memory_arc_new(sc_memory_context const * ctx, sc_type type, sc_addr b
   return sc_memory_arc_new_ext(ctx, type, beg, end, &result);
 }
 
-sc_addr sc_memory_arc_new_ext(sc_memory_context const * ctx, sc_type type, sc_addr beg, sc_addr end, sc_result * result)
+sc_result _sc_memory_check_arc_new_permissions(sc_memory_context const * ctx, sc_type type, sc_addr beg, sc_addr end)
 {
-  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
-  {
-    *result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
-    return SC_ADDR_EMPTY;
-  }
-
   if (_sc_memory_context_check_if_has_permitted_structure(
           memory->context_manager, ctx, SC_CONTEXT_PERMISSIONS_WRITE, beg)
           == SC_FALSE
@@ -347,30 +427,65 @@ sc_addr sc_memory_arc_new_ext(sc_memory_context const * ctx, sc_type type, sc_ad
     if (_sc_memory_context_check_local_and_global_permissions(
             memory->context_manager, ctx, SC_CONTEXT_PERMISSIONS_WRITE, beg)
         == SC_FALSE)
-    {
-      *result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS;
-      return SC_ADDR_EMPTY;
-    }
+      return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS;
     if (_sc_memory_context_check_local_and_global_permissions(
             memory->context_manager, ctx, SC_CONTEXT_PERMISSIONS_WRITE, end)
         == SC_FALSE)
-    {
-      *result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS;
-      return SC_ADDR_EMPTY;
-    }
+      return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS;
   }
 
   if (_sc_memory_context_check_global_permissions_to_write_permissions(
           memory->context_manager, ctx, beg, type, SC_CONTEXT_PERMISSIONS_TO_WRITE_PERMISSIONS)
       == SC_FALSE)
+    return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_WRITE_PERMISSIONS;
+
+  return SC_RESULT_OK;
+}
+
+sc_addr sc_memory_arc_new_ext(sc_memory_context const * ctx, sc_type type, sc_addr beg, sc_addr end, sc_result * result)
+{
+  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
   {
-    *result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_WRITE_PERMISSIONS;
+    *result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
     return SC_ADDR_EMPTY;
   }
 
+  *result = _sc_memory_check_arc_new_permissions(ctx, type, beg, end);
+  if (*result != SC_RESULT_OK)
+    return SC_ADDR_EMPTY;
+
   return sc_storage_arc_new_ext(ctx, type, beg, end, result);
 }
 
+sc_result sc_memory_arcs_new_batch(
+    sc_memory_context const * ctx,
+    sc_uint32 count,
+    sc_connector_triple const * triples,
+    sc_addr * connectors,
+    sc_bool emit_events)
+{
+  sc_result result = SC_RESULT_OK;
+  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
+  {
+    result = SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
+    goto error;
+  }
+
+  for (sc_uint32 i = 0; i < count; ++i)
+  {
+    result = _sc_memory_check_arc_new_permissions(ctx, triples[i].type, triples[i].begin, triples[i].end);
+    if (result != SC_RESULT_OK)
+      goto error;
+  }
+
+  return sc_storage_arcs_new_batch(ctx, count, triples, connectors, emit_events);
+
+error:
+  for (sc_uint32 i = 0; i < count; ++i)
+    connectors[i] = SC_ADDR_EMPTY;
+  return result;
+}
+
 sc_result sc_memory_get_element_type(sc_memory_context const * ctx, sc_addr addr, sc_type * result)
 {
   if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
@@ -613,6 +728,18 @@ sc_result sc_memory_stat(sc_memory_context const * ctx, sc_stat * stat)
   return sc_storage_get_elements_stat(stat);
 }
 
+sc_result sc_memory_set_connectors_index(sc_memory_context const * ctx, sc_bool is_enabled)
+{
+  if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
+    return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED;
+
+  if (_sc_memory_context_check_global_permissions(memory->context_manager, ctx, SC_CONTEXT_PERMISSIONS_WRITE)
+      == SC_FALSE)
+    return SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS;
+
+  return sc_storage_set_connectors_index(is_enabled);
+}
+
 sc_result sc_memory_save(sc_memory_context const * ctx)
 {
   if (_sc_memory_context_is_authenticated(memory->context_manager, ctx) == SC_FALSE)
@@ -19,11 +19,22 @@ void sc_memory_params_clear(sc_memory_params * params)
   params->enabled_extensions = (sc_char const **)null_ptr;
 
   params->max_loaded_segments = DEFAULT_MAX_LOADED_SEGMENTS;
+  params->segments_huge_pages = DEFAULT_SEGMENTS_HUGE_PAGES;
+  params->segments_numa_policy = DEFAULT_SEGMENTS_NUMA_POLICY;
+  params->segments_memory_limit = DEFAULT_SEGMENTS_MEMORY_LIMIT;  // megabytes
+  params->arcs_index_threshold = DEFAULT_ARCS_INDEX_THRESHOLD;
+  params->connectors_index = DEFAULT_CONNECTORS_INDEX;
   params->limit_max_threads_by_max_physical_cores = DEFAULT_LIMIT_MAX_THREADS_BY_MAX_PHYSICAL_CORES;
   params->max_events_and_agents_threads = DEFAULT_MAX_EVENTS_AND_AGENTS_THREADS;
 
   params->dump_memory = SC_TRUE;
   params->dump_memory_period = DEFAULT_DUMP_MEMORY_PERIOD;  // seconds
+  params->dump_memory_deltas_count = DEFAULT_DUMP_MEMORY_DELTAS_COUNT;
+  params->dump_memory_compression = DEFAULT_DUMP_MEMORY_COMPRESSION;
+  params->skip_corrupted_segments = DEFAULT_SKIP_CORRUPTED_SEGMENTS;
+  params->write_ahead_log = DEFAULT_WRITE_AHEAD_LOG;
+  params->write_ahead_log_sync_policy = DEFAULT_WRITE_AHEAD_LOG_SYNC_POLICY;
+  params->write_ahead_log_sync_period = DEFAULT_WRITE_AHEAD_LOG_SYNC_PERIOD;  // milliseconds
   params->dump_memory_statistics = SC_TRUE;
   params->dump_memory_statistics_period = DEFAULT_DUMP_MEMORY_STATISTICS_PERIOD;  // seconds
 
@@ -40,4 +51,5 @@ void sc_memory_params_clear(sc_memory_params * params)
   params->max_searchable_string_size = DEFAULT_MAX_SEARCHABLE_STRING_SIZE;
   params->term_separators = DEFAULT_TERM_SEPARATORS;
   params->search_by_substring = DEFAULT_SEARCH_BY_SUBSTRING;
+  params->link_contents_index = DEFAULT_LINK_CONTENTS_INDEX;
 }
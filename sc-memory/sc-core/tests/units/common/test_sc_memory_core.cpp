@@ -6,6 +6,9 @@
 
 #include <sc-memory/test/sc_test.hpp>
 
+#include <thread>
+#include <unordered_set>
+
 extern "C"
 {
 #include <sc-core/sc_memory.h>
@@ -101,3 +104,44 @@ TEST_F(ScMemoryTest, sc_event_subscription_invalid)
       sc_event_subscription_with_user_new(context, SC_ADDR_EMPTY, subscription_addr, 0, nullptr, nullptr, nullptr),
       nullptr);
 }
+
+TEST_F(ScMemoryTest, sc_memory_generate_and_erase_nodes_in_threads)
+{
+  sc_memory_context * context = **m_ctx;
+
+  sc_stat stat;
+  EXPECT_EQ(sc_memory_stat(context, &stat), SC_RESULT_OK);
+  sc_uint64 const node_count = stat.node_count;
+
+  static sc_uint32 const threads_count = 8;
+  static sc_uint32 const nodes_count = 5000;
+  std::vector<std::vector<sc_addr_hash>> thread_nodes(threads_count);
+  std::vector<std::thread> threads;
+  for (sc_uint32 i = 0; i < threads_count; ++i)
+    threads.emplace_back(
+        [context, &nodes = thread_nodes[i]]()
+        {
+          for (sc_uint32 j = 0; j < nodes_count; ++j)
+          {
+            sc_addr const node_addr = sc_memory_node_new(context, sc_type_const_node);
+            EXPECT_TRUE(SC_ADDR_IS_NOT_EMPTY(node_addr));
+
+            // released sc-elements must be reused by the next generated ones
+            if (j % 2 == 0)
+              EXPECT_EQ(sc_memory_element_free(context, node_addr), SC_RESULT_OK);
+            else
+              nodes.push_back(SC_ADDR_LOCAL_TO_INT(node_addr));
+          }
+        });
+
+  for (auto & thread : threads)
+    thread.join();
+
+  std::unordered_set<sc_addr_hash> unique_nodes;
+  for (auto const & nodes : thread_nodes)
+    unique_nodes.insert(nodes.cbegin(), nodes.cend());
+  EXPECT_EQ(unique_nodes.size(), threads_count * nodes_count / 2);
+
+  EXPECT_EQ(sc_memory_stat(context, &stat), SC_RESULT_OK);
+  EXPECT_EQ(stat.node_count, node_count + threads_count * nodes_count / 2);
+}
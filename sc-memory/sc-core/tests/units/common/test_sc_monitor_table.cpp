@@ -0,0 +1,149 @@
+/*
+ * This source file is part of an OSTIS project. For the latest info, see http://ostis.net
+ * Distributed under the MIT License
+ * (See accompanying file COPYING.MIT or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <sc-memory/test/sc_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include <sc-store/sc-base/sc_monitor_table_private.h>
+}
+
+TEST(ScMonitorTableTest, sc_monitor_table_get_monitor_for_addr)
+{
+  sc_monitor_table table;
+  _sc_monitor_table_init(&table, 100);
+  EXPECT_EQ(table.size, 128u);
+
+  EXPECT_EQ(sc_monitor_table_get_monitor_for_addr(&table, SC_ADDR_EMPTY), nullptr);
+
+  sc_addr addr;
+  addr.seg = 1;
+  addr.offset = 1;
+  sc_monitor * monitor = sc_monitor_table_get_monitor_for_addr(&table, addr);
+  EXPECT_NE(monitor, nullptr);
+  EXPECT_EQ(sc_monitor_table_get_monitor_for_addr(&table, addr), monitor);
+
+  for (sc_addr_offset offset = 1; offset < 1000; ++offset)
+  {
+    addr.offset = offset;
+    monitor = sc_monitor_table_get_monitor_for_addr(&table, addr);
+    EXPECT_GE(monitor, table.monitors);
+    EXPECT_LT(monitor, table.monitors + table.size);
+  }
+
+  _sc_monitor_table_destroy(&table);
+}
+
+TEST(ScMonitorTableTest, sc_monitor_try_acquire_write_n)
+{
+  sc_monitor_table table;
+  _sc_monitor_table_init(&table, 4);
+
+  sc_monitor * first_monitor = sc_monitor_table_get_monitor_from_table(&table, (sc_pointer)1);
+  sc_monitor * second_monitor = sc_monitor_table_get_monitor_from_table(&table, (sc_pointer)2);
+
+  EXPECT_TRUE(sc_monitor_try_acquire_write_n(3, first_monitor, second_monitor, first_monitor));
+  EXPECT_FALSE(sc_monitor_try_acquire_write(second_monitor));
+  sc_monitor_release_write_n(2, first_monitor, second_monitor);
+
+  sc_monitor_acquire_read(second_monitor);
+  EXPECT_FALSE(sc_monitor_try_acquire_write_n(2, first_monitor, second_monitor));
+  EXPECT_TRUE(sc_monitor_try_acquire_write(first_monitor));
+  sc_monitor_release_write(first_monitor);
+  sc_monitor_release_read(second_monitor);
+
+  _sc_monitor_table_destroy(&table);
+}
+
+TEST(ScMonitorTest, ConcurrentReadersDontStarveWriters)
+{
+  sc_monitor monitor;
+  sc_monitor_init(&monitor);
+
+  size_t const readersCount = 8;
+  size_t const writersCount = 2;
+  size_t const writesCount = 1000;
+
+  // writers change both values together, so readers see them equal
+  sc_uint64 firstValue = 0;
+  sc_uint64 secondValue = 0;
+  std::atomic<sc_uint32> activeReaders{0};
+  std::atomic<sc_uint32> activeWriters{0};
+  std::atomic<sc_uint32> finishedWriters{0};
+  std::atomic<bool> isConsistent{true};
+
+  // readers hold the monitor one after another without pauses, so writers get it only if they are preferred, readers
+  // stop by deadline, so starved writers don't hang the test
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  auto const & Read = [&]()
+  {
+    while (finishedWriters.load() < writersCount && std::chrono::steady_clock::now() < deadline)
+    {
+      sc_monitor_acquire_read(&monitor);
+      ++activeReaders;
+      if (activeWriters.load() != 0 || firstValue != secondValue)
+        isConsistent = false;
+#ifdef SC_ATOMIC_MONITOR
+      if (g_atomic_int_get(&monitor.state) <= 0)
+        isConsistent = false;
+#endif
+      --activeReaders;
+      sc_monitor_release_read(&monitor);
+    }
+  };
+
+  auto const & Write = [&]()
+  {
+    for (size_t i = 0; i < writesCount; ++i)
+    {
+      sc_monitor_acquire_write(&monitor);
+      if (++activeWriters != 1 || activeReaders.load() != 0)
+        isConsistent = false;
+#ifdef SC_ATOMIC_MONITOR
+      if (g_atomic_int_get(&monitor.state) != SC_MONITOR_WRITER_STATE)
+        isConsistent = false;
+#endif
+      ++firstValue;
+      ++secondValue;
+      --activeWriters;
+      sc_monitor_release_write(&monitor);
+    }
+    ++finishedWriters;
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < readersCount; ++i)
+    threads.emplace_back(Read);
+  for (size_t i = 0; i < writersCount; ++i)
+    threads.emplace_back(Write);
+  for (std::thread & thread : threads)
+    thread.join();
+
+  EXPECT_EQ(finishedWriters.load(), writersCount);
+  EXPECT_TRUE(isConsistent.load());
+  EXPECT_EQ(firstValue, writersCount * writesCount);
+  EXPECT_EQ(secondValue, writersCount * writesCount);
+
+  // all readers and writers left the monitor
+#ifdef SC_ATOMIC_MONITOR
+  EXPECT_EQ(monitor.state, 0);
+  EXPECT_EQ(monitor.waiting_writers, 0);
+  EXPECT_EQ(monitor.sleepers, 0);
+  EXPECT_EQ(monitor.ref_count, 0);
+#else
+  EXPECT_EQ(monitor.active_readers, 0u);
+  EXPECT_EQ(monitor.active_writer, 0u);
+  EXPECT_TRUE(sc_queue_empty(&monitor.queue));
+  EXPECT_EQ(monitor.ref_count, 0u);
+#endif
+
+  sc_monitor_destroy(&monitor);
+}
@@ -6,6 +6,8 @@
 
 #include <sc-memory/test/sc_test.hpp>
 
+#include <algorithm>
+
 extern "C"
 {
 #include <sc-core/sc-container/sc_dictionary.h>
@@ -229,3 +231,234 @@ TEST(ScDictionaryTest, sc_dictionary_append_get_by_key_prefix)
 
   EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
 }
+
+TEST(ScDictionaryTest, sc_hashed_dictionary_append_get_by_keys)
+{
+  sc_dictionary * dictionary;
+  EXPECT_TRUE(sc_dictionary_initialize_hashed(&dictionary));
+
+  sc_uint64 const STRINGS_COUNT = 10000;
+  sc_char string[20];
+  for (sc_uint64 hash = 1; hash <= STRINGS_COUNT; ++hash)
+  {
+    sc_uint32 const string_size = snprintf(string, sizeof(string), "%" PRIu64, hash);
+    sc_dictionary_append(dictionary, string, string_size, (sc_addr_hash_to_sc_pointer)hash);
+  }
+
+  for (sc_uint64 hash = 1; hash <= STRINGS_COUNT; ++hash)
+  {
+    sc_uint32 const string_size = snprintf(string, sizeof(string), "%" PRIu64, hash);
+    EXPECT_TRUE(sc_dictionary_has(dictionary, string, string_size));
+    EXPECT_EQ((sc_uint64)sc_dictionary_get_by_key(dictionary, string, string_size), hash);
+  }
+
+  sc_char string1[] = "string1";
+  sc_uint32 string1_size = sc_str_len(string1);
+  EXPECT_FALSE(sc_dictionary_has(dictionary, string1, string1_size));
+  EXPECT_EQ(sc_dictionary_get_by_key(dictionary, string1, string1_size), nullptr);
+
+  sc_dictionary_append(dictionary, "1", 1, (sc_addr_hash_to_sc_pointer)216);
+  EXPECT_EQ((sc_pointer_to_sc_addr_hash)sc_dictionary_get_by_key(dictionary, "1", 1), 216u);
+
+  sc_uint64 strings_count;
+  sc_uint64 memory_size;
+  sc_dictionary_get_memory_size(dictionary, &strings_count, &memory_size);
+  EXPECT_EQ(strings_count, STRINGS_COUNT);
+  EXPECT_GT(memory_size, 0u);
+
+  EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
+}
+
+TEST(ScDictionaryTest, sc_hashed_dictionary_append_get_by_key_prefix)
+{
+  sc_dictionary * dictionary;
+  EXPECT_TRUE(sc_dictionary_initialize_hashed(&dictionary));
+
+  sc_addr_hash hash1 = 1;
+  sc_char string1[] = "string1";
+  sc_dictionary_append(dictionary, string1, sc_str_len(string1), (sc_addr_hash_to_sc_pointer)hash1);
+
+  sc_addr_hash hash2 = 2;
+  sc_char string2[] = "string2";
+  sc_dictionary_append(dictionary, string2, sc_str_len(string2), (sc_addr_hash_to_sc_pointer)hash2);
+
+  sc_addr_hash hash3 = 3;
+  sc_char string3[] = "str_to_int";
+  sc_dictionary_append(dictionary, string3, sc_str_len(string3), (sc_addr_hash_to_sc_pointer)hash3);
+
+  sc_char search_string1[] = "str";
+  sc_list * hashes;
+  sc_list_init(&hashes);
+  sc_dictionary_get_by_key_prefix(
+      dictionary, search_string1, sc_str_len(search_string1), _test_visit_nodes_by_key_prefix, (void **)&hashes);
+  EXPECT_EQ(hashes->size, 3u);
+  sc_list_destroy(hashes);
+
+  sc_char search_string2[] = "stri";
+  sc_list_init(&hashes);
+  sc_dictionary_get_by_key_prefix(
+      dictionary, search_string2, sc_str_len(search_string2), _test_visit_nodes_by_key_prefix, (void **)&hashes);
+  EXPECT_EQ(hashes->size, 2u);
+
+  EXPECT_TRUE(sc_list_remove_if(hashes, (sc_addr_hash_to_sc_pointer)hash1, _test_sc_hashes_compare));
+  EXPECT_TRUE(sc_list_remove_if(hashes, (sc_addr_hash_to_sc_pointer)hash2, _test_sc_hashes_compare));
+  EXPECT_EQ(hashes->size, 0u);
+  sc_list_destroy(hashes);
+
+  sc_list_init(&hashes);
+  sc_dictionary_visit_down_nodes(dictionary, _test_visit_nodes_by_key_prefix, (void **)&hashes);
+  EXPECT_EQ(hashes->size, 3u);
+  sc_list_destroy(hashes);
+
+  EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
+}
+
+TEST(ScDictionaryTest, sc_art_dictionary_append_get_by_keys)
+{
+  sc_dictionary * dictionary;
+  EXPECT_TRUE(sc_dictionary_initialize_art(&dictionary));
+
+  // strings of numbers and strings with all bytes make nodes of all sizes
+  sc_uint64 const STRINGS_COUNT = 10000;
+  sc_char string[20];
+  for (sc_uint64 hash = 1; hash <= STRINGS_COUNT; ++hash)
+  {
+    sc_uint32 const string_size = snprintf(string, sizeof(string), "%" PRIu64, hash);
+    sc_dictionary_append(dictionary, string, string_size, (sc_addr_hash_to_sc_pointer)hash);
+  }
+  for (sc_uint64 byte = 1; byte <= 255; ++byte)
+  {
+    sc_char const byte_string[] = {'b', (sc_char)byte};
+    sc_dictionary_append(dictionary, byte_string, 2, (sc_addr_hash_to_sc_pointer)(STRINGS_COUNT + byte));
+  }
+
+  for (sc_uint64 hash = 1; hash <= STRINGS_COUNT; ++hash)
+  {
+    sc_uint32 const string_size = snprintf(string, sizeof(string), "%" PRIu64, hash);
+    EXPECT_TRUE(sc_dictionary_has(dictionary, string, string_size));
+    EXPECT_EQ((sc_uint64)sc_dictionary_get_by_key(dictionary, string, string_size), hash);
+  }
+  for (sc_uint64 byte = 1; byte <= 255; ++byte)
+  {
+    sc_char const byte_string[] = {'b', (sc_char)byte};
+    EXPECT_EQ((sc_uint64)sc_dictionary_get_by_key(dictionary, byte_string, 2), STRINGS_COUNT + byte);
+  }
+
+  sc_char string1[] = "string1";
+  sc_uint32 string1_size = sc_str_len(string1);
+  EXPECT_FALSE(sc_dictionary_has(dictionary, string1, string1_size));
+  EXPECT_EQ(sc_dictionary_get_by_key(dictionary, string1, string1_size), nullptr);
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "b", 1));
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "100000", 6));
+
+  sc_dictionary_append(dictionary, "1", 1, (sc_addr_hash_to_sc_pointer)216);
+  EXPECT_EQ((sc_pointer_to_sc_addr_hash)sc_dictionary_get_by_key(dictionary, "1", 1), 216u);
+
+  sc_uint64 strings_count;
+  sc_uint64 memory_size;
+  sc_dictionary_get_memory_size(dictionary, &strings_count, &memory_size);
+  EXPECT_EQ(strings_count, STRINGS_COUNT + 255);
+  EXPECT_GT(memory_size, 0u);
+
+  EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
+}
+
+sc_bool _test_visit_nodes_strings(sc_dictionary_node * node, void ** arguments)
+{
+  auto * strings = (std::vector<std::string> *)arguments;
+  strings->emplace_back(node->offset, node->offset_size);
+  return SC_TRUE;
+}
+
+TEST(ScDictionaryTest, sc_art_dictionary_append_get_by_key_prefix)
+{
+  sc_dictionary * dictionary;
+  EXPECT_TRUE(sc_dictionary_initialize_art(&dictionary));
+
+  // strings have common prefixes longer than prefixes stored in nodes, and some strings are prefixes of others
+  std::vector<std::string> const strings = {
+      "string_with_long_prefix_2",
+      "string_with_long_prefix_1",
+      "string_with_long_prefix",
+      "string1",
+      "str_to_int",
+      "str",
+      "",
+  };
+  for (size_t i = 0; i < strings.size(); ++i)
+    sc_dictionary_append(dictionary, strings[i].c_str(), strings[i].size(), (sc_addr_hash_to_sc_pointer)(i + 1));
+
+  for (size_t i = 0; i < strings.size(); ++i)
+    EXPECT_EQ((size_t)sc_dictionary_get_by_key(dictionary, strings[i].c_str(), strings[i].size()), i + 1);
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "string_with_long", 16));
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "string_with_short_prefix", 24));
+
+  std::vector<std::string> found_strings;
+  sc_dictionary_get_by_key_prefix(dictionary, "str", 3, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_EQ(found_strings.size(), 6u);
+
+  found_strings.clear();
+  sc_dictionary_get_by_key_prefix(dictionary, "stri", 4, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_EQ(found_strings.size(), 4u);
+
+  found_strings.clear();
+  sc_dictionary_get_by_key_prefix(
+      dictionary, "string_with_long_prefix_", 24, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_EQ(found_strings, (std::vector<std::string>{"string_with_long_prefix_1", "string_with_long_prefix_2"}));
+
+  found_strings.clear();
+  sc_dictionary_get_by_key_prefix(
+      dictionary, "string_with_lung", 16, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_TRUE(found_strings.empty());
+
+  // strings are visited in lexicographical order
+  found_strings.clear();
+  sc_dictionary_visit_down_nodes(dictionary, _test_visit_nodes_strings, (void **)&found_strings);
+  std::vector<std::string> sorted_strings = strings;
+  std::sort(sorted_strings.begin(), sorted_strings.end());
+  EXPECT_EQ(found_strings, sorted_strings);
+
+  EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
+}
+
+TEST(ScDictionaryTest, sc_art_dictionary_append_get_by_keys_with_zero_bytes)
+{
+  sc_dictionary * dictionary;
+  EXPECT_TRUE(sc_dictionary_initialize_art(&dictionary));
+
+  // zero bytes end strings in tree, so strings with zero bytes and escape bytes must not be mixed with their prefixes
+  std::vector<std::string> const strings = {
+      "a",
+      std::string("a\0", 2),
+      std::string("a\0b", 3),
+      std::string("a\1", 2),
+      std::string("a\1\2", 3),
+      std::string("\0", 1),
+      "ab",
+      "",
+  };
+  for (size_t i = 0; i < strings.size(); ++i)
+    sc_dictionary_append(dictionary, strings[i].c_str(), strings[i].size(), (sc_addr_hash_to_sc_pointer)(i + 1));
+
+  for (size_t i = 0; i < strings.size(); ++i)
+    EXPECT_EQ((size_t)sc_dictionary_get_by_key(dictionary, strings[i].c_str(), strings[i].size()), i + 1);
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "a\0\0", 3));
+  EXPECT_FALSE(sc_dictionary_has(dictionary, "a\1\1", 3));
+
+  std::vector<std::string> found_strings;
+  sc_dictionary_get_by_key_prefix(dictionary, "a\0", 2, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_EQ(found_strings, (std::vector<std::string>{std::string("a\0", 2), std::string("a\0b", 3)}));
+
+  found_strings.clear();
+  sc_dictionary_get_by_key_prefix(dictionary, "a", 1, _test_visit_nodes_strings, (void **)&found_strings);
+  EXPECT_EQ(found_strings.size(), 6u);
+
+  // strings are visited as they are appended and in lexicographical order
+  found_strings.clear();
+  sc_dictionary_visit_down_nodes(dictionary, _test_visit_nodes_strings, (void **)&found_strings);
+  std::vector<std::string> sorted_strings = strings;
+  std::sort(sorted_strings.begin(), sorted_strings.end());
+  EXPECT_EQ(found_strings, sorted_strings);
+
+  EXPECT_TRUE(_test_sc_uchar_dictionary_destroy(dictionary));
+}
@@ -6,11 +6,16 @@
 
 #include "sc_dictionary_fs_memory_test.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 extern "C"
 {
 #include <sc-core/sc-base/sc_allocator.h>
 #include <sc-core/sc-container/sc_list.h>
 #include <sc-core/sc-container/sc_string.h>
+#include <sc-core/sc_stream.h>
 
 #include <sc-store/sc-fs-memory/sc_dictionary_fs_memory.h>
 #include <sc-store/sc-fs-memory/sc_dictionary_fs_memory_private.h>
@@ -177,6 +182,43 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_string_by_link_hash
   EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
 }
 
+TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_stream_by_link_hash)
+{
+  sc_dictionary_fs_memory * memory;
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize(&memory, SC_DICTIONARY_FS_MEMORY_PATH), SC_FS_MEMORY_OK);
+
+  {
+    sc_char string1[] = TEXT_EXAMPLE_1;
+    sc_addr_hash hash1 = 112;
+    EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash1, string1, sc_str_len(string1)), SC_FS_MEMORY_OK);
+
+    sc_char string2[] = "";
+    sc_addr_hash hash2 = 518;
+    EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash2, string2, sc_str_len(string2)), SC_FS_MEMORY_OK);
+
+    sc_stream * stream;
+    sc_char * found_string;
+    sc_uint32 size;
+    EXPECT_EQ(sc_dictionary_fs_memory_get_stream_by_link_hash(memory, hash1, &stream), SC_FS_MEMORY_OK);
+    EXPECT_TRUE(sc_stream_get_data(stream, &found_string, &size));
+    EXPECT_EQ(size, sc_str_len(string1));
+    EXPECT_TRUE(sc_str_cmp(found_string, string1));
+    sc_mem_free(found_string);
+    sc_stream_free(stream);
+
+    EXPECT_EQ(sc_dictionary_fs_memory_get_stream_by_link_hash(memory, hash2, &stream), SC_FS_MEMORY_OK);
+    EXPECT_TRUE(sc_stream_get_data(stream, &found_string, &size));
+    EXPECT_EQ(size, 0u);
+    sc_stream_free(stream);
+
+    EXPECT_EQ(sc_dictionary_fs_memory_unlink_string(memory, hash1), SC_FS_MEMORY_OK);
+    EXPECT_EQ(sc_dictionary_fs_memory_get_stream_by_link_hash(memory, hash1, &stream), SC_FS_MEMORY_NO_STRING);
+    EXPECT_EQ(stream, null_ptr);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+}
+
 TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_string_by_link_hash_invalid_data)
 {
   sc_dictionary_fs_memory * memory;
@@ -950,6 +992,158 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_link_hashes_by_subs
   EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
 }
 
+TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_link_hashes_by_string_with_hashed_index)
+{
+  sc_dictionary_fs_memory * memory;
+  sc_memory_params * params = _sc_dictionary_fs_memory_get_default_params(SC_DICTIONARY_FS_MEMORY_PATH, SC_FALSE);
+  params->link_contents_index = "Hash";
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, params), SC_FS_MEMORY_OK);
+
+  sc_char string1[] = TEXT_EXAMPLE_1;
+  sc_addr_hash hash1 = 112;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash1, string1, sc_str_len(string1)), SC_FS_MEMORY_OK);
+
+  sc_char string2[] = TEXT_EXAMPLE_2;
+  sc_addr_hash hash2 = 518;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash2, string2, sc_str_len(string2)), SC_FS_MEMORY_OK);
+
+  {
+    sc_list * found_link_hashes;
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string1, sc_str_len(string1), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash1);
+    sc_list_destroy(found_link_hashes);
+
+    sc_char substring[] = "the sec";
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_substring(
+            memory, substring, sc_str_len(substring), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash2);
+    sc_list_destroy(found_link_hashes);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_unlink_string(memory, hash1), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_save(memory), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, params), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_load(memory), SC_FS_MEMORY_OK);
+  sc_mem_free(params);
+
+  {
+    sc_list * found_link_hashes;
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string1, sc_str_len(string1), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 0u);
+    sc_list_destroy(found_link_hashes);
+
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string2, sc_str_len(string2), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash2);
+    sc_list_destroy(found_link_hashes);
+
+    sc_char * found_string;
+    sc_uint64 found_string_size;
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_string_by_link_hash(memory, hash2, &found_string, &found_string_size),
+        SC_FS_MEMORY_OK);
+    EXPECT_TRUE(sc_str_cmp(found_string, string2));
+    sc_mem_free(found_string);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+}
+
+TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_link_hashes_by_string_with_art_index)
+{
+  sc_dictionary_fs_memory * memory;
+  sc_memory_params * params = _sc_dictionary_fs_memory_get_default_params(SC_DICTIONARY_FS_MEMORY_PATH, SC_FALSE);
+  params->link_contents_index = "ART";
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, params), SC_FS_MEMORY_OK);
+
+  sc_char string1[] = TEXT_EXAMPLE_1;
+  sc_addr_hash hash1 = 112;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash1, string1, sc_str_len(string1)), SC_FS_MEMORY_OK);
+
+  sc_char string2[] = TEXT_EXAMPLE_2;
+  sc_addr_hash hash2 = 518;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash2, string2, sc_str_len(string2)), SC_FS_MEMORY_OK);
+
+  {
+    sc_list * found_link_hashes;
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string1, sc_str_len(string1), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash1);
+    sc_list_destroy(found_link_hashes);
+
+    sc_char substring[] = "the sec";
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_substring(
+            memory, substring, sc_str_len(substring), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash2);
+    sc_list_destroy(found_link_hashes);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_unlink_string(memory, hash1), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_save(memory), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, params), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_load(memory), SC_FS_MEMORY_OK);
+  sc_mem_free(params);
+
+  {
+    sc_list * found_link_hashes;
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string1, sc_str_len(string1), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 0u);
+    sc_list_destroy(found_link_hashes);
+
+    sc_list_init(&found_link_hashes);
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_link_hashes_by_string(
+            memory, string2, sc_str_len(string2), found_link_hashes, _test_push_link_hash),
+        SC_FS_MEMORY_OK);
+    EXPECT_EQ(found_link_hashes->size, 1u);
+    EXPECT_EQ((sc_pointer_to_sc_addr_hash)found_link_hashes->begin->data, hash2);
+    sc_list_destroy(found_link_hashes);
+
+    sc_char * found_string;
+    sc_uint64 found_string_size;
+    EXPECT_EQ(
+        sc_dictionary_fs_memory_get_string_by_link_hash(memory, hash2, &found_string, &found_string_size),
+        SC_FS_MEMORY_OK);
+    EXPECT_TRUE(sc_str_cmp(found_string, string2));
+    sc_mem_free(found_string);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+}
+
 void _test_push_link_content(void * data, sc_addr const, sc_char const * link_content)
 {
   sc_uint32 const size = sc_str_len(link_content);
@@ -1025,6 +1219,86 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_strings_by_substrin
   EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
 }
 
+sc_uint32 _test_get_link_hashes_count_by_substring(
+    sc_dictionary_fs_memory * memory,
+    sc_char const * substring,
+    sc_uint32 max_length_to_search_as_prefix)
+{
+  sc_list * found_link_hashes;
+  sc_list_init(&found_link_hashes);
+  EXPECT_EQ(
+      sc_dictionary_fs_memory_get_link_hashes_by_substring_ext(
+          memory,
+          substring,
+          sc_str_len(substring),
+          max_length_to_search_as_prefix,
+          found_link_hashes,
+          _test_push_link_hash),
+      SC_FS_MEMORY_OK);
+  sc_uint32 const count = found_link_hashes->size;
+  sc_list_destroy(found_link_hashes);
+  return count;
+}
+
+TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_link_hashes_by_substring_inside_terms)
+{
+  sc_dictionary_fs_memory * memory;
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize(&memory, SC_DICTIONARY_FS_MEMORY_PATH), SC_FS_MEMORY_OK);
+
+  sc_char string1[] = "paragraph of text";
+  sc_addr_hash hash1 = 112;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash1, string1, sc_str_len(string1)), SC_FS_MEMORY_OK);
+
+  sc_char string2[] = "graph theory";
+  sc_addr_hash hash2 = 518;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash2, string2, sc_str_len(string2)), SC_FS_MEMORY_OK);
+
+  sc_char string3[] = "aaaaaa";
+  sc_addr_hash hash3 = 724;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash3, string3, sc_str_len(string3)), SC_FS_MEMORY_OK);
+
+  // substrings are found in any place of terms and across terms
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "graph", 0), 2u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "ragra", 0), 1u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "aph th", 0), 1u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "of tex", 0), 1u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "graphite", 0), 0u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "aaaa", 0), 1u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "aaaaaaa", 0), 0u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "graph", 5), 1u);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_unlink_string(memory, hash1), SC_FS_MEMORY_OK);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "graph", 0), 1u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "ragra", 0), 0u);
+
+  sc_addr_hash hash4 = 1024;
+  EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash4, string1, sc_str_len(string1)), SC_FS_MEMORY_OK);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "ragra", 0), 1u);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_save(memory), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize(&memory, SC_DICTIONARY_FS_MEMORY_PATH), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_dictionary_fs_memory_load(memory), SC_FS_MEMORY_OK);
+
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "graph", 0), 2u);
+  EXPECT_EQ(_test_get_link_hashes_count_by_substring(memory, "aph th", 0), 1u);
+
+  sc_list * found_strings;
+  sc_list_init(&found_strings);
+  sc_char substring[] = "ragra";
+  EXPECT_EQ(
+      sc_dictionary_fs_memory_get_strings_by_substring(
+          memory, substring, sc_str_len(substring), found_strings, _test_push_link_content),
+      SC_FS_MEMORY_OK);
+  EXPECT_EQ(found_strings->size, 1u);
+  EXPECT_TRUE(sc_str_cmp((sc_char *)found_strings->begin->data, string1));
+  sc_list_clear(found_strings);
+  sc_list_destroy(found_strings);
+
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+}
+
 TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_link_unlink_strings)
 {
   sc_dictionary_fs_memory * memory;
@@ -1382,6 +1656,7 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_mutiple_link_strings)
   params.max_strings_channel_size = DEFAULT_MAX_STRINGS_CHANNEL_SIZE;
   params.max_searchable_string_size = DEFAULT_MAX_SEARCHABLE_STRING_SIZE;
   params.term_separators = DEFAULT_TERM_SEPARATORS;
+  params.link_contents_index = DEFAULT_LINK_CONTENTS_INDEX;
 
   sc_dictionary_fs_memory * memory;
   EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, &params), SC_FS_MEMORY_OK);
@@ -1413,6 +1688,61 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_mutiple_link_strings)
   EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
 }
 
+TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_get_string_by_link_hash_while_linking_strings)
+{
+  sc_dictionary_fs_memory * memory;
+  EXPECT_EQ(sc_dictionary_fs_memory_initialize(&memory, SC_DICTIONARY_FS_MEMORY_PATH), SC_FS_MEMORY_OK);
+
+  {
+    sc_char const string_template[] = "This is string number %" PRIu64;
+    sc_uint64 const STRING_COUNT = 2000;
+    sc_uint32 const READERS_COUNT = 4;
+
+    std::atomic<sc_uint64> linked_count{0};
+    std::atomic<sc_uint64> invalid_count{0};
+
+    std::vector<std::thread> readers;
+    for (sc_uint32 i = 0; i < READERS_COUNT; ++i)
+      readers.emplace_back(
+          [&]()
+          {
+            sc_char expected_string[50];
+            while (linked_count.load() < STRING_COUNT)
+            {
+              sc_uint64 const count = linked_count.load();
+              for (sc_uint64 hash = 0; hash < count; ++hash)
+              {
+                snprintf(expected_string, 50, string_template, hash);
+
+                sc_char * found_string = nullptr;
+                sc_uint64 size;
+                if (sc_dictionary_fs_memory_get_string_by_link_hash(memory, hash, &found_string, &size)
+                        != SC_FS_MEMORY_OK
+                    || !sc_str_cmp(found_string, expected_string))
+                  ++invalid_count;
+                sc_mem_free(found_string);
+              }
+            }
+          });
+
+    sc_char string[50];
+    for (sc_uint64 hash = 0; hash < STRING_COUNT; ++hash)
+    {
+      snprintf(string, 50, string_template, hash);
+
+      EXPECT_EQ(sc_dictionary_fs_memory_link_string(memory, hash, string, sc_str_len(string)), SC_FS_MEMORY_OK);
+      ++linked_count;
+    }
+
+    for (auto & reader : readers)
+      reader.join();
+
+    EXPECT_EQ(invalid_count.load(), 0u);
+  }
+
+  EXPECT_EQ(sc_dictionary_fs_memory_shutdown(memory), SC_FS_MEMORY_OK);
+}
+
 TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_mutiple_link_strings_with_optimized_config)
 {
   sc_memory_params params;
@@ -1422,6 +1752,7 @@ TEST_F(ScDictionaryFSMemoryTest, sc_dictionary_fs_memory_mutiple_link_strings_wi
   params.max_strings_channel_size = DEFAULT_MAX_STRINGS_CHANNEL_SIZE;
   params.max_searchable_string_size = DEFAULT_MAX_SEARCHABLE_STRING_SIZE;
   params.term_separators = "";
+  params.link_contents_index = DEFAULT_LINK_CONTENTS_INDEX;
 
   sc_dictionary_fs_memory * memory;
   EXPECT_EQ(sc_dictionary_fs_memory_initialize_ext(&memory, &params), SC_FS_MEMORY_OK);
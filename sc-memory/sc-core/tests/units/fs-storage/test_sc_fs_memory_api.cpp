@@ -8,15 +8,22 @@
 
 extern "C"
 {
+#include <sc-core/sc_platform.h>
 #include <sc-core/sc-container/sc_string.h>
 
 #include <sc-store/sc-fs-memory/sc_file_system.h>
 #include <sc-store/sc-fs-memory/sc_fs_memory.h>
+#include <sc-store/sc-fs-memory/sc_fs_memory_header.h>
 #include <sc-store/sc-fs-memory/sc_io.h>
 #include <sc-store/sc_segment.h>
+#include <sc-store/sc_segment_pager.h>
 #include <sc-store/sc_storage_private.h>
 }
 
+#if SC_IS_PLATFORM_LINUX
+#  include <sys/mman.h>
+#endif
+
 TEST_F(ScFSMemoryTest, sc_fs_memory_initialize_shutdown)
 {
   EXPECT_EQ(sc_fs_memory_initialize(SC_FS_MEMORY_PATH, SC_FALSE), SC_FS_MEMORY_OK);
@@ -50,18 +57,177 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
 
   EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
   EXPECT_EQ(storage->segments_count, 0u);
 
   storage->segments_count = 2;
-  storage->segments[0] = sc_segment_new(0);
-  storage->segments[1] = sc_segment_new(1);
+  storage->segments[0] = sc_segment_new(0, SC_SEGMENT_POOL_NODES);
+  storage->segments[1] = sc_segment_new(1, SC_SEGMENT_POOL_NODES);
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_segments_elements)
+{
+  EXPECT_EQ(sc_fs_memory_initialize(SC_FS_MEMORY_PATH, SC_TRUE), SC_FS_MEMORY_OK);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
+
+  storage->segments_count = 2;
+  storage->segments[0] = sc_segment_new(1, SC_SEGMENT_POOL_NODES);
+  storage->segments[1] = sc_segment_new(2, SC_SEGMENT_POOL_NODES);
+  for (sc_addr_seg i = 0; i < storage->segments_count; ++i)
+  {
+    sc_segment * segment = storage->segments[i];
+    segment->last_engaged_offset = SC_SEGMENT_ELEMENTS_COUNT - 1 - i;
+    segment->last_released_offset = i + 1;
+    sc_segment_get_element(segment, 1)->flags.type = sc_type_const_node;
+    sc_segment_get_element(segment, SC_SEGMENT_ELEMENTS_COUNT - 1)->flags.type = sc_type_node_class;
+  }
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+  storage->segments_count = 0;
+
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(storage->segments_count, 2u);
+  for (sc_addr_seg i = 0; i < storage->segments_count; ++i)
+  {
+    sc_segment * segment = storage->segments[i];
+    EXPECT_EQ(segment->num, i + 1u);
+    EXPECT_EQ(segment->pool, SC_SEGMENT_POOL_NODES);
+    EXPECT_EQ(segment->last_engaged_offset, SC_SEGMENT_ELEMENTS_COUNT - 1u - i);
+    EXPECT_EQ(segment->last_released_offset, i + 1u);
+    EXPECT_EQ(sc_segment_get_element(segment, 1)->flags.type, sc_type_const_node);
+    EXPECT_EQ(sc_segment_get_element(segment, 2)->flags.type, 0u);
+    EXPECT_EQ(sc_segment_get_element(segment, SC_SEGMENT_ELEMENTS_COUNT - 1)->flags.type, sc_type_node_class);
+  }
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+sc_addr_seg reported_segments_count = 0;
+
+void TestReportSegmentsProgress(sc_char const *, sc_addr_seg processed_count, sc_addr_seg segments_count)
+{
+  EXPECT_LE(processed_count, segments_count);
+  reported_segments_count = sc_max(reported_segments_count, processed_count);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_segments_in_parallel)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.storage = SC_FS_MEMORY_PATH;
+  params.clear = SC_TRUE;
+  params.limit_max_threads_by_max_physical_cores = SC_FALSE;
+  params.max_events_and_agents_threads = 3;
+  EXPECT_EQ(sc_fs_memory_initialize_ext(&params), SC_FS_MEMORY_OK);
+  sc_fs_memory_set_segments_progress_callback(TestReportSegmentsProgress);
+
+  sc_addr_seg const segments_count = 8;
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, segments_count);
+  storage->segments_capacity = segments_count;
+
+  storage->segments_count = segments_count;
+  for (sc_addr_seg i = 0; i < segments_count; ++i)
+  {
+    storage->segments[i] = sc_segment_new(i + 1, SC_SEGMENT_POOL_NODES);
+    storage->segments[i]->last_engaged_offset = i + 1;
+    sc_segment_get_element(storage->segments[i], i + 1)->flags.type = sc_type_const_node;
+  }
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(reported_segments_count, segments_count);
+  for (sc_addr_seg i = 0; i < segments_count; ++i)
+    sc_segment_free(storage->segments[i]);
+  storage->segments_count = 0;
+
+  reported_segments_count = 0;
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(reported_segments_count, segments_count);
+  EXPECT_EQ(storage->segments_count, segments_count);
+  for (sc_addr_seg i = 0; i < segments_count; ++i)
+  {
+    sc_segment * segment = storage->segments[i];
+    EXPECT_EQ(segment->num, i + 1u);
+    EXPECT_EQ(segment->last_engaged_offset, i + 1u);
+    EXPECT_EQ(sc_segment_get_element(segment, i + 1)->flags.type, sc_type_const_node);
+    EXPECT_EQ(sc_segment_get_element(segment, i + 2)->flags.type, 0u);
+    sc_segment_free(segment);
+  }
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_compressed_segments)
+{
+#ifndef SC_FS_MEMORY_LZ4
+  GTEST_SKIP() << "Sc-machine is built without LZ4";
+#endif
+
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.storage = SC_FS_MEMORY_PATH;
+  params.clear = SC_TRUE;
+  params.dump_memory_compression = "LZ4";
+  EXPECT_EQ(sc_fs_memory_initialize_ext(&params), SC_FS_MEMORY_OK);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
+
+  storage->segments_count = 2;
+  storage->segments[0] = sc_segment_new(1, SC_SEGMENT_POOL_NODES);
+  storage->segments[1] = sc_segment_new(2, SC_SEGMENT_POOL_NODES);
+  storage->segments[1]->last_released_offset = 3;
+  sc_segment_get_element(storage->segments[0], 1)->flags.type = sc_type_const_node;
+  sc_segment_get_element(storage->segments[1], SC_SEGMENT_ELEMENTS_COUNT - 1)->flags.type = sc_type_node_class;
   EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
   sc_segment_free(storage->segments[0]);
   sc_segment_free(storage->segments[1]);
+  storage->segments_count = 0;
+
+  // segments aren't saved uncompressed silently
+  sc_fs_memory_header header;
+  sc_io_channel * channel = sc_io_new_read_channel(SC_FS_MEMORY_SEGMENTS_PATH, nullptr);
+  sc_io_channel_set_encoding(channel, nullptr, nullptr);
+  EXPECT_EQ(sc_fs_memory_header_read(channel, &header), SC_FS_MEMORY_OK);
+  sc_io_channel_shutdown(channel, SC_FALSE, nullptr);
+  EXPECT_EQ(header.format, (sc_uint32)SC_FS_MEMORY_SEGMENTS_FORMAT_COMPRESSED);
+  EXPECT_EQ(header.compression, (sc_uint32)SC_FS_MEMORY_SEGMENTS_COMPRESSION_LZ4);
+  EXPECT_LT(std::filesystem::file_size(SC_FS_MEMORY_SEGMENTS_PATH), SC_SEGMENT_ELEMENTS_COUNT * sizeof(sc_element));
 
   EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(storage->segments_count, 2u);
+  EXPECT_EQ(storage->segments[1]->num, 2u);
+  EXPECT_EQ(storage->segments[1]->last_released_offset, 3u);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[0], 1)->flags.type, sc_type_const_node);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[0], 2)->flags.type, 0u);
+  EXPECT_EQ(
+      sc_segment_get_element(storage->segments[1], SC_SEGMENT_ELEMENTS_COUNT - 1)->flags.type, sc_type_node_class);
   sc_segment_free(storage->segments[0]);
   sc_segment_free(storage->segments[1]);
 
@@ -71,12 +237,221 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load)
   EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
 }
 
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_segments_deltas)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.storage = SC_FS_MEMORY_PATH;
+  params.clear = SC_TRUE;
+  params.dump_memory_deltas_count = 2;
+  EXPECT_EQ(sc_fs_memory_initialize_ext(&params), SC_FS_MEMORY_OK);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
+  sc_monitor_init(&storage->segments_monitor);
+
+  storage->segments_count = 1;
+  storage->segments[0] = sc_segment_new(1, SC_SEGMENT_POOL_NODES);
+  sc_segment_get_element(storage->segments[0], 1)->flags.type = sc_type_const_node;
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+
+  // only changed segments are saved
+  storage->segments_count = 2;
+  storage->segments[1] = sc_segment_new(2, SC_SEGMENT_POOL_NODES);
+  storage->segments[1]->is_dirty = SC_TRUE;
+  storage->segments[1]->last_engaged_offset = 1;
+  sc_segment_get_element(storage->segments[1], 1)->flags.type = sc_type_node_class;
+  sc_segment_get_element(storage->segments[0], 2)->flags.type = sc_type_const_node;
+  storage->last_not_engaged_segment_num[SC_SEGMENT_POOL_NODES] = 2;
+  EXPECT_EQ(sc_fs_memory_save_changes(storage), SC_FS_MEMORY_OK);
+  EXPECT_TRUE(sc_fs_is_file(SC_FS_MEMORY_SEGMENTS_DELTAS_PATH));
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+  storage->segments_count = 0;
+  storage->last_not_engaged_segment_num[SC_SEGMENT_POOL_NODES] = 0;
+
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(storage->segments_count, 2u);
+  EXPECT_EQ(storage->last_not_engaged_segment_num[SC_SEGMENT_POOL_NODES], 2u);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[0], 1)->flags.type, sc_type_const_node);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[0], 2)->flags.type, 0u);
+  EXPECT_EQ(storage->segments[1]->last_engaged_offset, 1u);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[1], 1)->flags.type, sc_type_node_class);
+
+  // all segments are saved after `dump_memory_deltas_count` dumps of changes
+  EXPECT_EQ(sc_fs_memory_save_changes(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(sc_fs_memory_save_changes(storage), SC_FS_MEMORY_OK);
+  EXPECT_TRUE(sc_fs_is_file(SC_FS_MEMORY_SEGMENTS_DELTAS_PATH));
+  EXPECT_EQ(sc_fs_memory_save_changes(storage), SC_FS_MEMORY_OK);
+  EXPECT_FALSE(sc_fs_is_file(SC_FS_MEMORY_SEGMENTS_DELTAS_PATH));
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+
+  sc_monitor_destroy(&storage->segments_monitor);
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+void TestSaveSegmentsAndCorruptFirstSegment(sc_storage * storage)
+{
+  storage->segments_count = 2;
+  storage->segments[0] = sc_segment_new(1, SC_SEGMENT_POOL_NODES);
+  storage->segments[1] = sc_segment_new(2, SC_SEGMENT_POOL_NODES);
+  sc_segment_get_element(storage->segments[0], 1)->flags.type = sc_type_const_node;
+  sc_segment_get_element(storage->segments[1], 1)->flags.type = sc_type_node_class;
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+  storage->segments_count = 0;
+
+  // the first segment starts at the first offset aligned by 64 KiB after index of segments
+  FILE * file = fopen(ScFSMemoryTest::SC_FS_MEMORY_SEGMENTS_PATH, "r+b");
+  EXPECT_NE(file, nullptr);
+  EXPECT_EQ(fseek(file, 64 * 1024 + 100, SEEK_SET), 0);
+  sc_uint8 const corrupted_byte = 0xAB;
+  EXPECT_EQ(fwrite(&corrupted_byte, sizeof(corrupted_byte), 1, file), 1u);
+  fclose(file);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_corrupted_segment)
+{
+  EXPECT_EQ(sc_fs_memory_initialize(SC_FS_MEMORY_PATH, SC_TRUE), SC_FS_MEMORY_OK);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
+  TestSaveSegmentsAndCorruptFirstSegment(storage);
+
+  sc_uint32 corrupted_count = 0;
+  EXPECT_EQ(sc_fs_memory_verify(&corrupted_count), SC_FS_MEMORY_OK);
+  EXPECT_EQ(corrupted_count, 1u);
+
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_READ_ERROR);
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_skipped_corrupted_segment)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.storage = SC_FS_MEMORY_PATH;
+  params.clear = SC_TRUE;
+  params.skip_corrupted_segments = SC_TRUE;
+  EXPECT_EQ(sc_fs_memory_initialize_ext(&params), SC_FS_MEMORY_OK);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
+  TestSaveSegmentsAndCorruptFirstSegment(storage);
+
+  // corrupted segment is loaded empty, other segments are loaded as they are saved
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  EXPECT_EQ(storage->segments_count, 2u);
+  EXPECT_EQ(storage->segments[0]->num, 1u);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[0], 1)->flags.type, 0u);
+  EXPECT_EQ(sc_segment_get_element(storage->segments[1], 1)->flags.type, sc_type_node_class);
+  sc_segment_free(storage->segments[0]);
+  sc_segment_free(storage->segments[1]);
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
+TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_paged_out_segments)
+{
+#if !SC_IS_PLATFORM_LINUX || !defined(MADV_PAGEOUT)
+  GTEST_SKIP() << "Paging out of segments is supported on Linux 5.4 and newer only";
+#endif
+
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.storage = SC_FS_MEMORY_PATH;
+  params.clear = SC_TRUE;
+  params.segments_memory_limit = 1;
+  EXPECT_EQ(sc_fs_memory_initialize_ext(&params), SC_FS_MEMORY_OK);
+  sc_segment_pager_initialize(&params);
+
+  sc_storage * storage = sc_mem_new(sc_storage, 1);
+  storage->segments = sc_mem_new(sc_segment *, 3);
+  storage->segments_capacity = 3;
+  storage->segments_count = 3;
+  for (sc_addr_seg i = 0; i < 3; ++i)
+  {
+    storage->segments[i] = sc_segment_new(i + 1, SC_SEGMENT_POOL_NODES);
+    sc_segment_get_element(storage->segments[i], 1)->flags.type = sc_type_const_node;
+  }
+  EXPECT_EQ(sc_fs_memory_save(storage), SC_FS_MEMORY_OK);
+  for (sc_addr_seg i = 0; i < 3; ++i)
+    sc_segment_free(storage->segments[i]);
+  storage->segments_count = 0;
+
+  EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
+  ASSERT_EQ(storage->segments_count, 3u);
+
+  // segments are read into anonymous memory instead of mapping segments file, e.g. if it is compressed, so they
+  // can't be paged out
+  if (!storage->segments[0]->is_file_mapped)
+  {
+    for (sc_addr_seg i = 0; i < 3; ++i)
+      sc_segment_free(storage->segments[i]);
+    sc_mem_free(storage->segments);
+    sc_mem_free(storage);
+
+    sc_segment_pager_shutdown();
+    EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+    GTEST_SKIP() << "Segments aren't mapped from segments file";
+  }
+
+  for (sc_addr_seg i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(storage->segments[i]->is_file_mapped);
+    sc_segment_pager_access(storage->segments[i]);
+  }
+
+  // every segment exceeds the limit, so only the last accessed segment stays resident
+  sc_stat stat = {};
+  sc_segment_pager_get_stat(&stat);
+  EXPECT_EQ(stat.resident_segments_size, SC_SEG_ELEMENTS_SIZE_BYTE(SC_SEGMENT_POOL_NODES));
+  EXPECT_EQ(stat.paged_out_segments_count, 2u);
+  EXPECT_FALSE(storage->segments[0]->is_resident);
+  EXPECT_TRUE(storage->segments[2]->is_resident);
+
+  // one of every sampling period of accesses of thread is counted as the whole period
+  for (sc_uint32 i = 0; i < SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD; ++i)
+    sc_segment_pager_access(storage->segments[0]);
+  EXPECT_GE(storage->segments[0]->access_count, (sc_uint32)SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD);
+  EXPECT_EQ(storage->segments[0]->access_count % SC_SEGMENT_PAGER_ACCESS_SAMPLING_PERIOD, 0u);
+
+  // paged out segments are read from segments file again
+  for (sc_addr_seg i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(sc_segment_get_element(storage->segments[i], 1)->flags.type, sc_type_const_node);
+    sc_segment_free(storage->segments[i]);
+  }
+
+  sc_mem_free(storage->segments);
+  sc_mem_free(storage);
+
+  sc_segment_pager_shutdown();
+  EXPECT_EQ(sc_fs_memory_shutdown(), SC_FS_MEMORY_OK);
+}
+
 TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_file_read)
 {
   EXPECT_EQ(sc_fs_memory_initialize(SC_FS_MEMORY_PATH, SC_TRUE), SC_FS_MEMORY_OK);
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
 
   EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
   EXPECT_EQ(storage->segments_count, 0u);
@@ -99,6 +474,7 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_segments_num_read)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
 
   EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
   EXPECT_EQ(storage->segments_count, 0u);
@@ -119,6 +495,7 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_segment_read)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
 
   EXPECT_EQ(sc_fs_memory_load(storage), SC_FS_MEMORY_OK);
   EXPECT_EQ(storage->segments_count, 0u);
@@ -152,6 +529,7 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_file_write)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
   storage->segments[0] = nullptr;
   storage->segments[1] = nullptr;
   storage->segments_count = 2;
@@ -171,6 +549,7 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_segments_num_write)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
   storage->segments[0] = nullptr;
   storage->segments[1] = nullptr;
   storage->segments_count = *(sc_uint64 *)"invalid_size";
@@ -190,6 +569,7 @@ TEST_F(ScFSMemoryTest, sc_fs_memory_save_load_save_invalid_segment_write)
 
   sc_storage * storage = sc_mem_new(sc_storage, 1);
   storage->segments = sc_mem_new(sc_segment *, 2);
+  storage->segments_capacity = 2;
   storage->segments[0] = nullptr;
   storage->segments[1] = nullptr;
   storage->segments_count = 2;
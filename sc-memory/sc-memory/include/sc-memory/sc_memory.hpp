@@ -33,6 +33,15 @@ typedef struct
   ScAddr addr5;
 } ScSystemIdentifierQuintuple;
 
+typedef struct
+{
+  ScType type;
+  ScAddr sourceElementAddr;
+  ScAddr targetElementAddr;
+} ScConnectorTriple;
+
+using ScConnectorTripleVector = std::vector<ScConnectorTriple>;
+
 class ScMemory
 {
   friend class ScMemoryContext;
@@ -72,6 +81,54 @@ public:
    */
   _SC_EXTERN static bool Shutdown(bool saveState = true);
 
+  /*!
+   * @brief Verifies the sc-memory system saved in file system without loading it.
+   *
+   * This function verifies checksums of saved sc-segments and strings channels and reports every corrupted one.
+   * It must be called when the sc-memory system isn't initialized.
+   *
+   * @param params The parameters with path to sc-storage to verify.
+   * @return Returns true if saved sc-memory is read and it isn't corrupted; otherwise, returns false.
+   */
+  _SC_EXTERN static bool VerifyStorage(sc_memory_params const & params);
+
+  /*!
+   * @brief Compacts the sc-memory system saved in file system.
+   *
+   * This function relocates sc-elements of saved sc-memory into the first sc-segments and frees sc-segments emptied by
+   * erased sc-elements. Addresses of relocated sc-elements are changed, so ScAddr and their hashes kept outside of
+   * sc-memory become invalid. It must be called when the sc-memory system isn't initialized.
+   *
+   * @param params The parameters with path to sc-storage to compact.
+   * @return Returns true if saved sc-memory is compacted and saved; otherwise, returns false.
+   */
+  _SC_EXTERN static bool CompactStorage(sc_memory_params const & params);
+
+  /*!
+   * @brief Exports the sc-memory system saved in file system to file.
+   *
+   * This function writes sc-elements of saved sc-memory with their types, begin and end sc-elements of sc-connectors
+   * and contents of sc-links to file of binary format. The format doesn't depend on layout of sc-elements, so file is
+   * imported by sc-machines built with other options. It must be called when the sc-memory system isn't initialized.
+   *
+   * @param params The parameters with path to sc-storage to export.
+   * @param path The path to file to export sc-elements to.
+   * @return Returns true if saved sc-memory is exported; otherwise, returns false.
+   */
+  _SC_EXTERN static bool ExportStorage(sc_memory_params const & params, std::string const & path);
+
+  /*!
+   * @brief Imports sc-elements exported by `ExportStorage` to the sc-memory system saved in file system.
+   *
+   * Imported sc-elements get new addresses. If `clear` parameter is set, sc-elements are imported to empty sc-memory.
+   * It must be called when the sc-memory system isn't initialized.
+   *
+   * @param params The parameters with path to sc-storage to import sc-elements to.
+   * @param path The path to file to import sc-elements from.
+   * @return Returns true if sc-elements are imported and sc-memory is saved; otherwise, returns false.
+   */
+  _SC_EXTERN static bool ImportStorage(sc_memory_params const & params, std::string const & path);
+
   _SC_EXTERN static void LogMute();
   _SC_EXTERN static void LogUnmute();
 
@@ -91,6 +148,10 @@ public:
     sc_uint64 m_nodesNum;
     sc_uint64 m_linksNum;
     sc_uint64 m_connectorsNum;
+    sc_uint64 m_connectorsIndexSize;   // size of memory used by index of sc-connectors in bytes
+    sc_uint64 m_residentSegmentsSize;  // size of memory of resident segments mapped from dump in bytes
+    sc_uint64 m_pagedOutSegmentsNum;   // amount of paged out segments mapped from dump
+    sc_uint64 m_accessedSegmentsNum;   // amount of segments accessed after the last reset of their access counts
 
     sc_uint64 GetAllNum() const
     {
@@ -295,6 +356,29 @@ public:
    */
   _SC_EXTERN bool EraseElement(ScAddr const & elementAddr) noexcept(false);
 
+  /*!
+   * @brief Erases sc-elements from the sc-memory in batch.
+   *
+   * This method erases sc-elements identified by the given sc-addresses and all sc-connectors related to them. It is
+   * faster than calling `EraseElement` for each sc-element, because closure of sc-elements is computed once.
+   *
+   * @param elementAddrs Sc-addresses of sc-elements to erase.
+   * @return Returns true if all sc-elements were successfully erased; otherwise, returns false. If some sc-address is
+   * not valid, then the method returns false, but all other sc-elements are still erased.
+   * @throws ExceptionInvalidState if the sc-memory context is not authenticated or does not have erase permissions
+   * for any of sc-elements. In this case no sc-element is erased.
+   *
+   * @code
+   * ScMemoryContext context;
+   * ScAddrVector const & nodeAddrs = context.GenerateNodes(1000, ScType::ConstNode);
+   * if (context.EraseElements(nodeAddrs))
+   * {
+   *   // Elements successfully erased.
+   * }
+   * @endcode
+   */
+  _SC_EXTERN bool EraseElements(ScAddrVector const & elementAddrs) noexcept(false);
+
   /*!
    * @brief Generates a new sc-node with the specified type.
    *
@@ -335,6 +419,27 @@ public:
       "This method is deprecated. Use `GenerateNode` instead for better readability and standards compliance.")
   _SC_EXTERN ScAddr CreateNode(ScType const & nodeType) noexcept(false);
 
+  /*!
+   * @brief Generates sc-nodes with the specified type in batch.
+   *
+   * This method creates the specified count of sc-nodes with the same type and returns their sc-addresses. Sc-addresses
+   * are reserved for all sc-nodes at once, so it is faster than generation of the same sc-nodes one by one.
+   *
+   * @param count A count of sc-nodes to create.
+   * @param nodeType A sc-type of the sc-nodes to create.
+   * @return Returns the sc-addresses of the newly created sc-nodes.
+   * @throws ExceptionInvalidParams if the specified type is not a valid sc-node type or the specified count is greater
+   * than `UINT32_MAX`.
+   * @throws ExceptionCritical if sc-memory is full, then no sc-node is created.
+   * @throws ExceptionInvalidState if the sc-memory context is not authenticated.
+   *
+   * @code
+   * ScMemoryContext context;
+   * ScAddrVector const & nodeAddrs = context.GenerateNodes(1000, ScType::ConstNode);
+   * @endcode
+   */
+  _SC_EXTERN ScAddrVector GenerateNodes(size_t count, ScType const & nodeType) noexcept(false);
+
   /*!
    * @brief Generates a new sc-link with the specified type.
    *
@@ -429,6 +534,36 @@ public:
       ScAddr const & sourceElementAddr,
       ScAddr const & targetElementAddr) noexcept(false);
 
+  /*!
+   * @brief Generates sc-connectors in batch.
+   *
+   * This method creates sc-connectors with the specified types, sources and targets, and returns their sc-addresses in
+   * the same order. Sc-addresses are reserved for all sc-connectors at once, and sc-connectors are linked with their
+   * sources and targets in groups that share the same locks. It is the preferred way to load a lot of sc-connectors.
+   *
+   * @param triples Types, sources and targets of the sc-connectors to create.
+   * @param emitEvents Boolean indicating whether to emit sc-events of the generated sc-connectors. By default, it is
+   * true.
+   * @return Returns the sc-addresses of the newly created sc-connectors. If some source or target sc-element doesn't
+   * exist, then its sc-connector isn't created and its sc-address is empty, but other sc-connectors are created.
+   * @throws ExceptionInvalidParams if some specified type is not a valid sc-connector type, some source or target
+   * sc-address is empty, no source or target sc-element exists or count of triples is greater than `UINT32_MAX`. In
+   * this case no sc-connector is created.
+   * @throws ExceptionCritical if sc-memory is full, then no sc-connector is created.
+   * @throws ExceptionInvalidState if the sc-memory context is not authenticated or does not have write permissions.
+   *
+   * @code
+   * ScMemoryContext context;
+   * ScAddr sourceNodeAddr = context.GenerateNode(ScType::ConstNode);
+   * ScAddr targetNodeAddr = context.GenerateNode(ScType::ConstNode);
+   * ScAddrVector const & arcAddrs = context.GenerateConnectors(
+   *     {{ScType::ConstPermPosArc, sourceNodeAddr, targetNodeAddr},
+   *      {ScType::ConstCommonArc, sourceNodeAddr, targetNodeAddr}});
+   * @endcode
+   */
+  _SC_EXTERN ScAddrVector
+  GenerateConnectors(ScConnectorTripleVector const & triples, bool emitEvents = true) noexcept(false);
+
   /*!
    * @brief Returns the type of the specified sc-element.
    *
@@ -12,6 +12,8 @@
 
 #include "sc-memory/utils/sc_log.hpp"
 
+#include <limits>
+
 extern "C"
 {
 #include <glib.h>
@@ -104,6 +106,50 @@ bool ScMemory::Shutdown(bool saveState /* = true */)
   return result;
 }
 
+bool ScMemory::VerifyStorage(sc_memory_params const & params)
+{
+  g_log_set_default_handler(_logPrintHandler, nullptr);
+
+  sc_uint32 corruptedCount = 0;
+  sc_result const result = sc_memory_verify_storage(&params, &corruptedCount);
+
+  g_log_set_default_handler(g_log_default_handler, nullptr);
+  return result == SC_RESULT_OK && corruptedCount == 0;
+}
+
+bool ScMemory::CompactStorage(sc_memory_params const & params)
+{
+  g_log_set_default_handler(_logPrintHandler, nullptr);
+
+  sc_uint32 movedCount = 0;
+  sc_result const result = sc_memory_compact_storage(&params, &movedCount);
+
+  g_log_set_default_handler(g_log_default_handler, nullptr);
+  return result == SC_RESULT_OK;
+}
+
+bool ScMemory::ExportStorage(sc_memory_params const & params, std::string const & path)
+{
+  g_log_set_default_handler(_logPrintHandler, nullptr);
+
+  sc_uint64 exportedCount = 0;
+  sc_result const result = sc_memory_export_storage(&params, path.c_str(), &exportedCount);
+
+  g_log_set_default_handler(g_log_default_handler, nullptr);
+  return result == SC_RESULT_OK;
+}
+
+bool ScMemory::ImportStorage(sc_memory_params const & params, std::string const & path)
+{
+  g_log_set_default_handler(_logPrintHandler, nullptr);
+
+  sc_uint64 importedCount = 0;
+  sc_result const result = sc_memory_import_storage(&params, path.c_str(), &importedCount);
+
+  g_log_set_default_handler(g_log_default_handler, nullptr);
+  return result == SC_RESULT_OK;
+}
+
 void ScMemory::LogMute()
 {
   isLogMuted = true;
@@ -340,6 +386,40 @@ bool ScMemoryContext::EraseElement(ScAddr const & elementAddr)
   return result == SC_RESULT_OK;
 }
 
+bool ScMemoryContext::EraseElements(ScAddrVector const & elementAddrs)
+{
+  CHECK_CONTEXT;
+
+  std::vector<sc_addr> addrs;
+  addrs.reserve(elementAddrs.size());
+  for (ScAddr const & elementAddr : elementAddrs)
+    addrs.push_back(*elementAddr);
+
+  sc_result const result = sc_memory_elements_erase(m_context, addrs.size(), addrs.data());
+
+  switch (result)
+  {
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState, "Not able to erase sc-elements because sc-memory context is not authorized.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_ERASE_PERMISSIONS:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState,
+        "Not able to erase sc-elements because sc-memory context hasn't erase permissions.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_ERASE_PERMISSIONS:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState,
+        "Not able to erase sc-elements because sc-memory context hasn't permissions to erase permissions.");
+
+  default:
+    break;
+  }
+
+  return result == SC_RESULT_OK;
+}
+
 ScAddr ScMemoryContext::GenerateNode(ScType const & nodeType)
 {
   CHECK_CONTEXT;
@@ -373,6 +453,40 @@ ScAddr ScMemoryContext::CreateNode(ScType const & nodeType)
   return GenerateNode(nodeType);
 }
 
+ScAddrVector ScMemoryContext::GenerateNodes(size_t count, ScType const & nodeType)
+{
+  CHECK_CONTEXT;
+
+  if (count > std::numeric_limits<sc_uint32>::max())
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams,
+        "Specified count of sc-nodes `" << count << "` is greater than maximum count of sc-nodes generated in batch `"
+                                        << std::numeric_limits<sc_uint32>::max() << "`.");
+
+  std::vector<sc_addr> nodeAddrs(count);
+  sc_result const result = sc_memory_nodes_new_batch(m_context, *nodeType, count, nodeAddrs.data());
+
+  switch (result)
+  {
+  case SC_RESULT_ERROR_ELEMENT_IS_NOT_NODE:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams,
+        "Specified type must be sc-node type. You should provide any of ScType::...Node... value as a type.");
+
+  case SC_RESULT_ERROR_FULL_MEMORY:
+    SC_THROW_EXCEPTION(utils::ExceptionCritical, "Not able to create sc-nodes because sc-memory is full.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState, "Not able to create sc-nodes because sc-memory context is not authorized.");
+
+  default:
+    break;
+  }
+
+  return {nodeAddrs.cbegin(), nodeAddrs.cend()};
+}
+
 ScAddr ScMemoryContext::GenerateLink(ScType const & linkType /* = ScType::ConstNodeLink */)
 {
   CHECK_CONTEXT;
@@ -454,6 +568,70 @@ ScAddr ScMemoryContext::GenerateConnector(
   return connectorAddr;
 }
 
+ScAddrVector ScMemoryContext::GenerateConnectors(ScConnectorTripleVector const & triples, bool emitEvents)
+{
+  CHECK_CONTEXT;
+
+  if (triples.size() > std::numeric_limits<sc_uint32>::max())
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams,
+        "Specified count of sc-connectors `" << triples.size()
+                                             << "` is greater than maximum count of sc-connectors generated in batch `"
+                                             << std::numeric_limits<sc_uint32>::max() << "`.");
+
+  std::vector<sc_connector_triple> connectorTriples;
+  connectorTriples.reserve(triples.size());
+  for (ScConnectorTriple const & triple : triples)
+    connectorTriples.push_back({*triple.type, *triple.sourceElementAddr, *triple.targetElementAddr});
+
+  std::vector<sc_addr> connectorAddrs(triples.size());
+  sc_result const result = sc_memory_arcs_new_batch(
+      m_context, triples.size(), connectorTriples.data(), connectorAddrs.data(), emitEvents ? SC_TRUE : SC_FALSE);
+
+  // sc-connectors with not existing sources or targets aren't created, but other ones are created and must be returned
+  bool isSomeConnectorGenerated = false;
+  for (sc_addr const & connectorAddr : connectorAddrs)
+    isSomeConnectorGenerated |= SC_ADDR_IS_NOT_EMPTY(connectorAddr);
+  if (result == SC_RESULT_ERROR_ADDR_IS_NOT_VALID && isSomeConnectorGenerated)
+    return {connectorAddrs.cbegin(), connectorAddrs.cend()};
+
+  switch (result)
+  {
+  case SC_RESULT_ERROR_ADDR_IS_NOT_VALID:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams,
+        "Specified source or target sc-element sc-address is invalid to create sc-connectors.");
+
+  case SC_RESULT_ERROR_ELEMENT_IS_NOT_CONNECTOR:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidParams,
+        "Specified type must be sc-connector type. You should provide any of ScType::...Arc... or ScType::...Edge... "
+        "value as a type.");
+
+  case SC_RESULT_ERROR_FULL_MEMORY:
+    SC_THROW_EXCEPTION(utils::ExceptionCritical, "Not able to create sc-connectors because sc-memory is full.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_IS_NOT_AUTHENTICATED:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState, "Not able to create sc-connectors because sc-memory context is not authorized.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_WRITE_PERMISSIONS:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState,
+        "Not able to create sc-connectors because sc-memory context hasn't write permissions.");
+
+  case SC_RESULT_ERROR_SC_MEMORY_CONTEXT_HAS_NO_PERMISSIONS_TO_WRITE_PERMISSIONS:
+    SC_THROW_EXCEPTION(
+        utils::ExceptionInvalidState,
+        "Not able to create sc-connectors because sc-memory context hasn't permissions to write permissions.");
+
+  default:
+    break;
+  }
+
+  return {connectorAddrs.cbegin(), connectorAddrs.cend()};
+}
+
 ScAddr ScMemoryContext::CreateEdge(
     ScType const & connectorType,
     ScAddr const & sourceElementAddr,
@@ -1330,6 +1508,10 @@ ScMemoryContext::ScMemoryStatistics ScMemoryContext::CalculateStatistics() const
   statistics.m_connectorsNum = uint32_t(stat.connector_count);
   statistics.m_linksNum = uint32_t(stat.link_count);
   statistics.m_nodesNum = uint32_t(stat.node_count);
+  statistics.m_connectorsIndexSize = stat.connectors_index_size;
+  statistics.m_residentSegmentsSize = stat.resident_segments_size;
+  statistics.m_pagedOutSegmentsNum = stat.paged_out_segments_count;
+  statistics.m_accessedSegmentsNum = stat.accessed_segments_count;
 
   return statistics;
 }
@@ -6,7 +6,11 @@
 
 #include <sc-memory/test/sc_test.hpp>
 
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <thread>
+#include <unordered_set>
 
 #include <sc-memory/sc_memory.hpp>
 
@@ -14,6 +18,7 @@ extern "C"
 {
 #include <sc-store/sc_storage.h>
 #include <sc-store/sc_storage_private.h>
+#include <sc-store/sc_segment_allocator.h>
 }
 
 TEST_F(ScMemoryTest, Elements)
@@ -300,6 +305,200 @@ TEST_F(ScMemoryTest, GenerateConnectors)
   EXPECT_TRUE(ctx.CheckConnector(linkAddr, nodeAddr, ScType::ConstCommonEdge));
 }
 
+TEST_F(ScMemoryTest, GenerateNodesInBatch)
+{
+  ScMemoryContext ctx;
+
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(SC_SEGMENT_ELEMENTS_COUNT + 10, ScType::ConstNodeClass);
+  EXPECT_EQ(nodeAddrs.size(), SC_SEGMENT_ELEMENTS_COUNT + 10u);
+
+  ScAddrSet const uniqueNodeAddrs{nodeAddrs.cbegin(), nodeAddrs.cend()};
+  EXPECT_EQ(uniqueNodeAddrs.size(), nodeAddrs.size());
+  for (ScAddr const & nodeAddr : nodeAddrs)
+    EXPECT_EQ(ctx.GetElementType(nodeAddr), ScType::ConstNodeClass);
+
+  EXPECT_TRUE(ctx.GenerateNodes(0, ScType::ConstNode).empty());
+  EXPECT_THROW(ctx.GenerateNodes(10, ScType::ConstPermPosArc), utils::ExceptionInvalidParams);
+}
+
+TEST_F(ScMemoryTest, GenerateConnectorsInBatch)
+{
+  ScMemoryContext ctx;
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(100, ScType::ConstNode);
+
+  ScConnectorTripleVector triples;
+  for (ScAddr const & nodeAddr : nodeAddrs)
+  {
+    triples.push_back({ScType::ConstPermPosArc, classAddr, nodeAddr});
+    triples.push_back({ScType::ConstCommonEdge, nodeAddr, classAddr});
+  }
+
+  ScAddrVector const & connectorAddrs = ctx.GenerateConnectors(triples);
+  EXPECT_EQ(connectorAddrs.size(), triples.size());
+  for (size_t i = 0; i < triples.size(); ++i)
+  {
+    EXPECT_EQ(ctx.GetElementType(connectorAddrs[i]), triples[i].type);
+    auto const & [sourceAddr, targetAddr] = ctx.GetConnectorIncidentElements(connectorAddrs[i]);
+    EXPECT_EQ(sourceAddr, triples[i].sourceElementAddr);
+    EXPECT_EQ(targetAddr, triples[i].targetElementAddr);
+  }
+
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(classAddr), 200u);
+  EXPECT_EQ(ctx.GetElementEdgesAndIncomingArcsCount(classAddr), 100u);
+  for (ScAddr const & nodeAddr : nodeAddrs)
+  {
+    EXPECT_TRUE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstPermPosArc));
+    EXPECT_TRUE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstCommonEdge));
+  }
+
+  EXPECT_TRUE(ctx.EraseElement(connectorAddrs[0]));
+  EXPECT_FALSE(ctx.CheckConnector(classAddr, nodeAddrs[0], ScType::ConstPermPosArc));
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(classAddr), 199u);
+}
+
+TEST_F(ScMemoryTest, GenerateConnectorsInBatchWithInvalidParams)
+{
+  ScMemoryContext ctx;
+
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const invalidNodeAddr{475585172};
+
+  EXPECT_THROW(
+      ctx.GenerateConnectors({{ScType::ConstPermPosArc, nodeAddr, nodeAddr}, {ScType::ConstNode, nodeAddr, nodeAddr}}),
+      utils::ExceptionInvalidParams);
+  EXPECT_THROW(
+      ctx.GenerateConnectors({{ScType::ConstPermPosArc, nodeAddr, ScAddr::Empty}}), utils::ExceptionInvalidParams);
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddr), 0u);
+
+  EXPECT_THROW(
+      ctx.GenerateConnectors({{ScType::ConstPermPosArc, nodeAddr, invalidNodeAddr}}), utils::ExceptionInvalidParams);
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddr), 0u);
+
+  ScAddrVector const & connectorAddrs = ctx.GenerateConnectors(
+      {{ScType::ConstPermPosArc, nodeAddr, invalidNodeAddr}, {ScType::ConstPermPosArc, nodeAddr, nodeAddr}});
+  EXPECT_EQ(connectorAddrs.size(), 2u);
+  EXPECT_FALSE(connectorAddrs[0].IsValid());
+  EXPECT_TRUE(connectorAddrs[1].IsValid());
+  EXPECT_TRUE(ctx.CheckConnector(nodeAddr, nodeAddr, ScType::ConstPermPosArc));
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddr), 1u);
+
+  EXPECT_TRUE(ctx.EraseElement(connectorAddrs[1]));
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddr), 0u);
+}
+
+TEST_F(ScMemoryTest, EraseElementsInBatch)
+{
+  ScMemoryContext ctx;
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(100, ScType::ConstNode);
+
+  ScConnectorTripleVector triples;
+  for (size_t i = 0; i < nodeAddrs.size(); ++i)
+  {
+    triples.push_back({ScType::ConstPermPosArc, classAddr, nodeAddrs[i]});
+    triples.push_back({ScType::ConstPermPosArc, nodeAddrs[i], nodeAddrs[(i + 1) % nodeAddrs.size()]});
+  }
+  triples.push_back({ScType::ConstPermPosArc, nodeAddrs[0], linkAddr});
+  ScAddrVector const & connectorAddrs = ctx.GenerateConnectors(triples);
+
+  ScAddrVector erasedAddrs{nodeAddrs.cbegin(), nodeAddrs.cbegin() + 50};
+  erasedAddrs.push_back(connectorAddrs[100]);
+  erasedAddrs.push_back(nodeAddrs[0]);
+  EXPECT_TRUE(ctx.EraseElements(erasedAddrs));
+
+  for (size_t i = 0; i < nodeAddrs.size(); ++i)
+    EXPECT_EQ(ctx.IsElement(nodeAddrs[i]), i >= 50);
+  EXPECT_FALSE(ctx.IsElement(connectorAddrs[100]));
+  EXPECT_FALSE(ctx.IsElement(connectorAddrs.back()));
+  EXPECT_TRUE(ctx.IsElement(linkAddr));
+  EXPECT_EQ(ctx.GetElementEdgesAndIncomingArcsCount(linkAddr), 0u);
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(classAddr), 49u);
+  EXPECT_EQ(ctx.GetElementEdgesAndIncomingArcsCount(nodeAddrs[50]), 0u);
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddrs[50]), 1u);
+  EXPECT_EQ(ctx.GetElementEdgesAndIncomingArcsCount(nodeAddrs[99]), 2u);
+  EXPECT_EQ(ctx.GetElementEdgesAndOutgoingArcsCount(nodeAddrs[99]), 0u);
+  EXPECT_EQ(ctx.GetElementEdgesAndIncomingArcsCount(nodeAddrs[75]), 2u);
+
+  size_t arcsCount = 0;
+  ScIterator3Ptr const it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it3->Next())
+  {
+    EXPECT_TRUE(ctx.IsElement(it3->Get(2)));
+    ++arcsCount;
+  }
+  EXPECT_EQ(arcsCount, 49u);
+
+  ScAddr const invalidNodeAddr{475585172};
+  EXPECT_FALSE(ctx.EraseElements({nodeAddrs[50], invalidNodeAddr}));
+  EXPECT_FALSE(ctx.IsElement(nodeAddrs[50]));
+  EXPECT_TRUE(ctx.EraseElements({}));
+}
+
+TEST_F(ScMemoryTest, IterateArcsOfHighDegreeElementByTypes)
+{
+  ScMemoryContext ctx;
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(1500, ScType::ConstNode);
+
+  ScConnectorTripleVector triples;
+  for (ScAddr const & nodeAddr : nodeAddrs)
+  {
+    triples.push_back({ScType::ConstCommonArc, classAddr, nodeAddr});
+    triples.push_back({ScType::ConstPermPosArc, nodeAddr, classAddr});
+  }
+  ScAddrVector const & connectorAddrs = ctx.GenerateConnectors(triples);
+
+  ScAddrVector membershipArcAddrs;
+  for (size_t i = 0; i < 10; ++i)
+    membershipArcAddrs.push_back(ctx.GenerateConnector(ScType::MembershipArc, classAddr, nodeAddrs[i]));
+  for (size_t i = 0; i < 10; ++i)
+    ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddrs[i]);
+
+  auto const & CountOutgoingArcs = [&ctx, &classAddr](ScType const & arcType) -> size_t
+  {
+    size_t count = 0;
+    ScIterator3Ptr const it3 = ctx.CreateIterator3(classAddr, arcType, ScType::Unknown);
+    while (it3->Next())
+    {
+      EXPECT_TRUE((ctx.GetElementType(it3->Get(1)) & arcType) == arcType);
+      ++count;
+    }
+    return count;
+  };
+  auto const & CountIncomingArcs = [&ctx, &classAddr](ScType const & arcType) -> size_t
+  {
+    size_t count = 0;
+    ScIterator3Ptr const it3 = ctx.CreateIterator3(ScType::Unknown, arcType, classAddr);
+    while (it3->Next())
+      ++count;
+    return count;
+  };
+
+  EXPECT_EQ(CountOutgoingArcs(ScType::ConstPermPosArc), 10u);
+  EXPECT_EQ(CountOutgoingArcs(ScType::MembershipArc), 20u);
+  EXPECT_EQ(CountOutgoingArcs(ScType::ConstCommonArc), 1500u);
+  EXPECT_EQ(CountIncomingArcs(ScType::ConstPermPosArc), 1500u);
+  EXPECT_EQ(CountIncomingArcs(ScType::ConstCommonArc), 0u);
+
+  EXPECT_TRUE(ctx.SetElementSubtype(membershipArcAddrs[0], ScType::ConstPermPosArc));
+  EXPECT_EQ(CountOutgoingArcs(ScType::ConstPermPosArc), 11u);
+  EXPECT_EQ(CountOutgoingArcs(ScType::MembershipArc), 20u);
+
+  EXPECT_TRUE(ctx.EraseElements({connectorAddrs[0], connectorAddrs[1], membershipArcAddrs[0], nodeAddrs[1499]}));
+  EXPECT_EQ(CountOutgoingArcs(ScType::ConstPermPosArc), 10u);
+  EXPECT_EQ(CountOutgoingArcs(ScType::ConstCommonArc), 1498u);
+  EXPECT_EQ(CountIncomingArcs(ScType::ConstPermPosArc), 1498u);
+
+  ScIterator3Ptr const it3 = ctx.CreateIterator3(nodeAddrs[5], ScType::ConstPermPosArc, classAddr);
+  EXPECT_TRUE(it3->Next());
+  EXPECT_FALSE(it3->Next());
+}
+
 TEST_F(ScMemoryTest, EraseConnectorsBetweenTwoNodesByOneIterator)
 {
   ScAddr const classAddr = m_ctx->GenerateNode(ScType::ConstNodeClass);
@@ -452,7 +651,7 @@ TEST_F(ScMemoryTest, EraseEdgeTargetsBetweenSomeNodesByOneIterator)
   EXPECT_FALSE(m_ctx->IsElement(nodeAddr2));
 }
 
-TEST(SmallScMemoryTest, FullMemory)
+TEST(SmallScMemoryTest, GrowingMemory)
 {
   sc_memory_params params;
   sc_memory_params_clear(&params);
@@ -471,53 +670,30 @@ TEST(SmallScMemoryTest, FullMemory)
 
   ScAddrList addrs;
 
-  size_t count = SC_SEGMENT_ELEMENTS_COUNT / 3;
-  try
-  {
-    for (size_t i = 0; i < count; ++i)
-    {
-      ScAddr const node = ctx.GenerateNode(ScType::Const);
-      if (!node.IsValid() && !ctx.IsElement(node))
-        break;
-
-      ScAddr const link = ctx.GenerateLink();
-      if (!link.IsValid() && !ctx.IsElement(link))
-        break;
-
-      ScAddr const arcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, node, link);
-      if (!arcAddr.IsValid() && !ctx.IsElement(arcAddr))
-        break;
-      addrs.push_back(arcAddr);
-    }
-  }
-  catch (...)
-  {
-  }
-
-  count = addrs.size();
+  size_t const count = SC_SEGMENT_ELEMENTS_COUNT;
   for (size_t i = 0; i < count; ++i)
   {
-    ScAddr addr = addrs.back();
-    ctx.EraseElement(addr);
-    addrs.pop_back();
+    ScAddr const node = ctx.GenerateNode(ScType::Const);
+    ScAddr const link = ctx.GenerateLink();
+    ScAddr const arcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, node, link);
+    EXPECT_TRUE(arcAddr.IsValid());
+    addrs.push_back(arcAddr);
   }
 
-  for (size_t i = 0; i < count; ++i)
+  for (ScAddr const & addr : addrs)
   {
-    ScAddr const node = ctx.GenerateNode(ScType::Const);
-    EXPECT_TRUE(node.IsValid());
-    EXPECT_TRUE(ctx.IsElement(node));
+    EXPECT_TRUE(ctx.IsElement(addr));
+    EXPECT_TRUE(ctx.IsElement(ctx.GetArcSourceElement(addr)));
+    EXPECT_TRUE(ctx.IsElement(ctx.GetArcTargetElement(addr)));
   }
 
-  EXPECT_THROW(ctx.GenerateNode(ScType::Const), utils::ExceptionCritical);
-
   ctx.Destroy();
   ScMemory::LogMute();
   ScMemory::Shutdown();
   ScMemory::LogUnmute();
 }
 
-TEST(SmallScMemoryTest, FullMemory2)
+TEST(SmallScMemoryTest, GrowingMemoryWithReleasedElements)
 {
   sc_memory_params params;
   sc_memory_params_clear(&params);
@@ -538,7 +714,6 @@ TEST(SmallScMemoryTest, FullMemory2)
   ScAddrList tempAddrs;
 
   size_t count = params.max_loaded_segments * SC_SEGMENT_ELEMENTS_COUNT / 3;
-  sc_storage_start_new_process();
   try
   {
     for (size_t i = 0; i < count; ++i)
@@ -563,9 +738,7 @@ TEST(SmallScMemoryTest, FullMemory2)
   catch (...)
   {
   }
-  sc_storage_end_new_process();
 
-  sc_storage_start_new_process();
   count = tempAddrs.size();
   for (size_t i = 0; i < count; ++i)
   {
@@ -592,9 +765,7 @@ TEST(SmallScMemoryTest, FullMemory2)
   {
     EXPECT_TRUE(ctx.IsElement(addr));
   }
-  sc_storage_end_new_process();
 
-  sc_storage_start_new_process();
   for (size_t i = 0; i < count; ++i)
   {
     ScAddr const node = ctx.GenerateNode(ScType::Const);
@@ -607,13 +778,12 @@ TEST(SmallScMemoryTest, FullMemory2)
     EXPECT_TRUE(ctx.IsElement(addr));
   }
 
-  EXPECT_THROW(ctx.GenerateNode(ScType::Const), utils::ExceptionCritical);
+  EXPECT_TRUE(ctx.GenerateNode(ScType::Const).IsValid());
 
   for (ScAddr const & addr : addrs)
   {
     EXPECT_TRUE(ctx.IsElement(addr));
   }
-  sc_storage_end_new_process();
 
   ctx.Destroy();
   ScMemory::LogMute();
@@ -640,8 +810,8 @@ TEST(SmallScMemoryTest, EmptyMemory)
   ScMemoryContext ctx;
   EXPECT_TRUE(ctx.IsValid());
 
-  EXPECT_THROW(ctx.GenerateNode(ScType::Const), utils::ExceptionCritical);
-  EXPECT_THROW(ctx.GenerateNode(ScType::Const), utils::ExceptionCritical);
+  EXPECT_TRUE(ctx.GenerateNode(ScType::Const).IsValid());
+  EXPECT_TRUE(ctx.GenerateNode(ScType::Const).IsValid());
 
   ctx.Destroy();
   ScMemory::LogMute();
@@ -666,7 +836,6 @@ TEST(SmallScMemoryTest, DistributedMemory)
 
   ScMemoryContext ctx;
 
-  sc_storage_start_new_process();
   ScAddr node = ctx.GenerateNode(ScType::Const);
   EXPECT_TRUE(ctx.IsElement(node));
   node = ctx.GenerateNode(ScType::Const);
@@ -675,14 +844,11 @@ TEST(SmallScMemoryTest, DistributedMemory)
   EXPECT_FALSE(ctx.IsElement(node));
   node = ctx.GenerateNode(ScType::Const);
   EXPECT_TRUE(ctx.IsElement(node));
-  sc_storage_end_new_process();
 
-  sc_storage_start_new_process();
   node = ctx.GenerateNode(ScType::Const);
   EXPECT_TRUE(ctx.IsElement(node));
   EXPECT_TRUE(ctx.EraseElement(node));
   EXPECT_FALSE(ctx.IsElement(node));
-  sc_storage_end_new_process();
 
   ctx.Destroy();
   ScMemory::LogMute();
@@ -690,7 +856,7 @@ TEST(SmallScMemoryTest, DistributedMemory)
   ScMemory::LogUnmute();
 }
 
-TEST(ScMemoryDumper, DumpMemory)
+void TestSegmentsAllocation(sc_bool hugePages, sc_char const * numaPolicy)
 {
   sc_memory_params params;
   sc_memory_params_clear(&params);
@@ -699,39 +865,200 @@ TEST(ScMemoryDumper, DumpMemory)
   params.storage = "repo";
   params.log_level = "Debug";
 
-  params.dump_memory = SC_TRUE;
-  params.dump_memory_period = 4;
-  params.dump_memory_statistics = SC_FALSE;
+  params.segments_huge_pages = hugePages;
+  params.segments_numa_policy = numaPolicy;
 
-  params.max_loaded_segments = 1;
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  EXPECT_TRUE(sc_storage_is_initialized());
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+
+  size_t const count = SC_SEGMENT_ELEMENTS_COUNT + 1;
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(count, ScType::ConstNode);
+  ScConnectorTripleVector triples;
+  for (size_t i = 1; i < count; ++i)
+    triples.push_back({ScType::ConstPermPosArc, nodeAddrs[0], nodeAddrs[i]});
+  ScAddrVector const & arcAddrs = ctx.GenerateConnectors(triples);
+  for (ScAddr const & arcAddr : arcAddrs)
+    EXPECT_TRUE(ctx.IsElement(arcAddr));
+  EXPECT_EQ(ctx.GetElementOutputArcsCount(nodeAddrs[0]), count - 1);
+
+#if SC_IS_PLATFORM_LINUX
+  // segments are mapped by the allocator even if explicit huge pages aren't reserved
+  sc_storage * storage = sc_storage_get();
+  for (sc_addr_seg i = 0; i < storage->segments_count; ++i)
+    EXPECT_TRUE(storage->segments[i]->is_mapped);
+#endif
+
+  EXPECT_TRUE(ctx.EraseElement(nodeAddrs[0]));
+  for (ScAddr const & arcAddr : arcAddrs)
+    EXPECT_FALSE(ctx.IsElement(arcAddr));
+  EXPECT_TRUE(ctx.GenerateNode(ScType::ConstNode).IsValid());
+
+  ctx.Destroy();
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(SmallScMemoryTest, SegmentsInHugePages)
+{
+  TestSegmentsAllocation(SC_TRUE, SC_SEGMENTS_NUMA_POLICY_NONE);
+}
+
+TEST(SmallScMemoryTest, SegmentsInterleavedByNumaNodes)
+{
+  TestSegmentsAllocation(SC_FALSE, SC_SEGMENTS_NUMA_POLICY_INTERLEAVE);
+  TestSegmentsAllocation(SC_TRUE, SC_SEGMENTS_NUMA_POLICY_INTERLEAVE);
+}
+
+TEST(SmallScMemoryTest, SegmentsBoundToNumaNodes)
+{
+  TestSegmentsAllocation(SC_FALSE, SC_SEGMENTS_NUMA_POLICY_BIND);
+  TestSegmentsAllocation(SC_TRUE, SC_SEGMENTS_NUMA_POLICY_BIND);
+}
+
+TEST(SmallScMemoryTest, SegmentsInNormalPagesWithoutReservedHugePages)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+  params.segments_huge_pages = SC_TRUE;
+  sc_segment_allocator_initialize(&params);
+
+  // the allocator falls back to normal pages if there are no free reserved huge pages
+  sc_uint64 const size = 3 * 1024 * 1024 + 1;
+  sc_bool isMapped;
+  auto * memory = (sc_uchar *)sc_segment_allocator_new(0, size, &isMapped);
+  ASSERT_NE(memory, nullptr);
+#if SC_IS_PLATFORM_LINUX
+  EXPECT_TRUE(isMapped);
+#else
+  EXPECT_FALSE(isMapped);
+#endif
+  EXPECT_EQ(memory[0], 0u);
+  EXPECT_EQ(memory[size - 1], 0u);
+  memory[0] = 1;
+  memory[size - 1] = 1;
+  sc_segment_allocator_free(memory, size, isMapped);
+
+  sc_segment_allocator_shutdown();
+}
+
+TEST(SmallScMemoryTest, CheckConnectorsByIndex)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.connectors_index = SC_TRUE;
 
   ScMemory::LogMute();
   ScMemory::Initialize(params);
   ScMemory::LogUnmute();
 
   ScMemoryContext ctx;
-  ctx.Save();
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const otherNodeAddr = ctx.GenerateNode(ScType::ConstNode);
+
+  ScAddr const arcAddr1 = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+  ScAddr const arcAddr2 = ctx.GenerateConnector(ScType::ConstCommonArc, classAddr, nodeAddr);
+  ScAddr const arcAddr3 = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+  ctx.GenerateConnector(ScType::ConstCommonEdge, otherNodeAddr, classAddr);
+
+  EXPECT_TRUE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstPermPosArc));
+  EXPECT_TRUE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstCommonArc));
+  EXPECT_FALSE(ctx.CheckConnector(nodeAddr, classAddr, ScType::ConstPermPosArc));
+  EXPECT_TRUE(ctx.CheckConnector(classAddr, otherNodeAddr, ScType::ConstCommonEdge));
+  EXPECT_TRUE(ctx.CheckConnector(otherNodeAddr, classAddr, ScType::ConstCommonEdge));
+  EXPECT_FALSE(ctx.CheckConnector(classAddr, otherNodeAddr, ScType::ConstPermPosArc));
+
+  ScAddrVector arcAddrs;
+  ScIterator3Ptr it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  while (it3->Next())
+    arcAddrs.push_back(it3->Get(1));
+  EXPECT_EQ(arcAddrs, ScAddrVector({arcAddr3, arcAddr1}));
+
+  EXPECT_GT(ctx.CalculateStatistics().m_connectorsIndexSize, 0u);
+
+  EXPECT_TRUE(ctx.EraseElement(arcAddr3));
+  EXPECT_TRUE(ctx.EraseElement(arcAddr1));
+  EXPECT_FALSE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstPermPosArc));
+  EXPECT_TRUE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstCommonArc));
+
+  EXPECT_TRUE(ctx.EraseElement(nodeAddr));
+  EXPECT_FALSE(ctx.IsElement(arcAddr2));
+  EXPECT_FALSE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstCommonArc));
+
   ctx.Destroy();
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
 
-  auto previousScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  sleep(10);
-  auto currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
-  previousScMemorySaveTime = currentScMemorySaveTime;
-  sleep(10);
-  currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
-  previousScMemorySaveTime = currentScMemorySaveTime;
-  sleep(10);
-  currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
+TEST(SmallScMemoryTest, EraseConnectorsWhileIteratingByIndex)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.connectors_index = SC_TRUE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
 
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddrVector arcAddrs;
+  for (size_t i = 0; i < 10; ++i)
+    arcAddrs.push_back(ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr));
+
+  // got sc-arcs are erased with some of not got ones, and sc-arcs generated during iteration aren't got
+  ScAddr newArcAddr;
+  ScAddrVector gotArcAddrs;
+  ScIterator3Ptr it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  while (it3->Next())
+  {
+    ScAddr const arcAddr = it3->Get(1);
+    gotArcAddrs.push_back(arcAddr);
+    EXPECT_TRUE(ctx.EraseElement(arcAddr));
+    if (arcAddr == arcAddrs[9])
+      EXPECT_TRUE(ctx.EraseElement(arcAddrs[8]));
+    else if (arcAddr == arcAddrs[6])
+    {
+      EXPECT_TRUE(ctx.EraseElement(arcAddrs[5]));
+      newArcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+    }
+  }
+  EXPECT_EQ(
+      gotArcAddrs,
+      ScAddrVector(
+          {arcAddrs[9], arcAddrs[7], arcAddrs[6], arcAddrs[4], arcAddrs[3], arcAddrs[2], arcAddrs[1], arcAddrs[0]}));
+
+  it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  EXPECT_TRUE(it3->Next());
+  EXPECT_EQ(it3->Get(1), newArcAddr);
+  EXPECT_FALSE(it3->Next());
+
+  ctx.Destroy();
   ScMemory::LogMute();
   ScMemory::Shutdown();
   ScMemory::LogUnmute();
 }
 
-TEST(ScMemoryDumper, DumpMemoryStatistics)
+TEST(SmallScMemoryTest, IndexLoadedConnectors)
 {
   sc_memory_params params;
   sc_memory_params_clear(&params);
@@ -740,25 +1067,797 @@ TEST(ScMemoryDumper, DumpMemoryStatistics)
   params.storage = "repo";
   params.log_level = "Debug";
 
-  params.dump_memory = SC_FALSE;
-  params.dump_memory_period = 4;
-  params.dump_memory_statistics = SC_TRUE;
-  params.dump_memory_statistics_period = 4;
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
 
-  params.max_loaded_segments = 1;
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const arcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+  ScAddr const edgeAddr = ctx.GenerateConnector(ScType::ConstCommonEdge, classAddr, nodeAddr);
+  ScAddr const loopAddr = ctx.GenerateConnector(ScType::ConstCommonEdge, nodeAddr, nodeAddr);
+  EXPECT_EQ(ctx.CalculateStatistics().m_connectorsIndexSize, 0u);
+  ctx.Destroy();
+
+  // the index isn't saved, so it is built from sc-connectors of loaded sc-memory
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  params.clear = SC_FALSE;
+  params.connectors_index = SC_TRUE;
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext newCtx;
+  EXPECT_GT(newCtx.CalculateStatistics().m_connectorsIndexSize, 0u);
+
+  auto const getConnectors = [&newCtx](ScAddr const & beginAddr, ScAddr const & endAddr)
+  {
+    ScAddrVector connectorAddrs;
+    ScIterator3Ptr it3 = newCtx.CreateIterator3(beginAddr, ScType::Unknown, endAddr);
+    while (it3->Next())
+      connectorAddrs.push_back(it3->Get(1));
+    return connectorAddrs;
+  };
+
+  // loops are got once
+  EXPECT_EQ(getConnectors(classAddr, nodeAddr), ScAddrVector({edgeAddr, arcAddr}));
+  EXPECT_EQ(getConnectors(nodeAddr, classAddr), ScAddrVector({edgeAddr}));
+  EXPECT_EQ(getConnectors(nodeAddr, nodeAddr), ScAddrVector({loopAddr}));
+
+  ScAddr const otherLoopAddr = newCtx.GenerateConnector(ScType::ConstCommonEdge, nodeAddr, nodeAddr);
+  EXPECT_EQ(getConnectors(nodeAddr, nodeAddr), ScAddrVector({otherLoopAddr, loopAddr}));
+
+  newCtx.Destroy();
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(SmallScMemoryTest, EraseAllConnectorsOfPairByIndex)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.connectors_index = SC_TRUE;
 
   ScMemory::LogMute();
   ScMemory::Initialize(params);
   ScMemory::LogUnmute();
 
   ScMemoryContext ctx;
-  ctx.Save();
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddrVector arcAddrs;
+  for (size_t i = 0; i < 1000; ++i)
+    arcAddrs.push_back(ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr));
+
+  // removed sc-arcs are skipped until entries of the pair are compacted
+  for (size_t i = 0; i < arcAddrs.size(); i += 2)
+    EXPECT_TRUE(ctx.EraseElement(arcAddrs[i]));
+
+  ScAddrVector gotArcAddrs;
+  ScIterator3Ptr it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  while (it3->Next())
+    gotArcAddrs.push_back(it3->Get(1));
+  EXPECT_EQ(gotArcAddrs.size(), arcAddrs.size() / 2);
+  EXPECT_EQ(gotArcAddrs.front(), arcAddrs.back());
+
+  for (size_t i = 1; i < arcAddrs.size(); i += 2)
+    EXPECT_TRUE(ctx.EraseElement(arcAddrs[i]));
+  EXPECT_FALSE(ctx.CheckConnector(classAddr, nodeAddr, ScType::ConstPermPosArc));
+
   ctx.Destroy();
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
 
-  auto const & previousScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  sleep(10);
-  auto const & currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
-  EXPECT_EQ(previousScMemorySaveTime, currentScMemorySaveTime);
+TEST(SmallScMemoryTest, SwitchConnectorsIndex)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddrVector arcAddrs;
+  for (size_t i = 0; i < 4; ++i)
+    arcAddrs.push_back(ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr));
+
+  auto const getConnectors = [](ScIterator3Ptr const & it3)
+  {
+    ScAddrVector connectorAddrs;
+    while (it3->Next())
+      connectorAddrs.push_back(it3->Get(1));
+    return connectorAddrs;
+  };
+
+  // iterations started before the index is switched are continued without repeated sc-arcs
+  ScIterator3Ptr it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  EXPECT_TRUE(it3->Next());
+  EXPECT_EQ(it3->Get(1), arcAddrs[3]);
+  EXPECT_EQ(sc_memory_set_connectors_index(*ctx, SC_TRUE), SC_RESULT_OK);
+  EXPECT_GT(ctx.CalculateStatistics().m_connectorsIndexSize, 0u);
+  EXPECT_EQ(getConnectors(it3), ScAddrVector({arcAddrs[2], arcAddrs[1], arcAddrs[0]}));
+
+  it3 = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr);
+  EXPECT_TRUE(it3->Next());
+  EXPECT_EQ(it3->Get(1), arcAddrs[3]);
+  EXPECT_EQ(sc_memory_set_connectors_index(*ctx, SC_FALSE), SC_RESULT_OK);
+  EXPECT_EQ(ctx.CalculateStatistics().m_connectorsIndexSize, 0u);
+  EXPECT_EQ(getConnectors(it3), ScAddrVector({arcAddrs[2], arcAddrs[1], arcAddrs[0]}));
+
+  // the index is switched while other threads generate and erase sc-arcs, and it is built from linked ones only
+  std::atomic_bool isStopped{false};
+  std::thread generator(
+      [&]()
+      {
+        ScMemoryContext generatorCtx;
+        while (!isStopped)
+        {
+          ScAddr const arcAddr = generatorCtx.GenerateConnector(ScType::ConstCommonArc, classAddr, nodeAddr);
+          EXPECT_TRUE(generatorCtx.EraseElement(arcAddr));
+          generatorCtx.GenerateConnector(ScType::ConstCommonArc, classAddr, nodeAddr);
+        }
+      });
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(sc_memory_set_connectors_index(*ctx, i % 2 == 0 ? SC_TRUE : SC_FALSE), SC_RESULT_OK);
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(sc_memory_set_connectors_index(*ctx, SC_TRUE), SC_RESULT_OK);
+  isStopped = true;
+  generator.join();
+
+  ScAddrVector const indexedArcAddrs = getConnectors(ctx.CreateIterator3(classAddr, ScType::ConstCommonArc, nodeAddr));
+  EXPECT_EQ(indexedArcAddrs.size(), ctx.GetElementOutputArcsCount(classAddr) - arcAddrs.size());
+  EXPECT_EQ(ScAddrSet(indexedArcAddrs.cbegin(), indexedArcAddrs.cend()).size(), indexedArcAddrs.size());
+  EXPECT_EQ(
+      getConnectors(ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, nodeAddr)),
+      ScAddrVector({arcAddrs[3], arcAddrs[2], arcAddrs[1], arcAddrs[0]}));
+
+  ctx.Destroy();
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, DumpMemory)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_TRUE;
+  params.dump_memory_period = 4;
+  params.dump_memory_statistics = SC_FALSE;
+
+  params.max_loaded_segments = 1;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ctx.Save();
+  ctx.Destroy();
+
+  auto previousScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  sleep(10);
+  auto currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
+  previousScMemorySaveTime = currentScMemorySaveTime;
+  sleep(10);
+  currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
+  previousScMemorySaveTime = currentScMemorySaveTime;
+  sleep(10);
+  currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  EXPECT_NE(previousScMemorySaveTime, currentScMemorySaveTime);
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, DumpMemoryStatistics)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_period = 4;
+  params.dump_memory_statistics = SC_TRUE;
+  params.dump_memory_statistics_period = 4;
+
+  params.max_loaded_segments = 1;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ctx.Save();
+  ctx.Destroy();
+
+  auto const & previousScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  sleep(10);
+  auto const & currentScMemorySaveTime = std::filesystem::last_write_time("repo/segments.scdb");
+  EXPECT_EQ(previousScMemorySaveTime, currentScMemorySaveTime);
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, RecoverMemoryFromWriteAheadLog)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+  params.write_ahead_log = SC_TRUE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const erasedNodeAddr = ctx.GenerateNode(ScType::ConstNode);
+  ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+  ScAddr const arcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, erasedNodeAddr);
+  EXPECT_TRUE(ctx.SetLinkContent(linkAddr, "content"));
+  EXPECT_TRUE(ctx.SetElementSubtype(classAddr, ScType::ConstNodeClass));
+  EXPECT_TRUE(ctx.EraseElement(erasedNodeAddr));
+  ctx.Destroy();
+
+  // sc-memory isn't saved, so its changes are restored from write-ahead log only
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  params.clear = SC_FALSE;
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext newCtx;
+  EXPECT_EQ(newCtx.GetElementType(classAddr), ScType::ConstNodeClass);
+  EXPECT_TRUE(newCtx.IsElement(nodeAddr));
+  EXPECT_FALSE(newCtx.IsElement(erasedNodeAddr));
+  EXPECT_TRUE(newCtx.CheckConnector(classAddr, nodeAddr, ScType::ConstPermPosArc));
+  EXPECT_EQ(newCtx.GetArcSourceElement(arcAddr), classAddr);
+
+  std::string content;
+  EXPECT_TRUE(newCtx.GetLinkContent(linkAddr, content));
+  EXPECT_EQ(content, "content");
+
+  ScAddrVector targetAddrs;
+  ScIterator3Ptr it3 = newCtx.CreateIterator3(classAddr, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it3->Next())
+    targetAddrs.push_back(it3->Get(2));
+  EXPECT_EQ(targetAddrs, ScAddrVector({nodeAddr}));
+
+  ScAddr const newNodeAddr = newCtx.GenerateNode(ScType::ConstNode);
+  EXPECT_NE(newNodeAddr, classAddr);
+  EXPECT_NE(newNodeAddr, nodeAddr);
+  EXPECT_NE(newNodeAddr, linkAddr);
+  EXPECT_NE(newNodeAddr, arcAddr);
+
+  // log files of changes contained in dump are removed
+  EXPECT_TRUE(newCtx.Save());
+  sc_uint32 logFilesCount = 0;
+  for (auto const & entry : std::filesystem::directory_iterator("repo"))
+    logFilesCount += entry.path().filename().string().rfind("wal_", 0) == 0;
+  EXPECT_EQ(logFilesCount, 1u);
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+sc_uint64 GetStringsFilesSize(std::string const & path)
+{
+  sc_uint64 size = 0;
+  for (auto const & entry : std::filesystem::recursive_directory_iterator(path))
+  {
+    std::string const name = entry.path().filename().string();
+    if (entry.is_regular_file() && name.rfind("strings", 0) == 0 && name.find("checksums") == std::string::npos)
+      size += entry.file_size();
+  }
+  return size;
+}
+
+TEST(ScMemoryDumper, RedoLinkContentContainedInDump)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+  params.write_ahead_log = SC_TRUE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+  EXPECT_TRUE(ctx.SetLinkContent(linkAddr, "not searchable content", false));
+
+  // log files are kept as if sc-memory was stopped after dump was saved but before they were removed
+  std::filesystem::path const logsPath = "repo_logs";
+  std::filesystem::remove_all(logsPath);
+  std::filesystem::create_directory(logsPath);
+  for (auto const & entry : std::filesystem::directory_iterator("repo"))
+  {
+    if (entry.path().filename().string().rfind("wal_", 0) == 0)
+      std::filesystem::copy_file(entry.path(), logsPath / entry.path().filename());
+  }
+
+  EXPECT_TRUE(ctx.Save());
+  ctx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  ScMemory::LogUnmute();
+
+  for (auto const & entry : std::filesystem::directory_iterator(logsPath))
+    std::filesystem::copy_file(
+        entry.path(),
+        std::filesystem::path("repo") / entry.path().filename(),
+        std::filesystem::copy_options::overwrite_existing);
+  std::filesystem::remove_all(logsPath);
+  sc_uint64 const stringsSize = GetStringsFilesSize("repo");
+
+  // loaded dump already contains content of sc-link, so it isn't written again
+  ScMemory::LogMute();
+  params.clear = SC_FALSE;
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  EXPECT_EQ(GetStringsFilesSize("repo"), stringsSize);
+
+  ScMemoryContext newCtx;
+  std::string content;
+  EXPECT_TRUE(newCtx.GetLinkContent(linkAddr, content));
+  EXPECT_EQ(content, "not searchable content");
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, ReuseElementsErasedInOtherThreadAfterReload)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // erased sc-nodes and not used reserved sc-elements stay in allocation cache of the thread while sc-memory is saved
+  size_t const erasedNodesCount = 100;
+  std::unordered_set<sc_addr_hash> erasedNodes;
+  std::promise<void> nodesErased;
+  std::promise<void> memorySaved;
+  std::thread thread(
+      [&]()
+      {
+        ScMemoryContext threadCtx;
+        for (size_t i = 0; i < erasedNodesCount; ++i)
+        {
+          ScAddr const nodeAddr = threadCtx.GenerateNode(ScType::ConstNode);
+          erasedNodes.insert(nodeAddr.Hash());
+          EXPECT_TRUE(threadCtx.EraseElement(nodeAddr));
+        }
+        nodesErased.set_value();
+        memorySaved.get_future().wait();
+      });
+
+  nodesErased.get_future().wait();
+  ScMemoryContext ctx;
+  EXPECT_TRUE(ctx.Save());
+  ctx.Destroy();
+  memorySaved.set_value();
+  thread.join();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  params.clear = SC_FALSE;
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // released sc-elements are reused when not engaged ones of their segments are over
+  ScMemoryContext newCtx;
+  for (size_t i = 0; i < 2 * SC_SEGMENT_ELEMENTS_COUNT && !erasedNodes.empty(); ++i)
+    erasedNodes.erase(newCtx.GenerateNode(ScType::ConstNode).Hash());
+  EXPECT_TRUE(erasedNodes.empty());
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, SaveMemoryWhileElementsAreGeneratedAndErased)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(2 * SC_SEGMENT_ELEMENTS_COUNT, ScType::ConstNode);
+  ScConnectorTripleVector triples;
+  for (ScAddr const & nodeAddr : nodeAddrs)
+    triples.push_back({ScType::ConstPermPosArc, classAddr, nodeAddr});
+  ScAddrVector const & arcAddrs = ctx.GenerateConnectors(triples);
+
+  // sc-segments are copied to staging buffers under short locks, so other threads change them while dump is written
+  std::atomic_bool isStopped{false};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back(
+        [&isStopped]()
+        {
+          ScMemoryContext threadCtx;
+          ScAddr const threadClassAddr = threadCtx.GenerateNode(ScType::ConstNodeClass);
+          while (!isStopped)
+          {
+            ScAddr const nodeAddr = threadCtx.GenerateNode(ScType::ConstNode);
+            ScAddr const linkAddr = threadCtx.GenerateLink(ScType::ConstNodeLink);
+            threadCtx.GenerateConnector(ScType::ConstPermPosArc, threadClassAddr, nodeAddr);
+            EXPECT_TRUE(threadCtx.SetLinkContent(linkAddr, "content"));
+            EXPECT_TRUE(threadCtx.EraseElement(nodeAddr));
+          }
+        });
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    EXPECT_TRUE(ctx.Save());
+
+  isStopped = true;
+  for (auto & thread : threads)
+    thread.join();
+  ctx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  params.clear = SC_FALSE;
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // sc-elements generated before dump was started are saved whatever other threads changed during it
+  ScMemoryContext newCtx;
+  EXPECT_EQ(newCtx.GetElementType(classAddr), ScType::ConstNodeClass);
+  for (size_t i = 0; i < arcAddrs.size(); ++i)
+  {
+    EXPECT_TRUE(newCtx.IsElement(nodeAddrs[i]));
+    EXPECT_EQ(newCtx.GetElementType(arcAddrs[i]), ScType::ConstPermPosArc);
+    EXPECT_EQ(newCtx.GetArcSourceElement(arcAddrs[i]), classAddr);
+    EXPECT_EQ(newCtx.GetArcTargetElement(arcAddrs[i]), nodeAddrs[i]);
+  }
+
+  size_t arcsCount = 0;
+  ScIterator3Ptr it3 = newCtx.CreateIterator3(classAddr, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it3->Next())
+    ++arcsCount;
+  EXPECT_EQ(arcsCount, arcAddrs.size());
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown(false);
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, CompactStorage)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // erased sc-nodes fill more than one segment, and the remaining sc-elements fit into one segment
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  EXPECT_TRUE(ctx.SetElementSystemIdentifier("compacted_class", classAddr));
+  size_t const nodesCount = 70000;
+  size_t const remainingNodesCount = nodesCount / 100;
+  ScAddrVector nodeAddrs;
+  for (size_t i = 0; i < nodesCount; ++i)
+    nodeAddrs.push_back(ctx.GenerateNode(ScType::ConstNode));
+  for (size_t i = 0; i < nodesCount; ++i)
+  {
+    if (i % 100 == 0)
+      ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddrs[i]);
+    else
+      EXPECT_TRUE(ctx.EraseElement(nodeAddrs[i]));
+  }
+  ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+  EXPECT_TRUE(ctx.SetLinkContent(linkAddr, "compacted content"));
+  ctx.GenerateConnector(ScType::ConstCommonArc, classAddr, linkAddr);
+  ctx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+
+  auto const segmentsSize = std::filesystem::file_size("repo/segments.scdb");
+  params.clear = SC_FALSE;
+  ScMemory::LogMute();
+  EXPECT_TRUE(ScMemory::CompactStorage(params));
+  ScMemory::LogUnmute();
+  EXPECT_LT(std::filesystem::file_size("repo/segments.scdb"), segmentsSize);
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // sc-elements are found by their relocated connectors and contents
+  ScMemoryContext newCtx;
+  ScAddr const newClassAddr = newCtx.SearchElementBySystemIdentifier("compacted_class");
+  EXPECT_TRUE(newCtx.IsElement(newClassAddr));
+  EXPECT_EQ(newCtx.GetElementType(newClassAddr), ScType::ConstNodeClass);
+
+  size_t nodesNumber = 0;
+  ScIterator3Ptr it3 = newCtx.CreateIterator3(newClassAddr, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it3->Next())
+  {
+    EXPECT_EQ(newCtx.GetArcSourceElement(it3->Get(1)), newClassAddr);
+    EXPECT_EQ(newCtx.GetArcTargetElement(it3->Get(1)), it3->Get(2));
+    ++nodesNumber;
+  }
+  EXPECT_EQ(nodesNumber, remainingNodesCount);
+
+  ScAddrSet const linkAddrs = newCtx.SearchLinksByContent("compacted content");
+  EXPECT_EQ(linkAddrs.size(), 1u);
+  ScAddr const newLinkAddr = *linkAddrs.begin();
+  EXPECT_TRUE(newCtx.CheckConnector(newClassAddr, newLinkAddr, ScType::ConstCommonArc));
+  std::string content;
+  EXPECT_TRUE(newCtx.GetLinkContent(newLinkAddr, content));
+  EXPECT_EQ(content, "compacted content");
+
+  ScAddr const newNodeAddr = newCtx.GenerateNode(ScType::ConstNode);
+  EXPECT_TRUE(newCtx.IsElement(newNodeAddr));
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, CompactStorageWithInterleavedPools)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  EXPECT_TRUE(ctx.SetElementSystemIdentifier("compacted_class", classAddr));
+
+  size_t const linksCount = 10;
+  auto const generateLinks = [&ctx, &classAddr](std::string const & prefix)
+  {
+    for (size_t i = 0; i < linksCount; ++i)
+    {
+      ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+      EXPECT_TRUE(ctx.SetLinkContent(linkAddr, prefix + std::to_string(i)));
+      ctx.GenerateConnector(ScType::ConstCommonArc, classAddr, linkAddr);
+    }
+  };
+
+  // with compact layout of sc-elements, segments of sc-nodes and sc-connectors interleave, and the segment of erased
+  // sc-arcs is freed, so sc-links of the next segment keep their places, but their addresses are changed
+  generateLinks("first content ");
+  ScAddrVector const & nodeAddrs = ctx.GenerateNodes(SC_SEGMENT_ELEMENTS_COUNT, ScType::ConstNode);
+  ScConnectorTripleVector triples;
+  for (ScAddr const & nodeAddr : nodeAddrs)
+    triples.push_back({ScType::ConstPermPosArc, classAddr, nodeAddr});
+  ScAddrVector const & arcAddrs = ctx.GenerateConnectors(triples, false);
+  ctx.GenerateNodes(SC_SEGMENT_ELEMENTS_COUNT, ScType::ConstNode);
+  generateLinks("second content ");
+  EXPECT_TRUE(ctx.EraseElements(arcAddrs));
+  ctx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+
+  params.clear = SC_FALSE;
+  ScMemory::LogMute();
+  EXPECT_TRUE(ScMemory::CompactStorage(params));
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // every sc-link has its own content, and it is found by this content only
+  ScMemoryContext newCtx;
+  ScAddr const newClassAddr = newCtx.SearchElementBySystemIdentifier("compacted_class");
+  EXPECT_TRUE(newCtx.IsElement(newClassAddr));
+
+  std::set<std::string> contents;
+  ScIterator3Ptr it3 = newCtx.CreateIterator3(newClassAddr, ScType::ConstCommonArc, ScType::ConstNodeLink);
+  while (it3->Next())
+  {
+    std::string content;
+    EXPECT_TRUE(newCtx.GetLinkContent(it3->Get(2), content));
+    EXPECT_EQ(newCtx.SearchLinksByContent(content), ScAddrSet({it3->Get(2)}));
+    contents.insert(content);
+  }
+
+  std::set<std::string> expectedContents;
+  for (size_t i = 0; i < linksCount; ++i)
+  {
+    expectedContents.insert("first content " + std::to_string(i));
+    expectedContents.insert("second content " + std::to_string(i));
+  }
+  EXPECT_EQ(contents, expectedContents);
+  newCtx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+}
+
+TEST(ScMemoryDumper, ExportImportStorage)
+{
+  sc_memory_params params;
+  sc_memory_params_clear(&params);
+
+  params.clear = SC_TRUE;
+  params.storage = "repo";
+  params.log_level = "Debug";
+
+  params.dump_memory = SC_FALSE;
+  params.dump_memory_statistics = SC_FALSE;
+
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // sc-connectors are generated between sc-nodes, sc-links and other sc-connectors of several segments
+  ScMemoryContext ctx;
+  ScAddr const classAddr = ctx.GenerateNode(ScType::ConstNodeClass);
+  EXPECT_TRUE(ctx.SetElementSystemIdentifier("exported_class", classAddr));
+  ScAddr const relationAddr = ctx.GenerateNode(ScType::ConstNodeNonRole);
+  EXPECT_TRUE(ctx.SetElementSystemIdentifier("nrel_exported", relationAddr));
+  size_t const nodesCount = 70000;
+  for (size_t i = 0; i < nodesCount; ++i)
+  {
+    ScAddr const nodeAddr = ctx.GenerateNode(ScType::ConstNode);
+    ScAddr const arcAddr = ctx.GenerateConnector(ScType::ConstPermPosArc, classAddr, nodeAddr);
+    if (i % 10 == 0)
+      ctx.GenerateConnector(ScType::ConstPermPosArc, relationAddr, arcAddr);
+  }
+  ScAddr const linkAddr = ctx.GenerateLink(ScType::ConstNodeLink);
+  EXPECT_TRUE(ctx.SetLinkContent(linkAddr, "exported content"));
+  ctx.GenerateConnector(ScType::ConstCommonArc, classAddr, linkAddr);
+  ctx.Destroy();
+
+  ScMemory::LogMute();
+  ScMemory::Shutdown();
+  ScMemory::LogUnmute();
+
+  params.clear = SC_FALSE;
+  ScMemory::LogMute();
+  EXPECT_TRUE(ScMemory::ExportStorage(params, "repo.scg"));
+  ScMemory::LogUnmute();
+
+  params.clear = SC_TRUE;
+  params.storage = "imported_repo";
+  ScMemory::LogMute();
+  EXPECT_TRUE(ScMemory::ImportStorage(params, "repo.scg"));
+  ScMemory::LogUnmute();
+
+  params.clear = SC_FALSE;
+  ScMemory::LogMute();
+  ScMemory::Initialize(params);
+  ScMemory::LogUnmute();
+
+  // sc-elements are found by their imported connectors and contents
+  ScMemoryContext newCtx;
+  ScAddr const newClassAddr = newCtx.SearchElementBySystemIdentifier("exported_class");
+  EXPECT_TRUE(newCtx.IsElement(newClassAddr));
+  EXPECT_EQ(newCtx.GetElementType(newClassAddr), ScType::ConstNodeClass);
+  ScAddr const newRelationAddr = newCtx.SearchElementBySystemIdentifier("nrel_exported");
+  EXPECT_TRUE(newCtx.IsElement(newRelationAddr));
+
+  size_t nodesNumber = 0;
+  ScIterator3Ptr it3 = newCtx.CreateIterator3(newClassAddr, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it3->Next())
+    ++nodesNumber;
+  EXPECT_EQ(nodesNumber, nodesCount);
+
+  size_t arcsNumber = 0;
+  it3 = newCtx.CreateIterator3(newRelationAddr, ScType::ConstPermPosArc, ScType::ConstPermPosArc);
+  while (it3->Next())
+  {
+    EXPECT_EQ(newCtx.GetArcSourceElement(it3->Get(2)), newClassAddr);
+    ++arcsNumber;
+  }
+  EXPECT_EQ(arcsNumber, nodesCount / 10);
+
+  ScAddrSet const linkAddrs = newCtx.SearchLinksByContent("exported content");
+  EXPECT_EQ(linkAddrs.size(), 1u);
+  ScAddr const newLinkAddr = *linkAddrs.begin();
+  EXPECT_TRUE(newCtx.CheckConnector(newClassAddr, newLinkAddr, ScType::ConstCommonArc));
+  std::string content;
+  EXPECT_TRUE(newCtx.GetLinkContent(newLinkAddr, content));
+  EXPECT_EQ(content, "exported content");
+  newCtx.Destroy();
 
   ScMemory::LogMute();
   ScMemory::Shutdown();
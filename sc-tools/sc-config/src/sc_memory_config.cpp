@@ -162,6 +162,11 @@ sc_memory_params ScMemoryConfig::GetParams()
   m_memoryParams.enabled_extensions = nullptr;
 
   m_memoryParams.max_loaded_segments = GetIntByKey("max_loaded_segments", DEFAULT_MAX_LOADED_SEGMENTS);
+  m_memoryParams.segments_huge_pages = GetBoolByKey("segments_huge_pages", DEFAULT_SEGMENTS_HUGE_PAGES);
+  m_memoryParams.segments_numa_policy = GetStringByKey("segments_numa_policy", DEFAULT_SEGMENTS_NUMA_POLICY);
+  m_memoryParams.segments_memory_limit = GetIntByKey("segments_memory_limit", DEFAULT_SEGMENTS_MEMORY_LIMIT);
+  m_memoryParams.arcs_index_threshold = GetIntByKey("arcs_index_threshold", DEFAULT_ARCS_INDEX_THRESHOLD);
+  m_memoryParams.connectors_index = GetBoolByKey("connectors_index", DEFAULT_CONNECTORS_INDEX);
 
   m_memoryParams.limit_max_threads_by_max_physical_cores =
       GetBoolByKey("limit_max_threads_by_max_physical_cores", DEFAULT_LIMIT_MAX_THREADS_BY_MAX_PHYSICAL_CORES);
@@ -177,6 +182,15 @@ sc_memory_params ScMemoryConfig::GetParams()
         "`dump_memory_period` instead.");
   }
   m_memoryParams.dump_memory_period = GetIntByKey("dump_memory_period", DEFAULT_DUMP_MEMORY_PERIOD);
+  m_memoryParams.dump_memory_deltas_count = GetIntByKey("dump_memory_deltas_count", DEFAULT_DUMP_MEMORY_DELTAS_COUNT);
+  m_memoryParams.dump_memory_compression = GetStringByKey("dump_memory_compression", DEFAULT_DUMP_MEMORY_COMPRESSION);
+  m_memoryParams.skip_corrupted_segments = GetBoolByKey("skip_corrupted_segments", DEFAULT_SKIP_CORRUPTED_SEGMENTS);
+
+  m_memoryParams.write_ahead_log = GetBoolByKey("write_ahead_log", DEFAULT_WRITE_AHEAD_LOG);
+  m_memoryParams.write_ahead_log_sync_policy =
+      GetStringByKey("write_ahead_log_sync_policy", DEFAULT_WRITE_AHEAD_LOG_SYNC_POLICY);
+  m_memoryParams.write_ahead_log_sync_period =
+      GetIntByKey("write_ahead_log_sync_period", DEFAULT_WRITE_AHEAD_LOG_SYNC_PERIOD);
 
   m_memoryParams.dump_memory_statistics = GetBoolByKey("dump_memory_statistics", DEFAULT_DUMP_MEMORY_STATISTICS);
   if (HasKey("update_period"))
@@ -204,6 +218,7 @@ sc_memory_params ScMemoryConfig::GetParams()
       GetIntByKey("max_searchable_string_size", DEFAULT_MAX_SEARCHABLE_STRING_SIZE);
   m_memoryParams.term_separators = GetStringByKey("term_separators", DEFAULT_TERM_SEPARATORS);
   m_memoryParams.search_by_substring = GetBoolByKey("search_by_substring", DEFAULT_SEARCH_BY_SUBSTRING);
+  m_memoryParams.link_contents_index = GetStringByKey("link_contents_index", DEFAULT_LINK_CONTENTS_INDEX);
 
   return m_memoryParams;
 }
@@ -49,6 +49,21 @@ void PrintHelpMessage(std::string const & binaryName)
          "binaries.\n"
       << "  --test|-t                               Test sc-memory state. "
       << "If this flag is specified, sc-memory will be initialized and shutdown immediately.\n"
+      << "  --verify-storage                        Verify checksums of knowledge base binaries without loading "
+         "them. Every corrupted sc-segment and strings channel is reported.\n"
+         "                                          If this flag is specified, sc-memory isn't initialized, and exit "
+         "code is non-zero if knowledge base binaries are corrupted.\n"
+      << "  --compact-storage                       Relocate sc-elements of knowledge base binaries into the first "
+         "sc-segments and free sc-segments emptied by erased sc-elements.\n"
+         "                                          If this flag is specified, sc-memory isn't initialized. Addresses "
+         "of relocated sc-elements are changed.\n"
+      << "  --export-storage <file>                 Export sc-elements of knowledge base binaries with contents of "
+         "sc-links to file of binary format independent of build options.\n"
+         "                                          If this flag is specified, sc-memory isn't initialized.\n"
+      << "  --import-storage <file>                 Import sc-elements exported with --export-storage to knowledge "
+         "base binaries. Imported sc-elements get new addresses.\n"
+         "                                          If this flag is specified, sc-memory isn't initialized. Use "
+         "--clear to import them to empty knowledge base binaries.\n"
       << "  --version                               Display version of " << binaryName << ".\n"
       << "  --help                                  Display this help message.\n";
 }
@@ -92,6 +107,24 @@ try
     return EXIT_FAILURE;
   }
 
+  if (options.Has({"verify-storage"}))
+    return ScMemory::VerifyStorage(memoryConfig.GetParams()) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  if (options.Has({"compact-storage"}))
+    return ScMemory::CompactStorage(memoryConfig.GetParams()) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  if (options.Has({"export-storage"}))
+  {
+    std::string const path = options[{"export-storage"}].second;
+    return ScMemory::ExportStorage(memoryConfig.GetParams(), path) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (options.Has({"import-storage"}))
+  {
+    std::string const path = options[{"import-storage"}].second;
+    return ScMemory::ImportStorage(memoryConfig.GetParams(), path) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   std::atomic_bool isRun;
   if (!ScMemory::Initialize(memoryConfig.GetParams()))
     goto error;
@@ -54,6 +54,49 @@ TEST_F(ScMachineTest, RunWithVerbose)
   EXPECT_EQ(RunMachine(argsNumber, (sc_char **)args), EXIT_SUCCESS);
 }
 
+TEST_F(ScMachineTest, RunVerifyStorage)
+{
+  sc_uint32 const runArgsNumber = 4;
+  sc_char const * runArgs[runArgsNumber] = {"sc-machine", "-c", SC_MACHINE_INI.c_str(), "-t"};
+  EXPECT_EQ(RunMachine(runArgsNumber, (sc_char **)runArgs), EXIT_SUCCESS);
+
+  sc_uint32 const argsNumber = 4;
+  sc_char const * args[argsNumber] = {"sc-machine", "-c", SC_MACHINE_INI.c_str(), "--verify-storage"};
+  EXPECT_EQ(RunMachine(argsNumber, (sc_char **)args), EXIT_SUCCESS);
+}
+
+TEST_F(ScMachineTest, RunCompactStorage)
+{
+  sc_uint32 const runArgsNumber = 4;
+  sc_char const * runArgs[runArgsNumber] = {"sc-machine", "-c", SC_MACHINE_INI.c_str(), "-t"};
+  EXPECT_EQ(RunMachine(runArgsNumber, (sc_char **)runArgs), EXIT_SUCCESS);
+
+  sc_uint32 const argsNumber = 4;
+  sc_char const * args[argsNumber] = {"sc-machine", "-c", SC_MACHINE_INI.c_str(), "--compact-storage"};
+  EXPECT_EQ(RunMachine(argsNumber, (sc_char **)args), EXIT_SUCCESS);
+
+  EXPECT_EQ(RunMachine(runArgsNumber, (sc_char **)runArgs), EXIT_SUCCESS);
+}
+
+TEST_F(ScMachineTest, RunExportImportStorage)
+{
+  sc_uint32 const runArgsNumber = 4;
+  sc_char const * runArgs[runArgsNumber] = {"sc-machine", "-c", SC_MACHINE_INI.c_str(), "-t"};
+  EXPECT_EQ(RunMachine(runArgsNumber, (sc_char **)runArgs), EXIT_SUCCESS);
+
+  sc_uint32 const exportArgsNumber = 5;
+  sc_char const * exportArgs[exportArgsNumber] = {
+      "sc-machine", "-c", SC_MACHINE_INI.c_str(), "--export-storage", "kb.scg"};
+  EXPECT_EQ(RunMachine(exportArgsNumber, (sc_char **)exportArgs), EXIT_SUCCESS);
+
+  sc_uint32 const importArgsNumber = 6;
+  sc_char const * importArgs[importArgsNumber] = {
+      "sc-machine", "-c", SC_MACHINE_INI.c_str(), "--clear", "--import-storage", "kb.scg"};
+  EXPECT_EQ(RunMachine(importArgsNumber, (sc_char **)importArgs), EXIT_SUCCESS);
+
+  EXPECT_EQ(RunMachine(runArgsNumber, (sc_char **)runArgs), EXIT_SUCCESS);
+}
+
 TEST_F(ScMachineTest, PrintHelp)
 {
   sc_uint32 const argsNumber = 2;
@@ -8,11 +8,6 @@
 
 #include "sc_server_action_defines.hpp"
 
-extern "C"
-{
-#include <sc-store/sc_storage.h>
-}
-
 ScServerImpl::ScServerImpl(std::string const & host, ScServerPort port, sc_bool parallelActions)
   : ScServer(host, port)
   , m_parallelActions(parallelActions)
@@ -116,13 +111,8 @@ void ScServerImpl::OnMessage(ScServerSessionId const & sessionId, ScServerMessag
   }
   else
   {
-    // TODO(NikitaZotov): sc-server should not know about it
-    sc_storage_start_new_process();
-
     action->Emit();
     delete action;
-
-    sc_storage_end_new_process();
   }
 }
 
@@ -37,6 +37,7 @@ packagelist_dev=(
   libwebsocketpp-dev
   nlohmann-json3-dev
   libxml2-dev
+  liblz4-dev
   python3-dev
   libgtest-dev
   libbenchmark-dev